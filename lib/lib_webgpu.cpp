@@ -1,5 +1,11 @@
 #include "lib_webgpu.h"
+#include "lib_webgpu_vertex_formats.h"
 #include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // The initializers below omit fields that are intended to default-initialize to zero.
 // Ignore Clang warnings about those.
@@ -17,61 +23,16 @@ const char *wgpu_compilation_message_type_to_string(WGPU_COMPILATION_MESSAGE_TYP
         : (type == WGPU_COMPILATION_MESSAGE_TYPE_INFO ? "info" : "error");
 }
 
+#define _WGPU_VERTEX_FORMAT_CHANNEL_COUNT(format, channelCount, byteSize, isUnorm) case format: return channelCount;
+#define _WGPU_VERTEX_FORMAT_BYTE_SIZE(format, channelCount, byteSize, isUnorm) case format: return byteSize;
+#define _WGPU_VERTEX_FORMAT_IS_UNORM(format, channelCount, byteSize, isUnorm) case format: return isUnorm;
+
 int wgpu_vertex_format_channel_count(WGPU_VERTEX_FORMAT format)
 {
   switch(format)
   {
-  case WGPU_VERTEX_FORMAT_UINT8:
-  case WGPU_VERTEX_FORMAT_SINT8:
-  case WGPU_VERTEX_FORMAT_UNORM8:
-  case WGPU_VERTEX_FORMAT_SNORM8:
-  case WGPU_VERTEX_FORMAT_UINT16:
-  case WGPU_VERTEX_FORMAT_SINT16:
-  case WGPU_VERTEX_FORMAT_UNORM16:
-  case WGPU_VERTEX_FORMAT_SNORM16:
-  case WGPU_VERTEX_FORMAT_FLOAT16:
-  case WGPU_VERTEX_FORMAT_FLOAT32:
-  case WGPU_VERTEX_FORMAT_UINT32:
-  case WGPU_VERTEX_FORMAT_SINT32:
-    return 1;
-
-  case WGPU_VERTEX_FORMAT_UINT8X2:
-  case WGPU_VERTEX_FORMAT_SINT8X2:
-  case WGPU_VERTEX_FORMAT_UNORM8X2:
-  case WGPU_VERTEX_FORMAT_SNORM8X2:
-  case WGPU_VERTEX_FORMAT_UINT16X2:
-  case WGPU_VERTEX_FORMAT_SINT16X2:
-  case WGPU_VERTEX_FORMAT_UNORM16X2:
-  case WGPU_VERTEX_FORMAT_SNORM16X2:
-  case WGPU_VERTEX_FORMAT_FLOAT16X2:
-  case WGPU_VERTEX_FORMAT_FLOAT32X2:
-  case WGPU_VERTEX_FORMAT_UINT32X2:
-  case WGPU_VERTEX_FORMAT_SINT32X2:
-    return 2;
-
-  case WGPU_VERTEX_FORMAT_FLOAT32X3:
-  case WGPU_VERTEX_FORMAT_UINT32X3:
-  case WGPU_VERTEX_FORMAT_SINT32X3:
-    return 3;
-
-  case WGPU_VERTEX_FORMAT_UINT8X4:
-  case WGPU_VERTEX_FORMAT_SINT8X4:
-  case WGPU_VERTEX_FORMAT_UNORM8X4:
-  case WGPU_VERTEX_FORMAT_SNORM8X4:
-  case WGPU_VERTEX_FORMAT_UINT16X4:
-  case WGPU_VERTEX_FORMAT_SINT16X4:
-  case WGPU_VERTEX_FORMAT_UNORM16X4:
-  case WGPU_VERTEX_FORMAT_SNORM16X4:
-  case WGPU_VERTEX_FORMAT_FLOAT16X4:
-  case WGPU_VERTEX_FORMAT_FLOAT32X4:
-  case WGPU_VERTEX_FORMAT_UINT32X4:
-  case WGPU_VERTEX_FORMAT_SINT32X4:
-  case WGPU_VERTEX_FORMAT_UNORM10_10_10_2:
-  case WGPU_VERTEX_FORMAT_UNORM8X4_BGRA:
-    return 4;
-
-  default:
-    return 0;
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_CHANNEL_COUNT)
+    default: return 0;
   }
 }
 
@@ -79,76 +40,24 @@ int wgpu_vertex_format_byte_size(WGPU_VERTEX_FORMAT format)
 {
   switch(format)
   {
-    case WGPU_VERTEX_FORMAT_UINT8:
-    case WGPU_VERTEX_FORMAT_SINT8:
-    case WGPU_VERTEX_FORMAT_UNORM8:
-    case WGPU_VERTEX_FORMAT_SNORM8:
-      return 1;
-
-    case WGPU_VERTEX_FORMAT_UINT8X2:
-    case WGPU_VERTEX_FORMAT_SINT8X2:
-    case WGPU_VERTEX_FORMAT_UNORM8X2:
-    case WGPU_VERTEX_FORMAT_SNORM8X2:
-    case WGPU_VERTEX_FORMAT_UINT16:
-    case WGPU_VERTEX_FORMAT_SINT16:
-    case WGPU_VERTEX_FORMAT_UNORM16:
-    case WGPU_VERTEX_FORMAT_SNORM16:
-    case WGPU_VERTEX_FORMAT_FLOAT16:
-      return 2;
-
-    case WGPU_VERTEX_FORMAT_UINT8X4:
-    case WGPU_VERTEX_FORMAT_SINT8X4:
-    case WGPU_VERTEX_FORMAT_UNORM8X4:
-    case WGPU_VERTEX_FORMAT_SNORM8X4:
-    case WGPU_VERTEX_FORMAT_UINT16X2:
-    case WGPU_VERTEX_FORMAT_SINT16X2:
-    case WGPU_VERTEX_FORMAT_UNORM16X2:
-    case WGPU_VERTEX_FORMAT_SNORM16X2:
-    case WGPU_VERTEX_FORMAT_FLOAT16X2:
-    case WGPU_VERTEX_FORMAT_FLOAT32:
-    case WGPU_VERTEX_FORMAT_UINT32:
-    case WGPU_VERTEX_FORMAT_SINT32:
-    case WGPU_VERTEX_FORMAT_UNORM10_10_10_2:
-    case WGPU_VERTEX_FORMAT_UNORM8X4_BGRA:
-      return 4;
-
-    case WGPU_VERTEX_FORMAT_UINT16X4:
-    case WGPU_VERTEX_FORMAT_SINT16X4:
-    case WGPU_VERTEX_FORMAT_UNORM16X4:
-    case WGPU_VERTEX_FORMAT_SNORM16X4:
-    case WGPU_VERTEX_FORMAT_FLOAT16X4:
-    case WGPU_VERTEX_FORMAT_FLOAT32X2:
-    case WGPU_VERTEX_FORMAT_UINT32X2:
-    case WGPU_VERTEX_FORMAT_SINT32X2:
-      return 8;
-
-    case WGPU_VERTEX_FORMAT_FLOAT32X3:
-    case WGPU_VERTEX_FORMAT_UINT32X3:
-    case WGPU_VERTEX_FORMAT_SINT32X3:
-      return 12;
-
-    case WGPU_VERTEX_FORMAT_FLOAT32X4:
-    case WGPU_VERTEX_FORMAT_UINT32X4:
-    case WGPU_VERTEX_FORMAT_SINT32X4:
-      return 16;
-
-    default:
-      return 0;
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_BYTE_SIZE)
+    default: return 0;
   }
 }
 
 WGPU_BOOL wgpu_vertex_format_is_unorm(WGPU_VERTEX_FORMAT format)
 {
-  return format == WGPU_VERTEX_FORMAT_UNORM10_10_10_2
-      || format == WGPU_VERTEX_FORMAT_UNORM8X4_BGRA
-      || format == WGPU_VERTEX_FORMAT_UNORM16
-      || format == WGPU_VERTEX_FORMAT_UNORM16X2
-      || format == WGPU_VERTEX_FORMAT_UNORM16X4
-      || format == WGPU_VERTEX_FORMAT_UNORM8
-      || format == WGPU_VERTEX_FORMAT_UNORM8X2
-      || format == WGPU_VERTEX_FORMAT_UNORM8X4;
+  switch(format)
+  {
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_IS_UNORM)
+    default: return WGPU_FALSE;
+  }
 }
 
+#undef _WGPU_VERTEX_FORMAT_CHANNEL_COUNT
+#undef _WGPU_VERTEX_FORMAT_BYTE_SIZE
+#undef _WGPU_VERTEX_FORMAT_IS_UNORM
+
 const char *wgpu_vertex_format_to_string(WGPU_VERTEX_FORMAT format)
 {
   switch(format)
@@ -257,6 +166,1208 @@ WGPU_WGSL_ELEMENT_TYPE wgpu_vertex_format_wgsl_element_type(WGPU_VERTEX_FORMAT f
   }
 }
 
+// Texture format metadata, indexed by WGPU_TEXTURE_FORMAT.
+#define _C(bytes, components, sampleType, flags, srgbPair) { 1, 1, bytes, components, WGPU_TEXTURE_COMPRESSION_NONE, (flags) | ((sampleType) == WGPU_TEXTURE_SAMPLE_TYPE_FLOAT ? WGPU_TEXTURE_FORMAT_FLAG_FILTERABLE : 0), srgbPair, sampleType }
+#define _DS(bytes, components, sampleType, flags) { 1, 1, bytes, components, WGPU_TEXTURE_COMPRESSION_NONE, flags, 0, sampleType }
+#define _B(w, h, bytes, components, compression, flags, srgbPair) { w, h, bytes, components, compression, (flags) | WGPU_TEXTURE_FORMAT_FLAG_FILTERABLE, srgbPair, WGPU_TEXTURE_SAMPLE_TYPE_FLOAT }
+#define _ASTC(w, h, format) _B(w, h, 16, 4, WGPU_TEXTURE_COMPRESSION_ASTC, 0, format##_SRGB), _B(w, h, 16, 4, WGPU_TEXTURE_COMPRESSION_ASTC, WGPU_TEXTURE_FORMAT_FLAG_SRGB, format)
+#define _FLOAT WGPU_TEXTURE_SAMPLE_TYPE_FLOAT
+#define _UNFILTERABLE WGPU_TEXTURE_SAMPLE_TYPE_UNFILTERABLE_FLOAT
+#define _UINT WGPU_TEXTURE_SAMPLE_TYPE_UINT
+#define _SINT WGPU_TEXTURE_SAMPLE_TYPE_SINT
+#define _DEPTH WGPU_TEXTURE_SAMPLE_TYPE_DEPTH
+#define _SRGB WGPU_TEXTURE_FORMAT_FLAG_SRGB
+#define _BC WGPU_TEXTURE_COMPRESSION_BC
+#define _ETC2 WGPU_TEXTURE_COMPRESSION_ETC2
+static const WGpuTextureFormatInfo _wgpu_texture_format_infos[] = {
+  // INVALID: a 1x1 block of zero bytes, so that the size helpers return 0 for it without dividing by zero.
+  { 1, 1, 0, 0, WGPU_TEXTURE_COMPRESSION_NONE, 0, 0, 0 },
+
+  // 8-bit formats
+  _C(1, 1, _FLOAT, 0, 0),        // R8UNORM
+  _C(1, 1, _FLOAT, 0, 0),        // R8SNORM
+  _C(1, 1, _UINT, 0, 0),         // R8UINT
+  _C(1, 1, _SINT, 0, 0),         // R8SINT
+
+  // 16-bit formats
+  _C(2, 1, _FLOAT, 0, 0),        // R16UNORM
+  _C(2, 1, _FLOAT, 0, 0),        // R16SNORM
+  _C(2, 1, _UINT, 0, 0),         // R16UINT
+  _C(2, 1, _SINT, 0, 0),         // R16SINT
+  _C(2, 1, _FLOAT, 0, 0),        // R16FLOAT
+  _C(2, 2, _FLOAT, 0, 0),        // RG8UNORM
+  _C(2, 2, _FLOAT, 0, 0),        // RG8SNORM
+  _C(2, 2, _UINT, 0, 0),         // RG8UINT
+  _C(2, 2, _SINT, 0, 0),         // RG8SINT
+
+  // 32-bit formats
+  _C(4, 1, _UINT, 0, 0),         // R32UINT
+  _C(4, 1, _SINT, 0, 0),         // R32SINT
+  _C(4, 1, _UNFILTERABLE, 0, 0), // R32FLOAT (filterable with "float32-filterable")
+  _C(4, 2, _FLOAT, 0, 0),        // RG16UNORM
+  _C(4, 2, _FLOAT, 0, 0),        // RG16SNORM
+  _C(4, 2, _UINT, 0, 0),         // RG16UINT
+  _C(4, 2, _SINT, 0, 0),         // RG16SINT
+  _C(4, 2, _FLOAT, 0, 0),        // RG16FLOAT
+  _C(4, 4, _FLOAT, 0, WGPU_TEXTURE_FORMAT_RGBA8UNORM_SRGB), // RGBA8UNORM
+  _C(4, 4, _FLOAT, _SRGB, WGPU_TEXTURE_FORMAT_RGBA8UNORM),   // RGBA8UNORM_SRGB
+  _C(4, 4, _FLOAT, 0, 0),        // RGBA8SNORM
+  _C(4, 4, _UINT, 0, 0),         // RGBA8UINT
+  _C(4, 4, _SINT, 0, 0),         // RGBA8SINT
+  _C(4, 4, _FLOAT, 0, WGPU_TEXTURE_FORMAT_BGRA8UNORM_SRGB), // BGRA8UNORM
+  _C(4, 4, _FLOAT, _SRGB, WGPU_TEXTURE_FORMAT_BGRA8UNORM),   // BGRA8UNORM_SRGB
+
+  // Packed 32-bit formats
+  _C(4, 3, _FLOAT, 0, 0),        // RGB9E5UFLOAT
+  _C(4, 4, _UINT, 0, 0),         // RGB10A2UINT
+  _C(4, 4, _FLOAT, 0, 0),        // RGB10A2UNORM
+  _C(4, 3, _FLOAT, 0, 0),        // RG11B10UFLOAT
+
+  // 64-bit formats
+  _C(8, 2, _UINT, 0, 0),         // RG32UINT
+  _C(8, 2, _SINT, 0, 0),         // RG32SINT
+  _C(8, 2, _UNFILTERABLE, 0, 0), // RG32FLOAT (filterable with "float32-filterable")
+  _C(8, 4, _FLOAT, 0, 0),        // RGBA16UNORM
+  _C(8, 4, _FLOAT, 0, 0),        // RGBA16SNORM
+  _C(8, 4, _UINT, 0, 0),         // RGBA16UINT
+  _C(8, 4, _SINT, 0, 0),         // RGBA16SINT
+  _C(8, 4, _FLOAT, 0, 0),        // RGBA16FLOAT
+
+  // 128-bit formats
+  _C(16, 4, _UINT, 0, 0),        // RGBA32UINT
+  _C(16, 4, _SINT, 0, 0),        // RGBA32SINT
+  _C(16, 4, _UNFILTERABLE, 0, 0),// RGBA32FLOAT (filterable with "float32-filterable")
+
+  // Depth/stencil formats
+  _DS(1, 1, _UINT, WGPU_TEXTURE_FORMAT_FLAG_STENCIL),                                   // STENCIL8
+  _DS(2, 1, _DEPTH, WGPU_TEXTURE_FORMAT_FLAG_DEPTH),                                    // DEPTH16UNORM
+  _DS(0, 1, _DEPTH, WGPU_TEXTURE_FORMAT_FLAG_DEPTH),                                    // DEPTH24PLUS
+  _DS(0, 2, _DEPTH, WGPU_TEXTURE_FORMAT_FLAG_DEPTH | WGPU_TEXTURE_FORMAT_FLAG_STENCIL), // DEPTH24PLUS_STENCIL8
+  _DS(4, 1, _DEPTH, WGPU_TEXTURE_FORMAT_FLAG_DEPTH),                                    // DEPTH32FLOAT
+  _DS(4, 2, _DEPTH, WGPU_TEXTURE_FORMAT_FLAG_DEPTH | WGPU_TEXTURE_FORMAT_FLAG_STENCIL), // DEPTH32FLOAT_STENCIL8
+
+  // _BC compressed formats
+  _B(4, 4, 8, 4, _BC, 0, WGPU_TEXTURE_FORMAT_BC1_RGBA_UNORM_SRGB),     // BC1_RGBA_UNORM
+  _B(4, 4, 8, 4, _BC, _SRGB, WGPU_TEXTURE_FORMAT_BC1_RGBA_UNORM),       // BC1_RGBA_UNORM_SRGB
+  _B(4, 4, 16, 4, _BC, 0, WGPU_TEXTURE_FORMAT_BC2_RGBA_UNORM_SRGB),    // BC2_RGBA_UNORM
+  _B(4, 4, 16, 4, _BC, _SRGB, WGPU_TEXTURE_FORMAT_BC2_RGBA_UNORM),      // BC2_RGBA_UNORM_SRGB
+  _B(4, 4, 16, 4, _BC, 0, WGPU_TEXTURE_FORMAT_BC3_RGBA_UNORM_SRGB),    // BC3_RGBA_UNORM
+  _B(4, 4, 16, 4, _BC, _SRGB, WGPU_TEXTURE_FORMAT_BC3_RGBA_UNORM),      // BC3_RGBA_UNORM_SRGB
+  _B(4, 4, 8, 1, _BC, 0, 0),                                           // BC4_R_UNORM
+  _B(4, 4, 8, 1, _BC, 0, 0),                                           // BC4_R_SNORM
+  _B(4, 4, 16, 2, _BC, 0, 0),                                          // BC5_RG_UNORM
+  _B(4, 4, 16, 2, _BC, 0, 0),                                          // BC5_RG_SNORM
+  _B(4, 4, 16, 3, _BC, 0, 0),                                          // BC6H_RGB_UFLOAT
+  _B(4, 4, 16, 3, _BC, 0, 0),                                          // BC6H_RGB_FLOAT
+  _B(4, 4, 16, 4, _BC, 0, WGPU_TEXTURE_FORMAT_BC7_RGBA_UNORM_SRGB),    // BC7_RGBA_UNORM
+  _B(4, 4, 16, 4, _BC, _SRGB, WGPU_TEXTURE_FORMAT_BC7_RGBA_UNORM),      // BC7_RGBA_UNORM_SRGB
+
+  // _ETC2 compressed formats
+  _B(4, 4, 8, 3, _ETC2, 0, WGPU_TEXTURE_FORMAT_ETC2_RGB8UNORM_SRGB),   // ETC2_RGB8UNORM
+  _B(4, 4, 8, 3, _ETC2, _SRGB, WGPU_TEXTURE_FORMAT_ETC2_RGB8UNORM),     // ETC2_RGB8UNORM_SRGB
+  _B(4, 4, 8, 4, _ETC2, 0, WGPU_TEXTURE_FORMAT_ETC2_RGB8A1UNORM_SRGB), // ETC2_RGB8A1UNORM
+  _B(4, 4, 8, 4, _ETC2, _SRGB, WGPU_TEXTURE_FORMAT_ETC2_RGB8A1UNORM),   // ETC2_RGB8A1UNORM_SRGB
+  _B(4, 4, 16, 4, _ETC2, 0, WGPU_TEXTURE_FORMAT_ETC2_RGBA8UNORM_SRGB), // ETC2_RGBA8UNORM
+  _B(4, 4, 16, 4, _ETC2, _SRGB, WGPU_TEXTURE_FORMAT_ETC2_RGBA8UNORM),   // ETC2_RGBA8UNORM_SRGB
+  _B(4, 4, 8, 1, _ETC2, 0, 0),                                         // EAC_R11UNORM
+  _B(4, 4, 8, 1, _ETC2, 0, 0),                                         // EAC_R11SNORM
+  _B(4, 4, 16, 2, _ETC2, 0, 0),                                        // EAC_RG11UNORM
+  _B(4, 4, 16, 2, _ETC2, 0, 0),                                        // EAC_RG11SNORM
+
+  // ASTC compressed formats, each followed by its _SRGB variant
+  _ASTC(4, 4, WGPU_TEXTURE_FORMAT_ASTC_4X4_UNORM),
+  _ASTC(5, 4, WGPU_TEXTURE_FORMAT_ASTC_5X4_UNORM),
+  _ASTC(5, 5, WGPU_TEXTURE_FORMAT_ASTC_5X5_UNORM),
+  _ASTC(6, 5, WGPU_TEXTURE_FORMAT_ASTC_6X5_UNORM),
+  _ASTC(6, 6, WGPU_TEXTURE_FORMAT_ASTC_6X6_UNORM),
+  _ASTC(8, 5, WGPU_TEXTURE_FORMAT_ASTC_8X5_UNORM),
+  _ASTC(8, 6, WGPU_TEXTURE_FORMAT_ASTC_8X6_UNORM),
+  _ASTC(8, 8, WGPU_TEXTURE_FORMAT_ASTC_8X8_UNORM),
+  _ASTC(10, 5, WGPU_TEXTURE_FORMAT_ASTC_10X5_UNORM),
+  _ASTC(10, 6, WGPU_TEXTURE_FORMAT_ASTC_10X6_UNORM),
+  _ASTC(10, 8, WGPU_TEXTURE_FORMAT_ASTC_10X8_UNORM),
+  _ASTC(10, 10, WGPU_TEXTURE_FORMAT_ASTC_10X10_UNORM),
+  _ASTC(12, 10, WGPU_TEXTURE_FORMAT_ASTC_12X10_UNORM),
+  _ASTC(12, 12, WGPU_TEXTURE_FORMAT_ASTC_12X12_UNORM),
+};
+#undef _C
+#undef _DS
+#undef _B
+#undef _ASTC
+#undef _FLOAT
+#undef _UNFILTERABLE
+#undef _UINT
+#undef _SINT
+#undef _DEPTH
+#undef _SRGB
+#undef _BC
+#undef _ETC2
+static_assert(sizeof(_wgpu_texture_format_infos) / sizeof(_wgpu_texture_format_infos[0]) == WGPU_TEXTURE_FORMAT_LAST_VALUE + 1, "_wgpu_texture_format_infos must have an entry for each WGPU_TEXTURE_FORMAT!");
+
+const WGpuTextureFormatInfo *wgpu_texture_format_info(WGPU_TEXTURE_FORMAT format)
+{
+  // Map out of range formats to index 0 (WGPU_TEXTURE_FORMAT_INVALID) with a mask instead of a branch.
+  uint32_t index = (uint32_t)format;
+  index &= 0u - (uint32_t)(index <= WGPU_TEXTURE_FORMAT_LAST_VALUE);
+  return &_wgpu_texture_format_infos[index];
+}
+
+uint32_t wgpu_texture_format_bytes_per_row(WGPU_TEXTURE_FORMAT format, uint32_t width)
+{
+  const WGpuTextureFormatInfo *info = wgpu_texture_format_info(format);
+  return (width + info->blockWidth - 1) / info->blockWidth * info->bytesPerBlock;
+}
+
+uint32_t wgpu_texture_format_aligned_bytes_per_row(WGPU_TEXTURE_FORMAT format, uint32_t width)
+{
+  return (wgpu_texture_format_bytes_per_row(format, width) + WGPU_COPY_BYTES_PER_ROW_ALIGNMENT - 1) & ~(uint32_t)(WGPU_COPY_BYTES_PER_ROW_ALIGNMENT - 1);
+}
+
+uint32_t wgpu_texture_format_rows_per_image(WGPU_TEXTURE_FORMAT format, uint32_t height)
+{
+  const WGpuTextureFormatInfo *info = wgpu_texture_format_info(format);
+  return (height + info->blockHeight - 1) / info->blockHeight;
+}
+
+uint64_t wgpu_texture_format_image_size(WGPU_TEXTURE_FORMAT format, uint32_t width, uint32_t height, uint32_t depthOrArrayLayers, uint32_t bytesPerRow)
+{
+  if (!bytesPerRow)
+    bytesPerRow = wgpu_texture_format_bytes_per_row(format, width);
+  return (uint64_t)bytesPerRow * wgpu_texture_format_rows_per_image(format, height) * depthOrArrayLayers;
+}
+
+uint64_t wgpu_texture_format_mip_chain_size(WGPU_TEXTURE_FORMAT format, WGPU_TEXTURE_DIMENSION dimension, uint32_t width, uint32_t height, uint32_t depthOrArrayLayers,
+  uint32_t mipLevelCount, WGPU_BOOL alignRows)
+{
+  uint64_t size = 0;
+  for(uint32_t level = 0; level < mipLevelCount && level < 32; ++level)
+  {
+    uint32_t w = width >> level > 1 ? width >> level : 1;
+    uint32_t h = height >> level > 1 ? height >> level : 1;
+    uint32_t d = (dimension == WGPU_TEXTURE_DIMENSION_3D && depthOrArrayLayers >> level > 1) ? depthOrArrayLayers >> level
+               : (dimension == WGPU_TEXTURE_DIMENSION_3D ? 1 : depthOrArrayLayers);
+    size += wgpu_texture_format_image_size(format, w, h, d, alignRows ? wgpu_texture_format_aligned_bytes_per_row(format, w) : 0);
+  }
+  return size;
+}
+
+// Pipeline cache. Pipelines are keyed on a byte string that serializes the device and the full contents of the descriptor,
+// so that two descriptors produce the same key only if they describe identical pipelines. Object IDs are reused after their
+// objects are destroyed, so objects are identified by their serial numbers, both in the keys and in the cached entries.
+struct _WGpuPipelineCacheEntry
+{
+  WGpuObjectBase pipeline;
+  uint32_t serial;
+};
+static WGpuPipelineCacheStats _wgpu_pipeline_cache_stats;
+
+// The cache is constructed on first use, so that programs that do not use it do not pull in the container code.
+static std::unordered_map<std::string, _WGpuPipelineCacheEntry> &_wgpu_pipeline_cache()
+{
+  static std::unordered_map<std::string, _WGpuPipelineCacheEntry> cache;
+  return cache;
+}
+
+static void _wgpu_key_append(std::string &key, const void *data, size_t size)
+{
+  key.append((const char *)data, size);
+}
+
+static void _wgpu_key_append_u32(std::string &key, uint32_t value)
+{
+  _wgpu_key_append(key, &value, sizeof(value));
+}
+
+// Adding zero turns -0.0f into 0.0f, so that the two produce the same key.
+static void _wgpu_key_append_float(std::string &key, float value)
+{
+  value += 0.0f;
+  _wgpu_key_append(key, &value, sizeof(value));
+}
+
+static void _wgpu_key_append_stencil_face(std::string &key, const WGpuStencilFaceState &face)
+{
+  _wgpu_key_append_u32(key, face.compare);
+  _wgpu_key_append_u32(key, face.failOp);
+  _wgpu_key_append_u32(key, face.depthFailOp);
+  _wgpu_key_append_u32(key, face.passOp);
+}
+
+static void _wgpu_key_append_blend_component(std::string &key, const WGpuBlendComponent &component)
+{
+  _wgpu_key_append_u32(key, component.operation);
+  _wgpu_key_append_u32(key, component.srcFactor);
+  _wgpu_key_append_u32(key, component.dstFactor);
+}
+
+// Pipeline layouts can also be the special values WGPU_AUTO_LAYOUT_MODE_NO_HINT and WGPU_AUTO_LAYOUT_MODE_AUTO, which are not objects.
+static void _wgpu_key_append_object(std::string &key, WGpuObjectBase object)
+{
+  bool isObject = (uintptr_t)object > WGPU_AUTO_LAYOUT_MODE_AUTO;
+  key.push_back(isObject);
+  _wgpu_key_append_u32(key, isObject ? wgpu_object_get_serial(object) : (uint32_t)(uintptr_t)object);
+}
+
+// A null string and an empty string both mean the default entry point, so these produce the same key.
+static void _wgpu_key_append_string(std::string &key, const char *str)
+{
+  if (str)
+    key.append(str);
+  key.push_back('\0');
+}
+
+static void _wgpu_key_append_constants(std::string &key, const WGpuPipelineConstant *constants, int numConstants)
+{
+  _wgpu_key_append_u32(key, numConstants);
+  for(int i = 0; i < numConstants; ++i)
+  {
+    _wgpu_key_append_string(key, constants[i].name);
+    _wgpu_key_append(key, &constants[i].value, sizeof(constants[i].value));
+  }
+}
+
+// Looks up the given key from the pipeline cache. Returns the cached pipeline, or 0 if the key does not exist, or if the cached
+// pipeline has been destroyed in the meanwhile (e.g. because its device was destroyed), even if its ID has since been reused.
+static WGpuObjectBase _wgpu_pipeline_cache_find(const std::string &key)
+{
+  auto &cache = _wgpu_pipeline_cache();
+  auto entry = cache.find(key);
+  if (entry != cache.end())
+  {
+    if (wgpu_object_get_serial(entry->second.pipeline) == entry->second.serial)
+    {
+      ++_wgpu_pipeline_cache_stats.numHits;
+      return entry->second.pipeline;
+    }
+    cache.erase(entry);
+  }
+  ++_wgpu_pipeline_cache_stats.numMisses;
+  return 0;
+}
+
+static void _wgpu_pipeline_cache_insert(const std::string &key, WGpuObjectBase pipeline)
+{
+  if (pipeline)
+    _wgpu_pipeline_cache()[key] = { pipeline, wgpu_object_get_serial(pipeline) };
+}
+
+WGpuRenderPipeline wgpu_device_create_render_pipeline_cached(WGpuDevice device, const WGpuRenderPipelineDescriptor *renderPipelineDesc)
+{
+  assert(renderPipelineDesc);
+  const WGpuRenderPipelineDescriptor &desc = *renderPipelineDesc;
+
+  std::string key;
+  key.push_back('R');
+  _wgpu_key_append_object(key, device);
+  _wgpu_key_append_object(key, desc.layout);
+  _wgpu_key_append_u32(key, !!desc.retainDescriptor);
+
+  _wgpu_key_append_object(key, desc.vertex.module);
+  _wgpu_key_append_string(key, desc.vertex.entryPoint);
+  _wgpu_key_append_u32(key, desc.vertex.numBuffers);
+  for(int i = 0; i < desc.vertex.numBuffers; ++i)
+  {
+    const WGpuVertexBufferLayout &buffer = desc.vertex.buffers[i];
+    _wgpu_key_append(key, &buffer.arrayStride, sizeof(buffer.arrayStride));
+    _wgpu_key_append_u32(key, buffer.stepMode);
+    _wgpu_key_append_u32(key, buffer.numAttributes);
+    for(int j = 0; j < buffer.numAttributes; ++j)
+    {
+      _wgpu_key_append(key, &buffer.attributes[j].offset, sizeof(buffer.attributes[j].offset));
+      _wgpu_key_append_u32(key, buffer.attributes[j].shaderLocation);
+      _wgpu_key_append_u32(key, buffer.attributes[j].format);
+    }
+  }
+  _wgpu_key_append_constants(key, desc.vertex.constants, desc.vertex.numConstants);
+
+  // Booleans are normalized to 0 or 1, since any nonzero value means true.
+  const WGpuPrimitiveState &primitive = desc.primitive;
+  _wgpu_key_append_u32(key, primitive.topology);
+  _wgpu_key_append_u32(key, primitive.stripIndexFormat);
+  _wgpu_key_append_u32(key, primitive.frontFace);
+  _wgpu_key_append_u32(key, primitive.cullMode);
+  _wgpu_key_append_u32(key, !!primitive.unclippedDepth);
+
+  _wgpu_key_append_u32(key, desc.multisample.count);
+  _wgpu_key_append_u32(key, desc.multisample.mask);
+  _wgpu_key_append_u32(key, !!desc.multisample.alphaToCoverageEnabled);
+
+  // The depth-stencil state is ignored if it has no format.
+  const WGpuDepthStencilState &ds = desc.depthStencil;
+  _wgpu_key_append_u32(key, ds.format);
+  if (ds.format)
+  {
+    _wgpu_key_append_u32(key, !!ds.depthWriteEnabled);
+    _wgpu_key_append_u32(key, ds.depthCompare);
+    _wgpu_key_append_stencil_face(key, ds.stencilFront);
+    _wgpu_key_append_stencil_face(key, ds.stencilBack);
+    _wgpu_key_append_u32(key, ds.stencilReadMask);
+    _wgpu_key_append_u32(key, ds.stencilWriteMask);
+    _wgpu_key_append_u32(key, (uint32_t)ds.depthBias);
+    _wgpu_key_append_float(key, ds.depthBiasSlopeScale);
+    _wgpu_key_append_float(key, ds.depthBiasClamp);
+    _wgpu_key_append_u32(key, !!ds.clampDepth);
+  }
+
+  _wgpu_key_append_object(key, desc.fragment.module);
+  if (desc.fragment.module)
+  {
+    _wgpu_key_append_string(key, desc.fragment.entryPoint);
+    _wgpu_key_append_u32(key, desc.fragment.numTargets);
+    for(int i = 0; i < desc.fragment.numTargets; ++i)
+    {
+      // The blend factors are ignored when blending is disabled.
+      const WGpuColorTargetState &target = desc.fragment.targets[i];
+      _wgpu_key_append_u32(key, target.format);
+      _wgpu_key_append_u32(key, target.writeMask);
+      _wgpu_key_append_u32(key, target.blend.color.operation);
+      if (target.blend.color.operation != WGPU_BLEND_OPERATION_DISABLED)
+      {
+        _wgpu_key_append_blend_component(key, target.blend.color);
+        _wgpu_key_append_blend_component(key, target.blend.alpha);
+      }
+    }
+    _wgpu_key_append_constants(key, desc.fragment.constants, desc.fragment.numConstants);
+  }
+
+  WGpuRenderPipeline pipeline = _wgpu_pipeline_cache_find(key);
+  if (!pipeline)
+  {
+    pipeline = wgpu_device_create_render_pipeline(device, renderPipelineDesc);
+    _wgpu_pipeline_cache_insert(key, pipeline);
+  }
+  return pipeline;
+}
+
+WGpuComputePipeline wgpu_device_create_compute_pipeline_cached(WGpuDevice device, WGpuShaderModule computeModule, const char *entryPoint, WGpuPipelineLayout layout, const WGpuPipelineConstant *constants, int numConstants)
+{
+  std::string key;
+  key.push_back('C');
+  _wgpu_key_append_object(key, device);
+  _wgpu_key_append_object(key, layout);
+  _wgpu_key_append_object(key, computeModule);
+  _wgpu_key_append_string(key, entryPoint);
+  _wgpu_key_append_constants(key, constants, numConstants);
+
+  WGpuComputePipeline pipeline = _wgpu_pipeline_cache_find(key);
+  if (!pipeline)
+  {
+    pipeline = wgpu_device_create_compute_pipeline(device, computeModule, entryPoint, layout, constants, numConstants);
+    _wgpu_pipeline_cache_insert(key, pipeline);
+  }
+  return pipeline;
+}
+
+void wgpu_pipeline_cache_clear()
+{
+  // Pipelines that were destroyed in the meanwhile may have had their IDs reused by other objects, which must not be destroyed.
+  auto &cache = _wgpu_pipeline_cache();
+  for(auto &entry : cache)
+    if (wgpu_object_get_serial(entry.second.pipeline) == entry.second.serial)
+      wgpu_object_destroy(entry.second.pipeline);
+  cache.clear();
+}
+
+void wgpu_get_pipeline_cache_stats(WGpuPipelineCacheStats *stats)
+{
+  assert(stats);
+  *stats = _wgpu_pipeline_cache_stats;
+  stats->numPipelines = (uint32_t)_wgpu_pipeline_cache().size();
+}
+
+// Descriptor blobs. The writer tracks the size of the blob also when it does not fit in the destination, so that the same
+// code both measures and writes the blob.
+struct _WGpuBlobWriter
+{
+  uint8_t *dst;
+  uint32_t dstSize;
+  uint32_t size;
+  const WGpuObjectBase *objects;
+  int numObjects;
+  bool ok;
+
+  void write(const void *data, uint32_t bytes)
+  {
+    if (dst && size + bytes <= dstSize)
+      memcpy(dst + size, data, bytes);
+    size += bytes;
+  }
+  void u32(uint32_t value) { write(&value, sizeof(value)); }
+  void u64(uint64_t value) { write(&value, sizeof(value)); }
+  void f64(double value) { write(&value, sizeof(value)); }
+
+  // Objects are stored as their index in the objects array plus two, since handles 0 and 1 are stored as is.
+  void object(WGpuObjectBase object)
+  {
+    uintptr_t handle = (uintptr_t)object;
+    if (handle > 1)
+    {
+      int i = 0;
+      while(i < numObjects && objects[i] != object)
+        ++i;
+      ok = ok && i < numObjects;
+      handle = (uintptr_t)i + 2;
+    }
+    u32((uint32_t)handle);
+  }
+
+  // Strings are stored as their length in bytes (or 0xFFFFFFFF for a null string), followed by the null-terminated
+  // string padded up to a multiple of four bytes, so that the reader can use them in place.
+  void string(const char *str)
+  {
+    if (!str)
+    {
+      u32(0xFFFFFFFFu);
+      return;
+    }
+    uint32_t length = (uint32_t)strlen(str), zero = 0;
+    u32(length);
+    write(str, length);
+    write(&zero, 4 - (length & 3));
+  }
+
+  void constants(const WGpuPipelineConstant *constants, int numConstants)
+  {
+    u32(numConstants);
+    for(int i = 0; i < numConstants; ++i)
+    {
+      string(constants[i].name);
+      f64(constants[i].value);
+    }
+  }
+};
+
+// Reads a blob front to back. Any read past the end of the blob, or of an object index outside the objects array, marks the
+// blob as malformed, after which all reads return zeros.
+struct _WGpuBlobReader
+{
+  const uint8_t *pos;
+  const uint8_t *end;
+  const WGpuObjectBase *objects;
+  int numObjects;
+  bool ok;
+
+  void read(void *data, uint32_t bytes)
+  {
+    if (ok && (size_t)(end - pos) >= bytes)
+    {
+      memcpy(data, pos, bytes);
+      pos += bytes;
+    }
+    else
+    {
+      ok = false;
+      memset(data, 0, bytes);
+    }
+  }
+  uint32_t u32() { uint32_t value; read(&value, sizeof(value)); return value; }
+  uint64_t u64() { uint64_t value; read(&value, sizeof(value)); return value; }
+  double f64() { double value; read(&value, sizeof(value)); return value; }
+
+  // Reads an array length, and checks it against the number of bytes left, so that a malformed blob cannot cause a huge allocation.
+  int count(uint32_t minBytesPerItem)
+  {
+    uint32_t n = u32();
+    if (n > (size_t)(end - pos) / minBytesPerItem)
+    {
+      ok = false;
+      return 0;
+    }
+    return (int)n;
+  }
+
+  WGpuObjectBase object()
+  {
+    uint32_t handle = u32();
+    if (handle <= 1)
+      return (WGpuObjectBase)(uintptr_t)handle;
+    if (handle - 2 >= (uint32_t)numObjects)
+    {
+      ok = false;
+      return 0;
+    }
+    return objects[handle - 2];
+  }
+
+  const char *string()
+  {
+    uint32_t length = u32();
+    if (length == 0xFFFFFFFFu)
+      return 0;
+    uint32_t paddedLength = (length + 4) & ~3u;
+    if (!ok || (size_t)(end - pos) < paddedLength || pos[length] != 0)
+    {
+      ok = false;
+      return "";
+    }
+    const char *str = (const char *)pos;
+    pos += paddedLength;
+    return str;
+  }
+
+  void constants(std::vector<WGpuPipelineConstant> &constants)
+  {
+    constants.resize(count(12));
+    for(WGpuPipelineConstant &constant : constants)
+    {
+      constant.name = string();
+      constant.value = f64();
+    }
+  }
+};
+
+// Arrays that are read from blobs. These are reused between calls to avoid allocating memory for each created object, and
+// are constructed on first use, so that programs that do not read blobs do not pull in the container code.
+struct _WGpuBlobArrays
+{
+  std::vector<WGpuVertexBufferLayout> vertexBuffers;
+  std::vector<WGpuVertexAttribute> vertexAttributes;
+  std::vector<WGpuPipelineConstant> vertexConstants, fragmentConstants;
+  std::vector<WGpuColorTargetState> colorTargets;
+  std::vector<WGpuBindGroupLayoutEntry> bindGroupLayoutEntries;
+  std::vector<WGpuRenderPassColorAttachment> colorAttachments;
+};
+
+static _WGpuBlobArrays &_wgpu_blob_arrays()
+{
+  static _WGpuBlobArrays arrays;
+  return arrays;
+}
+
+static void _wgpu_blob_write_render_pipeline(_WGpuBlobWriter &w, const WGpuRenderPipelineDescriptor &desc)
+{
+  w.object(desc.vertex.module);
+  w.string(desc.vertex.entryPoint);
+  w.u32(desc.vertex.numBuffers);
+  for(int i = 0; i < desc.vertex.numBuffers; ++i)
+  {
+    const WGpuVertexBufferLayout &buffer = desc.vertex.buffers[i];
+    w.u64(buffer.arrayStride);
+    w.u32(buffer.stepMode);
+    w.u32(buffer.numAttributes);
+    for(int j = 0; j < buffer.numAttributes; ++j)
+    {
+      w.u64(buffer.attributes[j].offset);
+      w.u32(buffer.attributes[j].shaderLocation);
+      w.u32(buffer.attributes[j].format);
+    }
+  }
+  w.constants(desc.vertex.constants, desc.vertex.numConstants);
+
+  // The following structs consist of 32-bit fields only (see VERIFY_STRUCT_SIZE), so they have no padding and are stored as is.
+  w.write(&desc.primitive, sizeof(desc.primitive));
+  w.write(&desc.depthStencil, sizeof(desc.depthStencil));
+  w.write(&desc.multisample, sizeof(desc.multisample));
+
+  w.object(desc.fragment.module);
+  if (desc.fragment.module)
+  {
+    w.string(desc.fragment.entryPoint);
+    w.u32(desc.fragment.numTargets);
+    w.write(desc.fragment.targets, desc.fragment.numTargets * sizeof(WGpuColorTargetState));
+    w.constants(desc.fragment.constants, desc.fragment.numConstants);
+  }
+  w.object(desc.layout);
+  w.u32(desc.retainDescriptor);
+}
+
+static void _wgpu_blob_read_render_pipeline(_WGpuBlobReader &r, WGpuRenderPipelineDescriptor &desc)
+{
+  _WGpuBlobArrays &a = _wgpu_blob_arrays();
+  desc.vertex.module = r.object();
+  desc.vertex.entryPoint = r.string();
+  a.vertexBuffers.resize(r.count(16));
+  a.vertexAttributes.clear();
+  for(WGpuVertexBufferLayout &buffer : a.vertexBuffers)
+  {
+    buffer.arrayStride = r.u64();
+    buffer.stepMode = r.u32();
+    buffer.numAttributes = r.count(16);
+    for(int j = 0; j < buffer.numAttributes; ++j)
+    {
+      WGpuVertexAttribute attribute;
+      attribute.offset = r.u64();
+      attribute.shaderLocation = r.u32();
+      attribute.format = r.u32();
+      a.vertexAttributes.push_back(attribute);
+    }
+  }
+  // Point the buffers to their attributes only after all attributes have been read, since reading reallocates the array.
+  size_t attributeIndex = 0;
+  for(WGpuVertexBufferLayout &buffer : a.vertexBuffers)
+  {
+    buffer.attributes = a.vertexAttributes.data() + attributeIndex;
+    attributeIndex += buffer.numAttributes;
+  }
+  desc.vertex.buffers = a.vertexBuffers.data();
+  desc.vertex.numBuffers = (int)a.vertexBuffers.size();
+  r.constants(a.vertexConstants);
+  desc.vertex.constants = a.vertexConstants.data();
+  desc.vertex.numConstants = (int)a.vertexConstants.size();
+
+  r.read(&desc.primitive, sizeof(desc.primitive));
+  r.read(&desc.depthStencil, sizeof(desc.depthStencil));
+  r.read(&desc.multisample, sizeof(desc.multisample));
+
+  desc.fragment.module = r.object();
+  if (desc.fragment.module)
+  {
+    desc.fragment.entryPoint = r.string();
+    a.colorTargets.resize(r.count(sizeof(WGpuColorTargetState)));
+    r.read(a.colorTargets.data(), a.colorTargets.size() * sizeof(WGpuColorTargetState));
+    desc.fragment.targets = a.colorTargets.data();
+    desc.fragment.numTargets = (int)a.colorTargets.size();
+    r.constants(a.fragmentConstants);
+    desc.fragment.constants = a.fragmentConstants.data();
+    desc.fragment.numConstants = (int)a.fragmentConstants.size();
+  }
+  desc.layout = r.object();
+  desc.retainDescriptor = r.u32();
+}
+
+static void _wgpu_blob_write_render_pass(_WGpuBlobWriter &w, const WGpuRenderPassDescriptor &desc)
+{
+  w.f64(desc.maxDrawCount);
+  w.u32(desc.numColorAttachments);
+  for(int i = 0; i < desc.numColorAttachments; ++i)
+  {
+    const WGpuRenderPassColorAttachment &ca = desc.colorAttachments[i];
+    w.object(ca.view);
+    w.u32(ca.depthSlice);
+    w.object(ca.resolveTarget);
+    w.u32(ca.storeOp);
+    w.u32(ca.loadOp);
+    w.write(&ca.clearValue, sizeof(ca.clearValue));
+  }
+  const WGpuRenderPassDepthStencilAttachment &ds = desc.depthStencilAttachment;
+  w.object(ds.view);
+  // The fields after the view are all 32-bit.
+  w.write(&ds.depthLoadOp, sizeof(ds) - offsetof(WGpuRenderPassDepthStencilAttachment, depthLoadOp));
+  w.object(desc.occlusionQuerySet);
+  w.object(desc.timestampWrites.querySet);
+  w.u32(desc.timestampWrites.beginningOfPassWriteIndex);
+  w.u32(desc.timestampWrites.endOfPassWriteIndex);
+}
+
+static void _wgpu_blob_read_render_pass(_WGpuBlobReader &r, WGpuRenderPassDescriptor &desc)
+{
+  _WGpuBlobArrays &a = _wgpu_blob_arrays();
+  desc.maxDrawCount = r.f64();
+  a.colorAttachments.resize(r.count(4*sizeof(uint32_t) + sizeof(WGpuColor)));
+  for(WGpuRenderPassColorAttachment &ca : a.colorAttachments)
+  {
+    ca.view = r.object();
+    ca.depthSlice = r.u32();
+    ca.resolveTarget = r.object();
+    ca.storeOp = r.u32();
+    ca.loadOp = r.u32();
+    r.read(&ca.clearValue, sizeof(ca.clearValue));
+  }
+  desc.colorAttachments = a.colorAttachments.data();
+  desc.numColorAttachments = (int)a.colorAttachments.size();
+  WGpuRenderPassDepthStencilAttachment &ds = desc.depthStencilAttachment;
+  ds.view = r.object();
+  r.read(&ds.depthLoadOp, sizeof(ds) - offsetof(WGpuRenderPassDepthStencilAttachment, depthLoadOp));
+  desc.occlusionQuerySet = r.object();
+  desc.timestampWrites.querySet = r.object();
+  desc.timestampWrites.beginningOfPassWriteIndex = r.u32();
+  desc.timestampWrites.endOfPassWriteIndex = r.u32();
+}
+
+uint32_t wgpu_descriptor_blob_serialize(WGPU_DESCRIPTOR_BLOB_TYPE type, const void *descriptor, int numEntries, const WGpuObjectBase *objects, int numObjects, void *dst, uint32_t dstSize)
+{
+  assert(descriptor);
+  assert(numEntries >= 0);
+  assert(numObjects == 0 || objects);
+  assert(((uintptr_t)dst & 3) == 0);
+
+  _WGpuBlobWriter w = { (uint8_t *)dst, dstSize, 0, objects, numObjects, true };
+  WGpuDescriptorBlobHeader header = { WGPU_DESCRIPTOR_BLOB_MAGIC, WGPU_DESCRIPTOR_BLOB_VERSION, type, 0 };
+  w.write(&header, sizeof(header));
+
+  switch(type)
+  {
+  case WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PIPELINE:
+    assert(numEntries == 1);
+    _wgpu_blob_write_render_pipeline(w, *(const WGpuRenderPipelineDescriptor *)descriptor);
+    break;
+  case WGPU_DESCRIPTOR_BLOB_TYPE_BIND_GROUP_LAYOUT:
+    // WGpuBindGroupLayoutEntry holds no pointers or objects, so it is stored as is.
+    w.u32(numEntries);
+    w.write(descriptor, numEntries * sizeof(WGpuBindGroupLayoutEntry));
+    break;
+  case WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PASS:
+    assert(numEntries == 1);
+    _wgpu_blob_write_render_pass(w, *(const WGpuRenderPassDescriptor *)descriptor);
+    break;
+  default:
+    assert(false && "Unknown descriptor blob type!");
+    return 0;
+  }
+
+  assert(w.ok && "Descriptor references an object that is not present in the objects array!");
+  if (!w.ok)
+    return 0;
+  if (dst && w.size <= dstSize)
+    memcpy((uint8_t *)dst + offsetof(WGpuDescriptorBlobHeader, size), &w.size, sizeof(w.size));
+  return w.size;
+}
+
+// Validates the header of the given blob against the blobSize bytes available at it, and sets up a reader for its contents.
+static bool _wgpu_blob_begin_read(_WGpuBlobReader &r, const void *blob, uint32_t blobSize, WGPU_DESCRIPTOR_BLOB_TYPE type, const WGpuObjectBase *objects, int numObjects)
+{
+  assert(blob);
+  assert(((uintptr_t)blob & 3) == 0);
+  assert(numObjects == 0 || objects);
+
+  if (blobSize < sizeof(WGpuDescriptorBlobHeader))
+    return false;
+  WGpuDescriptorBlobHeader header;
+  memcpy(&header, blob, sizeof(header));
+  if (header.magic != WGPU_DESCRIPTOR_BLOB_MAGIC || header.version != WGPU_DESCRIPTOR_BLOB_VERSION || header.type != type
+    || header.size < sizeof(header) || header.size > blobSize)
+    return false;
+
+  r = { (const uint8_t *)blob + sizeof(header), (const uint8_t *)blob + header.size, objects, numObjects, true };
+  return true;
+}
+
+// A blob is well-formed if it was read without errors, and to its very end.
+static bool _wgpu_blob_end_read(const _WGpuBlobReader &r)
+{
+  return r.ok && r.pos == r.end;
+}
+
+WGpuRenderPipeline wgpu_device_create_render_pipeline_from_blob(WGpuDevice device, const void *blob, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects)
+{
+  _WGpuBlobReader r;
+  if (!_wgpu_blob_begin_read(r, blob, blobSize, WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PIPELINE, objects, numObjects))
+    return 0;
+  WGpuRenderPipelineDescriptor desc = {};
+  _wgpu_blob_read_render_pipeline(r, desc);
+  return _wgpu_blob_end_read(r) ? wgpu_device_create_render_pipeline(device, &desc) : 0;
+}
+
+WGpuBindGroupLayout wgpu_device_create_bind_group_layout_from_blob(WGpuDevice device, const void *blob, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects)
+{
+  _WGpuBlobReader r;
+  if (!_wgpu_blob_begin_read(r, blob, blobSize, WGPU_DESCRIPTOR_BLOB_TYPE_BIND_GROUP_LAYOUT, objects, numObjects))
+    return 0;
+  _WGpuBlobArrays &a = _wgpu_blob_arrays();
+  a.bindGroupLayoutEntries.resize(r.count(sizeof(WGpuBindGroupLayoutEntry)));
+  r.read(a.bindGroupLayoutEntries.data(), a.bindGroupLayoutEntries.size() * sizeof(WGpuBindGroupLayoutEntry));
+  return _wgpu_blob_end_read(r) ? wgpu_device_create_bind_group_layout(device, a.bindGroupLayoutEntries.data(), (int)a.bindGroupLayoutEntries.size()) : 0;
+}
+
+WGpuRenderPassTemplate wgpu_render_pass_template_create_from_blob(const void *blob, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects)
+{
+  _WGpuBlobReader r;
+  if (!_wgpu_blob_begin_read(r, blob, blobSize, WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PASS, objects, numObjects))
+    return 0;
+  WGpuRenderPassDescriptor desc = {};
+  _wgpu_blob_read_render_pass(r, desc);
+  return _wgpu_blob_end_read(r) ? wgpu_render_pass_template_create(&desc) : 0;
+}
+
+#ifdef __EMSCRIPTEN__
+// Command recording. The stream holds the commands of a single encoder, and is flushed when a command is recorded for
+// another encoder, or when the stream fills up. Object handles are only valid on the thread that created them, so each
+// thread has its own stream.
+#define _WGPU_COMMAND_STREAM_SIZE 16384 // In 32-bit words.
+static thread_local uint32_t _wgpu_command_stream[_WGPU_COMMAND_STREAM_SIZE];
+static thread_local uint32_t _wgpu_command_stream_size;
+static thread_local WGpuObjectBase _wgpu_command_stream_encoder;
+
+void wgpu_render_pass_flush_commands(WGpuBindingCommandsMixin encoder)
+{
+  if (encoder != _wgpu_command_stream_encoder || !_wgpu_command_stream_size)
+    return;
+  wgpu_encoder_replay_commands(encoder, _wgpu_command_stream, _wgpu_command_stream_size);
+  _wgpu_command_stream_size = 0;
+}
+
+void wgpu_flush_recorded_commands()
+{
+  wgpu_render_pass_flush_commands(_wgpu_command_stream_encoder);
+}
+
+// Returns space for a command of numWords words for the given encoder in the command stream.
+static uint32_t *_wgpu_command_stream_alloc(WGpuObjectBase encoder, uint32_t numWords)
+{
+  assert(encoder);
+  assert(numWords <= _WGPU_COMMAND_STREAM_SIZE);
+  if (encoder != _wgpu_command_stream_encoder || _wgpu_command_stream_size + numWords > _WGPU_COMMAND_STREAM_SIZE)
+  {
+    wgpu_render_pass_flush_commands(_wgpu_command_stream_encoder);
+    _wgpu_command_stream_encoder = encoder;
+  }
+  uint32_t *cmd = _wgpu_command_stream + _wgpu_command_stream_size;
+  _wgpu_command_stream_size += numWords;
+  return cmd;
+}
+
+// Stores a 64-bit offset or size as low and high words. WGPU_MAX_SIZE is stored as all ones.
+static void _wgpu_command_stream_write_u64(uint32_t *dst, double_int53_t value)
+{
+  uint64_t v = (uint64_t)(int64_t)value;
+  dst[0] = (uint32_t)v;
+  dst[1] = (uint32_t)(v >> 32);
+}
+
+static uint32_t _wgpu_float_bits(float f)
+{
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+void wgpu_record_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 2);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_PIPELINE;
+  cmd[1] = (uint32_t)pipeline;
+}
+
+void wgpu_record_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t index, WGpuBindGroup bindGroup, const uint32_t *dynamicOffsets, uint32_t numDynamicOffsets)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 3 + numDynamicOffsets);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_BIND_GROUP | (numDynamicOffsets << 8);
+  cmd[1] = index;
+  cmd[2] = (uint32_t)bindGroup;
+  if (numDynamicOffsets)
+    memcpy(cmd + 3, dynamicOffsets, numDynamicOffsets * sizeof(uint32_t));
+}
+
+void wgpu_record_set_index_buffer(WGpuRenderCommandsMixin encoder, WGpuBuffer buffer, WGPU_INDEX_FORMAT indexFormat, double_int53_t offset, double_int53_t size)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 6);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_INDEX_BUFFER | ((uint32_t)indexFormat << 8);
+  cmd[1] = (uint32_t)buffer;
+  _wgpu_command_stream_write_u64(cmd + 2, offset);
+  _wgpu_command_stream_write_u64(cmd + 4, size);
+}
+
+void wgpu_record_set_vertex_buffer(WGpuRenderCommandsMixin encoder, int32_t slot, WGpuBuffer buffer, double_int53_t offset, double_int53_t size)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 6);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_VERTEX_BUFFER | ((uint32_t)slot << 8);
+  cmd[1] = (uint32_t)buffer;
+  _wgpu_command_stream_write_u64(cmd + 2, offset);
+  _wgpu_command_stream_write_u64(cmd + 4, size);
+}
+
+void wgpu_record_draw(WGpuRenderCommandsMixin encoder, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 5);
+  cmd[0] = WGPU_RECORDED_COMMAND_DRAW;
+  cmd[1] = vertexCount;
+  cmd[2] = instanceCount;
+  cmd[3] = firstVertex;
+  cmd[4] = firstInstance;
+}
+
+void wgpu_record_draw_indexed(WGpuRenderCommandsMixin encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 6);
+  cmd[0] = WGPU_RECORDED_COMMAND_DRAW_INDEXED;
+  cmd[1] = indexCount;
+  cmd[2] = instanceCount;
+  cmd[3] = firstIndex;
+  cmd[4] = (uint32_t)baseVertex;
+  cmd[5] = firstInstance;
+}
+
+void wgpu_record_set_viewport(WGpuRenderPassEncoder encoder, float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 7);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_VIEWPORT;
+  cmd[1] = _wgpu_float_bits(x);
+  cmd[2] = _wgpu_float_bits(y);
+  cmd[3] = _wgpu_float_bits(width);
+  cmd[4] = _wgpu_float_bits(height);
+  cmd[5] = _wgpu_float_bits(minDepth);
+  cmd[6] = _wgpu_float_bits(maxDepth);
+}
+
+void wgpu_record_set_scissor_rect(WGpuRenderPassEncoder encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 5);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_SCISSOR_RECT;
+  cmd[1] = x;
+  cmd[2] = y;
+  cmd[3] = width;
+  cmd[4] = height;
+}
+
+void wgpu_record_set_stencil_reference(WGpuRenderPassEncoder encoder, uint32_t stencilValue)
+{
+  uint32_t *cmd = _wgpu_command_stream_alloc(encoder, 2);
+  cmd[0] = WGPU_RECORDED_COMMAND_SET_STENCIL_REFERENCE;
+  cmd[1] = stencilValue;
+}
+
+#else
+// In native builds, commands do not cross a language boundary, so they are executed immediately instead of being recorded.
+// The functions that WGPU_FILTER_REDUNDANT_STATE redirects are called with parenthesized names, to bypass the filter.
+void wgpu_render_pass_flush_commands(WGpuBindingCommandsMixin) {}
+void wgpu_flush_recorded_commands() {}
+void wgpu_record_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline) { (wgpu_encoder_set_pipeline)(encoder, pipeline); }
+void wgpu_record_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t index, WGpuBindGroup bindGroup, const uint32_t *dynamicOffsets, uint32_t numDynamicOffsets) { (wgpu_encoder_set_bind_group)(encoder, index, bindGroup, dynamicOffsets, numDynamicOffsets); }
+void wgpu_record_set_index_buffer(WGpuRenderCommandsMixin encoder, WGpuBuffer buffer, WGPU_INDEX_FORMAT indexFormat, double_int53_t offset, double_int53_t size) { (wgpu_render_commands_mixin_set_index_buffer)(encoder, buffer, indexFormat, offset, size); }
+void wgpu_record_set_vertex_buffer(WGpuRenderCommandsMixin encoder, int32_t slot, WGpuBuffer buffer, double_int53_t offset, double_int53_t size) { (wgpu_render_commands_mixin_set_vertex_buffer)(encoder, slot, buffer, offset, size); }
+void wgpu_record_draw(WGpuRenderCommandsMixin encoder, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) { wgpu_render_commands_mixin_draw(encoder, vertexCount, instanceCount, firstVertex, firstInstance); }
+void wgpu_record_draw_indexed(WGpuRenderCommandsMixin encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance) { wgpu_render_commands_mixin_draw_indexed(encoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance); }
+void wgpu_record_set_viewport(WGpuRenderPassEncoder encoder, float x, float y, float width, float height, float minDepth, float maxDepth) { (wgpu_render_pass_encoder_set_viewport)(encoder, x, y, width, height, minDepth, maxDepth); }
+void wgpu_record_set_scissor_rect(WGpuRenderPassEncoder encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height) { (wgpu_render_pass_encoder_set_scissor_rect)(encoder, x, y, width, height); }
+void wgpu_record_set_stencil_reference(WGpuRenderPassEncoder encoder, uint32_t stencilValue) { wgpu_render_pass_encoder_set_stencil_reference(encoder, stencilValue); }
+#endif
+
+// Redundant state filtering. The shadow state tracks the state of a single encoder at a time, and is reset when a filtered function
+// is called on another encoder, or when the tracked encoder ends. Bind group indices, dynamic offsets and vertex buffer slots
+// beyond the capacity of the shadow state pass through the filter unchanged.
+#define _WGPU_FILTER_MAX_BIND_GROUPS 8
+#define _WGPU_FILTER_MAX_DYNAMIC_OFFSETS 8
+#define _WGPU_FILTER_MAX_VERTEX_BUFFERS 8
+
+// Bits of _WGpuShadowState::known: which parts of the shadow state hold the current state of the encoder.
+#define _WGPU_KNOWN_PIPELINE       (1u << 0)
+#define _WGPU_KNOWN_INDEX_BUFFER   (1u << 1)
+#define _WGPU_KNOWN_VIEWPORT       (1u << 2)
+#define _WGPU_KNOWN_SCISSOR_RECT   (1u << 3)
+#define _WGPU_KNOWN_BLEND_CONSTANT (1u << 4)
+#define _WGPU_KNOWN_BIND_GROUP(i)    (1u << (8 + (i)))
+#define _WGPU_KNOWN_VERTEX_BUFFER(i) (1u << (16 + (i)))
+// GPURenderPassEncoder.executeBundles() resets these.
+#define _WGPU_KNOWN_BINDINGS (_WGPU_KNOWN_PIPELINE | _WGPU_KNOWN_INDEX_BUFFER | 0xFFFF00u)
+
+typedef struct _WGpuShadowBufferBinding
+{
+  WGpuBuffer buffer;
+  double_int53_t offset;
+  double_int53_t size;
+} _WGpuShadowBufferBinding;
+
+typedef struct _WGpuShadowState
+{
+  WGpuObjectBase encoder;
+  uint32_t known;
+  WGpuObjectBase pipeline;
+  struct
+  {
+    WGpuBindGroup bindGroup;
+    uint32_t numDynamicOffsets;
+    uint32_t dynamicOffsets[_WGPU_FILTER_MAX_DYNAMIC_OFFSETS];
+  } bindGroups[_WGPU_FILTER_MAX_BIND_GROUPS];
+  WGPU_INDEX_FORMAT indexFormat;
+  _WGpuShadowBufferBinding indexBuffer;
+  _WGpuShadowBufferBinding vertexBuffers[_WGPU_FILTER_MAX_VERTEX_BUFFERS];
+  float viewport[6];
+  uint32_t scissorRect[4];
+  double blendConstant[4];
+} _WGpuShadowState;
+
+// Object handles are only valid on the thread that created them, so each thread tracks its own encoder.
+static thread_local _WGpuShadowState _wgpu_shadow_state;
+static uint32_t _wgpu_num_elided_state_changes;
+
+// Returns the shadow state of the given encoder, starting to track it from an unknown state if it was not already tracked.
+static _WGpuShadowState &_wgpu_shadow_state_of(WGpuObjectBase encoder)
+{
+  if (encoder != _wgpu_shadow_state.encoder)
+  {
+    _wgpu_shadow_state.encoder = encoder;
+    _wgpu_shadow_state.known = 0;
+  }
+  return _wgpu_shadow_state;
+}
+
+// Returns true (and counts the call as elided) if the given state is known to already hold the given value. Otherwise marks
+// the state as known, for the caller to update its value and pass the call on.
+static bool _wgpu_filter(_WGpuShadowState &s, uint32_t state, bool unchanged)
+{
+  if ((s.known & state) && unchanged)
+  {
+    ++_wgpu_num_elided_state_changes;
+    return true;
+  }
+  s.known |= state;
+  return false;
+}
+
+// Where the calls that pass the filter go: when recording, into the command stream, and otherwise directly to the WebGPU API.
+#if defined(__EMSCRIPTEN__) && defined(WGPU_RECORD_RENDER_COMMANDS)
+#define _WGPU_FILTER_NEXT(recorded, direct) recorded
+#define _WGPU_FILTER_FLUSH(encoder) wgpu_render_pass_flush_commands(encoder)
+#define _WGPU_FILTER_FLUSH_ALL() wgpu_flush_recorded_commands()
+#else
+#define _WGPU_FILTER_NEXT(recorded, direct) (direct)
+#define _WGPU_FILTER_FLUSH(encoder) ((void)0)
+#define _WGPU_FILTER_FLUSH_ALL() ((void)0)
+#endif
+
+void wgpu_filter_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  if (_wgpu_filter(s, _WGPU_KNOWN_PIPELINE, s.pipeline == pipeline))
+    return;
+  s.pipeline = pipeline;
+  _WGPU_FILTER_NEXT(wgpu_record_set_pipeline, wgpu_encoder_set_pipeline)(encoder, pipeline);
+}
+
+void wgpu_filter_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t index, WGpuBindGroup bindGroup, const uint32_t *dynamicOffsets, uint32_t numDynamicOffsets)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  if (index < _WGPU_FILTER_MAX_BIND_GROUPS)
+  {
+    if (numDynamicOffsets <= _WGPU_FILTER_MAX_DYNAMIC_OFFSETS)
+    {
+      if (_wgpu_filter(s, _WGPU_KNOWN_BIND_GROUP(index), s.bindGroups[index].bindGroup == bindGroup
+        && s.bindGroups[index].numDynamicOffsets == numDynamicOffsets
+        && (!numDynamicOffsets || !memcmp(s.bindGroups[index].dynamicOffsets, dynamicOffsets, numDynamicOffsets * sizeof(uint32_t)))))
+        return;
+      s.bindGroups[index].bindGroup = bindGroup;
+      s.bindGroups[index].numDynamicOffsets = numDynamicOffsets;
+      if (numDynamicOffsets)
+        memcpy(s.bindGroups[index].dynamicOffsets, dynamicOffsets, numDynamicOffsets * sizeof(uint32_t));
+    }
+    else
+      s.known &= ~_WGPU_KNOWN_BIND_GROUP(index);
+  }
+  _WGPU_FILTER_NEXT(wgpu_record_set_bind_group, wgpu_encoder_set_bind_group)(encoder, index, bindGroup, dynamicOffsets, numDynamicOffsets);
+}
+
+void wgpu_filter_set_index_buffer(WGpuRenderCommandsMixin encoder, WGpuBuffer buffer, WGPU_INDEX_FORMAT indexFormat, double_int53_t offset, double_int53_t size)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  if (_wgpu_filter(s, _WGPU_KNOWN_INDEX_BUFFER, s.indexBuffer.buffer == buffer && s.indexFormat == indexFormat
+    && s.indexBuffer.offset == offset && s.indexBuffer.size == size))
+    return;
+  s.indexBuffer.buffer = buffer;
+  s.indexFormat = indexFormat;
+  s.indexBuffer.offset = offset;
+  s.indexBuffer.size = size;
+  _WGPU_FILTER_NEXT(wgpu_record_set_index_buffer, wgpu_render_commands_mixin_set_index_buffer)(encoder, buffer, indexFormat, offset, size);
+}
+
+void wgpu_filter_set_vertex_buffer(WGpuRenderCommandsMixin encoder, int32_t slot, WGpuBuffer buffer, double_int53_t offset, double_int53_t size)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  if ((uint32_t)slot < _WGPU_FILTER_MAX_VERTEX_BUFFERS)
+  {
+    _WGpuShadowBufferBinding &vb = s.vertexBuffers[slot];
+    if (_wgpu_filter(s, _WGPU_KNOWN_VERTEX_BUFFER(slot), vb.buffer == buffer && vb.offset == offset && vb.size == size))
+      return;
+    vb.buffer = buffer;
+    vb.offset = offset;
+    vb.size = size;
+  }
+  _WGPU_FILTER_NEXT(wgpu_record_set_vertex_buffer, wgpu_render_commands_mixin_set_vertex_buffer)(encoder, slot, buffer, offset, size);
+}
+
+void wgpu_filter_set_viewport(WGpuRenderPassEncoder encoder, float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  float *v = s.viewport;
+  if (_wgpu_filter(s, _WGPU_KNOWN_VIEWPORT, v[0] == x && v[1] == y && v[2] == width && v[3] == height && v[4] == minDepth && v[5] == maxDepth))
+    return;
+  v[0] = x; v[1] = y; v[2] = width; v[3] = height; v[4] = minDepth; v[5] = maxDepth;
+  _WGPU_FILTER_NEXT(wgpu_record_set_viewport, wgpu_render_pass_encoder_set_viewport)(encoder, x, y, width, height, minDepth, maxDepth);
+}
+
+void wgpu_filter_set_scissor_rect(WGpuRenderPassEncoder encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  uint32_t *r = s.scissorRect;
+  if (_wgpu_filter(s, _WGPU_KNOWN_SCISSOR_RECT, r[0] == x && r[1] == y && r[2] == width && r[3] == height))
+    return;
+  r[0] = x; r[1] = y; r[2] = width; r[3] = height;
+  _WGPU_FILTER_NEXT(wgpu_record_set_scissor_rect, wgpu_render_pass_encoder_set_scissor_rect)(encoder, x, y, width, height);
+}
+
+void wgpu_filter_set_blend_constant(WGpuRenderPassEncoder encoder, double r, double g, double b, double a)
+{
+  _WGpuShadowState &s = _wgpu_shadow_state_of(encoder);
+  double *c = s.blendConstant;
+  if (_wgpu_filter(s, _WGPU_KNOWN_BLEND_CONSTANT, c[0] == r && c[1] == g && c[2] == b && c[3] == a))
+    return;
+  c[0] = r; c[1] = g; c[2] = b; c[3] = a;
+  _WGPU_FILTER_FLUSH(encoder);
+  (wgpu_render_pass_encoder_set_blend_constant)(encoder, r, g, b, a);
+}
+
+void wgpu_filter_encoder_end(WGpuBindingCommandsMixin encoder)
+{
+  // The handle of the ended encoder will be reused for other objects, so stop tracking it.
+  if (encoder == _wgpu_shadow_state.encoder)
+    _wgpu_shadow_state.encoder = 0;
+  _WGPU_FILTER_FLUSH(encoder);
+  (wgpu_encoder_end)(encoder);
+}
+
+WGpuObjectBase wgpu_filter_encoder_finish(WGpuObjectBase encoder)
+{
+  // Render bundle encoders are not ended, but finished, after which their handle is reused.
+  if (encoder == _wgpu_shadow_state.encoder)
+    _wgpu_shadow_state.encoder = 0;
+  _WGPU_FILTER_FLUSH(encoder);
+  return (wgpu_encoder_finish)(encoder);
+}
+
+// Destroying an object also destroys its children, e.g. the unended passes of a command encoder, so any destroy may release the
+// handle of the tracked encoder. When recording, the recorded commands are flushed first, while the encoder and the objects
+// that they reference are still alive.
+void wgpu_filter_object_destroy(WGpuObjectBase wgpuObject)
+{
+  _wgpu_shadow_state.encoder = 0;
+  _WGPU_FILTER_FLUSH_ALL();
+  (wgpu_object_destroy)(wgpuObject);
+}
+
+void wgpu_filter_object_destroy_many(const WGpuObjectBase *wgpuObjects, int numObjects)
+{
+  _wgpu_shadow_state.encoder = 0;
+  _WGPU_FILTER_FLUSH_ALL();
+  (wgpu_object_destroy_many)(wgpuObjects, numObjects);
+}
+
+void wgpu_filter_transient_scope_end()
+{
+  _wgpu_shadow_state.encoder = 0;
+  _WGPU_FILTER_FLUSH_ALL();
+  (wgpu_transient_scope_end)();
+}
+
+void wgpu_filter_execute_bundles(WGpuRenderPassEncoder encoder, const WGpuRenderBundle *bundles, int numBundles)
+{
+  _wgpu_shadow_state_of(encoder).known &= ~_WGPU_KNOWN_BINDINGS;
+  _WGPU_FILTER_FLUSH(encoder);
+  (wgpu_render_pass_encoder_execute_bundles)(encoder, bundles, numBundles);
+}
+
+void wgpu_filter_draw_batch(WGpuRenderCommandsMixin encoder, const WGpuDrawBatchItem *items, int numItems)
+{
+  // The batch may change any of the bindings. (Tracking them is not worth it, since draw batches already avoid redundant calls
+  // by leaving unchanged state unset.)
+  _wgpu_shadow_state_of(encoder).known &= ~_WGPU_KNOWN_BINDINGS;
+  _WGPU_FILTER_FLUSH(encoder);
+  (wgpu_render_commands_mixin_draw_batch)(encoder, items, numItems);
+}
+
+void wgpu_filter_render_bundle_cache_end(WGpuRenderPassEncoder passEncoder, uint32_t key, WGpuRenderBundleEncoder bundleEncoder)
+{
+  // Executing the bundle resets the bindings of the pass, like wgpu_filter_execute_bundles() does. (this also stops tracking
+  // the bundle encoder, which is destroyed)
+  _wgpu_shadow_state_of(passEncoder).known &= ~_WGPU_KNOWN_BINDINGS;
+  _WGPU_FILTER_FLUSH(passEncoder);
+  _WGPU_FILTER_FLUSH(bundleEncoder);
+  (wgpu_render_bundle_cache_end)(passEncoder, key, bundleEncoder);
+}
+
+uint32_t wgpu_get_num_elided_state_changes()
+{
+  return _wgpu_num_elided_state_changes;
+}
+
 const WGpuRequestAdapterOptions WGPU_REQUEST_ADAPTER_OPTIONS_DEFAULT_INITIALIZER = {
 };
 
@@ -454,6 +1565,10 @@ extern const WGpuRenderPassColorAttachment WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEF
   }
 };
 
+extern const WGpuDrawBatchItem WGPU_DRAW_BATCH_ITEM_DEFAULT_INITIALIZER = {
+  .instanceCount = 1
+};
+
 extern const WGpuCopyExternalImageSourceInfo WGPU_COPY_EXTERNAL_IMAGE_SOURCE_INFO_DEFAULT_INITIALIZER = {
   .origin = WGpuOrigin2D {
     .x = 0,
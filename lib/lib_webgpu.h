@@ -67,7 +67,7 @@
 #endif
 
 #if defined(__EMSCRIPTEN__) && __cplusplus >= 201103L
-#define VERIFY_STRUCT_SIZE(struct_name, size) static_assert(sizeof(struct_name) == (size), "lib_webgpu.js is hardcoded to expect this size. If this changes, modify lib_webgpu.js accordingly. (search for sizeof(..) on struct name)");
+#define VERIFY_STRUCT_SIZE(struct_name, size) static_assert(sizeof(struct_name) == (size), "lib_webgpu.js is hardcoded to expect this size. If this changes, run 'node scripts/generate_tables.js' and modify lib_webgpu.js accordingly. (search for sizeof(..) on struct name)");
 #else
 #define VERIFY_STRUCT_SIZE(struct_name, size)
 #endif
@@ -77,8 +77,7 @@ extern "C" {
 #endif
 
 
-// Returns the number of WebGPU objects referenced by the WebGPU JS library. N.b. aim to use this function only for debugging purposes, as it
-// takes O(n) time to enumerate through all live objects.
+// Returns the number of WebGPU objects referenced by the WebGPU JS library. This function runs in O(1) time.
 uint32_t wgpu_get_num_live_objects(void);
 
 // Calls .destroy() on the given WebGPU object (if it has such a member function) and releases the JS side reference to it. Use this function
@@ -88,9 +87,25 @@ uint32_t wgpu_get_num_live_objects(void);
 // do excess "if (wgpuObject) wgpu_object_destroy(wgpuObject);")
 void wgpu_object_destroy(WGpuObjectBase wgpuObject);
 
+// Destroys each object in the given array, as if calling wgpu_object_destroy() on each of them in order. Objects derived from
+// the given objects are destroyed as well. Use this to tear down a large number of objects in a single call from Wasm to JS.
+// Null entries and objects that have already been destroyed are skipped.
+void wgpu_object_destroy_many(const WGpuObjectBase *wgpuObjects, int numObjects);
+
 // Deinitializes all initialized WebGPU objects.
 void wgpu_destroy_all_objects(void);
 
+// Begins a transient object scope. All WebGPU objects that are created until the matching call to wgpu_transient_scope_end()
+// will be destroyed at the end of the scope. Transient objects get bump allocated IDs, and are not linked to their parent objects,
+// which makes creating them cheaper than creating regular objects. Use this to wrap the command encoders, render/compute pass encoders,
+// texture views and command buffers that are created each frame. Do not create long-lived objects inside a transient scope.
+// Transient objects may still be destroyed individually before the end of the scope. Transient scopes cannot be nested, and the
+// begin and end calls should be made within the same frame callback, since objects from asynchronous callbacks that fire while the
+// scope is active will be transient as well.
+void wgpu_transient_scope_begin(void);
+// Ends the active transient object scope, and destroys all objects that were created inside it.
+void wgpu_transient_scope_end(void);
+
 #ifdef __EMSCRIPTEN__
 // Initializes a WebGPU rendering context to a canvas by calling canvas.getContext('webgpu').
 WGpuCanvasContext wgpu_canvas_get_webgpu_context(const char *canvasSelector NOTNULL);
@@ -110,7 +125,9 @@ interface mixin GPUObjectBase {
     attribute USVString label;
 };
 */
-// Returns true if the given handle references a valid WebGPU object
+// Returns true if the given handle references a valid WebGPU object.
+// When building with -jsDWEBGPU_GENERATIONAL_HANDLES=1 (or with WGPU_GENERATIONAL_HANDLES defined on the Dawn backend), object IDs
+// carry generation bits, and a stale ID of a destroyed object will return false here even after its slot has been reused by a new object.
 WGPU_BOOL wgpu_is_valid_object(WGpuObjectBase obj);
 // Set a human-readable label for the given WebGPU object. Pass an empty string "" to clear a label.
 void wgpu_object_set_label(WGpuObjectBase obj, const char *label NOTNULL);
@@ -119,6 +136,16 @@ void wgpu_object_set_label(WGpuObjectBase obj, const char *label NOTNULL);
 // dstLabelSize: length of dstLabel array in bytes.
 // Returns the number of bytes written (excluding null byte at end).
 int wgpu_object_get_label(WGpuObjectBase obj, char *dstLabel NOTNULL, uint32_t dstLabelSize);
+// Returns a nonzero serial number that identifies the given object for the lifetime of the program. Unlike object IDs, serial
+// numbers are not reused after an object is destroyed, so they can key caches that must not alias a new object that reuses the
+// ID of a destroyed one. Returns 0 if the handle does not reference a valid object.
+uint32_t wgpu_object_get_serial(WGpuObjectBase obj);
+
+// Registers a C string that stays alive and unmodified for the remaining lifetime of the program (e.g. a string literal),
+// so that passing it as a label, a shader entry point or a pipeline constant name returns a cached JS string instead of
+// decoding it again on each call. Strings that have not been registered are also cached, but their contents are hashed on each
+// use to detect that the memory has been reused for a different string. On the Dawn backend this function does nothing.
+void wgpu_intern_string(const char *str NOTNULL);
 
 /*
 dictionary GPUObjectDescriptorBase {
@@ -520,6 +547,8 @@ typedef struct WGpuDeviceDescriptor
 {
   WGpuSupportedLimits requiredLimits;
   WGpuQueueDescriptor defaultQueue;
+  // N.b. in Dawn builds, the device additionally gets the non-standard multi-draw indirect feature whenever the adapter supports
+  // it, see wgpu_render_commands_mixin_multi_draw_indirect().
   WGPU_FEATURES_BITFIELD requiredFeatures;
   uint32_t unused_padding;
 } WGpuDeviceDescriptor;
@@ -575,6 +604,11 @@ void wgpu_device_tick(WGpuDevice device);
 
 WGpuBuffer wgpu_device_create_buffer(WGpuDevice device, const WGpuBufferDescriptor *bufferDesc NOTNULL);
 WGpuTexture wgpu_device_create_texture(WGpuDevice device, const WGpuTextureDescriptor *textureDesc NOTNULL);
+// When building with -jsDWEBGPU_OBJECT_INTERNING=1 (or with WGPU_OBJECT_INTERNING defined on the Dawn backend), samplers, bind group
+// layouts and pipeline layouts are interned: creating one with a descriptor that is byte-for-byte identical to that of an existing object
+// on the same device returns the existing object instead of creating a new one. Interned objects are reference counted: each create call
+// adds a reference, and wgpu_object_destroy() releases one, destroying the object only when the last reference is released.
+// Objects created inside a transient scope (see wgpu_transient_scope_begin()) are not interned.
 WGpuSampler wgpu_device_create_sampler(WGpuDevice device, const WGpuSamplerDescriptor *samplerDesc NOTNULL);
 WGpuExternalTexture wgpu_device_import_external_texture(WGpuDevice device, const WGpuExternalTextureDescriptor *externalTextureDesc NOTNULL);
 
@@ -1182,6 +1216,59 @@ typedef int WGPU_TEXTURE_FORMAT;
 #define WGPU_TEXTURE_FORMAT_ASTC_12X12_UNORM_SRGB 101
 #define WGPU_TEXTURE_FORMAT_LAST_VALUE            101 // This needs to be equal to the highest texture format number above
 
+// Texture format metadata: wgpu_texture_format_info() returns static information about a texture format from a lookup table.
+// Identifies the block compression family of a texture format, and the device feature that is needed to use it.
+typedef int WGPU_TEXTURE_COMPRESSION;
+#define WGPU_TEXTURE_COMPRESSION_NONE 0
+#define WGPU_TEXTURE_COMPRESSION_BC   1 // Requires "texture-compression-bc"
+#define WGPU_TEXTURE_COMPRESSION_ETC2 2 // Requires "texture-compression-etc2". Includes the EAC formats.
+#define WGPU_TEXTURE_COMPRESSION_ASTC 3 // Requires "texture-compression-astc"
+
+#define WGPU_TEXTURE_FORMAT_FLAG_DEPTH      0x01 // The format has a depth aspect.
+#define WGPU_TEXTURE_FORMAT_FLAG_STENCIL    0x02 // The format has a stencil aspect.
+#define WGPU_TEXTURE_FORMAT_FLAG_SRGB       0x04 // The format is an sRGB format, i.e. is read with the sRGB to linear conversion.
+#define WGPU_TEXTURE_FORMAT_FLAG_FILTERABLE 0x08 // The format can be sampled with a filtering sampler without enabling any features (sampleType == WGPU_TEXTURE_SAMPLE_TYPE_FLOAT).
+
+typedef struct WGpuTextureFormatInfo
+{
+  uint8_t blockWidth;    // Width of a texel block in texels: 1 for uncompressed formats, 4 for BC and ETC2, and 4-12 for ASTC.
+  uint8_t blockHeight;   // Height of a texel block in texels.
+  uint8_t bytesPerBlock; // Texel block copy footprint in bytes, i.e. the size of a block in buffer<->texture copies. For combined depth-stencil formats, this is the
+                         // size of the depth aspect (copy the stencil aspect as WGPU_TEXTURE_FORMAT_STENCIL8). The depth24plus formats have no defined copy footprint, and have 0.
+  uint8_t numComponents; // Number of color channels, or the number of depth and stencil aspects.
+  uint8_t compression;   // One of WGPU_TEXTURE_COMPRESSION_*.
+  uint8_t flags;         // Bitwise-or of WGPU_TEXTURE_FORMAT_FLAG_*.
+  uint8_t srgbPair;      // The sRGB variant of a non-sRGB format, or vice versa. WGPU_TEXTURE_FORMAT_INVALID if the format does not have one.
+  uint8_t sampleType;    // The WGPU_TEXTURE_SAMPLE_TYPE that the format binds as without enabling any features (the depth aspect for depth-stencil formats).
+} WGpuTextureFormatInfo;
+
+// Returns information about the given texture format. The lookup is branch-free. Passing an invalid format value returns the entry
+// of WGPU_TEXTURE_FORMAT_INVALID, which describes a 1x1 texel block of zero bytes, so the size functions below return 0 for it.
+const WGpuTextureFormatInfo *wgpu_texture_format_info(WGPU_TEXTURE_FORMAT format);
+
+// Returns the number of bytes in one row of texel blocks of an image of the given width, when rows are tightly packed.
+// This is the minimum bytesPerRow to pass to wgpu_queue_write_texture().
+uint32_t wgpu_texture_format_bytes_per_row(WGPU_TEXTURE_FORMAT format, uint32_t width);
+
+// Like wgpu_texture_format_bytes_per_row(), but rounded up to a multiple of WGPU_COPY_BYTES_PER_ROW_ALIGNMENT (256), as
+// bytesPerRow is required to be in wgpu_command_encoder_copy_buffer_to_texture() and wgpu_command_encoder_copy_texture_to_buffer().
+#define WGPU_COPY_BYTES_PER_ROW_ALIGNMENT 256
+uint32_t wgpu_texture_format_aligned_bytes_per_row(WGPU_TEXTURE_FORMAT format, uint32_t width);
+
+// Returns the number of rows of texel blocks in an image of the given height. This is the rowsPerImage of a tightly packed image.
+uint32_t wgpu_texture_format_rows_per_image(WGPU_TEXTURE_FORMAT format, uint32_t height);
+
+// Returns the number of bytes that a width x height x depthOrArrayLayers image occupies in a buffer, when its rows of texel blocks are
+// bytesPerRow bytes apart, and its images are tightly packed. Pass bytesPerRow == 0 to use tightly packed rows.
+uint64_t wgpu_texture_format_image_size(WGPU_TEXTURE_FORMAT format, uint32_t width, uint32_t height, uint32_t depthOrArrayLayers, uint32_t bytesPerRow);
+
+// Returns the number of bytes that all the mip levels 0, 1, ..., mipLevelCount-1 of a texture occupy in a buffer, e.g. to size a staging
+// buffer that holds a full mip chain. If alignRows is true, each row is padded to WGPU_COPY_BYTES_PER_ROW_ALIGNMENT bytes, as is needed
+// to upload the mip levels with wgpu_command_encoder_copy_buffer_to_texture(). The depth of WGPU_TEXTURE_DIMENSION_3D textures is halved
+// at each mip level, whereas the array layer count of 1D and 2D textures stays the same.
+uint64_t wgpu_texture_format_mip_chain_size(WGPU_TEXTURE_FORMAT format, WGPU_TEXTURE_DIMENSION dimension, uint32_t width, uint32_t height, uint32_t depthOrArrayLayers,
+  uint32_t mipLevelCount, WGPU_BOOL alignRows);
+
 /*
 [Exposed=(Window, DedicatedWorker), SecureContext]
 interface GPUExternalTexture {
@@ -2526,6 +2613,69 @@ void wgpu_render_commands_mixin_draw_indexed(WGpuRenderCommandsMixin renderComma
 void wgpu_render_commands_mixin_draw_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset);
 void wgpu_render_commands_mixin_draw_indexed_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset);
 
+// Multi-draw indirect: issues drawCount indirect draws, whose arguments are read from indirectBuffer starting at indirectOffset,
+// stride bytes apart. A stride of 0 means that the arguments are tightly packed. In Dawn builds, tightly packed draws on a render
+// pass are issued with a single native multi-draw call if the device has the multi-draw indirect feature, which is enabled at
+// device creation whenever the adapter supports it. Otherwise (and always on the web, since browsers do not support multi-draw
+// indirect) the draws are issued one at a time in a loop inside the library, which costs only a single Wasm->JS call.
+// The feature is not part of the WebGPU spec and has no WGPU_FEATURE_* flag, so it cannot be requested in requiredFeatures; it
+// has no effect other than enabling this fast path. indirectOffset must be a multiple of 4.
+#define WGPU_DRAW_INDIRECT_ARGS_SIZE 16         // sizeof { vertexCount, instanceCount, firstVertex, firstInstance }
+#define WGPU_DRAW_INDEXED_INDIRECT_ARGS_SIZE 20 // sizeof { indexCount, instanceCount, firstIndex, baseVertex, firstInstance }
+void wgpu_render_commands_mixin_multi_draw_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t drawCount, uint32_t stride _WGPU_DEFAULT_VALUE(0));
+void wgpu_render_commands_mixin_multi_draw_indexed_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t drawCount, uint32_t stride _WGPU_DEFAULT_VALUE(0));
+
+// Draw batches: an application that already has a sorted list of draws can submit the whole list with a single call to
+// wgpu_render_commands_mixin_draw_batch(), avoiding the cost of a Wasm->JS call (or a handle lookup in Dawn builds) for each
+// individual state change and draw. Each WGpuDrawBatchItem holds the state changes to perform before its draw. A zero object
+// handle in an item means that the corresponding state is left unchanged from the previous item, so items only need to
+// populate the state that actually changes.
+#define WGPU_DRAW_BATCH_MAX_BIND_GROUPS 4
+#define WGPU_DRAW_BATCH_MAX_DYNAMIC_OFFSETS 4
+#define WGPU_DRAW_BATCH_MAX_VERTEX_BUFFERS 4
+
+typedef struct WGpuDrawBatchBindGroup
+{
+  WGpuBindGroup bindGroup; // If 0, the bind group at this index is left unchanged.
+  uint32_t numDynamicOffsets;
+  uint32_t dynamicOffsets[WGPU_DRAW_BATCH_MAX_DYNAMIC_OFFSETS];
+} WGpuDrawBatchBindGroup;
+VERIFY_STRUCT_SIZE(WGpuDrawBatchBindGroup, 6*sizeof(uint32_t));
+
+typedef struct WGpuDrawBatchBufferBinding
+{
+  WGpuBuffer buffer; // If 0, the buffer binding is left unchanged.
+  uint64_t offset;
+  uint64_t size; // If set to 0 (default), the remainder of the buffer after offset is bound.
+} WGpuDrawBatchBufferBinding;
+VERIFY_STRUCT_SIZE(WGpuDrawBatchBufferBinding, 6*sizeof(uint32_t));
+
+typedef struct WGpuDrawBatchItem
+{
+  WGpuRenderPipeline pipeline; // If 0, the current pipeline is left unchanged.
+  WGPU_INDEX_FORMAT indexFormat; // Specifies the format of indexBuffer. Ignored if indexBuffer.buffer is 0.
+  WGpuDrawBatchBindGroup bindGroups[WGPU_DRAW_BATCH_MAX_BIND_GROUPS];
+  WGpuDrawBatchBufferBinding indexBuffer;
+  WGpuDrawBatchBufferBinding vertexBuffers[WGPU_DRAW_BATCH_MAX_VERTEX_BUFFERS];
+
+  // If indexCount > 0, the item issues drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance).
+  // Otherwise, if vertexCount > 0, the item issues draw(vertexCount, instanceCount, firstVertex, firstInstance).
+  // If both are zero, the item only changes state.
+  uint32_t vertexCount;
+  uint32_t indexCount;
+  uint32_t instanceCount; // Default: 1
+  uint32_t firstVertex;
+  uint32_t firstIndex;
+  int32_t baseVertex;
+  uint32_t firstInstance;
+  uint32_t unused_padding;
+} WGpuDrawBatchItem;
+VERIFY_STRUCT_SIZE(WGpuDrawBatchItem, 64*sizeof(uint32_t));
+extern const WGpuDrawBatchItem WGPU_DRAW_BATCH_ITEM_DEFAULT_INITIALIZER;
+
+// Performs the state changes and draws of numItems items in order.
+void wgpu_render_commands_mixin_draw_batch(WGpuRenderCommandsMixin renderCommandsMixin, const WGpuDrawBatchItem *items NOTNULL, int numItems);
+
 /*
 [Exposed=(Window, DedicatedWorker), SecureContext]
 interface GPURenderPassEncoder {
@@ -2562,6 +2712,13 @@ void wgpu_render_pass_encoder_set_stencil_reference(WGpuRenderPassEncoder encode
 void wgpu_render_pass_encoder_begin_occlusion_query(WGpuRenderPassEncoder encoder, int32_t queryIndex);
 void wgpu_render_pass_encoder_end_occlusion_query(WGpuRenderPassEncoder encoder);
 void wgpu_render_pass_encoder_execute_bundles(WGpuRenderPassEncoder encoder, const WGpuRenderBundle *bundles, int numBundles);
+
+// Like wgpu_render_commands_mixin_multi_draw_indirect(), but the number of draws is read from the uint32 at drawCountBufferOffset
+// in drawCountBuffer, and clamped to maxDrawCount. The loop fallback (see above) cannot read the draw count on the CPU, so it issues
+// all maxDrawCount draws: for portable results, the arguments of the draws past the draw count must be no-op draws that have
+// an instanceCount of 0, e.g. by having the compute shader that writes out the draw count also clear the unused draws.
+void wgpu_render_pass_encoder_multi_draw_indirect_count(WGpuRenderPassEncoder encoder, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t maxDrawCount, uint32_t stride, WGpuBuffer drawCountBuffer, double_int53_t drawCountBufferOffset);
+void wgpu_render_pass_encoder_multi_draw_indexed_indirect_count(WGpuRenderPassEncoder encoder, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t maxDrawCount, uint32_t stride, WGpuBuffer drawCountBuffer, double_int53_t drawCountBufferOffset);
 #define wgpu_render_pass_encoder_end wgpu_encoder_end
 
 // Inherited from GPUDebugCommandsMixin:
@@ -2580,6 +2737,9 @@ void wgpu_render_pass_encoder_execute_bundles(WGpuRenderPassEncoder encoder, con
 #define wgpu_render_pass_encoder_draw_indexed wgpu_render_commands_mixin_draw_indexed
 #define wgpu_render_pass_encoder_draw_indirect wgpu_render_commands_mixin_draw_indirect
 #define wgpu_render_pass_encoder_draw_indexed_indirect wgpu_render_commands_mixin_draw_indexed_indirect
+#define wgpu_render_pass_encoder_multi_draw_indirect wgpu_render_commands_mixin_multi_draw_indirect
+#define wgpu_render_pass_encoder_multi_draw_indexed_indirect wgpu_render_commands_mixin_multi_draw_indexed_indirect
+#define wgpu_render_pass_encoder_draw_batch wgpu_render_commands_mixin_draw_batch
 
 /*
 dictionary GPURenderPassColorAttachment {
@@ -2710,6 +2870,9 @@ WGPU_BOOL wgpu_is_render_bundle_encoder(WGpuObjectBase object);
 #define wgpu_render_bundle_encoder_draw_indexed wgpu_render_commands_mixin_draw_indexed
 #define wgpu_render_bundle_encoder_draw_indirect wgpu_render_commands_mixin_draw_indirect
 #define wgpu_render_bundle_encoder_draw_indexed_indirect wgpu_render_commands_mixin_draw_indexed_indirect
+#define wgpu_render_bundle_encoder_multi_draw_indirect wgpu_render_commands_mixin_multi_draw_indirect
+#define wgpu_render_bundle_encoder_multi_draw_indexed_indirect wgpu_render_commands_mixin_multi_draw_indexed_indirect
+#define wgpu_render_bundle_encoder_draw_batch wgpu_render_commands_mixin_draw_batch
 
 /*
 dictionary GPURenderBundleEncoderDescriptor : GPURenderPassLayout {
@@ -2870,11 +3033,11 @@ WGpuTexture wgpu_canvas_context_get_current_texture(WGpuCanvasContext canvasCont
 // Dawn SwapChain returns a TextureView, whereas GPUCanvasContext.getCurrentTexture() returns a Texture,
 // so provide a convenient function wgpu_canvas_context_get_current_texture_view() to obtain
 // a TextureView in a cross-platform manner.
-#ifdef __EMSCRIPTEN__
-#define wgpu_canvas_context_get_current_texture_view(canvasContext) wgpu_texture_create_view_simple(wgpu_canvas_context_get_current_texture((canvasContext)))
-#else
+// The returned view is cached in the canvas context: calling this function several times while the
+// current canvas texture stays the same returns the same view, and when the canvas texture rotates, the
+// view is replaced with a view to the new texture. So there is no need to call wgpu_object_destroy() on
+// the returned view.
 WGpuTextureView wgpu_canvas_context_get_current_texture_view(WGpuCanvasContext canvasContext);
-#endif
 
 #ifndef __EMSCRIPTEN__
 void wgpu_canvas_context_present(WGpuCanvasContext canvasContext);
@@ -3259,7 +3422,7 @@ typedef struct _WGPU_ALIGN_TO_64BITS WGpuRenderPipelineDescriptor
   uint32_t unused_padding;
   WGpuFragmentState fragment;
   WGpuPipelineLayout layout; // Set to special value WGPU_AUTO_LAYOUT_MODE_AUTO to specify that automatic layout should be used.
-  uint32_t unused_padding2;
+  WGPU_BOOL retainDescriptor; // If true, the pipeline retains its descriptor so that variants can be created from it. See wgpu_device_create_render_pipeline_variant().
 } WGpuRenderPipelineDescriptor;
 extern const WGpuRenderPipelineDescriptor WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
 
@@ -3290,6 +3453,353 @@ typedef void (*WGpuLoadImageBitmapCallback)(WGpuImageBitmap bitmap, int width, i
 
 void wgpu_load_image_bitmap_from_url_async(const char *url NOTNULL, WGPU_BOOL flipY, WGpuLoadImageBitmapCallback callback, void *userData);
 
+// Identifies the type of a WebGPU object for the purposes of WGpuLiveObjectStats.
+typedef int WGPU_OBJECT_TYPE;
+#define WGPU_OBJECT_TYPE_INVALID               0
+#define WGPU_OBJECT_TYPE_ADAPTER               1
+#define WGPU_OBJECT_TYPE_DEVICE                2
+#define WGPU_OBJECT_TYPE_BIND_GROUP_LAYOUT     3
+#define WGPU_OBJECT_TYPE_BUFFER                4
+#define WGPU_OBJECT_TYPE_TEXTURE               5
+#define WGPU_OBJECT_TYPE_TEXTURE_VIEW          6
+#define WGPU_OBJECT_TYPE_EXTERNAL_TEXTURE      7
+#define WGPU_OBJECT_TYPE_SAMPLER               8
+#define WGPU_OBJECT_TYPE_BIND_GROUP            9
+#define WGPU_OBJECT_TYPE_PIPELINE_LAYOUT       10
+#define WGPU_OBJECT_TYPE_SHADER_MODULE         11
+#define WGPU_OBJECT_TYPE_COMPUTE_PIPELINE      12
+#define WGPU_OBJECT_TYPE_RENDER_PIPELINE       13
+#define WGPU_OBJECT_TYPE_COMMAND_BUFFER        14
+#define WGPU_OBJECT_TYPE_COMMAND_ENCODER       15
+#define WGPU_OBJECT_TYPE_COMPUTE_PASS_ENCODER  16
+#define WGPU_OBJECT_TYPE_RENDER_PASS_ENCODER   17
+#define WGPU_OBJECT_TYPE_RENDER_BUNDLE         18
+#define WGPU_OBJECT_TYPE_RENDER_BUNDLE_ENCODER 19
+#define WGPU_OBJECT_TYPE_QUEUE                 20
+#define WGPU_OBJECT_TYPE_QUERY_SET             21
+#define WGPU_OBJECT_TYPE_CANVAS_CONTEXT        22
+#define WGPU_OBJECT_TYPE_OTHER                 23 // Other objects in the object table, e.g. ImageBitmaps, GPUDeviceLostInfos and GPUErrors.
+#define WGPU_OBJECT_TYPE_COUNT                 24
+
+typedef struct WGpuLiveObjectStats
+{
+  // The following arrays are indexed by WGPU_OBJECT_TYPE.
+  uint32_t numLiveObjects[WGPU_OBJECT_TYPE_COUNT];      // Number of objects of each type that are currently alive.
+  uint32_t numCreatedObjects[WGPU_OBJECT_TYPE_COUNT];   // Total number of objects of each type that have been created since startup.
+  uint32_t numDestroyedObjects[WGPU_OBJECT_TYPE_COUNT]; // Total number of objects of each type that have been destroyed since startup.
+} WGpuLiveObjectStats;
+VERIFY_STRUCT_SIZE(WGpuLiveObjectStats, 3*WGPU_OBJECT_TYPE_COUNT*sizeof(uint32_t));
+
+// Fills the given structure with per-type counts of the objects in the WebGPU object table. The counters are
+// maintained incrementally as objects are created and destroyed, so this function is cheap enough to call
+// each frame, e.g. for leak monitoring.
+void wgpu_get_live_object_stats(WGpuLiveObjectStats *stats NOTNULL);
+
+#ifndef __EMSCRIPTEN__
+// The Dawn backend allocates its internal object wrappers from slab pools. This struct reports the occupancy of a pool.
+typedef struct WGpuObjectPoolStats
+{
+  uint32_t numLiveObjects; // Number of object wrappers currently allocated from the pool.
+  uint32_t highWaterMark;  // Largest value that numLiveObjects has had since startup.
+  uint32_t capacity;       // Number of object wrappers that fit in the slabs allocated so far.
+} WGpuObjectPoolStats;
+
+// Reports the occupancy of the object wrapper pools of the Dawn backend. GPUBuffer wrappers are allocated from their own pool,
+// and wrappers of all other object types from a shared pool.
+void wgpu_get_object_pool_stats(WGpuObjectPoolStats *objectPoolStats NOTNULL, WGpuObjectPoolStats *bufferPoolStats NOTNULL);
+#endif
+
+// Pipeline cache: the following functions create render and compute pipelines like wgpu_device_create_render_pipeline() and
+// wgpu_device_create_compute_pipeline() do, but first look up the pipeline from a cache that is keyed on the full contents of the
+// pipeline descriptor (following all pointers in it: vertex buffer layouts, attributes, color targets, constants and entry point names).
+// If an identical pipeline has already been created for the same device, that pipeline is returned without recreating it.
+// Pipelines returned by these functions are owned by the cache, so do not call wgpu_object_destroy() on them. Instead, call
+// wgpu_pipeline_cache_clear() to destroy all cached pipelines, e.g. before destroying the device they were created on.
+WGpuRenderPipeline wgpu_device_create_render_pipeline_cached(WGpuDevice device, const WGpuRenderPipelineDescriptor *renderPipelineDesc NOTNULL);
+WGpuComputePipeline wgpu_device_create_compute_pipeline_cached(WGpuDevice device, WGpuShaderModule computeModule, const char *entryPoint, WGpuPipelineLayout layout, const WGpuPipelineConstant *constants, int numConstants);
+
+// Destroys all pipelines in the pipeline cache, and empties the cache. Does not reset the hit/miss statistics.
+void wgpu_pipeline_cache_clear(void);
+
+typedef struct WGpuPipelineCacheStats
+{
+  uint32_t numPipelines; // Number of pipelines currently in the cache.
+  uint32_t numHits;      // Number of *_cached() calls that returned an existing pipeline.
+  uint32_t numMisses;    // Number of *_cached() calls that had to create a new pipeline.
+} WGpuPipelineCacheStats;
+VERIFY_STRUCT_SIZE(WGpuPipelineCacheStats, 3*sizeof(uint32_t));
+
+void wgpu_get_pipeline_cache_stats(WGpuPipelineCacheStats *stats NOTNULL);
+
+// Render pipeline variants: creates a render pipeline whose descriptor is that of the given base render pipeline, with the given
+// delta applied to it. The base descriptor does not need to be marshalled again, and only the fields in the delta are read. This
+// is useful for e.g. creating the same material with different culling, depth or blending state.
+// The base pipeline must have been created with retainDescriptor set, either in its WGpuRenderPipelineDescriptor, or in the
+// WGpuRenderPipelineDelta of wgpu_device_create_render_pipeline_variant() itself. A retained descriptor keeps its shader modules
+// and pipeline layout alive until the pipeline is destroyed, so only retain the descriptors of pipelines that variants are made of.
+// If the base pipeline uses an automatic layout, each variant gets its own automatic layout, so bind groups that were created
+// with the bind group layouts of the base pipeline are not compatible with the variants. Use an explicit pipeline layout to share
+// bind groups between the base pipeline and its variants.
+#define WGPU_RENDER_PIPELINE_DELTA_TOPOLOGY      0x01 // topology and stripIndexFormat
+#define WGPU_RENDER_PIPELINE_DELTA_FRONT_FACE    0x02 // frontFace
+#define WGPU_RENDER_PIPELINE_DELTA_CULL_MODE     0x04 // cullMode
+#define WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE 0x08 // depthCompare. The base pipeline must have a depth-stencil state.
+#define WGPU_RENDER_PIPELINE_DELTA_DEPTH_WRITE   0x10 // depthWriteEnabled. The base pipeline must have a depth-stencil state.
+#define WGPU_RENDER_PIPELINE_DELTA_DEPTH_BIAS    0x20 // depthBias, depthBiasSlopeScale and depthBiasClamp. The base pipeline must have a depth-stencil state.
+#define WGPU_RENDER_PIPELINE_DELTA_BLEND         0x40 // blend, applied to all (non-sparse) color targets.
+#define WGPU_RENDER_PIPELINE_DELTA_WRITE_MASK    0x80 // writeMask, applied to all (non-sparse) color targets.
+
+typedef struct _WGPU_ALIGN_TO_64BITS WGpuRenderPipelineDelta
+{
+  uint32_t fields; // A combination of the WGPU_RENDER_PIPELINE_DELTA_* flags, specifying which of the fields below replace those of the base pipeline.
+  WGPU_PRIMITIVE_TOPOLOGY topology;
+  WGPU_INDEX_FORMAT stripIndexFormat;
+  WGPU_FRONT_FACE frontFace;
+  WGPU_CULL_MODE cullMode;
+  WGPU_COMPARE_FUNCTION depthCompare;
+  WGPU_BOOL depthWriteEnabled;
+  int32_t depthBias;
+  float depthBiasSlopeScale;
+  float depthBiasClamp;
+  WGpuBlendState blend; // Set blend.color.operation to WGPU_BLEND_OPERATION_DISABLED to disable blending.
+  WGPU_COLOR_WRITE_FLAGS writeMask;
+
+  // Pipeline-overridable constants of the vertex and fragment stages. These are merged to the constants of the base pipeline:
+  // a constant with the same name as a constant of the base pipeline replaces its value, and other constants are added.
+  int numVertexConstants;
+  int numFragmentConstants;
+  WGPU_BOOL retainDescriptor; // If true, the variant retains its descriptor so that further variants can be created from it.
+  const WGpuPipelineConstant *vertexConstants;
+  _WGPU_PTR_PADDING(0);
+  const WGpuPipelineConstant *fragmentConstants;
+  _WGPU_PTR_PADDING(1);
+} WGpuRenderPipelineDelta;
+VERIFY_STRUCT_SIZE(WGpuRenderPipelineDelta, 24*sizeof(uint32_t));
+
+WGpuRenderPipeline wgpu_device_create_render_pipeline_variant(WGpuDevice device, WGpuRenderPipeline base, const WGpuRenderPipelineDelta *delta NOTNULL);
+
+// Bind group cache: creates a bind group like wgpu_device_create_bind_group() does, but first looks up the bind group from a cache
+// that is keyed on the layout and the entries. If an identical bind group already exists, it is returned without recreating it.
+// A cached bind group is evicted from the cache and destroyed when its layout, or any buffer, texture view or sampler that it
+// references, is destroyed with wgpu_object_destroy(). When the cache holds more than the maximum number of bind groups
+// (4096 by default), the least recently used bind group is evicted and destroyed.
+// Bind groups returned by this function are owned by the cache, so do not hold on to them across frames, but call this function
+// again to look them up. (a cached bind group may also be destroyed with wgpu_object_destroy(), which removes it from the cache)
+WGpuBindGroup wgpu_device_create_bind_group_cached(WGpuDevice device, WGpuBindGroupLayout bindGroupLayout, const WGpuBindGroupEntry *entries, int numEntries);
+
+// Sets the maximum number of bind groups in the bind group cache, evicting least recently used bind groups if needed.
+void wgpu_bind_group_cache_set_capacity(uint32_t maxBindGroups);
+
+// Destroys all bind groups in the bind group cache, and empties the cache. Does not reset the statistics.
+void wgpu_bind_group_cache_clear(void);
+
+typedef struct WGpuBindGroupCacheStats
+{
+  uint32_t numBindGroups; // Number of bind groups currently in the cache.
+  uint32_t numHits;       // Number of wgpu_device_create_bind_group_cached() calls that returned an existing bind group.
+  uint32_t numMisses;     // Number of wgpu_device_create_bind_group_cached() calls that had to create a new bind group.
+  uint32_t numEvictions;  // Number of bind groups that were evicted because the cache was full.
+} WGpuBindGroupCacheStats;
+VERIFY_STRUCT_SIZE(WGpuBindGroupCacheStats, 4*sizeof(uint32_t));
+
+void wgpu_get_bind_group_cache_stats(WGpuBindGroupCacheStats *stats NOTNULL);
+
+// Render bundle cache: records a block of render commands into a render bundle the first time that the block is run, and replays
+// the bundle with a single execute bundles call on later frames. Each block is identified by an application chosen key:
+//
+//   WGpuRenderBundleEncoder bundleEncoder = wgpu_render_bundle_cache_begin(device, key, &bundleDesc);
+//   if (bundleEncoder)
+//   {
+//     // Cache miss: issue the commands of the block to bundleEncoder.
+//   }
+//   wgpu_render_bundle_cache_end(passEncoder, key, bundleEncoder);
+//
+// A cached bundle is evicted from the cache when any pipeline, bind group or buffer that its commands reference is destroyed with
+// wgpu_object_destroy(), so that the next wgpu_render_bundle_cache_begin() call with its key records the block again. Changes to
+// anything else that the commands depend on (e.g. the number of draws, or which objects they use) must be signaled by calling
+// wgpu_render_bundle_cache_invalidate(), or by using a different key.
+
+// If a bundle for the given key is in the cache, returns 0. Otherwise creates a render bundle encoder with the given descriptor,
+// and returns it for recording the commands of the block into.
+WGpuRenderBundleEncoder wgpu_render_bundle_cache_begin(WGpuDevice device, uint32_t key, const WGpuRenderBundleEncoderDescriptor *renderBundleEncoderDesc NOTNULL);
+
+// Executes the bundle of the given key in the given render pass. bundleEncoder is the return value of the matching
+// wgpu_render_bundle_cache_begin() call: if it is nonzero, the bundle is first finished from it and stored in the cache, and the
+// encoder is destroyed.
+void wgpu_render_bundle_cache_end(WGpuRenderPassEncoder passEncoder, uint32_t key, WGpuRenderBundleEncoder bundleEncoder);
+
+// Destroys the bundle of the given key, if it is in the cache, so that it is recorded again.
+void wgpu_render_bundle_cache_invalidate(uint32_t key);
+
+// Destroys all bundles in the render bundle cache, and empties the cache. Does not reset the statistics.
+void wgpu_render_bundle_cache_clear(void);
+
+typedef struct WGpuRenderBundleCacheStats
+{
+  uint32_t numBundles; // Number of bundles currently in the cache.
+  uint32_t numHits;    // Number of wgpu_render_bundle_cache_begin() calls that found the bundle in the cache.
+  uint32_t numMisses;  // Number of wgpu_render_bundle_cache_begin() calls that returned an encoder to record the bundle with.
+} WGpuRenderBundleCacheStats;
+VERIFY_STRUCT_SIZE(WGpuRenderBundleCacheStats, 3*sizeof(uint32_t));
+
+void wgpu_get_render_bundle_cache_stats(WGpuRenderBundleCacheStats *stats NOTNULL);
+
+// Render pass templates: a render pass template holds a render pass descriptor that is converted to the form that the browser
+// (or Dawn) consumes only once, at template creation time. Render passes can then be begun from the template without marshalling
+// the whole descriptor again, and without allocating new JS objects for it. The template does not hold on to the given descriptor
+// memory. Attachment views in the template are stored as handles, and resolved again each time a render pass is begun. Use a
+// WGpuRenderPassPatch to change e.g. the view of wgpu_canvas_context_get_current_texture_view() each frame. Destroy a template with
+// wgpu_object_destroy().
+typedef WGpuObjectBase WGpuRenderPassTemplate;
+#define WGPU_MAX_COLOR_ATTACHMENTS 8
+
+WGpuRenderPassTemplate wgpu_render_pass_template_create(const WGpuRenderPassDescriptor *renderPassDesc NOTNULL);
+
+// A set of changes to apply to a render pass template when beginning a render pass from it. Zero-initialized fields leave the
+// corresponding template fields unchanged. Changes to clear values persist in the template for subsequent render passes.
+typedef struct _WGPU_ALIGN_TO_64BITS WGpuRenderPassPatch
+{
+  WGpuObjectBase colorAttachmentViews[WGPU_MAX_COLOR_ATTACHMENTS]; // If nonzero, replaces the view of the color attachment at that index.
+  WGpuObjectBase resolveTargets[WGPU_MAX_COLOR_ATTACHMENTS];       // If nonzero, replaces the resolve target of the color attachment at that index.
+  WGpuObjectBase depthStencilView; // If nonzero, replaces the view of the depth-stencil attachment.
+  uint32_t clearValueMask; // If bit i is set, clearValues[i] replaces the clear value of the color attachment at index i.
+  WGpuColor clearValues[WGPU_MAX_COLOR_ATTACHMENTS];
+} WGpuRenderPassPatch;
+VERIFY_STRUCT_SIZE(WGpuRenderPassPatch, 82*sizeof(uint32_t));
+
+// Begins a render pass from the given template, after applying the given patch to it. patch may be null to begin the render
+// pass as the template was last left. Sparse color attachments in the template (view == 0) stay sparse.
+WGpuRenderPassEncoder wgpu_command_encoder_begin_render_pass_from_template(WGpuCommandEncoder commandEncoder, WGpuRenderPassTemplate renderPassTemplate, const WGpuRenderPassPatch *patch);
+
+// Descriptor blobs: a pointer-free serialization of render pipeline, bind group layout and render pass descriptors. A blob is a
+// single contiguous block of little-endian 32-bit words that starts with a WGpuDescriptorBlobHeader: nested arrays and strings
+// are stored inline, so a blob can be memcpy'd, hashed, written to disk, or baked offline by an asset build, and is read back
+// with one linear pass. Objects (shader modules, layouts, texture views, query sets) are stored as indices to an object table
+// that the application passes in both when serializing and when creating objects from the blob. The special handle values 0
+// (null) and 1 (WGPU_AUTO_LAYOUT_MODE_AUTO, or the canvas texture in a render pass) are stored as is.
+#define WGPU_DESCRIPTOR_BLOB_MAGIC   0x42444757 // "WGDB"
+#define WGPU_DESCRIPTOR_BLOB_VERSION 1
+
+typedef int WGPU_DESCRIPTOR_BLOB_TYPE;
+#define WGPU_DESCRIPTOR_BLOB_TYPE_INVALID           0
+#define WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PIPELINE   1 // Serializes a WGpuRenderPipelineDescriptor.
+#define WGPU_DESCRIPTOR_BLOB_TYPE_BIND_GROUP_LAYOUT 2 // Serializes an array of WGpuBindGroupLayoutEntry.
+#define WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PASS       3 // Serializes a WGpuRenderPassDescriptor.
+
+typedef struct WGpuDescriptorBlobHeader
+{
+  uint32_t magic; // WGPU_DESCRIPTOR_BLOB_MAGIC
+  uint32_t version; // WGPU_DESCRIPTOR_BLOB_VERSION. Blobs of other versions are rejected.
+  WGPU_DESCRIPTOR_BLOB_TYPE type;
+  uint32_t size; // Size of the whole blob in bytes, including this header.
+} WGpuDescriptorBlobHeader;
+VERIFY_STRUCT_SIZE(WGpuDescriptorBlobHeader, 4*sizeof(uint32_t));
+
+// Serializes the given descriptor to a blob at dst. descriptor points to a struct of the given type. For
+// WGPU_DESCRIPTOR_BLOB_TYPE_BIND_GROUP_LAYOUT, descriptor points to an array of numEntries WGpuBindGroupLayoutEntry structs,
+// for other types numEntries must be 1. Each object referenced by the descriptor must be present in the objects array.
+// Returns the size of the blob in bytes. The blob is written only if dstSize is large enough, so call this function with
+// dst == 0 to query the needed size. dst must be 4-byte aligned. Returns 0 if the descriptor references an object
+// that is not present in the objects array.
+uint32_t wgpu_descriptor_blob_serialize(WGPU_DESCRIPTOR_BLOB_TYPE type, const void *descriptor NOTNULL, int numEntries, const WGpuObjectBase *objects, int numObjects, void *dst, uint32_t dstSize);
+
+// Creates an object from a blob that was produced by wgpu_descriptor_blob_serialize(), with the objects array containing the
+// objects that the blob references, in the same order as when the blob was serialized. blob must be 4-byte aligned, and
+// blobSize is the number of bytes available at blob: nothing past it is read, even if the blob header claims a larger size.
+// Returns 0 if the blob is of the wrong type or version, or is malformed.
+WGpuRenderPipeline wgpu_device_create_render_pipeline_from_blob(WGpuDevice device, const void *blob NOTNULL, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects);
+WGpuBindGroupLayout wgpu_device_create_bind_group_layout_from_blob(WGpuDevice device, const void *blob NOTNULL, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects);
+WGpuRenderPassTemplate wgpu_render_pass_template_create_from_blob(const void *blob NOTNULL, uint32_t blobSize, const WGpuObjectBase *objects, int numObjects);
+
+// Command recording: in scenes with many draws, the Wasm->JS call made for each render command can dominate the CPU time of a
+// frame. The wgpu_record_*() functions below append the command to a command stream in Wasm memory instead, and the recorded
+// commands are replayed in a single JS call when wgpu_render_pass_flush_commands() is called. The command stream holds the
+// commands of one encoder at a time: recording a command for another encoder, or filling the stream, flushes the stream first.
+// Commands that do not have a wgpu_record_*() variant must not be issued directly on an encoder that has unflushed commands, since
+// they would then execute out of order. Call wgpu_render_pass_flush_commands() before those, and before ending the pass.
+// The stream holds object handles that are resolved only when the commands are replayed, so the encoder and the objects that the
+// recorded commands reference must not be destroyed before the commands are flushed: otherwise the commands would be replayed on
+// whatever objects reuse their handles. Call wgpu_flush_recorded_commands() before destroying them. Each thread has its own
+// command stream, since object handles are only valid on the thread that created them.
+//
+// To record all render commands of an application without changing its code, build the application and lib_webgpu.cpp with
+// WGPU_RECORD_RENDER_COMMANDS defined. This redirects the recordable commands to their wgpu_record_*() variants, and makes all
+// other pass and render bundle encoder commands, as well as wgpu_object_destroy(), wgpu_object_destroy_many() and
+// wgpu_transient_scope_end(), flush the stream first. Recording is not useful with the Dawn backend, where
+// commands do not cross a language boundary: there the wgpu_record_*() functions execute their commands immediately, and
+// WGPU_RECORD_RENDER_COMMANDS has no effect.
+void wgpu_record_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline);
+void wgpu_record_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t index, WGpuBindGroup bindGroup, const uint32_t *dynamicOffsets _WGPU_DEFAULT_VALUE(0), uint32_t numDynamicOffsets _WGPU_DEFAULT_VALUE(0));
+void wgpu_record_set_index_buffer(WGpuRenderCommandsMixin encoder, WGpuBuffer buffer, WGPU_INDEX_FORMAT indexFormat, double_int53_t offset _WGPU_DEFAULT_VALUE(0), double_int53_t size _WGPU_DEFAULT_VALUE(WGPU_MAX_SIZE));
+void wgpu_record_set_vertex_buffer(WGpuRenderCommandsMixin encoder, int32_t slot, WGpuBuffer buffer, double_int53_t offset _WGPU_DEFAULT_VALUE(0), double_int53_t size _WGPU_DEFAULT_VALUE(WGPU_MAX_SIZE));
+void wgpu_record_draw(WGpuRenderCommandsMixin encoder, uint32_t vertexCount, uint32_t instanceCount _WGPU_DEFAULT_VALUE(1), uint32_t firstVertex _WGPU_DEFAULT_VALUE(0), uint32_t firstInstance _WGPU_DEFAULT_VALUE(0));
+void wgpu_record_draw_indexed(WGpuRenderCommandsMixin encoder, uint32_t indexCount, uint32_t instanceCount _WGPU_DEFAULT_VALUE(1), uint32_t firstIndex _WGPU_DEFAULT_VALUE(0), int32_t baseVertex _WGPU_DEFAULT_VALUE(0), uint32_t firstInstance _WGPU_DEFAULT_VALUE(0));
+void wgpu_record_set_viewport(WGpuRenderPassEncoder encoder, float x, float y, float width, float height, float minDepth, float maxDepth);
+void wgpu_record_set_scissor_rect(WGpuRenderPassEncoder encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+void wgpu_record_set_stencil_reference(WGpuRenderPassEncoder encoder, uint32_t stencilValue);
+
+// Replays the commands recorded for the given encoder. A no-op if the command stream does not hold commands of this encoder.
+// Despite the name, this applies to compute pass and render bundle encoders as well.
+void wgpu_render_pass_flush_commands(WGpuBindingCommandsMixin encoder);
+// Replays the commands in the command stream of the calling thread, whichever encoder they were recorded for.
+void wgpu_flush_recorded_commands(void);
+
+// The command stream format. Each command is a sequence of 32-bit words, the first of which holds the command opcode in its low
+// 8 bits, and a small command specific immediate value in its high 24 bits. 64-bit offsets and sizes are stored as low and high
+// words, with WGPU_MAX_SIZE stored as all ones.
+typedef int WGPU_RECORDED_COMMAND;
+#define WGPU_RECORDED_COMMAND_SET_PIPELINE          1 // [op, pipeline]
+#define WGPU_RECORDED_COMMAND_SET_BIND_GROUP        2 // [op | numDynamicOffsets<<8, index, bindGroup, dynamicOffsets...]
+#define WGPU_RECORDED_COMMAND_SET_INDEX_BUFFER      3 // [op | indexFormat<<8, buffer, offsetLo, offsetHi, sizeLo, sizeHi]
+#define WGPU_RECORDED_COMMAND_SET_VERTEX_BUFFER     4 // [op | slot<<8, buffer, offsetLo, offsetHi, sizeLo, sizeHi]
+#define WGPU_RECORDED_COMMAND_DRAW                  5 // [op, vertexCount, instanceCount, firstVertex, firstInstance]
+#define WGPU_RECORDED_COMMAND_DRAW_INDEXED          6 // [op, indexCount, instanceCount, firstIndex, baseVertex, firstInstance]
+#define WGPU_RECORDED_COMMAND_SET_VIEWPORT          7 // [op, x, y, width, height, minDepth, maxDepth] (as floats)
+#define WGPU_RECORDED_COMMAND_SET_SCISSOR_RECT      8 // [op, x, y, width, height]
+#define WGPU_RECORDED_COMMAND_SET_STENCIL_REFERENCE 9 // [op, stencilValue]
+
+#ifdef __EMSCRIPTEN__
+// Executes the given command stream of numWords words on the given encoder. This is what wgpu_render_pass_flush_commands() calls,
+// but it can also be used to replay a command stream that the application has built itself, e.g. once per frame.
+void wgpu_encoder_replay_commands(WGpuBindingCommandsMixin encoder, const uint32_t *commands NOTNULL, uint32_t numWords);
+#endif
+
+// Redundant state filtering: the wgpu_filter_*() functions below keep a shadow copy of the state that has been set on an encoder,
+// and drop calls that would set the same pipeline, bind group (with the same dynamic offsets), vertex or index buffer, viewport,
+// scissor rect or blend constant that is already set, before they reach the WebGPU API. The shadow state tracks a single encoder
+// per thread at a time: calling a filtered function on another encoder starts tracking that encoder from an unknown state, so
+// filtering works best when each pass is recorded without interleaving commands to other encoders.
+//
+// To filter the state changes of an application without changing its code, build the application and lib_webgpu.cpp with
+// WGPU_FILTER_REDUNDANT_STATE defined. This redirects the state setting functions to their wgpu_filter_*() variants, and makes
+// wgpu_encoder_end(), wgpu_encoder_finish(), wgpu_render_pass_encoder_execute_bundles(), wgpu_render_commands_mixin_draw_batch(),
+// wgpu_render_bundle_cache_end(), wgpu_object_destroy(), wgpu_object_destroy_many() and wgpu_transient_scope_end() update the
+// shadow state. This can be combined with WGPU_RECORD_RENDER_COMMANDS, in which case
+// the calls that pass the filter are recorded.
+// State that is set on the encoder in other ways (e.g. by calling the wgpu_record_*() functions directly) is not seen by the
+// filter, so the two should not be mixed on the same encoder.
+// N.b. objects are compared by their handles, so an object that is bound on an encoder must not be destroyed and its handle
+// reused for another object while the encoder is being recorded.
+void wgpu_filter_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline);
+void wgpu_filter_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t index, WGpuBindGroup bindGroup, const uint32_t *dynamicOffsets _WGPU_DEFAULT_VALUE(0), uint32_t numDynamicOffsets _WGPU_DEFAULT_VALUE(0));
+void wgpu_filter_set_index_buffer(WGpuRenderCommandsMixin encoder, WGpuBuffer buffer, WGPU_INDEX_FORMAT indexFormat, double_int53_t offset _WGPU_DEFAULT_VALUE(0), double_int53_t size _WGPU_DEFAULT_VALUE(WGPU_MAX_SIZE));
+void wgpu_filter_set_vertex_buffer(WGpuRenderCommandsMixin encoder, int32_t slot, WGpuBuffer buffer, double_int53_t offset _WGPU_DEFAULT_VALUE(0), double_int53_t size _WGPU_DEFAULT_VALUE(WGPU_MAX_SIZE));
+void wgpu_filter_set_viewport(WGpuRenderPassEncoder encoder, float x, float y, float width, float height, float minDepth, float maxDepth);
+void wgpu_filter_set_scissor_rect(WGpuRenderPassEncoder encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+void wgpu_filter_set_blend_constant(WGpuRenderPassEncoder encoder, double r, double g, double b, double a);
+// These perform the given command, and update the shadow state of the encoder accordingly.
+void wgpu_filter_encoder_end(WGpuBindingCommandsMixin encoder);
+WGpuObjectBase wgpu_filter_encoder_finish(WGpuObjectBase commandOrRenderBundleEncoder);
+void wgpu_filter_object_destroy(WGpuObjectBase wgpuObject);
+void wgpu_filter_object_destroy_many(const WGpuObjectBase *wgpuObjects, int numObjects);
+void wgpu_filter_transient_scope_end(void);
+void wgpu_filter_execute_bundles(WGpuRenderPassEncoder encoder, const WGpuRenderBundle *bundles, int numBundles);
+void wgpu_filter_draw_batch(WGpuRenderCommandsMixin encoder, const WGpuDrawBatchItem *items NOTNULL, int numItems);
+void wgpu_filter_render_bundle_cache_end(WGpuRenderPassEncoder passEncoder, uint32_t key, WGpuRenderBundleEncoder bundleEncoder);
+
+// Returns the total number of state changes that the wgpu_filter_*() functions have dropped as redundant.
+uint32_t wgpu_get_num_elided_state_changes(void);
+
 // This function is available when building with JSPI enabled. It performs three things:
 // 1) presents all canvases that have been rendered to from the current scope of execution.
 // 2) yields back to browser's event loop with JSPI, so processes all pending browser events (keyboard, mouse, etc.)
@@ -3355,6 +3865,71 @@ void offscreen_canvas_set_size(OffscreenCanvasId id, int width, int height);
 
 #endif
 
+#if defined(__EMSCRIPTEN__) && defined(WGPU_RECORD_RENDER_COMMANDS)
+// See wgpu_render_pass_flush_commands() above. The commands that are not recorded flush the recorded commands of their encoder first.
+static inline WGpuObjectBase _wgpu_flush_commands(WGpuObjectBase encoder) { wgpu_render_pass_flush_commands(encoder); return encoder; }
+
+#define wgpu_render_commands_mixin_draw wgpu_record_draw
+#define wgpu_render_commands_mixin_draw_indexed wgpu_record_draw_indexed
+#define wgpu_render_pass_encoder_set_stencil_reference wgpu_record_set_stencil_reference
+
+#define wgpu_encoder_push_debug_group(encoder, ...) wgpu_encoder_push_debug_group(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_encoder_pop_debug_group(encoder) wgpu_encoder_pop_debug_group(_wgpu_flush_commands(encoder))
+#define wgpu_encoder_insert_debug_marker(encoder, ...) wgpu_encoder_insert_debug_marker(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_encoder_set_immediates(encoder, ...) wgpu_encoder_set_immediates(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_compute_pass_encoder_dispatch_workgroups(encoder, ...) wgpu_compute_pass_encoder_dispatch_workgroups(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_compute_pass_encoder_dispatch_workgroups_indirect(encoder, ...) wgpu_compute_pass_encoder_dispatch_workgroups_indirect(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_commands_mixin_draw_indirect(encoder, ...) wgpu_render_commands_mixin_draw_indirect(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_commands_mixin_draw_indexed_indirect(encoder, ...) wgpu_render_commands_mixin_draw_indexed_indirect(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_commands_mixin_multi_draw_indirect(encoder, ...) wgpu_render_commands_mixin_multi_draw_indirect(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_commands_mixin_multi_draw_indexed_indirect(encoder, ...) wgpu_render_commands_mixin_multi_draw_indexed_indirect(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_multi_draw_indirect_count(encoder, ...) wgpu_render_pass_encoder_multi_draw_indirect_count(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_multi_draw_indexed_indirect_count(encoder, ...) wgpu_render_pass_encoder_multi_draw_indexed_indirect_count(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_begin_occlusion_query(encoder, ...) wgpu_render_pass_encoder_begin_occlusion_query(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_end_occlusion_query(encoder) wgpu_render_pass_encoder_end_occlusion_query(_wgpu_flush_commands(encoder))
+
+#ifndef WGPU_FILTER_REDUNDANT_STATE // When filtering, the wgpu_filter_*() functions record or flush instead.
+#define wgpu_encoder_set_pipeline wgpu_record_set_pipeline
+#define wgpu_encoder_set_bind_group wgpu_record_set_bind_group
+#define wgpu_render_commands_mixin_set_index_buffer wgpu_record_set_index_buffer
+#define wgpu_render_commands_mixin_set_vertex_buffer wgpu_record_set_vertex_buffer
+#define wgpu_render_pass_encoder_set_viewport wgpu_record_set_viewport
+#define wgpu_render_pass_encoder_set_scissor_rect wgpu_record_set_scissor_rect
+
+#define wgpu_encoder_end(encoder) wgpu_encoder_end(_wgpu_flush_commands(encoder))
+#define wgpu_encoder_finish(encoder) wgpu_encoder_finish(_wgpu_flush_commands(encoder))
+#define wgpu_render_commands_mixin_draw_batch(encoder, ...) wgpu_render_commands_mixin_draw_batch(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_set_blend_constant(encoder, ...) wgpu_render_pass_encoder_set_blend_constant(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_pass_encoder_execute_bundles(encoder, ...) wgpu_render_pass_encoder_execute_bundles(_wgpu_flush_commands(encoder), __VA_ARGS__)
+#define wgpu_render_bundle_cache_end(passEncoder, key, bundleEncoder) wgpu_render_bundle_cache_end(_wgpu_flush_commands(passEncoder), key, _wgpu_flush_commands(bundleEncoder))
+// Destroying an object may release the encoder or an object that the recorded commands reference, so these flush the
+// recorded commands of any encoder first.
+#define wgpu_object_destroy(wgpuObject) wgpu_object_destroy((wgpu_flush_recorded_commands(), (wgpuObject)))
+#define wgpu_object_destroy_many(wgpuObjects, numObjects) wgpu_object_destroy_many((wgpu_flush_recorded_commands(), (wgpuObjects)), numObjects)
+#define wgpu_transient_scope_end() (wgpu_flush_recorded_commands(), wgpu_transient_scope_end())
+#endif
+#endif
+
+#ifdef WGPU_FILTER_REDUNDANT_STATE
+// See wgpu_filter_set_pipeline() above. These are function-like macros, so that lib_webgpu.cpp can call the unfiltered functions
+// by parenthesizing their names.
+#define wgpu_encoder_set_pipeline(...) wgpu_filter_set_pipeline(__VA_ARGS__)
+#define wgpu_encoder_set_bind_group(...) wgpu_filter_set_bind_group(__VA_ARGS__)
+#define wgpu_render_commands_mixin_set_index_buffer(...) wgpu_filter_set_index_buffer(__VA_ARGS__)
+#define wgpu_render_commands_mixin_set_vertex_buffer(...) wgpu_filter_set_vertex_buffer(__VA_ARGS__)
+#define wgpu_render_pass_encoder_set_viewport(...) wgpu_filter_set_viewport(__VA_ARGS__)
+#define wgpu_render_pass_encoder_set_scissor_rect(...) wgpu_filter_set_scissor_rect(__VA_ARGS__)
+#define wgpu_render_pass_encoder_set_blend_constant(...) wgpu_filter_set_blend_constant(__VA_ARGS__)
+#define wgpu_encoder_end(...) wgpu_filter_encoder_end(__VA_ARGS__)
+#define wgpu_encoder_finish(...) wgpu_filter_encoder_finish(__VA_ARGS__)
+#define wgpu_object_destroy(...) wgpu_filter_object_destroy(__VA_ARGS__)
+#define wgpu_object_destroy_many(...) wgpu_filter_object_destroy_many(__VA_ARGS__)
+#define wgpu_transient_scope_end(...) wgpu_filter_transient_scope_end(__VA_ARGS__)
+#define wgpu_render_pass_encoder_execute_bundles(...) wgpu_filter_execute_bundles(__VA_ARGS__)
+#define wgpu_render_commands_mixin_draw_batch(...) wgpu_filter_draw_batch(__VA_ARGS__)
+#define wgpu_render_bundle_cache_end(...) wgpu_filter_render_bundle_cache_end(__VA_ARGS__)
+#endif
+
 #ifdef __cplusplus
 } // ~extern "C"
 #endif
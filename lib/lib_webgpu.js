@@ -104,6 +104,37 @@
     if (Number.isInteger(n) && isFinite(n)) return `${x}n`;
     return `BigInt(${x})`;
   }
+  // Returns the index to the wgpu table that the given object ID refers to.
+  globalThis.wgpuSlot = function(id) {
+    return parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES) ? `(${id} & 0xFFFFF)` : id;
+  }
+  // Returns an expression that reads the object with the given ID from the wgpu table. With WEBGPU_GENERATIONAL_HANDLES,
+  // this validates the generation of the ID, so that stale IDs read back as undefined, the same way that IDs of destroyed
+  // objects do. (and trip the same assertions) Writes to the table should index it with wgpuSlot() instead.
+  globalThis.wgpuObject = function(id) {
+    return parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES) ? `wgpuGet(${id})` : `wgpu[${id}]`;
+  }
+  // Names of the WebGPU interfaces, in the order of WGPU_OBJECT_TYPE.
+  globalThis.wgpuObjectTypeNames = ['', 'GPUAdapter', 'GPUDevice', 'GPUBindGroupLayout', 'GPUBuffer', 'GPUTexture', 'GPUTextureView', 'GPUExternalTexture', 'GPUSampler', 'GPUBindGroup', 'GPUPipelineLayout', 'GPUShaderModule', 'GPUComputePipeline', 'GPURenderPipeline', 'GPUCommandBuffer', 'GPUCommandEncoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundle', 'GPURenderBundleEncoder', 'GPUQueue', 'GPUQuerySet', 'GPUCanvasContext'];
+  // Returns an expression that tests if the object with the given ID is of any of the given WebGPU interface
+  // types, by reading the type tag of the object from the wgpuTypes table. Does not validate the generation
+  // of the ID, so with WEBGPU_GENERATIONAL_HANDLES, test that the object exists first.
+  globalThis.wgpuIsType = function(id, ...typeNames) {
+    var types = typeNames.map(name => {
+      var type = wgpuObjectTypeNames.indexOf(name);
+      if (type <= 0) throw new Error(`Unknown WebGPU object type ${name}!`);
+      return type;
+    });
+    var tag = `wgpuTypes[${wgpuSlot(id)}]`;
+    if (types.length == 1) return `${tag} == ${types[0]}`;
+    return `(1 << ${tag} & ${types.reduce((mask, type) => mask | 1 << type, 0)})`;
+  }
+  // Like wgpuIsType(), but returns a boolean, and also validates the generation of the ID with
+  // WEBGPU_GENERATIONAL_HANDLES. Used to implement the wgpu_is_*() functions.
+  globalThis.wgpuIsTypeChecked = function(id, ...typeNames) {
+    if (parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)) return `!!(${wgpuIsType(id, ...typeNames)} && ${wgpuObject(id)})`;
+    return typeNames.length == 1 ? wgpuIsType(id, ...typeNames) : `!!${wgpuIsType(id, ...typeNames)}`;
+  }
   globalThis.wasm4GbShift = function(ptr) {
     if (CAN_ADDRESS_2GB) return `${ptr} >>> 0`;
     else return ptr;
@@ -111,8 +142,49 @@
   null;
 }}}
 
+// GENERATED STRUCT LAYOUTS BEGIN: do not edit by hand, run 'node scripts/generate_tables.js' instead.
+{{{
+  // Sizes and field offsets of WebGPU structs, in 32-bit words.
+  globalThis.wgpuStructs = {
+    WGpuSupportedLimits: { sizeof: 40, maxUniformBufferBindingSize: 0, maxStorageBufferBindingSize: 2, maxBufferSize: 4, maxTextureDimension1D: 6, maxTextureDimension2D: 7, maxTextureDimension3D: 8, maxTextureArrayLayers: 9, maxBindGroups: 10, maxBindGroupsPlusVertexBuffers: 11, maxImmediateSize: 12, maxBindingsPerBindGroup: 13, maxDynamicUniformBuffersPerPipelineLayout: 14, maxDynamicStorageBuffersPerPipelineLayout: 15, maxSampledTexturesPerShaderStage: 16, maxSamplersPerShaderStage: 17, maxStorageBuffersPerShaderStage: 18, maxStorageBuffersInVertexStage: 19, maxStorageBuffersInFragmentStage: 20, maxStorageTexturesPerShaderStage: 21, maxStorageTexturesInVertexStage: 22, maxStorageTexturesInFragmentStage: 23, maxUniformBuffersPerShaderStage: 24, minUniformBufferOffsetAlignment: 25, minStorageBufferOffsetAlignment: 26, maxVertexBuffers: 27, maxVertexAttributes: 28, maxVertexBufferArrayStride: 29, maxInterStageShaderVariables: 30, maxColorAttachments: 31, maxColorAttachmentBytesPerSample: 32, maxComputeWorkgroupStorageSize: 33, maxComputeInvocationsPerWorkgroup: 34, maxComputeWorkgroupSizeX: 35, maxComputeWorkgroupSizeY: 36, maxComputeWorkgroupSizeZ: 37, maxComputeWorkgroupsPerDimension: 38, padding: 39 },
+    WGpuQueueDescriptor: { sizeof: 2, label: 0 },
+    WGpuPipelineError: { sizeof: 6, name: 0, message: 2, reason: 4 },
+    WGpuCompilationMessage: { sizeof: 8, message: 0, type: 2, lineNum: 3, linePos: 4, offset: 5, length: 6 },
+    WGpuCompilationInfo: { sizeof: 2, numMessages: 0, messages: 2 },
+    WGpuPrimitiveState: { sizeof: 5, topology: 0, stripIndexFormat: 1, frontFace: 2, cullMode: 3, unclippedDepth: 4 },
+    WGpuMultisampleState: { sizeof: 3, count: 0, mask: 1, alphaToCoverageEnabled: 2 },
+    WGpuFragmentState: { sizeof: 10, entryPoint: 0, targets: 2, constants: 4, module: 6, numTargets: 7, numConstants: 8 },
+    WGpuStencilFaceState: { sizeof: 4, compare: 0, failOp: 1, depthFailOp: 2, passOp: 3 },
+    WGpuVertexState: { sizeof: 10, entryPoint: 0, buffers: 2, constants: 4, module: 6, numBuffers: 7, numConstants: 8 },
+    WGpuVertexBufferLayout: { sizeof: 6, attributes: 0, numAttributes: 2, stepMode: 3, arrayStride: 4 },
+    WGpuComputePassTimestampWrites: { sizeof: 3, querySet: 0, beginningOfPassWriteIndex: 1, endOfPassWriteIndex: 2 },
+    WGpuDrawBatchBindGroup: { sizeof: 6, bindGroup: 0, numDynamicOffsets: 1, dynamicOffsets: 2 },
+    WGpuDrawBatchBufferBinding: { sizeof: 6, buffer: 0, offset: 2, size: 4 },
+    WGpuDrawBatchItem: { sizeof: 64, pipeline: 0, indexFormat: 1, bindGroups: 2, indexBuffer: 26, vertexBuffers: 32, vertexCount: 56, indexCount: 57, instanceCount: 58, firstVertex: 59, firstIndex: 60, baseVertex: 61, firstInstance: 62 },
+    WGpuRenderPassDepthStencilAttachment: { sizeof: 9, view: 0, depthLoadOp: 1, depthClearValue: 2, depthStoreOp: 3, depthReadOnly: 4, stencilLoadOp: 5, stencilClearValue: 6, stencilStoreOp: 7, stencilReadOnly: 8 },
+    WGpuRenderBundleEncoderDescriptor: { sizeof: 8, colorFormats: 0, numColorFormats: 2, depthStencilFormat: 3, sampleCount: 4, depthReadOnly: 5, stencilReadOnly: 6 },
+    WGpuCanvasConfiguration: { sizeof: 10, device: 0, format: 1, usage: 2, numViewFormats: 3, viewFormats: 4, colorSpace: 6, toneMapping: 7, alphaMode: 8 },
+    WGpuRenderPassColorAttachment: { sizeof: 14, view: 0, depthSlice: 1, resolveTarget: 2, storeOp: 3, loadOp: 4, clearValue: 6 },
+    WGpuDepthStencilState: { sizeof: 17, format: 0, depthWriteEnabled: 1, depthCompare: 2, stencilReadMask: 3, stencilWriteMask: 4, depthBias: 5, depthBiasSlopeScale: 6, depthBiasClamp: 7, stencilFront: 8, stencilBack: 12, clampDepth: 16 },
+    WGpuLiveObjectStats: { sizeof: 72, numLiveObjects: 0, numCreatedObjects: 24, numDestroyedObjects: 48 },
+    WGpuPipelineCacheStats: { sizeof: 3, numPipelines: 0, numHits: 1, numMisses: 2 },
+    WGpuRenderPipelineDelta: { sizeof: 24, fields: 0, topology: 1, stripIndexFormat: 2, frontFace: 3, cullMode: 4, depthCompare: 5, depthWriteEnabled: 6, depthBias: 7, depthBiasSlopeScale: 8, depthBiasClamp: 9, blend: 10, writeMask: 16, numVertexConstants: 17, numFragmentConstants: 18, retainDescriptor: 19, vertexConstants: 20, fragmentConstants: 22 },
+    WGpuBindGroupCacheStats: { sizeof: 4, numBindGroups: 0, numHits: 1, numMisses: 2, numEvictions: 3 },
+    WGpuRenderBundleCacheStats: { sizeof: 3, numBundles: 0, numHits: 1, numMisses: 2 },
+    WGpuRenderPassPatch: { sizeof: 82, colorAttachmentViews: 0, resolveTargets: 8, depthStencilView: 16, clearValueMask: 17, clearValues: 18 },
+    WGpuDescriptorBlobHeader: { sizeof: 4, magic: 0, version: 1, type: 2, size: 3 },
+    WGpuBlendComponent: { sizeof: 3, operation: 0, srcFactor: 1, dstFactor: 2 },
+    WGpuBlendState: { sizeof: 6, color: 0, alpha: 3 },
+    WGpuColorTargetState: { sizeof: 8, format: 0, blend: 1, writeMask: 7 },
+    WGpuVertexAttribute: { sizeof: 4, offset: 0, shaderLocation: 2, format: 3 },
+    WGpuRenderPipelineDescriptor: { sizeof: 48, vertex: 0, primitive: 10, depthStencil: 15, multisample: 32, fragment: 36, layout: 46, retainDescriptor: 47 },
+  };
+  null;
+}}}
+// GENERATED STRUCT LAYOUTS END
+
 let api = {
-  $wgpu__deps: ['$utf8'
+  $wgpu__deps: ['$utf8', '$utf8Cached'
 #if (ASSERTIONS || parseInt(globalThis.WEBGPU_DEBUG))
   , '$wgpu_checked_shift'
 #endif
@@ -123,42 +195,180 @@ let api = {
 #endif
 
   // Stores a ID->WebGPU object mapping registry of global top-level WebGPU objects.
-  $wgpu: {},
+  // This is a dense array indexed by object ID. Freed slots are overwritten with
+  // undefined instead of being deleted, so that JS engines keep the table in fast
+  // elements mode regardless of how many objects have been created and destroyed.
+  // ID 0: reserved for invalid object (i.e. undefined) for e.g. wgpu_encoder_set_bind_group() purposes,
+  // ID 1: reserved for a special GPUTexture that GPUCanvasContext.getCurrentTexture() returns.
+  // [2, wgpu.length-1]: valid WebGPU IDs
+  $wgpu: [],
+
+  // Stack of IDs in range [2, wgpu.length-1] that are not currently in use.
+  $wgpuFreeIds: [],
 
   // Stores ID->OffscreenCanvas objects that are owned by the current thread.
   $wgpuOffscreenCanvases: {},
 
-  // Free ID counter generation number
-  // 0: reserved for invalid object (i.e. undefined) for e.g. wgpu_encoder_set_bind_group() purposes,
-  // 1: reserved for a special GPUTexture that GPUCanvasContext.getCurrentTexture() returns.
-  // [2, 2147483647]: valid WebGPU IDs
-  $wgpuIdCounter: 2,
+  // If nonzero, a transient scope is active, and all IDs in range [wgpuTransientScopeStart, wgpu.length-1]
+  // were bump allocated inside that scope. These IDs are not placed on the free list when their objects are
+  // destroyed, but instead the whole range is released at once in wgpu_transient_scope_end().
+  $wgpuTransientScopeStart: 0,
+  // Number of objects in the active transient scope that have already been destroyed.
+  $wgpuNumTransientIdsFreed: 0,
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  // The generation bits that IDs in the active transient scope are tagged with. Each transient
+  // scope reuses the same slots, so this is bumped each scope to make old transient IDs stale.
+  $wgpuTransientScopeGeneration: 0,
+#endif
+
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  // If building with -jsDWEBGPU_GENERATIONAL_HANDLES=1, object IDs are generational handles:
+  // the low 20 bits of an ID hold the slot index in the wgpu table, and the next 11 bits hold
+  // a generation counter that is bumped each time the slot is recycled. This way a stale ID
+  // to a destroyed object does not alias the new object that reuses its slot. At most 2^20-2
+  // objects can be alive at the same time, and the generation of a slot wraps around after
+  // it has been reused 2048 times.
+  // Returns the object that the given handle refers to, or undefined if the handle is stale.
+  $wgpuGet__deps: ['$wgpu'],
+  $wgpuGet: function(id) {
+    var o = wgpu[id & 0xFFFFF];
+    // Each live object stores its full handle in its .wid field, so a single compare
+    // validates the generation of the handle.
+    if (o?.wid === id) return o;
+  },
+#endif
+
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  // If building with -jsDWEBGPU_OBJECT_INTERNING=1, samplers, bind group layouts and pipeline layouts are interned: creating
+  // one with a descriptor that is identical to that of an existing object returns the existing object, and increments its
+  // reference count. wgpu_object_destroy() then decrements the reference count, and destroys the object only when the last
+  // reference is released. Objects created inside a transient scope are not interned.
+  // Maps a key built from the device and the raw descriptor contents to the interned object.
+  $wgpuInternedObjects: '=new Map()',
+
+  // Returns the ID of the interned object with the given key, after adding a reference to it, or undefined if there is none.
+  $wgpuInternLookup__deps: ['$wgpuInternedObjects', '$wgpuTransientScopeStart'],
+  $wgpuInternLookup: function(key) {
+    let o = !wgpuTransientScopeStart && wgpuInternedObjects.get(key);
+    if (o) {
+      ++o.internRefs;
+      return o.wid;
+    }
+  },
+
+  // Interns the newly created object with the given ID under the given key. Returns the ID.
+  $wgpuIntern__deps: ['$wgpu', '$wgpuInternedObjects', '$wgpuTransientScopeStart'],
+  $wgpuIntern: function(key, id) {
+    let o = {{{ wgpuObject('id') }}};
+    if (o && !wgpuTransientScopeStart) {
+      o.internRefs = 1;
+      // Called when the object is destroyed.
+      o.uncache = () => wgpuInternedObjects.delete(key);
+      wgpuInternedObjects.set(key, o);
+    }
+    return id;
+  },
+
+  // Releases a reference to the given object if it is interned. Returns true if the object should be destroyed, i.e. it is
+  // not interned, or this was the last reference to it.
+  $wgpuReleaseInternedReference__deps: ['$wgpu'],
+  $wgpuReleaseInternedReference: function(id) {
+    let o = {{{ wgpuObject('id') }}};
+    return !(o?.internRefs > 1 && o.internRefs--);
+  },
+#endif
+
+  $wgpuObjectTypeNames: {{{ JSON.stringify(wgpuObjectTypeNames) }}},
+  // Maps WebGPU interface constructors to their WGPU_OBJECT_TYPE. Populated on first use, since navigator.gpu
+  // may not be available at startup.
+  $wgpuObjectTypesByConstructor: 0,
+
+  // Returns the WGPU_OBJECT_TYPE of the given object.
+  $wgpuObjectType__deps: ['$wgpuObjectTypeNames', '$wgpuObjectTypesByConstructor'],
+  $wgpuObjectType: function(object) {
+    wgpuObjectTypesByConstructor ||= new Map(wgpuObjectTypeNames.map((name, type) => [globalThis[name], type]));
+    return wgpuObjectTypesByConstructor.get(object.constructor) || 23/*WGPU_OBJECT_TYPE_OTHER*/;
+  },
+
+  // The WGPU_OBJECT_TYPE of each object in the wgpu table, or 0 for free slots. Recorded when an object is stored,
+  // so that the type of an object can be tested with a single typed array read instead of 'instanceof' checks.
+  $wgpuTypes: '=new Uint8Array(1024)',
+
+  // Sets the type tag of the given slot in the wgpu table, growing the tag table if needed.
+  $wgpuSetType__deps: ['$wgpuTypes'],
+  $wgpuSetType: function(slot, type) {
+    if (slot >= wgpuTypes.length) {
+      var types = new Uint8Array(2 * slot);
+      types.set(wgpuTypes);
+      wgpuTypes = types;
+    }
+    wgpuTypes[slot] = type;
+  },
+
+  // Total number of objects of each WGPU_OBJECT_TYPE that have been created and destroyed.
+  $wgpuNumCreatedObjects: [],
+  $wgpuNumDestroyedObjects: [],
+
+  // Update the per-type statistics when an object of the given WGPU_OBJECT_TYPE is created or destroyed.
+  $wgpuCountCreatedObject__deps: ['$wgpuNumCreatedObjects'],
+  $wgpuCountCreatedObject: function(type) {
+    wgpuNumCreatedObjects[type] = (wgpuNumCreatedObjects[type] | 0) + 1;
+  },
+  $wgpuCountDestroyedObject__deps: ['$wgpuNumDestroyedObjects'],
+  $wgpuCountDestroyedObject: function(type) {
+    wgpuNumDestroyedObjects[type] = (wgpuNumDestroyedObjects[type] | 0) + 1;
+  },
 
   // Stores the given WebGPU object under a new free WebGPU object ID.
   // Returns the new ID. Can be called with a null/undefined, in which
   // case no object/ID is persisted.
-  $wgpuStore__deps: ['$wgpu', '$wgpuIdCounter'],
+  $wgpuStore__deps: ['$wgpu', '$wgpuFreeIds', '$wgpuTransientScopeStart', '$wgpuObjectType', '$wgpuSetType', '$wgpuCountCreatedObject'
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  , '$wgpuTransientScopeGeneration'
+#endif
+  ],
   $wgpuStore: function(object) {
     if (object) {
       // WebGPU renderer usage can burn through a lot of object IDs each rendered frame
       // (a number of GPUCommandEncoder, GPUTexture, GPUTextureView, GPURenderPassEncoder,
-      // GPUCommandBuffer objects are created each application frame)
-      // If we assume an upper bound of 1000 object IDs created per rendered frame, and a
-      // new mobile device with 120hz display, a signed int32 state space is exhausted in
-      // 2147483646 / 1000 / 120 / 60 / 60 = 4.97 hours, which is realistic for a page to
-      // stay open for that long. Therefore handle wraparound of the ID counter generation,
-      // and find free gaps in the object IDs for new objects.
-      while(wgpu[wgpuIdCounter]) wgpuIdCounter = wgpuIdCounter < 2147483647 ? wgpuIdCounter + 1 : 2;
+      // GPUCommandBuffer objects are created each application frame), so recycle IDs
+      // of destroyed objects from the free list in O(1) time. Only when there are no
+      // free IDs left is the table grown by appending to its end.
+      var id;
+      if (wgpuTransientScopeStart) {
+        // Inside a transient scope, bump allocate IDs at the end of the table. These will be released
+        // all at once in wgpu_transient_scope_end().
+        id = wgpu.length;
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+        id |= wgpuTransientScopeGeneration;
+#endif
+      } else {
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+        // The free list holds the last handle that each free slot had. Bump the generation
+        // bits of that handle so that old handles to the slot become stale.
+        id = wgpuFreeIds.pop();
+        id = id ? (id + 0x100000) & 0x7FFFFFFF : wgpu.length || 2;
+#else
+        id = wgpuFreeIds.pop() || wgpu.length || 2;
+#endif
+      }
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+      {{{ wassert(`wgpu.length <= 0xFFFFF, 'Too many live WebGPU objects for WEBGPU_GENERATIONAL_HANDLES!'`); }}}
+#endif
 
-      wgpu[wgpuIdCounter] = object;
+      wgpu[{{{ wgpuSlot('id') }}}] = object;
+
+      var type = wgpuObjectType(object);
+      wgpuSetType({{{ wgpuSlot('id') }}}, type);
+      wgpuCountCreatedObject(type);
 
       // Each persisted objects gets a custom 'wid' field (wasm ID) which stores the ID that
       // this object is known by on Wasm side.
-      object.wid = wgpuIdCounter;
+      object.wid = id;
 
-      {{{ wdebugdir('object', '`Stored WebGPU object of type \'${object.constructor.name}\' with ID ${wgpuIdCounter}:`') }}};
+      {{{ wdebugdir('object', '`Stored WebGPU object of type \'${object.constructor.name}\' with ID ${id}:`') }}};
 
-      return wgpuIdCounter++;
+      return id;
     }
     // Implicit return undefined to marshal ID 0 over to Wasm.
   },
@@ -177,20 +387,28 @@ let api = {
   // Marks the given 'object' to be a child/derived object of 'parent',
   // and stores a reference to the object in the WebGPU table,
   // returning the ID.
-  $wgpuStoreAndSetParent__deps: ['$wgpuStore', '$wgpuLinkParentAndChild'],
+  // Objects created inside a transient scope are not linked to their parents, since they will all
+  // be released together at the end of the scope anyway.
+  $wgpuStoreAndSetParent__deps: ['$wgpuStore', '$wgpuLinkParentAndChild', '$wgpuTransientScopeStart'],
   $wgpuStoreAndSetParent: function(object, parent) {
     if (object) {
       var objectId = wgpuStore(object);
-      wgpuLinkParentAndChild(parent, objectId, object);
+      if (!wgpuTransientScopeStart) wgpuLinkParentAndChild(parent, objectId, object);
       return objectId;
     }
   },
 
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  $wgpuReadArrayOfItemsMaybeNull__deps: ['$wgpu', '$wgpuGet'],
+#endif
   $wgpuReadArrayOfItemsMaybeNull: function(itemDict, ptr, numItems) {
     {{{ wassert('numItems >= 0'); }}}
     {{{ wassert('ptr != 0 || numItems == 0'); }}} // Must be non-null pointer
     {{{ replacePtrToIdx('ptr', 2); }}}
 
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+    if (itemDict == wgpu) return Array.from({length: numItems}, () => wgpuGet(HEAPU32[ptr++]));
+#endif
     return Array.from({length: numItems}, () => itemDict[HEAPU32[ptr++]]);
   },
 
@@ -204,7 +422,11 @@ let api = {
     var idx = {{{ shiftPtr('ptr', 2) }}};
     for(var i = 0; i < numItems; ++i) {
       {{{ wassert('HEAPU32[idx+i]'); }}} // Must reference a nonzero item
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+      {{{ wassert('itemDict == wgpu ? wgpuGet(HEAPU32[idx+i]) : itemDict[HEAPU32[idx+i]]'); }}} // Must reference a valid item in the array
+#else
       {{{ wassert('itemDict[HEAPU32[idx+i]]'); }}} // Must reference a valid item in the array
+#endif
     }
     return wgpuReadArrayOfItemsMaybeNull(itemDict, ptr, numItems);
   },
@@ -233,79 +455,214 @@ let api = {
 #endif
   },
 
-  wgpu_get_num_live_objects__deps: ['$wgpu'],
+  wgpu_get_num_live_objects__deps: ['$wgpu', '$wgpuFreeIds', '$wgpuNumTransientIdsFreed'],
   wgpu_get_num_live_objects: function() {
-    return Object.keys(wgpu).length;
+    // All IDs in range [2, wgpu.length-1] are live, except the ones in the free list and the ones that
+    // have been freed in the active transient scope. Plus the special canvas texture ID 1.
+    return Math.max(wgpu.length - 2, 0) - wgpuFreeIds.length - wgpuNumTransientIdsFreed + !!wgpu[1];
+  },
+
+  // Stack of object IDs that are pending destruction in wgpuDestroyPendingObjects().
+  $wgpuDestroyStack: [],
+
+  // Destroys all objects in wgpuDestroyStack, and all objects derived from them. Uses an explicit stack instead of
+  // recursion, so that arbitrarily large object hierarchies can be torn down without growing the JS call stack.
+  $wgpuDestroyPendingObjects__deps: ['$wgpu', '$wgpuTypes', '$wgpuFreeIds', '$wgpuDestroyStack', '$wgpuTransientScopeStart', '$wgpuNumTransientIdsFreed', '$wgpuCountDestroyedObject'
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  , '$wgpuGet'
+#endif
+  ],
+  $wgpuDestroyPendingObjects: function() {
+    while(wgpuDestroyStack.length) {
+      let object = wgpuDestroyStack.pop();
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+      // Destroying a stale handle is a no-op, and will not destroy the object that currently occupies the slot.
+      let o = wgpuGet(object);
+#else
+      let o = wgpu[object];
+#endif
+      if (o) {
+        // Make sure if there might exist any other references to this JS object, that they will no longer see the .wid
+        // field, since this object no longer exists in the wgpu table.
+        o.wid = 0;
+        wgpuCountDestroyedObject(wgpuTypes[{{{ wgpuSlot('object') }}}]);
+        // WebGPU objects of type GPUDevice, GPUBuffer, GPUTexture and GPUQuerySet have an explicit .destroy() function. Call that if applicable.
+        o['destroy']?.();
+        // If the given object has derived objects (GPUTexture -> GPUTextureViews), delete those in a hierarchy as well.
+        o.derivedObjects?.forEach((_,k) => wgpuDestroyStack.push(k));
+        // If this object has a parent, unlink this object from its parent.
+        o.parentObject?.derivedObjects.delete(object);
+        // If this is a cached bind group or render bundle, remove it from its cache. If this is an object that cached bind groups
+        // or render bundles reference, evict those from their caches.
+        o.uncache?.();
+        o.cacheDependents?.forEach(dependent => wgpuDestroyStack.push(dependent.wid));
+        // Finally erase reference to this object, and recycle its ID. (the special canvas texture ID 1 is never recycled)
+        wgpu[{{{ wgpuSlot('object') }}}] = void 0;
+        wgpuTypes[{{{ wgpuSlot('object') }}}] = 0;
+        // IDs of a transient scope are not recycled individually, but all at once at the end of the scope.
+        if (wgpuTransientScopeStart && {{{ wgpuSlot('object') }}} >= wgpuTransientScopeStart) ++wgpuNumTransientIdsFreed;
+        else if (object > 1) wgpuFreeIds.push(object);
+      }
+    }
   },
 
   // Calls .destroy() on the given WebGPU object, and releases the reference to it.
-  wgpu_object_destroy__deps: ['$wgpu'],
+  wgpu_object_destroy__deps: ['$wgpu', '$wgpuDestroyStack', '$wgpuDestroyPendingObjects'
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  , '$wgpuReleaseInternedReference'
+#endif
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  , '$wgpuGet'
+#endif
+  ],
   wgpu_object_destroy: function(object) {
-    let o = wgpu[object];
-    {{{ wassert(`o || !wgpu.hasOwnProperty(object), 'wgpu dictionary should never be storing key-values with null/undefined value in it'`); }}}
-    if (o) {
-      // Make sure if there might exist any other references to this JS object, that they will no longer see the .wid
-      // field, since this object no longer exists in the wgpu table.
-      o.wid = 0;
-      // WebGPU objects of type GPUDevice, GPUBuffer, GPUTexture and GPUQuerySet have an explicit .destroy() function. Call that if applicable.
-      o['destroy']?.();
-      // If the given object has derived objects (GPUTexture -> GPUTextureViews), delete those in a hierarchy as well.
-      o.derivedObjects?.forEach((_,k) => _wgpu_object_destroy(k));
-      // If this object has a parent, unlink this object from its parent.
-      o.parentObject?.derivedObjects.delete(object);
-      // Finally erase reference to this object.
-      delete wgpu[object];
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    if (!wgpuReleaseInternedReference(object)) return;
+#endif
+    wgpuDestroyStack.push(object);
+    wgpuDestroyPendingObjects();
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+    {{{ wassert(`!wgpuGet(object), 'object should have gotten deleted'`); }}}
+#else
+    {{{ wassert(`!wgpu[object], 'object should have gotten deleted'`); }}}
+#endif
+  },
+
+  wgpu_object_destroy_many__deps: ['$wgpuDestroyStack', '$wgpuDestroyPendingObjects'
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  , '$wgpuReleaseInternedReference'
+#endif
+  ],
+  wgpu_object_destroy_many: function(wgpuObjects, numObjects) {
+    {{{ wassert('numObjects >= 0'); }}}
+    {{{ wassert('wgpuObjects != 0 || numObjects == 0'); }}}
+    {{{ replacePtrToIdx('wgpuObjects', 2); }}}
+    // Push in reverse order, so that the objects get destroyed in the order that they were given in.
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    while(numObjects--) {
+      let object = HEAPU32[wgpuObjects + numObjects];
+      if (wgpuReleaseInternedReference(object)) wgpuDestroyStack.push(object);
     }
-    {{{ wassert(`!wgpu.hasOwnProperty(object), 'object should have gotten deleted'`); }}}
+#else
+    while(numObjects--) wgpuDestroyStack.push(HEAPU32[wgpuObjects + numObjects]);
+#endif
+    wgpuDestroyPendingObjects();
   },
 
-  wgpu_destroy_all_objects__deps: ['$wgpu'],
+  wgpu_destroy_all_objects__deps: ['$wgpu', '$wgpuTypes', '$wgpuFreeIds', '$wgpuTransientScopeStart', '$wgpuNumTransientIdsFreed', '$wgpuCountDestroyedObject'],
   wgpu_destroy_all_objects: function() {
-    Object.values(wgpu).forEach(o => {
-      o.wid = 0;
-      o['destroy']?.();
+    wgpu.forEach((o, slot) => {
+      if (o) {
+        o.wid = 0;
+        wgpuCountDestroyedObject(wgpuTypes[slot]);
+        o['destroy']?.();
+        o.uncache?.();
+      }
     });
-    wgpu = {};
+    wgpu = [];
+    wgpuTypes.fill(0);
+    wgpuFreeIds = [];
+    wgpuTransientScopeStart = wgpuNumTransientIdsFreed = 0;
+  },
+
+  wgpu_get_live_object_stats__deps: ['$wgpuNumCreatedObjects', '$wgpuNumDestroyedObjects'],
+  wgpu_get_live_object_stats: function(stats) {
+    {{{ wassert('stats != 0'); }}}
+    {{{ replacePtrToIdx('stats', 2); }}}
+    for(var type = 0; type < 24/*WGPU_OBJECT_TYPE_COUNT*/; ++type) {
+      var created = wgpuNumCreatedObjects[type] | 0, destroyed = wgpuNumDestroyedObjects[type] | 0;
+      HEAPU32[stats + type] = created - destroyed;
+      HEAPU32[stats + 24 + type] = created;
+      HEAPU32[stats + 48 + type] = destroyed;
+    }
   },
 
+  wgpu_transient_scope_begin__deps: ['$wgpu', '$wgpuTransientScopeStart'
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  , '$wgpuTransientScopeGeneration'
+#endif
+  ],
+  wgpu_transient_scope_begin: function() {
+    {{{ wassert(`!wgpuTransientScopeStart, 'Transient scopes cannot be nested!'`); }}}
+    // IDs 0 and 1 are reserved, so transient IDs start at 2 at the earliest. This also keeps
+    // wgpuTransientScopeStart nonzero while the scope is active.
+    wgpuTransientScopeStart = wgpu.length = Math.max(wgpu.length, 2);
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+    wgpuTransientScopeGeneration = ((wgpuTransientScopeGeneration + 0x100000) & 0x7FF00000) || 0x100000;
+#endif
+  },
+
+  wgpu_transient_scope_end__deps: ['$wgpu', '$wgpuTypes', '$wgpuTransientScopeStart', '$wgpuNumTransientIdsFreed', '$wgpuCountDestroyedObject', '$wgpuDestroyStack', '$wgpuDestroyPendingObjects'],
+  wgpu_transient_scope_end: function() {
+    {{{ wassert(`wgpuTransientScopeStart, 'wgpu_transient_scope_end() called without a matching wgpu_transient_scope_begin()!'`); }}}
+    // Release in reverse creation order, so that derived objects are destroyed before the objects they were created from.
+    for(var i = wgpu.length - 1; i >= wgpuTransientScopeStart; --i) {
+      var o = wgpu[i];
+      if (o) {
+        o.wid = 0;
+        wgpuCountDestroyedObject(wgpuTypes[i]);
+        wgpuTypes[i] = 0;
+        o['destroy']?.();
+        o.uncache?.();
+        o.cacheDependents?.forEach(dependent => wgpuDestroyStack.push(dependent.wid));
+      }
+    }
+    // Evict cached bind groups and render bundles from outside the scope that referenced transient objects.
+    wgpuDestroyPendingObjects();
+    wgpu.length = wgpuTransientScopeStart;
+    wgpuTransientScopeStart = wgpuNumTransientIdsFreed = 0;
+  },
+
+#if parseInt(globalThis.WEBGPU_GENERATIONAL_HANDLES)
+  wgpu_is_valid_object: function(o) { return wgpu[o & 0xFFFFF]?.wid === o; }, // Tests if this ID references anything, and is not a stale handle
+#else
   wgpu_is_valid_object: function(o) { return !!wgpu[o]; }, // Tests if this ID references anything (not just a GPUObjectBase)
-  wgpu_is_adapter: function(o) { return wgpu[o] instanceof GPUAdapter; },
-  wgpu_is_device: function(o) { return wgpu[o] instanceof GPUDevice; },
-  wgpu_is_buffer: function(o) { return wgpu[o] instanceof GPUBuffer; },
-  wgpu_is_texture: function(o) { return wgpu[o] instanceof GPUTexture; },
-  wgpu_is_texture_view: function(o) { return wgpu[o] instanceof GPUTextureView; },
-  wgpu_is_external_texture: function(o) { return wgpu[o] instanceof GPUExternalTexture; },
-  wgpu_is_sampler: function(o) { return wgpu[o] instanceof GPUSampler; },
-  wgpu_is_bind_group_layout: function(o) { return wgpu[o] instanceof GPUBindGroupLayout; },
-  wgpu_is_bind_group: function(o) { return wgpu[o] instanceof GPUBindGroup; },
-  wgpu_is_pipeline_layout: function(o) { return wgpu[o] instanceof GPUPipelineLayout; },
-  wgpu_is_shader_module: function(o) { return wgpu[o] instanceof GPUShaderModule; },
-  wgpu_is_compute_pipeline: function(o) { return wgpu[o] instanceof GPUComputePipeline; },
-  wgpu_is_render_pipeline: function(o) { return wgpu[o] instanceof GPURenderPipeline; },
-  wgpu_is_command_buffer: function(o) { return wgpu[o] instanceof GPUCommandBuffer; },
-  wgpu_is_command_encoder: function(o) { return wgpu[o] instanceof GPUCommandEncoder; },
-  wgpu_is_binding_commands_mixin: function(o) { return wgpu[o] instanceof GPUComputePassEncoder || wgpu[o] instanceof GPURenderPassEncoder || wgpu[o] instanceof GPURenderBundleEncoder; },
-  wgpu_is_render_commands_mixin: function(o) { return wgpu[o] instanceof GPURenderPassEncoder || wgpu[o] instanceof GPURenderBundleEncoder; },
-  wgpu_is_render_pass_encoder: function(o) { return wgpu[o] instanceof GPURenderPassEncoder; },
-  wgpu_is_render_bundle: function(o) { return wgpu[o] instanceof GPURenderBundle; },
-  wgpu_is_render_bundle_encoder: function(o) { return wgpu[o] instanceof GPURenderBundleEncoder; },
-  wgpu_is_compute_pass_encoder: function(o) { return wgpu[o] instanceof GPUComputePassEncoder; },
-  wgpu_is_queue: function(o) { return wgpu[o] instanceof GPUQueue; },
-  wgpu_is_query_set: function(o) { return wgpu[o] instanceof GPUQuerySet; },
-  wgpu_is_canvas_context: function(o) { return wgpu[o] instanceof GPUCanvasContext; },
-  wgpu_is_device_lost_info: function(o) { return wgpu[o] instanceof GPUDeviceLostInfo; },
-  wgpu_is_error: function(o) { return wgpu[o] instanceof GPUError; },
-
-  wgpu_object_set_label__deps: ['$utf8'],
+#endif
+  wgpu_is_adapter: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUAdapter') }}}; },
+  wgpu_is_device: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUDevice') }}}; },
+  wgpu_is_buffer: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUBuffer') }}}; },
+  wgpu_is_texture: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUTexture') }}}; },
+  wgpu_is_texture_view: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUTextureView') }}}; },
+  wgpu_is_external_texture: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUExternalTexture') }}}; },
+  wgpu_is_sampler: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUSampler') }}}; },
+  wgpu_is_bind_group_layout: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUBindGroupLayout') }}}; },
+  wgpu_is_bind_group: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUBindGroup') }}}; },
+  wgpu_is_pipeline_layout: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUPipelineLayout') }}}; },
+  wgpu_is_shader_module: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUShaderModule') }}}; },
+  wgpu_is_compute_pipeline: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUComputePipeline') }}}; },
+  wgpu_is_render_pipeline: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPURenderPipeline') }}}; },
+  wgpu_is_command_buffer: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUCommandBuffer') }}}; },
+  wgpu_is_command_encoder: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUCommandEncoder') }}}; },
+  wgpu_is_binding_commands_mixin: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder') }}}; },
+  wgpu_is_render_commands_mixin: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPURenderPassEncoder', 'GPURenderBundleEncoder') }}}; },
+  wgpu_is_render_pass_encoder: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPURenderPassEncoder') }}}; },
+  wgpu_is_render_bundle: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPURenderBundle') }}}; },
+  wgpu_is_render_bundle_encoder: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPURenderBundleEncoder') }}}; },
+  wgpu_is_compute_pass_encoder: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUComputePassEncoder') }}}; },
+  wgpu_is_queue: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUQueue') }}}; },
+  wgpu_is_query_set: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUQuerySet') }}}; },
+  wgpu_is_canvas_context: function(o) { return {{{ wgpuIsTypeChecked('o', 'GPUCanvasContext') }}}; },
+  wgpu_is_device_lost_info: function(o) { return {{{ wgpuObject('o') }}} instanceof GPUDeviceLostInfo; },
+  wgpu_is_error: function(o) { return {{{ wgpuObject('o') }}} instanceof GPUError; },
+
+  wgpu_object_set_label__deps: ['$utf8Cached'],
   wgpu_object_set_label: function(o, label) {
-    {{{ wassert('wgpu[o]'); }}}
-    wgpu[o]['label'] = utf8(label);
+    {{{ wassert(wgpuObject('o')); }}}
+    {{{ wgpuObject('o') }}}['label'] = utf8Cached(label);
   },
 
   wgpu_object_get_label__deps: ['$stringToUTF8'],
   wgpu_object_get_label: function(o, dstLabel, dstLabelSize) {
-    {{{ wassert('wgpu[o]'); }}}
-    stringToUTF8(wgpu[o]['label'], {{{ toNumber('dstLabel') }}}, dstLabelSize);
+    {{{ wassert(wgpuObject('o')); }}}
+    stringToUTF8({{{ wgpuObject('o') }}}['label'], {{{ toNumber('dstLabel') }}}, dstLabelSize);
+  },
+
+  // Serial numbers are assigned on first query, so that objects that are never queried do not pay for them.
+  $wgpuNextObjectSerial: 0,
+  wgpu_object_get_serial__deps: ['$wgpuNextObjectSerial'],
+  wgpu_object_get_serial: function(o) {
+    o = {{{ wgpuObject('o') }}};
+    return o ? o.serial ||= ++wgpuNextObjectSerial : 0;
   },
 
   $wgpu_checked_shift: function(ptr, shift) {
@@ -327,6 +684,36 @@ let api = {
     return UTF8ToString({{{ toNumber('ptr') }}});
   },
 
+  // Strings registered with wgpu_intern_string(), keyed by pointer.
+  $wgpuInternedStrings: '=new Map()',
+  // Recently decoded strings keyed by pointer, with the length and hash of their UTF-8 contents to detect if the memory
+  // has since been reused for a different string.
+  $wgpuStringCache: '=new Map()',
+
+  // Like utf8(), but returns a cached JS string if the same string has been decoded before. Used for short strings that
+  // are passed repeatedly, like labels, entry point names and pipeline constant names.
+  $utf8Cached__deps: ['$utf8', '$wgpuInternedStrings', '$wgpuStringCache'],
+  $utf8Cached: function(ptr) {
+    ptr = {{{ wasm4GbShift(toNumber('ptr')) }}};
+    let s = wgpuInternedStrings.get(ptr), e, h = 0x811C9DC5, i = ptr, c;
+    if (s === void 0 && ptr) {
+      // Hash the string with FNV-1a, which is cheaper than decoding it, and does not generate garbage.
+      while ((c = HEAPU8[i++])) h = Math.imul(h ^ c, 0x01000193);
+      e = wgpuStringCache.get(ptr);
+      if (e?.h === h && e.n === i - ptr) return e.s;
+      if (wgpuStringCache.size >= 4096) wgpuStringCache.clear();
+      wgpuStringCache.set(ptr, { h: h, n: i - ptr, s: s = utf8(ptr) });
+    }
+    return s || '';
+  },
+
+  wgpu_intern_string__deps: ['$utf8', '$wgpuInternedStrings'],
+  wgpu_intern_string: function(str) {
+    {{{ wassert('str'); }}}
+    str = {{{ wasm4GbShift(toNumber('str')) }}};
+    wgpuInternedStrings.set(str, utf8(str));
+  },
+
   wgpu_canvas_get_webgpu_context__deps: ['$wgpuStore'
 #if PROXY_TO_PTHREAD
     , '$GL'
@@ -388,47 +775,132 @@ let api = {
     requestAnimationFrame(tick);
   },
 
-  $GPUTextureAndVertexFormats: [, 'r8unorm', 'r8snorm', 'r8uint', 'r8sint', 'r16unorm', 'r16snorm', 'r16uint', 'r16sint', 'r16float', 'rg8unorm', 'rg8snorm', 'rg8uint', 'rg8sint', 'r32uint', 'r32sint', 'r32float', 'rg16unorm', 'rg16snorm', 'rg16uint', 'rg16sint', 'rg16float', 'rgba8unorm', 'rgba8unorm-srgb', 'rgba8snorm', 'rgba8uint', 'rgba8sint', 'bgra8unorm', 'bgra8unorm-srgb', 'rgb9e5ufloat', 'rgb10a2uint', 'rgb10a2unorm', 'rg11b10ufloat', 'rg32uint', 'rg32sint', 'rg32float', 'rgba16unorm', 'rgba16snorm', 'rgba16uint', 'rgba16sint', 'rgba16float', 'rgba32uint', 'rgba32sint', 'rgba32float', 'stencil8', 'depth16unorm', 'depth24plus', 'depth24plus-stencil8', 'depth32float', 'depth32float-stencil8', 'bc1-rgba-unorm', 'bc1-rgba-unorm-srgb', 'bc2-rgba-unorm', 'bc2-rgba-unorm-srgb', 'bc3-rgba-unorm', 'bc3-rgba-unorm-srgb', 'bc4-r-unorm', 'bc4-r-snorm', 'bc5-rg-unorm', 'bc5-rg-snorm', 'bc6h-rgb-ufloat', 'bc6h-rgb-float', 'bc7-rgba-unorm', 'bc7-rgba-unorm-srgb', 'etc2-rgb8unorm', 'etc2-rgb8unorm-srgb', 'etc2-rgb8a1unorm', 'etc2-rgb8a1unorm-srgb', 'etc2-rgba8unorm', 'etc2-rgba8unorm-srgb', 'eac-r11unorm', 'eac-r11snorm', 'eac-rg11unorm', 'eac-rg11snorm', 'astc-4x4-unorm', 'astc-4x4-unorm-srgb', 'astc-5x4-unorm', 'astc-5x4-unorm-srgb', 'astc-5x5-unorm', 'astc-5x5-unorm-srgb', 'astc-6x5-unorm', 'astc-6x5-unorm-srgb', 'astc-6x6-unorm', 'astc-6x6-unorm-srgb', 'astc-8x5-unorm', 'astc-8x5-unorm-srgb', 'astc-8x6-unorm', 'astc-8x6-unorm-srgb', 'astc-8x8-unorm', 'astc-8x8-unorm-srgb', 'astc-10x5-unorm', 'astc-10x5-unorm-srgb', 'astc-10x6-unorm', 'astc-10x6-unorm-srgb', 'astc-10x8-unorm', 'astc-10x8-unorm-srgb', 'astc-10x10-unorm', 'astc-10x10-unorm-srgb', 'astc-12x10-unorm', 'astc-12x10-unorm-srgb', 'astc-12x12-unorm', 'astc-12x12-unorm-srgb', 'uint8', 'uint8x2', 'uint8x4', 'sint8', 'sint8x2', 'sint8x4', 'unorm8', 'unorm8x2', 'unorm8x4', 'snorm8', 'snorm8x2', 'snorm8x4', 'uint16', 'uint16x2', 'uint16x4', 'sint16', 'sint16x2', 'sint16x4', 'unorm16', 'unorm16x2', 'unorm16x4', 'snorm16', 'snorm16x2', 'snorm16x4', 'float16', 'float16x2', 'float16x4', 'float32', 'float32x2', 'float32x3', 'float32x4', 'uint32', 'uint32x2', 'uint32x3', 'uint32x4', 'sint32', 'sint32x2', 'sint32x3', 'sint32x4', 'unorm10-10-10-2', 'unorm8x4-bgra' ],
   wgpu32BitLimitNames: ['maxTextureDimension1D', 'maxTextureDimension2D', 'maxTextureDimension3D', 'maxTextureArrayLayers', 'maxBindGroups', 'maxBindGroupsPlusVertexBuffers', 'maxImmediateSize', 'maxBindingsPerBindGroup', 'maxDynamicUniformBuffersPerPipelineLayout', 'maxDynamicStorageBuffersPerPipelineLayout', 'maxSampledTexturesPerShaderStage', 'maxSamplersPerShaderStage', 'maxStorageBuffersPerShaderStage', 'maxStorageBuffersInVertexStage', 'maxStorageBuffersInFragmentStage', 'maxStorageTexturesPerShaderStage', 'maxStorageTexturesInVertexStage', 'maxStorageTexturesInFragmentStage', 'maxUniformBuffersPerShaderStage', 'minUniformBufferOffsetAlignment', 'minStorageBufferOffsetAlignment', 'maxVertexBuffers', 'maxVertexAttributes', 'maxVertexBufferArrayStride', 'maxInterStageShaderVariables', 'maxColorAttachments', 'maxColorAttachmentBytesPerSample', 'maxComputeWorkgroupStorageSize', 'maxComputeInvocationsPerWorkgroup', 'maxComputeWorkgroupSizeX', 'maxComputeWorkgroupSizeY', 'maxComputeWorkgroupSizeZ', 'maxComputeWorkgroupsPerDimension' ],
   wgpu64BitLimitNames: ['maxUniformBufferBindingSize', 'maxStorageBufferBindingSize', 'maxBufferSize' ],
   wgpuFeatures: ['core-features-and-limits', 'depth-clip-control', 'depth32float-stencil8', 'texture-compression-bc', 'texture-compression-bc-sliced-3d', 'texture-compression-etc2', 'texture-compression-astc', 'texture-compression-astc-sliced-3d', 'timestamp-query', 'indirect-first-instance', 'shader-f16', 'rg11b10ufloat-renderable', 'bgra8unorm-storage', 'float32-filterable', 'float32-blendable', 'clip-distances', 'dual-source-blending', 'subgroups', 'texture-formats-tier1', 'texture-formats-tier2', 'primitive-index', 'texture-component-swizzle' ],
+
+  // Maps an array of enum strings to a Map from string to its index in the array, for marshalling JS enum values to the C integer values.
+  $wgpuEnumIds: function(names) {
+    return new Map(names.map((name, i) => [name, i]));
+  },
+
+  // The tables below are indexed by the integer values of the corresponding WGPU_* enums in lib_webgpu.h. $GPUMipmapFilterModes has identical
+  // values to $GPUFilterModes - the same array is used for both mag/min and mipmap filter lookups.
+// GENERATED ENUM TABLES BEGIN: do not edit by hand, run 'node scripts/generate_tables.js' instead.
+  $GPUTextureAndVertexFormats: [, 'r8unorm', 'r8snorm', 'r8uint', 'r8sint', 'r16unorm', 'r16snorm', 'r16uint', 'r16sint', 'r16float', 'rg8unorm', 'rg8snorm', 'rg8uint', 'rg8sint', 'r32uint', 'r32sint', 'r32float', 'rg16unorm', 'rg16snorm', 'rg16uint', 'rg16sint', 'rg16float', 'rgba8unorm', 'rgba8unorm-srgb', 'rgba8snorm', 'rgba8uint', 'rgba8sint', 'bgra8unorm', 'bgra8unorm-srgb', 'rgb9e5ufloat', 'rgb10a2uint', 'rgb10a2unorm', 'rg11b10ufloat', 'rg32uint', 'rg32sint', 'rg32float', 'rgba16unorm', 'rgba16snorm', 'rgba16uint', 'rgba16sint', 'rgba16float', 'rgba32uint', 'rgba32sint', 'rgba32float', 'stencil8', 'depth16unorm', 'depth24plus', 'depth24plus-stencil8', 'depth32float', 'depth32float-stencil8', 'bc1-rgba-unorm', 'bc1-rgba-unorm-srgb', 'bc2-rgba-unorm', 'bc2-rgba-unorm-srgb', 'bc3-rgba-unorm', 'bc3-rgba-unorm-srgb', 'bc4-r-unorm', 'bc4-r-snorm', 'bc5-rg-unorm', 'bc5-rg-snorm', 'bc6h-rgb-ufloat', 'bc6h-rgb-float', 'bc7-rgba-unorm', 'bc7-rgba-unorm-srgb', 'etc2-rgb8unorm', 'etc2-rgb8unorm-srgb', 'etc2-rgb8a1unorm', 'etc2-rgb8a1unorm-srgb', 'etc2-rgba8unorm', 'etc2-rgba8unorm-srgb', 'eac-r11unorm', 'eac-r11snorm', 'eac-rg11unorm', 'eac-rg11snorm', 'astc-4x4-unorm', 'astc-4x4-unorm-srgb', 'astc-5x4-unorm', 'astc-5x4-unorm-srgb', 'astc-5x5-unorm', 'astc-5x5-unorm-srgb', 'astc-6x5-unorm', 'astc-6x5-unorm-srgb', 'astc-6x6-unorm', 'astc-6x6-unorm-srgb', 'astc-8x5-unorm', 'astc-8x5-unorm-srgb', 'astc-8x6-unorm', 'astc-8x6-unorm-srgb', 'astc-8x8-unorm', 'astc-8x8-unorm-srgb', 'astc-10x5-unorm', 'astc-10x5-unorm-srgb', 'astc-10x6-unorm', 'astc-10x6-unorm-srgb', 'astc-10x8-unorm', 'astc-10x8-unorm-srgb', 'astc-10x10-unorm', 'astc-10x10-unorm-srgb', 'astc-12x10-unorm', 'astc-12x10-unorm-srgb', 'astc-12x12-unorm', 'astc-12x12-unorm-srgb', 'uint8', 'uint8x2', 'uint8x4', 'sint8', 'sint8x2', 'sint8x4', 'unorm8', 'unorm8x2', 'unorm8x4', 'snorm8', 'snorm8x2', 'snorm8x4', 'uint16', 'uint16x2', 'uint16x4', 'sint16', 'sint16x2', 'sint16x4', 'unorm16', 'unorm16x2', 'unorm16x4', 'snorm16', 'snorm16x2', 'snorm16x4', 'float16', 'float16x2', 'float16x4', 'float32', 'float32x2', 'float32x3', 'float32x4', 'uint32', 'uint32x2', 'uint32x3', 'uint32x4', 'sint32', 'sint32x2', 'sint32x3', 'sint32x4', 'unorm10-10-10-2', 'unorm8x4-bgra' ],
+  $GPUTextureAndVertexFormatIds__deps: ['$GPUTextureAndVertexFormats', '$wgpuEnumIds'],
+  $GPUTextureAndVertexFormatIds: '=wgpuEnumIds(GPUTextureAndVertexFormats)',
   $GPUBlendFactors: [, 'zero', 'one', 'src', 'one-minus-src', 'src-alpha', 'one-minus-src-alpha', 'dst', 'one-minus-dst', 'dst-alpha', 'one-minus-dst-alpha', 'src-alpha-saturated', 'constant', 'one-minus-constant', 'src1', 'one-minus-src1', 'src1-alpha', 'one-minus-src1-alpha' ],
   $GPUStencilOperations: [, 'keep', 'zero', 'replace', 'invert', 'increment-clamp', 'decrement-clamp', 'increment-wrap', 'decrement-wrap' ],
   $GPUCompareFunctions: [, 'never', 'less', 'equal', 'less-equal', 'greater', 'not-equal', 'greater-equal', 'always' ],
   $GPUBlendOperations: [, 'add', 'subtract', 'reverse-subtract', 'min', 'max' ],
   $GPUIndexFormats: [, 'uint16', 'uint32' ],
-  $GPUTextureDimensions: [, '1d', '2d', '3d'],
+  $GPUTextureDimensions: [, '1d', '2d', '3d' ],
   $GPUTextureViewDimensions: [, '1d', '2d', '2d-array', 'cube', 'cube-array', '3d' ],
+  $GPUTextureViewDimensionIds__deps: ['$GPUTextureViewDimensions', '$wgpuEnumIds'],
+  $GPUTextureViewDimensionIds: '=wgpuEnumIds(GPUTextureViewDimensions)',
   $GPUStorageTextureSampleTypes: [, 'write-only', 'read-only', 'read-write' ],
   $GPUAddressModes: [, 'clamp-to-edge', 'repeat', 'mirror-repeat' ],
   $GPUTextureAspects: [, 'all', 'stencil-only', 'depth-only' ],
   $GPUPrimitiveTopologys: [, 'point-list', 'line-list', 'line-strip', 'triangle-list', 'triangle-strip' ],
+  $GPUFrontFaces: [, 'ccw', 'cw' ],
+  $GPUCullModes: [, 'none', 'front', 'back' ],
+  $GPUVertexStepModes: [, 'vertex', 'instance' ],
   $GPUBufferBindingTypes: [, 'uniform', 'storage', 'read-only-storage' ],
   $GPUSamplerBindingTypes: [, 'filtering', 'non-filtering', 'comparison' ],
   $GPUTextureSampleTypes: [, 'float', 'unfilterable-float', 'depth', 'sint', 'uint' ],
-  $GPUQueryTypes: [, 'occlusion', 'timestamp'],
-  $HTMLPredefinedColorSpaces: [, 'srgb', 'srgb-linear', 'display-p3', 'display-p3-linear'],
+  $GPUQueryTypes: [, 'occlusion', 'timestamp' ],
+  $HTMLPredefinedColorSpaces: [, 'srgb', 'srgb-linear', 'display-p3', 'display-p3-linear' ],
+  $HTMLPredefinedColorSpaceIds__deps: ['$HTMLPredefinedColorSpaces', '$wgpuEnumIds'],
+  $HTMLPredefinedColorSpaceIds: '=wgpuEnumIds(HTMLPredefinedColorSpaces)',
   $GPUFilterModes: [, 'nearest', 'linear' ],
-  // $GPUMipmapFilterModes has identical values to $GPUFilterModes - reuse the same array for both mag/min and mipmap filter lookups.
-  // $GPUMipmapFilterModes: [, 'nearest', 'linear' ],
-  $GPULoadOps: [, 'load', 'clear'],
-  $GPUStoreOps: [, 'store', 'discard'],
-  $GPUCanvasToneMappingModes: [, 'standard', 'extended'],
-  $GPUCanvasAlphaModes: [, 'opaque', 'premultiplied'],
+  $GPULoadOps: [, 'load', 'clear' ],
+  $GPUStoreOps: [, 'store', 'discard' ],
+  $GPUCanvasToneMappingModes: [, 'standard', 'extended' ],
+  $GPUCanvasToneMappingModeIds__deps: ['$GPUCanvasToneMappingModes', '$wgpuEnumIds'],
+  $GPUCanvasToneMappingModeIds: '=wgpuEnumIds(GPUCanvasToneMappingModes)',
+  $GPUCanvasAlphaModes: [, 'opaque', 'premultiplied' ],
+  $GPUCanvasAlphaModeIds__deps: ['$GPUCanvasAlphaModes', '$wgpuEnumIds'],
+  $GPUCanvasAlphaModeIds: '=wgpuEnumIds(GPUCanvasAlphaModes)',
+
+  $wgpuReadGpuStencilFaceState__deps: ['$GPUCompareFunctions', '$GPUStencilOperations'],
+  $wgpuReadGpuStencilFaceState: function(idx) {
+    {{{ wassert('idx != 0'); }}}
+    return {
+      'compare': GPUCompareFunctions[HEAPU32[idx]],
+      'failOp': GPUStencilOperations[HEAPU32[idx+1]],
+      'depthFailOp': GPUStencilOperations[HEAPU32[idx+2]],
+      'passOp': GPUStencilOperations[HEAPU32[idx+3]]
+    };
+  },
+
+  $wgpuReadGpuBlendComponent__deps: ['$GPUBlendOperations', '$GPUBlendFactors'],
+  $wgpuReadGpuBlendComponent: function(idx) {
+    {{{ wassert('idx != 0'); }}}
+    {{{ wassert('GPUBlendOperations[HEAPU32[idx]]'); }}}
+    {{{ wassert('GPUBlendFactors[HEAPU32[idx+1]]'); }}}
+    {{{ wassert('GPUBlendFactors[HEAPU32[idx+2]]'); }}}
+    return {
+      'operation': GPUBlendOperations[HEAPU32[idx]],
+      'srcFactor': GPUBlendFactors[HEAPU32[idx+1]],
+      'dstFactor': GPUBlendFactors[HEAPU32[idx+2]]
+    };
+  },
+
+  $wgpuReadGpuPrimitiveState__deps: ['$GPUPrimitiveTopologys', '$GPUIndexFormats', '$GPUFrontFaces', '$GPUCullModes'],
+  $wgpuReadGpuPrimitiveState: function(idx) {
+    {{{ wassert('idx != 0'); }}}
+    return {
+      'topology': GPUPrimitiveTopologys[HEAPU32[idx]],
+      'stripIndexFormat': GPUIndexFormats[HEAPU32[idx+1]],
+      'frontFace': GPUFrontFaces[HEAPU32[idx+2]],
+      'cullMode': GPUCullModes[HEAPU32[idx+3]],
+      'unclippedDepth': !!HEAPU32[idx+4]
+    };
+  },
+
+  $wgpuReadGpuDepthStencilState__deps: ['$GPUTextureAndVertexFormats', '$GPUCompareFunctions', '$wgpuReadGpuStencilFaceState'],
+  $wgpuReadGpuDepthStencilState: function(idx) {
+    {{{ wassert('idx != 0'); }}}
+    return {
+      'format': GPUTextureAndVertexFormats[HEAPU32[idx]],
+      'depthWriteEnabled': !!HEAPU32[idx+1],
+      'depthCompare': GPUCompareFunctions[HEAPU32[idx+2]],
+      'stencilReadMask': HEAPU32[idx+3],
+      'stencilWriteMask': HEAPU32[idx+4],
+      'depthBias': HEAP32[idx+5],
+      'depthBiasSlopeScale': HEAPF32[idx+6],
+      'depthBiasClamp': HEAPF32[idx+7],
+      'stencilFront': wgpuReadGpuStencilFaceState(idx+8),
+      'stencilBack': wgpuReadGpuStencilFaceState(idx+12),
+      'clampDepth': !!HEAPU32[idx+16]
+    };
+  },
+
+  $wgpuReadGpuMultisampleState: function(idx) {
+    {{{ wassert('idx != 0'); }}}
+    return {
+      'count': HEAPU32[idx],
+      'mask': HEAPU32[idx+1],
+      'alphaToCoverageEnabled': !!HEAPU32[idx+2]
+    };
+  },
+// GENERATED ENUM TABLES END
+
   $GPUAutoLayoutMode: '="auto"',
 
   wgpu_canvas_context_configure__deps: ['$GPUTextureAndVertexFormats', '$HTMLPredefinedColorSpaces', '$wgpuReadArrayOfItems', '$GPUCanvasToneMappingModes', '$GPUCanvasAlphaModes'],
   wgpu_canvas_context_configure: function(canvasContext, config) {
     {{{ wdebuglog('`wgpu_canvas_context_configure(canvasContext=${canvasContext}, config=${config})`'); }}}
     {{{ wassert('canvasContext != 0'); }}}
-    {{{ wassert('wgpu[canvasContext]'); }}}
-    {{{ wassert('wgpu[canvasContext] instanceof GPUCanvasContext'); }}}
+    {{{ wassert(wgpuObject('canvasContext')); }}}
+    {{{ wassert(wgpuIsType('canvasContext', 'GPUCanvasContext')); }}}
     {{{ wassert('config != 0'); }}} // Must be non-null
 
     {{{ replacePtrToIdx('config', 2); }}}
 
     let desc = {
-      'device': wgpu[HEAPU32[config]],
+      'device': {{{ wgpuObject('HEAPU32[config]') }}},
       'format': GPUTextureAndVertexFormats[HEAPU32[config+1]],
       'usage': HEAPU32[config+2],
       'viewFormats': wgpuReadArrayOfItems(GPUTextureAndVertexFormats, {{{ readPtrFromIdx32('config', 4) }}}, HEAPU32[config+3]),
@@ -440,67 +912,67 @@ let api = {
     };
 
     {{{ wdebugdir('desc', '`canvasContext.configure() with descriptor:`') }}};
-    wgpu[canvasContext]['configure'](desc);
+    {{{ wgpuObject('canvasContext') }}}['configure'](desc);
   },
 
   wgpu_canvas_context_unconfigure: function(canvasContext) {
     {{{ wdebuglog('`wgpu_canvas_context_unconfigure(canvasContext=${canvasContext})`'); }}}
     {{{ wassert('canvasContext != 0'); }}}
-    {{{ wassert('wgpu[canvasContext]'); }}}
-    {{{ wassert('wgpu[canvasContext] instanceof GPUCanvasContext'); }}}
+    {{{ wassert(wgpuObject('canvasContext')); }}}
+    {{{ wassert(wgpuIsType('canvasContext', 'GPUCanvasContext')); }}}
 
-    wgpu[canvasContext]['unconfigure']();
+    {{{ wgpuObject('canvasContext') }}}['unconfigure']();
   },
 
-  wgpu_canvas_context_get_configuration__deps: ['malloc', '$GPUTextureAndVertexFormats', '$HTMLPredefinedColorSpaces', '$GPUCanvasToneMappingModes', '$GPUCanvasAlphaModes'],
+  wgpu_canvas_context_get_configuration__deps: ['malloc', '$GPUTextureAndVertexFormatIds', '$HTMLPredefinedColorSpaceIds', '$GPUCanvasToneMappingModeIds', '$GPUCanvasAlphaModeIds'],
   wgpu_canvas_context_get_configuration: function(canvasContext) {
     {{{ wdebuglog('`wgpu_canvas_context_get_configuration(canvasContext=${canvasContext})`'); }}}
     {{{ wassert('canvasContext != 0'); }}}
-    {{{ wassert('wgpu[canvasContext]'); }}}
-    {{{ wassert('wgpu[canvasContext] instanceof GPUCanvasContext'); }}}    
+    {{{ wassert(wgpuObject('canvasContext')); }}}
+    {{{ wassert(wgpuIsType('canvasContext', 'GPUCanvasContext')); }}}    
 
-    var cfg = wgpu[canvasContext]['getConfiguration']();
+    var cfg = {{{ wgpuObject('canvasContext') }}}['getConfiguration']();
     {{{ wdebugdir('cfg', '`canvasContext.getConfiguration() returned:`') }}};
     if (!cfg) return {{{ toWasm64('0') }}};
 
     var numViewFormats = cfg['viewFormats'].length;
-    var config = _malloc(40+4*numViewFormats); // sizeof(WGpuCanvasConfiguration) + 4*numViewFormats
+    var config = _malloc({{{ wgpuStructs.WGpuCanvasConfiguration.sizeof*4 }}}+4*numViewFormats);
     var c = {{{ shiftIndex('config', 2) }}};
 
     HEAPU32[c]   = cfg['device'].wid;
-    HEAPU32[c+1] = GPUTextureAndVertexFormats.indexOf(cfg['format']);
+    HEAPU32[c+1] = GPUTextureAndVertexFormatIds.get(cfg['format']);
     HEAPU32[c+2] = cfg['usage'];
     HEAPU32[c+3] = numViewFormats;
 #if MEMORY64
-    HEAPU64[c+4 >>> 1] = BigInt(config + 40); // viewFormats pointer
+    HEAPU64[c+4 >>> 1] = BigInt(config + {{{ wgpuStructs.WGpuCanvasConfiguration.sizeof*4 }}}); // viewFormats pointer
 #else
-    HEAPU32[c+4] = config + 40;
+    HEAPU32[c+4] = config + {{{ wgpuStructs.WGpuCanvasConfiguration.sizeof*4 }}};
 #endif
-    HEAPU32[c+6] = HTMLPredefinedColorSpaces.indexOf(cfg['colorSpace']);
+    HEAPU32[c+6] = HTMLPredefinedColorSpaceIds.get(cfg['colorSpace']);
     // TODO: Firefox does not currently implement toneMapping field. Remove '?.' after all browsers support it.
 #if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED
-    HEAPU32[c+7] = GPUCanvasToneMappingModes.indexOf(cfg['toneMapping']?.['mode']);
+    HEAPU32[c+7] = GPUCanvasToneMappingModeIds.get(cfg['toneMapping']?.['mode']);
 #else
-    HEAPU32[c+7] = GPUCanvasToneMappingModes.indexOf(cfg['toneMapping']['mode']);
+    HEAPU32[c+7] = GPUCanvasToneMappingModeIds.get(cfg['toneMapping']['mode']);
 #endif
-    HEAPU32[c+8] = GPUCanvasAlphaModes.indexOf(cfg['alphaMode']);
+    HEAPU32[c+8] = GPUCanvasAlphaModeIds.get(cfg['alphaMode']);
 
     // Populate the actual formats into the viewFormats pointer.
     for(var i = 0; i < numViewFormats; ++i) {
-      HEAPU32[c+10+i] = GPUTextureAndVertexFormats.indexOf(cfg['viewFormats'][i]);
+      HEAPU32[c+{{{ wgpuStructs.WGpuCanvasConfiguration.sizeof }}}+i] = GPUTextureAndVertexFormatIds.get(cfg['viewFormats'][i]);
     }
 
     return {{{ toWasm64('config') }}}; // Return the malloc()ed pointer to caller. It must remember to free it!
   },
 
-  wgpu_canvas_context_get_current_texture__deps: ['wgpu_object_destroy', '$wgpuLinkParentAndChild'],
+  wgpu_canvas_context_get_current_texture__deps: ['wgpu_object_destroy', '$wgpuLinkParentAndChild', '$wgpuSetType', '$wgpuCountCreatedObject'],
   wgpu_canvas_context_get_current_texture: function(canvasContext) {
     {{{ wdebuglog('`wgpu_canvas_context_get_current_texture(canvasContext=${canvasContext})`'); }}}
     {{{ wassert('canvasContext != 0'); }}}
-    {{{ wassert('wgpu[canvasContext]'); }}}
-    {{{ wassert('wgpu[canvasContext] instanceof GPUCanvasContext'); }}}
+    {{{ wassert(wgpuObject('canvasContext')); }}}
+    {{{ wassert(wgpuIsType('canvasContext', 'GPUCanvasContext')); }}}
 
-    canvasContext = wgpu[canvasContext];
+    canvasContext = {{{ wgpuObject('canvasContext') }}};
     // The canvas context texture is a special texture that automatically invalidates itself after the current rAF()
     // callback if over. Therefore when a new swap chain texture is produced, we need to delete the old one to avoid
     // accumulating references to stale textures from each frame.
@@ -508,17 +980,56 @@ let api = {
     // Acquire the new canvas context texture..
     var canvasTexture = canvasContext['getCurrentTexture']();
     {{{ wassert('canvasTexture'); }}}
-    if (canvasTexture != wgpu[1]) {
+    if (canvasTexture != {{{ wgpuObject('1') }}}) {
       // ... and destroy previous special canvas context texture, if it was an old one.
       _wgpu_object_destroy(1);
       wgpu[1] = canvasTexture;
       canvasTexture.wid = 1;
+      wgpuSetType(1, 5/*WGPU_OBJECT_TYPE_TEXTURE*/);
+      wgpuCountCreatedObject(5/*WGPU_OBJECT_TYPE_TEXTURE*/);
       wgpuLinkParentAndChild(canvasContext, 1, canvasTexture);
     }
     // The canvas context texture is hardcoded the special ID 1. Return that ID to caller.
     return 1;
   },
 
+  wgpu_canvas_context_get_current_texture_view__deps: ['wgpu_canvas_context_get_current_texture', '$wgpuStoreAndSetParent', '$wgpuFreeIds', '$wgpuTransientScopeStart', '$wgpuCountCreatedObject', '$wgpuCountDestroyedObject'],
+  wgpu_canvas_context_get_current_texture_view: function(canvasContext) {
+    {{{ wdebuglog('`wgpu_canvas_context_get_current_texture_view(canvasContext=${canvasContext})`'); }}}
+    _wgpu_canvas_context_get_current_texture(canvasContext);
+    canvasContext = {{{ wgpuObject('canvasContext') }}};
+    // The view to the canvas texture is cached in the context, as a child of the context.
+    var texture = {{{ wgpuObject('1') }}}, cached = canvasContext.currentTextureView, id = cached?.wid;
+    if (id && cached.canvasTexture == texture) return id;
+
+    var view = texture['createView']();
+    view.canvasTexture = texture;
+    if (id) {
+      // The canvas texture has rotated: replace the old view with the new one under the same ID, so that the view
+      // keeps an ID outside of any active transient scope.
+      cached.wid = 0;
+      wgpu[{{{ wgpuSlot('id') }}}] = view;
+      view.wid = id;
+      view.parentObject = canvasContext;
+      canvasContext.derivedObjects.set(id, view);
+      wgpuCountDestroyedObject(6/*WGPU_OBJECT_TYPE_TEXTURE_VIEW*/);
+      wgpuCountCreatedObject(6/*WGPU_OBJECT_TYPE_TEXTURE_VIEW*/);
+    } else if (!wgpuTransientScopeStart || wgpuFreeIds.length) {
+      // The view is owned by the context, so it must not be released at the end of an active transient scope. Take
+      // an ID from the free list for it instead.
+      var transientScopeStart = wgpuTransientScopeStart;
+      wgpuTransientScopeStart = 0;
+      wgpuStoreAndSetParent(view, canvasContext);
+      wgpuTransientScopeStart = transientScopeStart;
+    } else {
+      // The first view of the context is created inside a transient scope, and there is no free ID outside of it:
+      // use a transient view for this frame, and cache the view of a later frame.
+      return wgpuStoreAndSetParent(view, texture);
+    }
+    canvasContext.currentTextureView = view;
+    return view.wid;
+  },
+
   wgpuReportErrorCodeAndMessage__deps: ['$lengthBytesUTF8', '$stringToUTF8'
 #if parseInt(EMSCRIPTEN_VERSION.split('.')[0]) > 3 || (parseInt(EMSCRIPTEN_VERSION.split('.')[0]) == 3 && parseInt(EMSCRIPTEN_VERSION.split('.')[1]) > 1) || (parseInt(EMSCRIPTEN_VERSION.split('.')[0]) == 3 && parseInt(EMSCRIPTEN_VERSION.split('.')[1]) == 1 && parseInt(EMSCRIPTEN_VERSION.split('.')[2]) >= 57)
   , '$stackSave', '$stackAlloc', '$stackRestore'
@@ -543,9 +1054,9 @@ let api = {
   wgpu_device_set_lost_callback__deps: ['wgpuReportErrorCodeAndMessage'],
   wgpu_device_set_lost_callback: function(device, callback, userData) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    wgpu[device]['lost'].then(deviceLostInfo => {
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    {{{ wgpuObject('device') }}}['lost'].then(deviceLostInfo => {
       {{{ wdebuglog("`WebGPU device lost. Reason: ${deviceLostInfo['reason']}`"); }}}
       _wgpuReportErrorCodeAndMessage(device, callback,
         +(deviceLostInfo['reason'][0] == 'd')/*WGPU_DEVICE_LOST_REASON_DESTROYED=1, UNKNOWN=0*/,
@@ -555,9 +1066,9 @@ let api = {
 
   wgpu_device_push_error_scope: function(device, filter) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    wgpu[device]['pushErrorScope']([, 'out-of-memory', 'validation', 'internal'][filter]);
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    {{{ wgpuObject('device') }}}['pushErrorScope']([, 'out-of-memory', 'validation', 'internal'][filter]);
   },
 
   wgpuErrorObjectToErrorType: function(error) {
@@ -600,12 +1111,12 @@ let api = {
   wgpu_device_pop_error_scope_async__deps: ['wgpuDispatchWebGpuErrorEvent', 'wgpuMuteJsExceptions'],
   wgpu_device_pop_error_scope_async: function(device, callback, userData) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('callback'); }}}
 
     let d = error => _wgpuDispatchWebGpuErrorEvent(device, callback, error, userData);
-    wgpu[device]['popErrorScope']().then(_wgpuMuteJsExceptions(d)).catch(d);
+    {{{ wgpuObject('device') }}}['popErrorScope']().then(_wgpuMuteJsExceptions(d)).catch(d);
   },
 
   wgpu_device_pop_error_scope_sync__deps: ['_wgpuNumAsyncifiedOperationsPending', '$wgpu_async', 'wgpuMuteJsExceptions', '$stringToUTF8', 'wgpuErrorObjectToErrorType'],
@@ -614,8 +1125,8 @@ let api = {
   wgpu_device_pop_error_scope_sync: function(device, msg, msgLen) {
     return wgpu_async(() => {
       {{{ wassert('device != 0'); }}}
-      {{{ wassert('wgpu[device]'); }}}
-      {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+      {{{ wassert(wgpuObject('device')); }}}
+      {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
       {{{ wassert('msgLen >= 0'); }}}
       {{{ wassert('msg || msgLen == 0'); }}}
 
@@ -630,7 +1141,7 @@ let api = {
       };
 
       ++__wgpuNumAsyncifiedOperationsPending;
-      return wgpu[device]['popErrorScope']()
+      return {{{ wgpuObject('device') }}}['popErrorScope']()
         .then(_wgpuMuteJsExceptions(dispatchErrorCallback))
         .catch(dispatchErrorCallback);
     });
@@ -639,9 +1150,9 @@ let api = {
   wgpu_device_set_uncapturederror_callback__deps: ['wgpuDispatchWebGpuErrorEvent'],
   wgpu_device_set_uncapturederror_callback: function(device, callback, userData) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    wgpu[device]['onuncapturederror'] = callback ? function(uncapturedError) {
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    {{{ wgpuObject('device') }}}['onuncapturederror'] = callback ? function(uncapturedError) {
       {{{ wdebugdir('uncapturedError'); }}}
       _wgpuDispatchWebGpuErrorEvent(device, callback, uncapturedError['error'], userData);
     } : null;
@@ -777,13 +1288,13 @@ let api = {
   },
 #endif
 
-  navigator_gpu_get_preferred_canvas_format__deps: ['$GPUTextureAndVertexFormats'],
+  navigator_gpu_get_preferred_canvas_format__deps: ['$GPUTextureAndVertexFormatIds'],
   navigator_gpu_get_preferred_canvas_format: function() {
     {{{ wdebuglog('`navigator_gpu_get_preferred_canvas_format()`'); }}}
     {{{ wassert('navigator["gpu"], "Your browser does not support WebGPU!"'); }}}
 
-    {{{ wassert('GPUTextureAndVertexFormats.includes(navigator["gpu"]["getPreferredCanvasFormat"]())'); }}}
-    return GPUTextureAndVertexFormats.indexOf(navigator['gpu']['getPreferredCanvasFormat']());
+    {{{ wassert('GPUTextureAndVertexFormatIds.has(navigator["gpu"]["getPreferredCanvasFormat"]())'); }}}
+    return GPUTextureAndVertexFormatIds.get(navigator['gpu']['getPreferredCanvasFormat']());
   },
 
   navigator_gpu_get_wgsl_language_features__deps: ['$stringToUTF8OnStack', '$stackAlloc'],
@@ -818,14 +1329,14 @@ let api = {
   wgpu_adapter_or_device_get_features: function(adapterOrDevice) {
     {{{ wdebuglog('`wgpu_adapter_or_device_get_features(adapterOrDevice: ${adapterOrDevice})`'); }}}
     {{{ wassert('adapterOrDevice != 0'); }}}
-    {{{ wassert('wgpu[adapterOrDevice]'); }}}
-    {{{ wassert('wgpu[adapterOrDevice] instanceof GPUAdapter || wgpu[adapterOrDevice] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('adapterOrDevice')); }}}
+    {{{ wassert(wgpuIsType('adapterOrDevice', 'GPUAdapter', 'GPUDevice')); }}}
     let featuresBitMask = 0;
 
     {{{ wdebuglog('`The following adapter features are supported:`'); }}}
 
     _wgpuFeatures.forEach((feature, i) => {
-      if (wgpu[adapterOrDevice]['features'].has(feature)) {
+      if ({{{ wgpuObject('adapterOrDevice') }}}['features'].has(feature)) {
         {{{ wdebuglog('` - "${feature}", feature bit 0x${(1<<i).toString(16)}`'); }}}
         featuresBitMask |= 1 << i;
       }
@@ -838,9 +1349,9 @@ let api = {
     {{{ wdebuglog('`wgpu_adapter_or_device_supports_feature(adapterOrDevice: ${adapterOrDevice}, feature: ${feature} == ${_wgpuFeatures[31 - Math.clz32(feature)]})`'); }}}
     {{{ wassert('adapterOrDevice != 0'); }}}
     {{{ wassert('(feature & (feature-1)) == 0'); }}} // Only call on a single feature at a time, not a bit combination of multiple features!
-    {{{ wassert('wgpu[adapterOrDevice]'); }}}
-    {{{ wassert('wgpu[adapterOrDevice] instanceof GPUAdapter || wgpu[adapterOrDevice] instanceof GPUDevice'); }}}
-    return wgpu[adapterOrDevice]['features'].has(_wgpuFeatures[31 - Math.clz32(feature)])
+    {{{ wassert(wgpuObject('adapterOrDevice')); }}}
+    {{{ wassert(wgpuIsType('adapterOrDevice', 'GPUAdapter', 'GPUDevice')); }}}
+    return {{{ wgpuObject('adapterOrDevice') }}}['features'].has(_wgpuFeatures[31 - Math.clz32(feature)])
   },
 
   wgpu_adapter_or_device_get_limits__deps: ['wgpu32BitLimitNames', 'wgpu64BitLimitNames', '$wgpuWriteI53ToU64HeapIdx'],
@@ -848,10 +1359,10 @@ let api = {
     {{{ wdebuglog('`wgpu_adapter_or_device_get_limits(adapterOrDevice: ${adapterOrDevice}, limits: ${limits})`'); }}}
     {{{ wassert('limits != 0, "passed a null limits struct pointer"'); }}}
     {{{ wassert('adapterOrDevice != 0'); }}}
-    {{{ wassert('wgpu[adapterOrDevice]'); }}}
-    {{{ wassert('wgpu[adapterOrDevice] instanceof GPUAdapter || wgpu[adapterOrDevice] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('adapterOrDevice')); }}}
+    {{{ wassert(wgpuIsType('adapterOrDevice', 'GPUAdapter', 'GPUDevice')); }}}
 
-    let l = wgpu[adapterOrDevice]['limits'];
+    let l = {{{ wgpuObject('adapterOrDevice') }}}['limits'];
 
     {{{ replacePtrToIdx('limits', 2); }}}
     for(let limitName of _wgpu64BitLimitNames) {
@@ -886,12 +1397,13 @@ let api = {
     return requiredLimits;
   },
 
+  $wgpuReadQueueDescriptor__deps: ['$utf8Cached'],
   $wgpuReadQueueDescriptor: function(heap32Idx) {
 #if MEMORY64
     {{{ wassert('heap32Idx % 2 == 0'); }}} // Must be aligned at 64-bit boundary
-    let v = HEAPU64[heap32Idx >>> 1]; return v ? { 'label': utf8(v) } : void 0;
+    let v = HEAPU64[heap32Idx >>> 1]; return v ? { 'label': utf8Cached(v) } : void 0;
 #else
-    let v = HEAPU32[heap32Idx]; return v ? { 'label': utf8(v) } : void 0;
+    let v = HEAPU32[heap32Idx]; return v ? { 'label': utf8Cached(v) } : void 0;
 #endif
   },
 
@@ -923,10 +1435,10 @@ let api = {
   wgpu_adapter_request_device_async: function(adapter, descriptor, deviceCallback, userData) {
     {{{ wdebuglog('`wgpu_adapter_request_device_async(adapter: ${adapter}, deviceCallback: ${deviceCallback}, userData: ${userData})`'); }}}
     {{{ wassert('adapter != 0'); }}}
-    {{{ wassert('wgpu[adapter]'); }}}
-    {{{ wassert('wgpu[adapter] instanceof GPUAdapter'); }}}
+    {{{ wassert(wgpuObject('adapter')); }}}
+    {{{ wassert(wgpuIsType('adapter', 'GPUAdapter')); }}}
 
-    adapter = wgpu[adapter];
+    adapter = {{{ wgpuObject('adapter') }}};
     let cb = device => {
       // If device is non-null, initialization succeeded.
       {{{ wdebugdir('device', '`adapter.requestDevice resolved with following device:`'); }}}
@@ -957,10 +1469,10 @@ let api = {
     return wgpu_async(() => {
       {{{ wdebuglog('`wgpu_adapter_request_device_sync(adapter: ${adapter})`'); }}}
       {{{ wassert('adapter != 0'); }}}
-      {{{ wassert('wgpu[adapter]'); }}}
-      {{{ wassert('wgpu[adapter] instanceof GPUAdapter'); }}}
+      {{{ wassert(wgpuObject('adapter')); }}}
+      {{{ wassert(wgpuIsType('adapter', 'GPUAdapter')); }}}
 
-      adapter = wgpu[adapter];
+      adapter = {{{ wgpuObject('adapter') }}};
       let cb = device => {
         // If device is non-null, initialization succeeded.
         {{{ wdebugdir('device', '`adapter.requestDevice resolved with following device:`'); }}}
@@ -986,9 +1498,9 @@ let api = {
   wgpu_adapter_request_device_async_simple: function(adapter, deviceCallback) {
     {{{ wdebuglog('`wgpu_adapter_request_device_async_simple(adapter: ${adapter}, deviceCallback=${deviceCallback})`'); }}}
     {{{ wassert('adapter != 0'); }}}
-    {{{ wassert('wgpu[adapter]'); }}}
-    {{{ wassert('wgpu[adapter] instanceof GPUAdapter'); }}}
-    adapter = wgpu[adapter];
+    {{{ wassert(wgpuObject('adapter')); }}}
+    {{{ wassert(wgpuIsType('adapter', 'GPUAdapter')); }}}
+    adapter = {{{ wgpuObject('adapter') }}};
     adapter['requestDevice']().then(device => {
       // Register an ID for the queue of this newly created device (using a ?. if device initialization succeeded)
       wgpuStoreAndSetParent(device?.['queue'], device);
@@ -1009,10 +1521,10 @@ let api = {
     return wgpu_async(() => {
       {{{ wdebuglog('`wgpu_adapter_request_device_sync_simple(adapter: ${adapter})`'); }}}
       {{{ wassert('adapter != 0'); }}}
-      {{{ wassert('wgpu[adapter]'); }}}
-      {{{ wassert('wgpu[adapter] instanceof GPUAdapter'); }}}
+      {{{ wassert(wgpuObject('adapter')); }}}
+      {{{ wassert(wgpuIsType('adapter', 'GPUAdapter')); }}}
       ++__wgpuNumAsyncifiedOperationsPending;
-      adapter = wgpu[adapter];
+      adapter = {{{ wgpuObject('adapter') }}};
       return adapter['requestDevice']().then(device => {
         // Register an ID for the queue of this newly created device (using a ?. if device initialization succeeded)
         wgpuStoreAndSetParent(device?.['queue'], device);
@@ -1026,12 +1538,12 @@ let api = {
   wgpu_adapter_or_device_get_info: function(adapterOrDevice, infoPtr) {
     {{{ wdebuglog('`wgpu_adapter_or_device_get_info(adapterOrDevice: ${adapterOrDevice}, info: ${infoPtr})`'); }}}
     {{{ wassert('adapterOrDevice != 0'); }}}
-    {{{ wassert('wgpu[adapterOrDevice]'); }}}
-    {{{ wassert('wgpu[adapterOrDevice] instanceof GPUAdapter || wgpu[adapterOrDevice] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('adapterOrDevice')); }}}
+    {{{ wassert(wgpuIsType('adapterOrDevice', 'GPUAdapter', 'GPUDevice')); }}}
     {{{ wassert('infoPtr != 0'); }}}
     var infoIdx = {{{ shiftPtr('infoPtr', 2) }}},
       infoByteIdx = {{{ shiftPtr('infoPtr', 0) }}},
-      ao = wgpu[adapterOrDevice],
+      ao = {{{ wgpuObject('adapterOrDevice') }}},
       adapterInfo = ao['adapterInfo'] || ao['info'];
     {{{ wdebugdir('adapterInfo', '`GPUAdapter.info is a member with following parameters:`'); }}}
 
@@ -1044,14 +1556,14 @@ let api = {
   wgpu_device_get_queue: function(device) {
     {{{ wdebuglog('`wgpu_device_get_queue(device=${device})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    {{{ wassert('wgpu[device].wid == device', "GPUDevice has lost its wid member field!"); }}}
-    {{{ wassert('wgpu[device]["queue"].wid', "GPUDevice.queue must have been assigned an ID in function wgpu_adapter_request_device!"); }}}
-    return wgpu[device]['queue'].wid;
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    {{{ wassert(`${wgpuObject('device')}.wid == device`, "GPUDevice has lost its wid member field!"); }}}
+    {{{ wassert(`${wgpuObject('device')}["queue"].wid`, "GPUDevice.queue must have been assigned an ID in function wgpu_adapter_request_device!"); }}}
+    return {{{ wgpuObject('device') }}}['queue'].wid;
   },
 
-  $wgpuReadShaderModuleCompilationHints__deps: ['$GPUAutoLayoutMode'],
+  $wgpuReadShaderModuleCompilationHints__deps: ['$utf8Cached', '$GPUAutoLayoutMode'],
   $wgpuReadShaderModuleCompilationHints: function(index) {
     let numHints = HEAP32[index+2],
       hints = [],
@@ -1064,11 +1576,11 @@ let api = {
       // layout == 1 (WGPU_AUTO_LAYOUT_MODE_AUTO) means { layout: 'auto' } hint will be passed.
       // layout > 1: A handle to a given GPUPipelineLayout object is specified as a hint for creating the shader.
       // See https://github.com/gpuweb/gpuweb/pull/2876#issuecomment-1218341636
-      {{{ wassert('layout <= 1 || wgpu[layout]'); }}}
-      {{{ wassert('layout <= 1 || wgpu[layout] instanceof GPUPipelineLayout'); }}}
+      {{{ wassert(`layout <= 1 || ${wgpuObject('layout')}`); }}}
+      {{{ wassert('layout <= 1 || ' + wgpuIsType('layout', 'GPUPipelineLayout')); }}}
       hints.push({
-        'entryPoint': utf8({{{ readPtrFromIdx32('hintsIndex') }}}),
-        'layout': layout > 1 ? wgpu[layout] : (layout ? GPUAutoLayoutMode : void 0)
+        'entryPoint': utf8Cached({{{ readPtrFromIdx32('hintsIndex') }}}),
+        'layout': layout > 1 ? {{{ wgpuObject('layout') }}} : (layout ? GPUAutoLayoutMode : void 0)
       });
       hintsIndex += 4;
     }
@@ -1093,10 +1605,10 @@ let api = {
   wgpu_device_create_shader_module: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_shader_module(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
 
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     let desc = wgpuReadShaderModuleDescriptor(descriptor);
     {{{ wdebugdir('desc', '`device.createShaderModule() with descriptor:`') }}};
     return wgpuStoreAndSetParent(device['createShaderModule'](desc), device);
@@ -1106,10 +1618,10 @@ let api = {
   wgpu_shader_module_get_compilation_info_async: function(shaderModule, callback, userData) {
     {{{ wdebuglog('`wgpu_shader_module_get_compilation_info_async(shaderModule=${shaderModule}, callback=${callback}, userData=${userData})`'); }}}
     {{{ wassert('shaderModule != 0'); }}}
-    {{{ wassert('wgpu[shaderModule]'); }}}
-    {{{ wassert('wgpu[shaderModule] instanceof GPUShaderModule'); }}}
+    {{{ wassert(wgpuObject('shaderModule')); }}}
+    {{{ wassert(wgpuIsType('shaderModule', 'GPUShaderModule')); }}}
     {{{ wassert('callback != 0'); }}}
-    wgpu[shaderModule]['getCompilationInfo']().then(info => {
+    {{{ wgpuObject('shaderModule') }}}['getCompilationInfo']().then(info => {
       {{{ wdebugdir('info', '`shaderModule.getCompilationInfo() completed with info:`'); }}}
       // To optimize marshalling, call into malloc() just once, and marshal the compilationInfo
       // object into one memory block, with the following layout:
@@ -1161,10 +1673,10 @@ let api = {
   wgpu_device_create_buffer: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_buffer(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor != 0'); }}}
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     {{{ replacePtrToIdx('descriptor', 2); }}}
 
     let desc = {
@@ -1185,15 +1697,15 @@ let api = {
   wgpu_buffer_get_mapped_range: function(gpuBuffer, offset, size) {
     {{{ wdebuglog('`wgpu_buffer_get_mapped_range(gpuBuffer=${gpuBuffer}, offset=${offset}, size=${size})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(offset)'); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size)'); }}}
     {{{ wassert('size >= -1'); }}}
 
     {{{ wdebuglog("`gpuBuffer.getMappedRange(offset=${offset}, size=${size}):`"); }}}
-    gpuBuffer = wgpu[gpuBuffer];
+    gpuBuffer = {{{ wgpuObject('gpuBuffer') }}};
     try {
       gpuBuffer.mappedRanges[offset] = gpuBuffer['getMappedRange'](offset, size < 0 ? void 0 : size);
     } catch(e) {
@@ -1208,9 +1720,9 @@ let api = {
   wgpu_buffer_read_mapped_range: function(gpuBuffer, startOffset, subOffset, dst, size) {
     {{{ wdebuglog('`wgpu_buffer_read_mapped_range(gpuBuffer=${gpuBuffer}, startOffset=${startOffset}, subOffset=${subOffset}, dst=${dst}, size=${size})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    {{{ wassert('wgpu[gpuBuffer].mappedRanges[startOffset]', "wgpu_buffer_read_mapped_range: No such mapped range with specified startOffset!"); }}}
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    {{{ wassert(`${wgpuObject('gpuBuffer')}.mappedRanges[startOffset]`, "wgpu_buffer_read_mapped_range: No such mapped range with specified startOffset!"); }}}
     {{{ wassert('Number.isSafeInteger(startOffset)'); }}}
     {{{ wassert('startOffset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(subOffset)'); }}}
@@ -1221,15 +1733,15 @@ let api = {
 
     // N.b. this generates garbage because JavaScript does not allow ArrayBufferView.set(ArrayBuffer, offset, size, dst)
     // but must create a dummy view.
-    HEAPU8.set(new Uint8Array(wgpu[gpuBuffer].mappedRanges[startOffset], subOffset, size), {{{ shiftPtr('dst', 0) }}} );
+    HEAPU8.set(new Uint8Array({{{ wgpuObject('gpuBuffer') }}}.mappedRanges[startOffset], subOffset, size), {{{ shiftPtr('dst', 0) }}} );
   },
 
   wgpu_buffer_write_mapped_range: function(gpuBuffer, startOffset, subOffset, src, size) {
     {{{ wdebuglog('`wgpu_buffer_write_mapped_range(gpuBuffer=${gpuBuffer}, startOffset=${startOffset}, subOffset=${subOffset}, src=${src}, size=${size})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    {{{ wassert('wgpu[gpuBuffer].mappedRanges[startOffset]', "wgpu_buffer_write_mapped_range: No such mapped range with specified startOffset!"); }}}
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    {{{ wassert(`${wgpuObject('gpuBuffer')}.mappedRanges[startOffset]`, "wgpu_buffer_write_mapped_range: No such mapped range with specified startOffset!"); }}}
     {{{ wassert('Number.isSafeInteger(startOffset)'); }}}
     {{{ wassert('startOffset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(subOffset)'); }}}
@@ -1240,15 +1752,15 @@ let api = {
 
     // Here 'buffer' refers to the global Wasm memory buffer.
     // N.b. generates garbage.
-    new Uint8Array(wgpu[gpuBuffer].mappedRanges[startOffset]).set(new Uint8Array(HEAPU8.buffer, {{{ shiftPtr('src', 0) }}}, size), subOffset);
+    new Uint8Array({{{ wgpuObject('gpuBuffer') }}}.mappedRanges[startOffset]).set(new Uint8Array(HEAPU8.buffer, {{{ shiftPtr('src', 0) }}}, size), subOffset);
   },
 
   wgpu_buffer_unmap: function(gpuBuffer) {
     {{{ wdebuglog('`wgpu_buffer_unmap(gpuBuffer=${gpuBuffer})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    gpuBuffer = wgpu[gpuBuffer];
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    gpuBuffer = {{{ wgpuObject('gpuBuffer') }}};
     gpuBuffer['unmap']();
 
     // Let GC reclaim all previous getMappedRange()s for this buffer.
@@ -1258,53 +1770,29 @@ let api = {
   wgpu_buffer_size: function(gpuBuffer) {
     {{{ wdebuglog('`wgpu_buffer_size(gpuBuffer=${gpuBuffer})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    return wgpu[gpuBuffer]['size'];
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    return {{{ wgpuObject('gpuBuffer') }}}['size'];
   },
 
   wgpu_buffer_usage: function(gpuBuffer) {
     {{{ wdebuglog('`wgpu_buffer_usage(gpuBuffer=${gpuBuffer})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    return wgpu[gpuBuffer]['usage'];
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    return {{{ wgpuObject('gpuBuffer') }}}['usage'];
   },
 
   wgpu_buffer_map_state: function(gpuBuffer) {
     {{{ wdebuglog('`wgpu_buffer_map_state(gpuBuffer=${gpuBuffer})`'); }}}
     {{{ wassert('gpuBuffer != 0'); }}}
-    {{{ wassert('wgpu[gpuBuffer]'); }}}
-    {{{ wassert('wgpu[gpuBuffer] instanceof GPUBuffer'); }}}
-    {{{ wassert('["unmapped","pending","mapped"].includes(wgpu[gpuBuffer]["mapState"])'); }}}
-    return ' upm'.indexOf(wgpu[gpuBuffer]['mapState'][0]); // 'u'nmapped=1, 'p'ending=2, 'm'apped=3
-  },
-
-  $wgpuReadGpuStencilFaceState__deps: ['$GPUCompareFunctions', '$GPUStencilOperations'],
-  $wgpuReadGpuStencilFaceState: function(idx) {
-    {{{ wassert('idx != 0'); }}}
-    return {
-      'compare': GPUCompareFunctions[HEAPU32[idx]],
-      'failOp': GPUStencilOperations[HEAPU32[idx+1]],
-      'depthFailOp': GPUStencilOperations[HEAPU32[idx+2]],
-      'passOp': GPUStencilOperations[HEAPU32[idx+3]]
-    };
-  },
-
-  $wgpuReadGpuBlendComponent__deps: ['$GPUBlendOperations', '$GPUBlendFactors'],
-  $wgpuReadGpuBlendComponent: function(idx) {
-    {{{ wassert('idx != 0'); }}}
-    {{{ wassert('GPUBlendOperations[HEAPU32[idx]]'); }}}
-    {{{ wassert('GPUBlendFactors[HEAPU32[idx+1]]'); }}}
-    {{{ wassert('GPUBlendFactors[HEAPU32[idx+2]]'); }}}
-    return {
-      'operation': GPUBlendOperations[HEAPU32[idx]],
-      'srcFactor': GPUBlendFactors[HEAPU32[idx+1]],
-      'dstFactor': GPUBlendFactors[HEAPU32[idx+2]]
-    };
+    {{{ wassert(wgpuObject('gpuBuffer')); }}}
+    {{{ wassert(wgpuIsType('gpuBuffer', 'GPUBuffer')); }}}
+    {{{ wassert(`["unmapped","pending","mapped"].includes(${wgpuObject('gpuBuffer')}["mapState"])`); }}}
+    return ' upm'.indexOf({{{ wgpuObject('gpuBuffer') }}}['mapState'][0]); // 'u'nmapped=1, 'p'ending=2, 'm'apped=3
   },
 
-  $wgpuReadRenderPipelineDescriptor__deps: ['$wgpuReadGpuStencilFaceState', '$wgpuReadGpuBlendComponent', '$wgpuReadI53FromU64HeapIdx', '$wgpuReadConstants', '$GPUIndexFormats', '$GPUTextureAndVertexFormats', '$GPUCompareFunctions', '$GPUPrimitiveTopologys', '$GPUAutoLayoutMode'],
+  $wgpuReadRenderPipelineDescriptor__deps: ['$wgpuReadGpuPrimitiveState', '$wgpuReadGpuDepthStencilState', '$wgpuReadGpuMultisampleState', '$wgpuReadGpuBlendComponent', '$wgpuReadI53FromU64HeapIdx', '$wgpuReadConstants', '$utf8Cached', '$GPUTextureAndVertexFormats', '$GPUVertexStepModes', '$GPUAutoLayoutMode'],
   $wgpuReadRenderPipelineDescriptor: function(descriptor) {
     {{{ wassert('descriptor != 0'); }}}
     {{{ replacePtrToIdx('descriptor', 2); }}}
@@ -1314,20 +1802,20 @@ let api = {
         vertexIdx = descriptor,
         numVertexBuffers = HEAP32[vertexIdx+7], // +7 == WGpuVertexState.numBuffers
         vertexBuffersIdx = {{{ readIdx32('vertexIdx+2') }}}, // +2 == WGpuVertexState.buffers
-        primitiveIdx = vertexIdx + 10, // sizeof(WGpuVertexState)
-        depthStencilIdx = primitiveIdx + 5, // sizeof(WGpuPrimitiveState)
-        multisampleIdx = depthStencilIdx + 17, // sizeof(WGpuDepthStencilState)
-        fragmentIdx = multisampleIdx + 4, // sizeof(WGpuMultisampleState) + 1 for unused padding
+        primitiveIdx = descriptor + {{{ wgpuStructs.WGpuRenderPipelineDescriptor.primitive }}},
+        depthStencilIdx = descriptor + {{{ wgpuStructs.WGpuRenderPipelineDescriptor.depthStencil }}},
+        multisampleIdx = descriptor + {{{ wgpuStructs.WGpuRenderPipelineDescriptor.multisample }}},
+        fragmentIdx = descriptor + {{{ wgpuStructs.WGpuRenderPipelineDescriptor.fragment }}},
         numTargets = HEAP32[fragmentIdx+7], // +7 == WGpuFragmentState.numTargets
         targetsIdx = {{{ readIdx32('fragmentIdx+2') }}}, // +2 == WGpuFragmentState.targets
         depthStencilFormat = HEAPU32[depthStencilIdx],
         multisampleCount = HEAPU32[multisampleIdx],
         fragmentModule = HEAPU32[fragmentIdx+6],
-        pipelineLayoutId = HEAPU32[fragmentIdx+10], // sizeof(WGpuFragmentState)
+        pipelineLayoutId = HEAPU32[descriptor+{{{ wgpuStructs.WGpuRenderPipelineDescriptor.layout }}}],
         desc;
 
-    {{{ wassert('pipelineLayoutId <= 1/*"auto"*/ || wgpu[pipelineLayoutId]'); }}}
-    {{{ wassert('pipelineLayoutId <= 1/*"auto"*/ || wgpu[pipelineLayoutId] instanceof GPUPipelineLayout'); }}}
+    {{{ wassert(`pipelineLayoutId <= 1/*"auto"*/ || ${wgpuObject('pipelineLayoutId')}`); }}}
+    {{{ wassert('pipelineLayoutId <= 1/*"auto"*/ || ' + wgpuIsType('pipelineLayoutId', 'GPUPipelineLayout')); }}}
 
     // Read GPUVertexState
     {{{ wassert('numVertexBuffers >= 0'); }}}
@@ -1342,14 +1830,14 @@ let api = {
           'shaderLocation': HEAPU32[attributesIdx+2],
           'format': GPUTextureAndVertexFormats[HEAPU32[attributesIdx+3]]
         });
-        attributesIdx += 4;
+        attributesIdx += {{{ wgpuStructs.WGpuVertexAttribute.sizeof }}};
       }
       vertexBuffers.push({
         'arrayStride': wgpuReadI53FromU64HeapIdx(vertexBuffersIdx+4),
-        'stepMode': [, 'vertex', 'instance'][HEAPU32[vertexBuffersIdx+3]],
+        'stepMode': GPUVertexStepModes[HEAPU32[vertexBuffersIdx+3]],
         'attributes': attributes
       });
-      vertexBuffersIdx += 6; // sizeof(WGpuVertexBufferLayout)
+      vertexBuffersIdx += {{{ wgpuStructs.WGpuVertexBufferLayout.sizeof }}};
     }
 
     {{{ wassert('numTargets >= 0'); }}}
@@ -1365,50 +1853,28 @@ let api = {
         } : void 0,
         'writeMask': HEAPU32[targetsIdx+7]
       } : null);
-      targetsIdx += 8;
+      targetsIdx += {{{ wgpuStructs.WGpuColorTargetState.sizeof }}};
     }
 
     desc = {
       'vertex': {
-        'module': wgpu[HEAPU32[vertexIdx+6]],
-        // If null pointer was passed to use the default entry point name, then utf8() would return '', but spec requires undefined.
-        'entryPoint': utf8({{{ readPtrFromIdx32('vertexIdx') }}}) || void 0,
+        'module': {{{ wgpuObject('HEAPU32[vertexIdx+6]') }}},
+        // If null pointer was passed to use the default entry point name, then utf8Cached() would return '', but spec requires undefined.
+        'entryPoint': utf8Cached({{{ readPtrFromIdx32('vertexIdx') }}}) || void 0,
         'buffers': vertexBuffers,
         'constants': wgpuReadConstants({{{ readPtrFromIdx32('vertexIdx+4') }}}, HEAP32[vertexIdx+8])
       },
       'fragment': fragmentModule ? {
-        'module': wgpu[fragmentModule],
-        // If null pointer was passed to use the default entry point name, then utf8() would return '', but spec requires undefined.
-        'entryPoint': utf8({{{ readPtrFromIdx32('fragmentIdx') }}}) || void 0,
+        'module': {{{ wgpuObject('fragmentModule') }}},
+        // If null pointer was passed to use the default entry point name, then utf8Cached() would return '', but spec requires undefined.
+        'entryPoint': utf8Cached({{{ readPtrFromIdx32('fragmentIdx') }}}) || void 0,
         'targets': targets,
         'constants': wgpuReadConstants({{{ readPtrFromIdx32('fragmentIdx+4') }}}, HEAP32[fragmentIdx+8])
       } : void 0,
-      'primitive': {
-        'topology': GPUPrimitiveTopologys[HEAPU32[primitiveIdx]],
-        'stripIndexFormat': GPUIndexFormats[HEAPU32[primitiveIdx+1]],
-        'frontFace': [, 'ccw', 'cw'][HEAPU32[primitiveIdx+2]],
-        'cullMode': [, 'none', 'front', 'back'][HEAPU32[primitiveIdx+3]],
-        'unclippedDepth': !!HEAPU32[primitiveIdx+4]
-      },
-      'depthStencil': depthStencilFormat ? {
-        'format': GPUTextureAndVertexFormats[depthStencilFormat],
-        'depthWriteEnabled': !!HEAPU32[depthStencilIdx+1],
-        'depthCompare': GPUCompareFunctions[HEAPU32[depthStencilIdx+2]],
-        'stencilReadMask': HEAPU32[depthStencilIdx+3],
-        'stencilWriteMask': HEAPU32[depthStencilIdx+4],
-        'depthBias': HEAP32[depthStencilIdx+5],
-        'depthBiasSlopeScale': HEAPF32[depthStencilIdx+6],
-        'depthBiasClamp': HEAPF32[depthStencilIdx+7],
-        'stencilFront': wgpuReadGpuStencilFaceState(depthStencilIdx+8),
-        'stencilBack': wgpuReadGpuStencilFaceState(depthStencilIdx+12),
-        'clampDepth': !!HEAPU32[depthStencilIdx+16],
-      } : void 0,
-      'multisample': multisampleCount ? {
-        'count': multisampleCount,
-        'mask': HEAPU32[multisampleIdx+1],
-        'alphaToCoverageEnabled': !!HEAPU32[multisampleIdx+2]
-      } : void 0,
-      'layout': pipelineLayoutId > 1 ? wgpu[pipelineLayoutId] : GPUAutoLayoutMode
+      'primitive': wgpuReadGpuPrimitiveState(primitiveIdx),
+      'depthStencil': depthStencilFormat ? wgpuReadGpuDepthStencilState(depthStencilIdx) : void 0,
+      'multisample': multisampleCount ? wgpuReadGpuMultisampleState(multisampleIdx) : void 0,
+      'layout': pipelineLayoutId > 1 ? {{{ wgpuObject('pipelineLayoutId') }}} : GPUAutoLayoutMode
     };
 
     return desc;
@@ -1418,14 +1884,85 @@ let api = {
   wgpu_device_create_render_pipeline: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_render_pipeline(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor'); }}}
 
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     let desc = wgpuReadRenderPipelineDescriptor(descriptor);
     {{{ wdebugdir('desc', '`GPUDevice.createRenderPipeline() with descriptor:`') }}};
-    return wgpuStoreAndSetParent(device['createRenderPipeline'](desc), device);
+    let pipeline = device['createRenderPipeline'](desc);
+    // Retain the descriptor for wgpu_device_create_render_pipeline_variant(), if requested.
+    if (HEAPU32[{{{ shiftPtr('descriptor', 2) }}}+{{{ wgpuStructs.WGpuRenderPipelineDescriptor.retainDescriptor }}}]) pipeline.desc = desc;
+    return wgpuStoreAndSetParent(pipeline, device);
+  },
+
+  wgpu_device_create_render_pipeline_variant__deps: ['$wgpuReadGpuBlendComponent', '$wgpuReadConstants', '$wgpuStoreAndSetParent', '$GPUIndexFormats', '$GPUCompareFunctions', '$GPUPrimitiveTopologys', '$GPUFrontFaces', '$GPUCullModes'],
+  wgpu_device_create_render_pipeline_variant: function(device, base, delta) {
+    {{{ wdebuglog('`wgpu_device_create_render_pipeline_variant(device=${device}, base=${base}, delta=${delta})`'); }}}
+    {{{ wassert('device != 0'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    {{{ wassert(wgpuObject('base')); }}}
+    {{{ wassert(wgpuIsType('base', 'GPURenderPipeline')); }}}
+    {{{ wassert(`${wgpuObject('base')}.desc, "Base render pipeline must be created with retainDescriptor set!"`); }}}
+    {{{ wassert('delta != 0'); }}}
+    {{{ replacePtrToIdx('delta', 2); }}}
+
+    device = {{{ wgpuObject('device') }}};
+    // Shallow copy the base descriptor, and then copy only those sub-objects that the delta modifies.
+    let desc = {...{{{ wgpuObject('base') }}}.desc},
+      fields = HEAPU32[delta],
+      primitive, depthStencil, fragment, blend;
+
+    if (fields & 7/*WGPU_RENDER_PIPELINE_DELTA_TOPOLOGY|FRONT_FACE|CULL_MODE*/) {
+      primitive = desc['primitive'] = {...desc['primitive']};
+      if (fields & 1/*WGPU_RENDER_PIPELINE_DELTA_TOPOLOGY*/) {
+        primitive['topology'] = GPUPrimitiveTopologys[HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.topology }}}]];
+        primitive['stripIndexFormat'] = GPUIndexFormats[HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.stripIndexFormat }}}]];
+      }
+      if (fields & 2/*WGPU_RENDER_PIPELINE_DELTA_FRONT_FACE*/) primitive['frontFace'] = GPUFrontFaces[HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.frontFace }}}]];
+      if (fields & 4/*WGPU_RENDER_PIPELINE_DELTA_CULL_MODE*/) primitive['cullMode'] = GPUCullModes[HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.cullMode }}}]];
+    }
+
+    if (fields & 0x38/*WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE|DEPTH_WRITE|DEPTH_BIAS*/) {
+      {{{ wassert('desc["depthStencil"], "Base render pipeline must have a depth-stencil state to apply a depth delta to it!"'); }}}
+      depthStencil = desc['depthStencil'] = {...desc['depthStencil']};
+      if (fields & 8/*WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE*/) depthStencil['depthCompare'] = GPUCompareFunctions[HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.depthCompare }}}]];
+      if (fields & 0x10/*WGPU_RENDER_PIPELINE_DELTA_DEPTH_WRITE*/) depthStencil['depthWriteEnabled'] = !!HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.depthWriteEnabled }}}];
+      if (fields & 0x20/*WGPU_RENDER_PIPELINE_DELTA_DEPTH_BIAS*/) {
+        depthStencil['depthBias'] = HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.depthBias }}}];
+        depthStencil['depthBiasSlopeScale'] = HEAPF32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.depthBiasSlopeScale }}}];
+        depthStencil['depthBiasClamp'] = HEAPF32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.depthBiasClamp }}}];
+      }
+    }
+
+    if (HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.numVertexConstants }}}]) desc['vertex'] = {
+      ...desc['vertex'],
+      'constants': {...desc['vertex']['constants'], ...wgpuReadConstants({{{ readPtrFromIdx32(`delta+${wgpuStructs.WGpuRenderPipelineDelta.vertexConstants}`) }}}, HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.numVertexConstants }}}])}
+    };
+
+    if (desc['fragment'] && ((fields & 0xC0/*WGPU_RENDER_PIPELINE_DELTA_BLEND|WRITE_MASK*/) || HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.numFragmentConstants }}}])) {
+      fragment = desc['fragment'] = {...desc['fragment']};
+      if (fields & 0xC0) {
+        blend = HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.blend }}}] ? {
+          'color': wgpuReadGpuBlendComponent(delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.blend }}}),
+          'alpha': wgpuReadGpuBlendComponent(delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.blend + wgpuStructs.WGpuBlendState.alpha }}})
+        } : void 0;
+        // Sparse (null) color targets stay null.
+        fragment['targets'] = fragment['targets'].map(t => t && {
+          ...t,
+          'blend': fields & 0x40/*WGPU_RENDER_PIPELINE_DELTA_BLEND*/ ? blend : t['blend'],
+          'writeMask': fields & 0x80/*WGPU_RENDER_PIPELINE_DELTA_WRITE_MASK*/ ? HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.writeMask }}}] : t['writeMask']
+        });
+      }
+      if (HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.numFragmentConstants }}}]) fragment['constants'] = {...fragment['constants'], ...wgpuReadConstants({{{ readPtrFromIdx32(`delta+${wgpuStructs.WGpuRenderPipelineDelta.fragmentConstants}`) }}}, HEAP32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.numFragmentConstants }}}])};
+    }
+
+    {{{ wdebugdir('desc', '`GPUDevice.createRenderPipeline() with variant descriptor:`') }}};
+    let pipeline = device['createRenderPipeline'](desc);
+    if (HEAPU32[delta+{{{ wgpuStructs.WGpuRenderPipelineDelta.retainDescriptor }}}]) pipeline.desc = desc;
+    return wgpuStoreAndSetParent(pipeline, device);
   },
 
   $wgpuPipelineCreationFailed__deps: ['malloc', 'free', '$stringToNewUTF8'],
@@ -1453,18 +1990,20 @@ let api = {
   wgpu_device_create_render_pipeline_async: function(device, descriptor, callback, userData) {
     {{{ wdebuglog('`wgpu_device_create_render_pipeline_async(device=${device}, descriptor=${descriptor}, callback=${callback}, userData=${userData})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor'); }}}
     {{{ wassert('callback'); }}}
-    let deviceObject = wgpu[device];
+    let deviceObject = {{{ wgpuObject('device') }}};
 
     let cb = (pipeline) => {
       {{{ wdebugdir('pipeline', '`createRenderPipelineAsync completed with pipeline:`'); }}}
+      if (pipeline && retainDescriptor) pipeline.desc = desc;
       {{{ makeDynCall('vipip', 'callback') }}}(device, {{{ toWasm64('0') }}}, wgpuStoreAndSetParent(pipeline, deviceObject), userData);
     };
 
-    let desc = wgpuReadRenderPipelineDescriptor(descriptor);
+    let desc = wgpuReadRenderPipelineDescriptor(descriptor),
+      retainDescriptor = HEAPU32[{{{ shiftPtr('descriptor', 2) }}}+{{{ wgpuStructs.WGpuRenderPipelineDescriptor.retainDescriptor }}}];
     {{{ wdebugdir('desc', '`GPUDevice.createRenderPipelineAsync() with descriptor:`') }}};
     deviceObject['createRenderPipelineAsync'](desc)
       .then(_wgpuMuteJsExceptions(cb))
@@ -1481,9 +2020,9 @@ let api = {
   wgpu_device_create_command_encoder: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_command_encoder(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    device = wgpu[device];
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+    device = {{{ wgpuObject('device') }}};
     return wgpuStoreAndSetParent(device['createCommandEncoder'](), device);
   },
 
@@ -1492,7 +2031,7 @@ let api = {
   // args and creating readable test cases etc.
   wgpu_device_create_command_encoder_simple__deps: ['$wgpuStoreAndSetParent'],
   wgpu_device_create_command_encoder_simple: function(device) {
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     return wgpuStoreAndSetParent(device['createCommandEncoder'](), device);
   },
 
@@ -1500,10 +2039,10 @@ let api = {
   wgpu_device_create_render_bundle_encoder: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_render_bundle_encoder(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor != 0'); }}} // Must be non-null
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     {{{ replacePtrToIdx('descriptor', 2); }}}
 
     let colorFormats = [],
@@ -1532,10 +2071,10 @@ let api = {
   wgpu_device_create_query_set: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_query_set(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor != 0'); }}} // Must be non-null
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     {{{ replacePtrToIdx('descriptor', 2); }}}
 
     let desc = {
@@ -1549,15 +2088,15 @@ let api = {
   wgpu_buffer_map_async: function(buffer, callback, userData, mode, offset, size) {
     {{{ wdebuglog('`wgpu_buffer_map_async(buffer=${buffer}, callback=${callback}, userData=${userData}, mode=${mode}, offset=${offset}, size=${size})`'); }}}
     {{{ wassert('buffer != 0'); }}}
-    {{{ wassert('wgpu[buffer]'); }}}
-    {{{ wassert('wgpu[buffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('buffer')); }}}
+    {{{ wassert(wgpuIsType('buffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(offset)'); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size)'); }}}
     {{{ wassert('size >= -1'); }}}
 
     // N.b. mapAsync() is broken in Firefox <= 151. https://bugzil.la/1994733
-    wgpu[buffer]['mapAsync'](mode, offset, size < 0 ? void 0 : size).then(() => {{{ makeDynCall('vipidd', 'callback') }}}(buffer, userData, mode, offset, size));
+    {{{ wgpuObject('buffer') }}}['mapAsync'](mode, offset, size < 0 ? void 0 : size).then(() => {{{ makeDynCall('vipidd', 'callback') }}}(buffer, userData, mode, offset, size));
   },
 
 #if ASYNCIFY
@@ -1568,14 +2107,14 @@ let api = {
     return wgpu_async(() => {
       {{{ wdebuglog('`wgpu_buffer_map_sync(buffer=${buffer}, mode=${mode}, offset=${offset}, size=${size})`'); }}}
       {{{ wassert('buffer != 0'); }}}
-      {{{ wassert('wgpu[buffer]'); }}}
-      {{{ wassert('wgpu[buffer] instanceof GPUBuffer'); }}}
+      {{{ wassert(wgpuObject('buffer')); }}}
+      {{{ wassert(wgpuIsType('buffer', 'GPUBuffer')); }}}
       {{{ wassert('Number.isSafeInteger(offset)'); }}}
       {{{ wassert('offset >= 0'); }}}
       {{{ wassert('Number.isSafeInteger(size)'); }}}
       {{{ wassert('size >= -1'); }}}
 
-      buffer = wgpu[buffer];
+      buffer = {{{ wgpuObject('buffer') }}};
       ++__wgpuNumAsyncifiedOperationsPending;
 
       // N.b. mapAsync() is broken in Firefox <= 151. https://bugzil.la/1994733
@@ -1589,10 +2128,10 @@ let api = {
   wgpu_device_create_texture: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_texture(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor != 0'); }}} // Must be non-null
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
 
     {{{ replacePtrToIdx('descriptor', 2); }}}
     {{{ wassert('HEAPU32[descriptor+8] >= 1'); }}} // 'dimension' must be one of 1d, 2d or 3d.
@@ -1614,15 +2153,23 @@ let api = {
     return wgpuStoreAndSetParent(texture, device);
   },
 
-  wgpu_device_create_sampler__deps: ['$wgpuStoreAndSetParent', '$GPUAddressModes', '$GPUFilterModes', '$GPUCompareFunctions'],
+  wgpu_device_create_sampler__deps: ['$wgpuStoreAndSetParent', '$GPUAddressModes', '$GPUFilterModes', '$GPUCompareFunctions'
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  , '$wgpuInternLookup', '$wgpuIntern'
+#endif
+  ],
   wgpu_device_create_sampler: function(device, descriptor) {
     {{{ wdebuglog('`wgpu_device_create_sampler(device=${device}, descriptor=${descriptor})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    device = wgpu[device];
-
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ replacePtrToIdx('descriptor', 2); }}}
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    let key = `S${device},${descriptor && HEAPU32.subarray(descriptor, descriptor + 10)}`, id = wgpuInternLookup(key);
+    if (id) return id;
+#endif
+    device = {{{ wgpuObject('device') }}};
+
     let desc = descriptor ? {
       'addressModeU': GPUAddressModes[HEAPU32[descriptor]],
       'addressModeV': GPUAddressModes[HEAPU32[descriptor+1]],
@@ -1638,7 +2185,11 @@ let api = {
     } : void 0;
     {{{ wdebugdir('desc', '`GPUDevice.createSampler() with descriptor:`'); }}}
 
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    return wgpuIntern(key, wgpuStoreAndSetParent(device['createSampler'](desc), device));
+#else
     return wgpuStoreAndSetParent(device['createSampler'](desc), device);
+#endif
   },
 
   // This is a JavaScript facing API function for calling GPUDevice.importExternalTexture().
@@ -1648,11 +2199,11 @@ let api = {
   wgpuDeviceImportExternalTexture__deps: ['$wgpuStoreAndSetParent'],
   wgpuDeviceImportExternalTexture: function(device, descriptor) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor'); }}}
     {{{ wassert('descriptor["source"]'); }}}
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
 
     return wgpuStoreAndSetParent(device['importExternalTexture'](descriptor), device);
   },
@@ -1663,19 +2214,19 @@ let api = {
   // descriptor: a pointer to a GPUExternalTextureDescriptor struct in Wasm heap
   wgpu_device_import_external_texture: function(device, descriptor) {
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('descriptor'); }}}
 
     {{{ replacePtrToIdx('descriptor', 2); }}}
 
-    {{{ wassert('wgpu[HEAPU32[descriptor]]'); }}}
-    {{{ wassert('wgpu[HEAPU32[descriptor]] instanceof HTMLVideoElement'); }}}
+    {{{ wassert(wgpuObject('HEAPU32[descriptor]')); }}}
+    {{{ wassert(`${wgpuObject('HEAPU32[descriptor]')} instanceof HTMLVideoElement`); }}}
 
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
 
     return wgpuStoreAndSetParent(device['importExternalTexture']({
-      'source': wgpu[HEAPU32[descriptor]]
+      'source': {{{ wgpuObject('HEAPU32[descriptor]') }}}
       // TODO: If/when GPUExternalTextureDescriptor.colorSpace field gains other values than 'srgb', add reading those fields in here.
     }), device);
   },
@@ -1727,52 +2278,79 @@ let api = {
     }
   },
 
-  wgpu_device_create_bind_group_layout__deps: ['$wgpuStoreAndSetParent', '$wgpuReadBindGroupLayoutDescriptor'],
+  wgpu_device_create_bind_group_layout__deps: ['$wgpuStoreAndSetParent', '$wgpuReadBindGroupLayoutDescriptor'
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  , '$wgpuInternLookup', '$wgpuIntern'
+#endif
+  ],
   wgpu_device_create_bind_group_layout: function(device, entries, numEntries) {
     {{{ wdebuglog('`wgpu_device_create_bind_group_layout(device=${device}, entries=${entries}, numEntries=${numEntries})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    device = wgpu[device];
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    // Each WGpuBindGroupLayoutEntry is 8 uint32s.
+    let key = `B${device},${HEAPU32.subarray({{{ shiftPtr('entries', 2) }}}, {{{ shiftPtr('entries', 2) }}} + 8*numEntries)}`, id = wgpuInternLookup(key);
+    if (id) return id;
+#endif
+    device = {{{ wgpuObject('device') }}};
 
     let desc = wgpuReadBindGroupLayoutDescriptor(entries, numEntries);
     {{{ wdebugdir('desc', '`GPUDevice.createBindGroupLayout() with descriptor:`'); }}}
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    return wgpuIntern(key, wgpuStoreAndSetParent(device['createBindGroupLayout'](desc), device));
+#else
     return wgpuStoreAndSetParent(device['createBindGroupLayout'](desc), device);
+#endif
   },
 
-  wgpu_device_create_pipeline_layout__deps: ['$wgpuStoreAndSetParent', '$wgpuReadArrayOfItemsMaybeNull'],
+  wgpu_device_create_pipeline_layout__deps: ['$wgpuStoreAndSetParent', '$wgpuReadArrayOfItemsMaybeNull'
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+  , '$wgpuInternLookup', '$wgpuIntern', 'wgpu_object_get_serial'
+#endif
+  ],
   wgpu_device_create_pipeline_layout: function(device, layouts, numLayouts, immediateSize) {
     {{{ wdebuglog('`wgpu_device_create_pipeline_layout(device=${device}, layouts=${layouts}, numLayouts=${numLayouts})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
-    device = wgpu[device];
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    // Bind group layouts are interned as well, so identical pipeline layouts refer to the same bind group layouts. Key on
+    // their serial numbers rather than their IDs, since a new bind group layout may reuse the ID of a destroyed one.
+    let key = `P${device},${immediateSize},${Array.from(HEAPU32.subarray({{{ shiftPtr('layouts', 2) }}}, {{{ shiftPtr('layouts', 2) }}} + numLayouts), _wgpu_object_get_serial)}`, id = wgpuInternLookup(key);
+    if (id) return id;
+#endif
+    device = {{{ wgpuObject('device') }}};
 
     let desc = {
       'bindGroupLayouts': wgpuReadArrayOfItemsMaybeNull(wgpu, layouts, numLayouts),
       'immediateSize': immediateSize
     };
     {{{ wdebugdir('desc', '`GPUDevice.createPipelineLayout() with descriptor:`') }}};
+#if parseInt(globalThis.WEBGPU_OBJECT_INTERNING)
+    return wgpuIntern(key, wgpuStoreAndSetParent(device['createPipelineLayout'](desc), device));
+#else
     return wgpuStoreAndSetParent(device['createPipelineLayout'](desc), device);
+#endif
   },
 
   wgpu_device_create_bind_group__deps: ['$wgpuStoreAndSetParent', '$wgpuReadI53FromU64HeapIdx'],
   wgpu_device_create_bind_group: function(device, layout, entries, numEntries) {
     {{{ wdebuglog('`wgpu_device_create_bind_group(device=${device}, layout=${layout}, entries=${entries}, numEntries=${numEntries})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('layout != 0'); }}} // Must be a valid BindGroupLayout
     {{{ wassert('layout > 1'); }}} // Cannot pass WGPU_AUTO_LAYOUT_MODE_NO_HINT or WGPU_AUTO_LAYOUT_MODE_AUTO to this function
-    {{{ wassert('wgpu[layout]'); }}}
-    {{{ wassert('wgpu[layout] instanceof GPUBindGroupLayout'); }}}
+    {{{ wassert(wgpuObject('layout')); }}}
+    {{{ wassert(wgpuIsType('layout', 'GPUBindGroupLayout')); }}}
     {{{ wassert('numEntries >= 0'); }}}
     {{{ wassert('entries != 0 || numEntries == 0'); }}} // Must be non-null pointer
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
     {{{ replacePtrToIdx('entries', 2); }}}
     let e = [];
     while(numEntries--) {
-      let resource = wgpu[HEAPU32[entries + 1]];
+      let resource = {{{ wgpuObject('HEAPU32[entries + 1]') }}};
       {{{ wassert('resource'); }}}
       e.push({
         'binding': HEAPU32[entries],
@@ -1786,32 +2364,199 @@ let api = {
     }
 
     let desc = {
-      'layout': wgpu[layout],
+      'layout': {{{ wgpuObject('layout') }}},
       'entries': e
     };
     {{{ wdebugdir('desc', '`GPUDevice.createBindGroup() with descriptor:`') }}};
     return wgpuStoreAndSetParent(device['createBindGroup'](desc), device);
   },
 
+  // Bind group cache: maps a key string built from the layout and the entries of a bind group to the cached GPUBindGroup.
+  // A Map iterates in insertion order, so keeping the most recently used bind group at the end of the Map makes the first
+  // bind group in the Map the least recently used one.
+  $wgpuBindGroupCache: '=new Map()',
+  $wgpuBindGroupCacheCapacity: 4096,
+  $wgpuBindGroupCacheNumHits: 0,
+  $wgpuBindGroupCacheNumMisses: 0,
+  $wgpuBindGroupCacheNumEvictions: 0,
+
+  wgpu_device_create_bind_group_cached__deps: ['wgpu_device_create_bind_group', 'wgpu_object_destroy', '$wgpuBindGroupCache', '$wgpuBindGroupCacheCapacity',
+    '$wgpuBindGroupCacheNumHits', '$wgpuBindGroupCacheNumMisses', '$wgpuBindGroupCacheNumEvictions'],
+  wgpu_device_create_bind_group_cached: function(device, layout, entries, numEntries) {
+    {{{ wdebuglog('`wgpu_device_create_bind_group_cached(device=${device}, layout=${layout}, entries=${entries}, numEntries=${numEntries})`'); }}}
+    {{{ wassert('numEntries >= 0'); }}}
+    let entriesIdx = {{{ shiftPtr('entries', 2) }}},
+      // Each WGpuBindGroupEntry is 6 uint32s. The device does not need to be part of the key, since the layout belongs to a single device.
+      key = `${layout},${HEAPU32.subarray(entriesIdx, entriesIdx + 6*numEntries)}`,
+      bindGroup = wgpuBindGroupCache.get(key);
+
+    if (bindGroup) {
+      // Move the bind group to the most recently used end of the cache.
+      wgpuBindGroupCache.delete(key);
+      wgpuBindGroupCache.set(key, bindGroup);
+      ++wgpuBindGroupCacheNumHits;
+      return bindGroup.wid;
+    }
+
+    ++wgpuBindGroupCacheNumMisses;
+    let id = _wgpu_device_create_bind_group(device, layout, entries, numEntries);
+    if (id) {
+      bindGroup = {{{ wgpuObject('id') }}};
+      // Register the bind group with its layout and each resource that it references, so that destroying any of them evicts the
+      // bind group from the cache.
+      let resources = [{{{ wgpuObject('layout') }}}];
+      for(let i = 0; i < numEntries; ++i) {
+        let resource = {{{ wgpuObject('HEAPU32[entriesIdx + 6*i + 1]') }}};
+        if (resource) resources.push(resource);
+      }
+      resources.forEach(r => (r.cacheDependents ??= new Set()).add(bindGroup));
+      bindGroup.uncache = () => {
+        wgpuBindGroupCache.delete(key);
+        resources.forEach(r => r.cacheDependents.delete(bindGroup));
+      };
+      wgpuBindGroupCache.set(key, bindGroup);
+
+      if (wgpuBindGroupCache.size > wgpuBindGroupCacheCapacity) {
+        ++wgpuBindGroupCacheNumEvictions;
+        _wgpu_object_destroy(wgpuBindGroupCache.values().next().value.wid);
+      }
+    }
+    return id;
+  },
+
+  wgpu_bind_group_cache_set_capacity__deps: ['$wgpuBindGroupCache', '$wgpuBindGroupCacheCapacity', '$wgpuBindGroupCacheNumEvictions', 'wgpu_object_destroy'],
+  wgpu_bind_group_cache_set_capacity: function(maxBindGroups) {
+    {{{ wassert('maxBindGroups >= 0'); }}}
+    wgpuBindGroupCacheCapacity = maxBindGroups;
+    while(wgpuBindGroupCache.size > wgpuBindGroupCacheCapacity) {
+      ++wgpuBindGroupCacheNumEvictions;
+      _wgpu_object_destroy(wgpuBindGroupCache.values().next().value.wid);
+    }
+  },
+
+  wgpu_bind_group_cache_clear__deps: ['$wgpuBindGroupCache', 'wgpu_object_destroy'],
+  wgpu_bind_group_cache_clear: function() {
+    wgpuBindGroupCache.forEach(bindGroup => _wgpu_object_destroy(bindGroup.wid));
+  },
+
+  wgpu_get_bind_group_cache_stats__deps: ['$wgpuBindGroupCache', '$wgpuBindGroupCacheNumHits', '$wgpuBindGroupCacheNumMisses', '$wgpuBindGroupCacheNumEvictions'],
+  wgpu_get_bind_group_cache_stats: function(stats) {
+    {{{ wassert('stats != 0'); }}}
+    {{{ replacePtrToIdx('stats', 2); }}}
+    HEAPU32[stats] = wgpuBindGroupCache.size;
+    HEAPU32[stats+1] = wgpuBindGroupCacheNumHits;
+    HEAPU32[stats+2] = wgpuBindGroupCacheNumMisses;
+    HEAPU32[stats+3] = wgpuBindGroupCacheNumEvictions;
+  },
+
+  // Render bundle cache: maps an application chosen key to the GPURenderBundle that was recorded for it.
+  $wgpuRenderBundleCache: '=new Map()',
+  $wgpuRenderBundleCacheNumHits: 0,
+  $wgpuRenderBundleCacheNumMisses: 0,
+
+  wgpu_render_bundle_cache_begin__deps: ['wgpu_device_create_render_bundle_encoder', '$wgpuRenderBundleCache', '$wgpuRenderBundleCacheNumHits',
+    '$wgpuRenderBundleCacheNumMisses'],
+  wgpu_render_bundle_cache_begin: function(device, key, descriptor) {
+    {{{ wdebuglog('`wgpu_render_bundle_cache_begin(device=${device}, key=${key}, descriptor=${descriptor})`'); }}}
+    if (wgpuRenderBundleCache.has(key)) {
+      ++wgpuRenderBundleCacheNumHits;
+      return 0;
+    }
+
+    ++wgpuRenderBundleCacheNumMisses;
+    let id = _wgpu_device_create_render_bundle_encoder(device, descriptor);
+    if (id) {
+      // Collect the objects that the recorded commands reference, by shadowing the methods of this encoder that take objects with
+      // ones that add the object to the set. Each method name is paired with the index of its object argument.
+      let encoder = {{{ wgpuObject('id') }}}, references = encoder.bundleCacheReferences = new Set();
+      [['setPipeline', 0], ['setBindGroup', 1], ['setIndexBuffer', 0], ['setVertexBuffer', 1], ['drawIndirect', 0], ['drawIndexedIndirect', 0]].forEach(([name, arg]) => {
+        let f = encoder[name];
+        encoder[name] = function() {
+          if (arguments[arg]) references.add(arguments[arg]);
+          return f.apply(encoder, arguments);
+        };
+      });
+    }
+    return id;
+  },
+
+  wgpu_render_bundle_cache_end__deps: ['wgpu_object_destroy', '$wgpuStore', '$wgpuRenderBundleCache'],
+  wgpu_render_bundle_cache_end: function(passEncoder, key, bundleEncoder) {
+    {{{ wdebuglog('`wgpu_render_bundle_cache_end(passEncoder=${passEncoder}, key=${key}, bundleEncoder=${bundleEncoder})`'); }}}
+    {{{ wassert('passEncoder != 0'); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder')); }}}
+    let bundle;
+    if (bundleEncoder) {
+      {{{ wassert(wgpuIsType('bundleEncoder', 'GPURenderBundleEncoder')); }}}
+      let encoder = {{{ wgpuObject('bundleEncoder') }}}, references = [...encoder.bundleCacheReferences];
+      bundle = encoder['finish']();
+      _wgpu_object_destroy(bundleEncoder);
+      // Replace a bundle that was recorded for the same key in the meantime.
+      if (wgpuRenderBundleCache.has(key)) _wgpu_object_destroy(wgpuRenderBundleCache.get(key).wid);
+      wgpuStore(bundle);
+      // If an object that the bundle references was destroyed while recording, the bundle is not valid. It is executed anyway,
+      // so that the validation error surfaces, but it is not cached.
+      if (references.some(r => !r.wid)) {
+        {{{ wgpuObject('passEncoder') }}}['executeBundles']([bundle]);
+        _wgpu_object_destroy(bundle.wid);
+        return;
+      }
+      // Register the bundle with each object that it references, so that destroying any of them evicts the bundle from the cache,
+      // and the next wgpu_render_bundle_cache_begin() call with this key records the bundle again.
+      references.forEach(r => (r.cacheDependents ??= new Set()).add(bundle));
+      bundle.uncache = () => {
+        wgpuRenderBundleCache.delete(key);
+        references.forEach(r => r.cacheDependents.delete(bundle));
+      };
+      wgpuRenderBundleCache.set(key, bundle);
+    } else {
+      bundle = wgpuRenderBundleCache.get(key);
+      {{{ wassert(`bundle, 'wgpu_render_bundle_cache_end() called without a bundle encoder for a key that is not in the cache!'`); }}}
+    }
+    {{{ wdebuglog('`GPURenderPassEncoder.executeBundles() with cached bundle of key ${key}`'); }}}
+    {{{ wgpuObject('passEncoder') }}}['executeBundles']([bundle]);
+  },
+
+  wgpu_render_bundle_cache_invalidate__deps: ['$wgpuRenderBundleCache', 'wgpu_object_destroy'],
+  wgpu_render_bundle_cache_invalidate: function(key) {
+    let bundle = wgpuRenderBundleCache.get(key);
+    if (bundle) _wgpu_object_destroy(bundle.wid);
+  },
+
+  wgpu_render_bundle_cache_clear__deps: ['$wgpuRenderBundleCache', 'wgpu_object_destroy'],
+  wgpu_render_bundle_cache_clear: function() {
+    wgpuRenderBundleCache.forEach(bundle => _wgpu_object_destroy(bundle.wid));
+  },
+
+  wgpu_get_render_bundle_cache_stats__deps: ['$wgpuRenderBundleCache', '$wgpuRenderBundleCacheNumHits', '$wgpuRenderBundleCacheNumMisses'],
+  wgpu_get_render_bundle_cache_stats: function(stats) {
+    {{{ wassert('stats != 0'); }}}
+    {{{ replacePtrToIdx('stats', 2); }}}
+    HEAPU32[stats] = wgpuRenderBundleCache.size;
+    HEAPU32[stats+1] = wgpuRenderBundleCacheNumHits;
+    HEAPU32[stats+2] = wgpuRenderBundleCacheNumMisses;
+  },
+
+  $wgpuReadConstants__deps: ['$utf8Cached'],
   $wgpuReadConstants: function(constants, numConstants) {
     {{{ wassert('numConstants >= 0'); }}}
     {{{ wassert('constants != 0 || numConstants == 0'); }}}
 
     let c = {};
     while(numConstants--) {
-      c[utf8({{{ readPtr('constants') }}})] = HEAPF64[{{{ shiftPtr('constants + ' + toWasm64('8'), 3) }}}];
+      c[utf8Cached({{{ readPtr('constants') }}})] = HEAPF64[{{{ shiftPtr('constants + ' + toWasm64('8'), 3) }}}];
       constants += {{{ toWasm64('16') }}};
     }
     return c;
   },
 
-  $wgpuReadComputePipelineDescriptor__deps: ['$wgpuReadConstants', '$GPUAutoLayoutMode'],
+  $wgpuReadComputePipelineDescriptor__deps: ['$wgpuReadConstants', '$utf8Cached', '$GPUAutoLayoutMode'],
   $wgpuReadComputePipelineDescriptor: function(computeModule, entryPoint, layout, constants, numConstants) {
     return {
-      'layout': layout > 1 ? wgpu[layout] : GPUAutoLayoutMode,
+      'layout': layout > 1 ? {{{ wgpuObject('layout') }}} : GPUAutoLayoutMode,
       'compute': {
-        'module': wgpu[computeModule],
-        'entryPoint': utf8(entryPoint) || void 0, // If null pointer was passed to use the default entry point name, then utf8() would return '', but spec requires undefined.
+        'module': {{{ wgpuObject('computeModule') }}},
+        'entryPoint': utf8Cached(entryPoint) || void 0, // If null pointer was passed to use the default entry point name, then utf8Cached() would return '', but spec requires undefined.
         'constants': wgpuReadConstants(constants, numConstants)
       }
     };
@@ -1821,17 +2566,17 @@ let api = {
   wgpu_device_create_compute_pipeline: function(device, computeModule, entryPoint, layout, constants, numConstants) {
     {{{ wdebuglog('`wgpu_device_create_compute_pipeline(device=${device}, computeModule=${computeModule}, entryPoint=${entryPoint}, layout=${layout}, constants=${constants}, numConstants=${numConstants})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('computeModule != 0'); }}}
-    {{{ wassert('wgpu[computeModule]'); }}}
-    {{{ wassert('wgpu[computeModule] instanceof GPUShaderModule'); }}}
-    {{{ wassert('layout <= 1/*"auto"*/ || wgpu[layout]'); }}}
-    {{{ wassert('layout <= 1/*"auto"*/ || wgpu[layout] instanceof GPUPipelineLayout'); }}}
+    {{{ wassert(wgpuObject('computeModule')); }}}
+    {{{ wassert(wgpuIsType('computeModule', 'GPUShaderModule')); }}}
+    {{{ wassert(`layout <= 1/*"auto"*/ || ${wgpuObject('layout')}`); }}}
+    {{{ wassert('layout <= 1/*"auto"*/ || ' + wgpuIsType('layout', 'GPUPipelineLayout')); }}}
     {{{ wassert('numConstants >= 0'); }}}
     {{{ wassert('numConstants == 0 || constants'); }}}
     {{{ wassert('!entryPoint || utf8(entryPoint).length > 0'); }}} // If entry point string is provided, it must be a nonempty JS string
-    device = wgpu[device];
+    device = {{{ wgpuObject('device') }}};
 
     let desc = wgpuReadComputePipelineDescriptor(computeModule, entryPoint, layout, constants, numConstants);
     {{{ wdebugdir('desc', '`GPUDevice.createComputePipeline() with descriptor:`') }}};
@@ -1843,18 +2588,18 @@ let api = {
   wgpu_device_create_compute_pipeline_async: function(device, computeModule, entryPoint, layout, constants, numConstants, callback, userData) {
     {{{ wdebuglog('`wgpu_device_create_compute_pipeline_async(device=${device}, computeModule=${computeModule}, entryPoint=${entryPoint}, layout=${layout}, constants=${constants}, numConstants=${numConstants}, callback=${callback}, userData=${userData})`'); }}}
     {{{ wassert('device != 0'); }}}
-    {{{ wassert('wgpu[device]'); }}}
-    {{{ wassert('wgpu[device] instanceof GPUDevice'); }}}
+    {{{ wassert(wgpuObject('device')); }}}
+    {{{ wassert(wgpuIsType('device', 'GPUDevice')); }}}
     {{{ wassert('computeModule != 0'); }}}
-    {{{ wassert('wgpu[computeModule]'); }}}
-    {{{ wassert('wgpu[computeModule] instanceof GPUShaderModule'); }}}
-    {{{ wassert('layout <= 1/*"auto"*/ || wgpu[layout]'); }}}
-    {{{ wassert('layout <= 1/*"auto"*/ || wgpu[layout] instanceof GPUPipelineLayout'); }}}
+    {{{ wassert(wgpuObject('computeModule')); }}}
+    {{{ wassert(wgpuIsType('computeModule', 'GPUShaderModule')); }}}
+    {{{ wassert(`layout <= 1/*"auto"*/ || ${wgpuObject('layout')}`); }}}
+    {{{ wassert('layout <= 1/*"auto"*/ || ' + wgpuIsType('layout', 'GPUPipelineLayout')); }}}
     {{{ wassert('numConstants >= 0'); }}}
     {{{ wassert('numConstants == 0 || constants'); }}}
     {{{ wassert('!entryPoint || utf8(entryPoint).length > 0'); }}} // If entry point string is provided, it must be a nonempty JS string
     {{{ wassert('callback'); }}}
-    let deviceObject = wgpu[device];
+    let deviceObject = {{{ wgpuObject('device') }}};
 
     let cb = (pipeline) => {
       {{{ wdebugdir('pipeline', '`createComputePipelineAsync succeeded with pipeline:`'); }}}
@@ -1879,9 +2624,9 @@ let api = {
   wgpu_texture_create_view: function(texture, descriptor) {
     {{{ wdebuglog('`wgpu_texture_create_view(texture=${texture}, descriptor=${descriptor})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    texture = wgpu[texture];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    texture = {{{ wgpuObject('texture') }}};
 
     var descriptorIdx = {{{ shiftPtr('descriptor', 2) }}},
       descriptorByteIdx = {{{ shiftPtr('descriptor', 0) }}};
@@ -1908,50 +2653,50 @@ let api = {
   wgpu_texture_create_view_simple: function(texture) {
     {{{ wdebuglog('`wgpu_texture_create_view_simple(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    texture = wgpu[texture];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    texture = {{{ wgpuObject('texture') }}};
     return wgpuStoreAndSetParent(texture['createView'](), texture);
   },
 
   wgpu_texture_width: function(texture) {
     {{{ wdebuglog('`wgpu_texture_width(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['width'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['width'];
   },
 
   wgpu_texture_height: function(texture) {
     {{{ wdebuglog('`wgpu_texture_height(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['height'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['height'];
   },
 
   wgpu_texture_depth_or_array_layers: function(texture) {
     {{{ wdebuglog('`wgpu_texture_depth_or_array_layers(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['depthOrArrayLayers'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['depthOrArrayLayers'];
   },
 
   wgpu_texture_mip_level_count: function(texture) {
     {{{ wdebuglog('`wgpu_texture_mip_level_count(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['mipLevelCount'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['mipLevelCount'];
   },
 
   wgpu_texture_sample_count: function(texture) {
     {{{ wdebuglog('`wgpu_texture_sample_count(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['sampleCount'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['sampleCount'];
   },
 
 #if ASSERTIONS || globalThis.WEBGPU_DEBUG
@@ -1960,56 +2705,56 @@ let api = {
   wgpu_texture_dimension: function(texture) {
     {{{ wdebuglog('`wgpu_texture_dimension(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    {{{ wassert('GPUTextureDimensions.indexOf(wgpu[texture]["dimension"]) != -1'); }}}
-    {{{ wassert('GPUTextureDimensions.indexOf(wgpu[texture]["dimension"]) == +wgpu[texture]["dimension"][0]'); }}}
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    {{{ wassert(`GPUTextureDimensions.indexOf(${wgpuObject('texture')}["dimension"]) != -1`); }}}
+    {{{ wassert(`GPUTextureDimensions.indexOf(${wgpuObject('texture')}["dimension"]) == +${wgpuObject('texture')}["dimension"][0]`); }}}
     // N.b. instead of indexing to the string array, e.g.
     // return GPUTextureDimensions.indexOf(wgpu[texture]['dimension']);
     // Look up the enum value arithmetically.
-    return +wgpu[texture]['dimension'][0];
+    return +{{{ wgpuObject('texture') }}}['dimension'][0];
   },
 
-  wgpu_texture_format__deps: ['$GPUTextureAndVertexFormats'],
+  wgpu_texture_format__deps: ['$GPUTextureAndVertexFormatIds'],
   wgpu_texture_format: function(texture) {
     {{{ wdebuglog('`wgpu_texture_format(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    {{{ wassert('GPUTextureAndVertexFormats.indexOf(wgpu[texture]["format"]) != -1'); }}}
-    return GPUTextureAndVertexFormats.indexOf(wgpu[texture]['format']);
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    {{{ wassert(`GPUTextureAndVertexFormatIds.has(${wgpuObject('texture')}["format"])`); }}}
+    return GPUTextureAndVertexFormatIds.get({{{ wgpuObject('texture') }}}['format']);
   },
 
   wgpu_texture_usage: function(texture) {
     {{{ wdebuglog('`wgpu_texture_usage(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return wgpu[texture]['usage'];
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return {{{ wgpuObject('texture') }}}['usage'];
   },
 
-  wgpu_texture_binding_view_dimension__deps: ['$GPUTextureViewDimensions'],
+  wgpu_texture_binding_view_dimension__deps: ['$GPUTextureViewDimensionIds'],
   wgpu_texture_binding_view_dimension: function(texture) {
     {{{ wdebuglog('`wgpu_texture_binding_view_dimension(texture=${texture})`'); }}}
     {{{ wassert('texture != 0'); }}}
-    {{{ wassert('wgpu[texture]'); }}}
-    {{{ wassert('wgpu[texture] instanceof GPUTexture'); }}}
-    return GPUTextureViewDimensions.indexOf(wgpu[texture]['textureBindingViewDimension']);
+    {{{ wassert(wgpuObject('texture')); }}}
+    {{{ wassert(wgpuIsType('texture', 'GPUTexture')); }}}
+    return GPUTextureViewDimensionIds.get({{{ wgpuObject('texture') }}}['textureBindingViewDimension']) || 0;
   },
 
   wgpu_pipeline_get_bind_group_layout: function(pipelineBase, index) {
     {{{ wdebuglog('`wgpu_pipeline_get_bind_group_layout(pipelineBase=${pipelineBase}, index=${index})`'); }}}
     {{{ wassert('pipelineBase != 0'); }}}
-    {{{ wassert('wgpu[pipelineBase]'); }}}
-    {{{ wassert('wgpu[pipelineBase] instanceof GPURenderPipeline || wgpu[pipelineBase] instanceof GPUComputePipeline'); }}}
-    pipelineBase = wgpu[pipelineBase];
+    {{{ wassert(wgpuObject('pipelineBase')); }}}
+    {{{ wassert(wgpuIsType('pipelineBase', 'GPURenderPipeline', 'GPUComputePipeline')); }}}
+    pipelineBase = {{{ wgpuObject('pipelineBase') }}};
     return wgpuStoreAndSetParent(pipelineBase['getBindGroupLayout'](index), pipelineBase);
   },
 
   $wgpuReadTimestampWrites: function(timestampWritesIndex) {
     let querySet = HEAPU32[timestampWritesIndex];
     if (querySet) {
-      let timestampWrites = { 'querySet': wgpu[querySet] }, i;
+      let timestampWrites = { 'querySet': {{{ wgpuObject('querySet') }}} }, i;
       if ((i = HEAP32[timestampWritesIndex+1]) >= 0) timestampWrites['beginningOfPassWriteIndex'] = i;
       if ((i = HEAP32[timestampWritesIndex+2]) >= 0) timestampWrites['endOfPassWriteIndex'] = i;
       return timestampWrites;
@@ -2018,7 +2763,7 @@ let api = {
 
   $wgpuReadRenderPassDepthStencilAttachment: function(heap32Idx) {
     let v = HEAPU32[heap32Idx]; return v ? {
-        'view': wgpu[v],
+        'view': {{{ wgpuObject('v') }}},
         'depthLoadOp': GPULoadOps[HEAPU32[heap32Idx+1]],
         'depthClearValue': HEAPF32[heap32Idx+2],
         'depthStoreOp': GPUStoreOps[HEAPU32[heap32Idx+3]],
@@ -2030,16 +2775,8 @@ let api = {
       } : void 0;
   },
 
-  wgpu_command_encoder_begin_render_pass__deps: ['$GPULoadOps', '$GPUStoreOps', '$wgpuReadTimestampWrites', '$wgpuReadRenderPassDepthStencilAttachment', '$wgpuStore'],
-  wgpu_command_encoder_begin_render_pass: function(commandEncoder, descriptor) {
-    {{{ wdebuglog('`wgpu_command_encoder_begin_render_pass(commandEncoder=${commandEncoder}, descriptor=${descriptor})`'); }}}
-    {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
-    {{{ wassert('descriptor != 0'); }}}
-
-    {{{ replacePtrToIdx('descriptor', 2); }}}
-
+  $wgpuReadRenderPassDescriptor__deps: ['$wgpu', '$GPULoadOps', '$GPUStoreOps', '$wgpuReadTimestampWrites', '$wgpuReadRenderPassDepthStencilAttachment'],
+  $wgpuReadRenderPassDescriptor: function(descriptor) {
     let colorAttachments = [],
       numColorAttachments = HEAP32[descriptor+4],
       colorAttachmentsIdx = {{{ readIdx32('descriptor+2') }}},
@@ -2051,16 +2788,16 @@ let api = {
     {{{ wassert('maxDrawCount >= 0'); }}}
 
     {{{ wassert('colorAttachmentsIdx % 2 == 0'); }}} // Must be aligned at double boundary
-    {{{ wassert('depthStencilAttachment == 0 || wgpu[depthStencilAttachment] instanceof GPUTexture || wgpu[depthStencilAttachment] instanceof GPUTextureView'); }}} // Must point to a valid WebGPU texture or texture view object if nonzero
+    {{{ wassert('depthStencilAttachment == 0 || ' + wgpuIsType('depthStencilAttachment', 'GPUTexture', 'GPUTextureView')); }}} // Must point to a valid WebGPU texture or texture view object if nonzero
 
     {{{ wassert('numColorAttachments >= 0'); }}}
     while(numColorAttachments--) {
       // If view is 0, then this attachment is to be sparse.
       let v = HEAPU32[colorAttachmentsIdx], ds = HEAP32[colorAttachmentsIdx+1];
       colorAttachments.push(v ? {
-        'view': wgpu[v],
+        'view': {{{ wgpuObject('v') }}},
         'depthSlice': ds < 0 ? void 0 : ds, // Awkward polymorphism: spec does not allow 'depthSlice' to be given a value (even 0) if attachment is not a 3D texture.
-        'resolveTarget': wgpu[HEAPU32[colorAttachmentsIdx+2]],
+        'resolveTarget': {{{ wgpuObject('HEAPU32[colorAttachmentsIdx+2]') }}},
         'storeOp': GPUStoreOps[HEAPU32[colorAttachmentsIdx+3]],
         'loadOp': GPULoadOps[HEAPU32[colorAttachmentsIdx+4]],
         'clearValue': [HEAPF64[colorAttachmentsIdxDbl  ], HEAPF64[colorAttachmentsIdxDbl+1],
@@ -2076,25 +2813,98 @@ let api = {
       // Awkward polymorphism: cannot specify 'view': undefined if no depth-stencil attachment
       // is to be present, but must pass undefined as the whole attachment object.
       'depthStencilAttachment': wgpuReadRenderPassDepthStencilAttachment(descriptor+5),
-      'occlusionQuerySet': wgpu[HEAPU32[descriptor+14]], // 5 + 9==sizeof(WGpuRenderPassDepthStencilAttachment)
+      'occlusionQuerySet': {{{ wgpuObject('HEAPU32[descriptor+14]') }}}, // 5 + 9==sizeof(WGpuRenderPassDepthStencilAttachment)
       // If maxDrawCount is set to zero, pass in undefined to use the default value
       // (likely 50 million, but omit it in case the spec might change in the future)
       'maxDrawCount': maxDrawCount || void 0,
       'timestampWrites': wgpuReadTimestampWrites(descriptor+15) // 5 + 9==sizeof(WGpuRenderPassDepthStencilAttachment) + 1==sizeof(WGpuQuerySet)
     };
     {{{ wdebugdir('desc', '`GPUCommandEncoder.beginRenderPass() with descriptor:`') }}};
-    return wgpuStore(wgpu[commandEncoder]['beginRenderPass'](desc));
+    return desc;
+  },
+
+  wgpu_command_encoder_begin_render_pass__deps: ['$wgpuReadRenderPassDescriptor', '$wgpuStore'],
+  wgpu_command_encoder_begin_render_pass: function(commandEncoder, descriptor) {
+    {{{ wdebuglog('`wgpu_command_encoder_begin_render_pass(commandEncoder=${commandEncoder}, descriptor=${descriptor})`'); }}}
+    {{{ wassert('commandEncoder != 0'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
+    {{{ wassert('descriptor != 0'); }}}
+
+    {{{ replacePtrToIdx('descriptor', 2); }}}
+    return wgpuStore({{{ wgpuObject('commandEncoder') }}}['beginRenderPass'](wgpuReadRenderPassDescriptor(descriptor)));
+  },
+
+  // A render pass template holds a render pass descriptor object that is built only once, and then patched in place and reused
+  // each time a render pass is begun from the template. Attachment views are stored as IDs and looked up from the wgpu table on
+  // each begin, so that e.g. the ID of the canvas texture (1) refers to the current canvas texture.
+  wgpu_render_pass_template_create__deps: ['$wgpuReadRenderPassDescriptor', '$wgpuStore'],
+  wgpu_render_pass_template_create: function(descriptor) {
+    {{{ wdebuglog('`wgpu_render_pass_template_create(descriptor=${descriptor})`'); }}}
+    {{{ wassert('descriptor != 0'); }}}
+
+    {{{ replacePtrToIdx('descriptor', 2); }}}
+    let desc = wgpuReadRenderPassDescriptor(descriptor),
+      colorAttachmentsIdx = {{{ readIdx32('descriptor+2') }}},
+      numColorAttachments = desc['colorAttachments'].length,
+      views = [],
+      resolveTargets = [];
+    {{{ wassert('numColorAttachments <= 8'); }}} // WGPU_MAX_COLOR_ATTACHMENTS
+
+    for(let i = 0; i < numColorAttachments; ++i, colorAttachmentsIdx += 14) { // sizeof(WGpuRenderPassColorAttachment)
+      views.push(HEAPU32[colorAttachmentsIdx]);
+      resolveTargets.push(HEAPU32[colorAttachmentsIdx+2]);
+    }
+    return wgpuStore({
+      desc: desc,
+      views: views,
+      resolveTargets: resolveTargets,
+      depthStencilView: HEAPU32[descriptor+5]
+    });
+  },
+
+  wgpu_command_encoder_begin_render_pass_from_template__deps: ['$wgpuStore'],
+  wgpu_command_encoder_begin_render_pass_from_template: function(commandEncoder, renderPassTemplate, patch) {
+    {{{ wdebuglog('`wgpu_command_encoder_begin_render_pass_from_template(commandEncoder=${commandEncoder}, renderPassTemplate=${renderPassTemplate}, patch=${patch})`'); }}}
+    {{{ wassert('commandEncoder != 0'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
+    {{{ wassert(`${wgpuObject('renderPassTemplate')}?.views`); }}} // Must be a render pass template
+    // patch may be a null pointer
+
+    let t = {{{ wgpuObject('renderPassTemplate') }}}, desc = t.desc, colorAttachments = desc['colorAttachments'], a, clearValueMask, c;
+    {{{ replacePtrToIdx('patch', 2); }}}
+    clearValueMask = patch && HEAPU32[patch+17];
+    c = {{{ shiftIndex('patch + 18', 1) }}}; // Alias the clear values for HEAPF64.
+    for(let i = 0; i < t.views.length; ++i, c += 4) {
+      // Sparse attachments are null in the template, and remain so.
+      if ((a = colorAttachments[i])) {
+        a['view'] = {{{ wgpuObject('patch && HEAPU32[patch+i] || t.views[i]') }}};
+        a['resolveTarget'] = {{{ wgpuObject('patch && HEAPU32[patch+8+i] || t.resolveTargets[i]') }}};
+        if (clearValueMask & (1 << i)) {
+          a = a['clearValue'];
+          a[0] = HEAPF64[c];
+          a[1] = HEAPF64[c+1];
+          a[2] = HEAPF64[c+2];
+          a[3] = HEAPF64[c+3];
+        }
+      }
+    }
+    if ((a = desc['depthStencilAttachment'])) a['view'] = {{{ wgpuObject('patch && HEAPU32[patch+16] || t.depthStencilView') }}};
+
+    {{{ wdebugdir('desc', '`GPUCommandEncoder.beginRenderPass() with descriptor:`') }}};
+    return wgpuStore({{{ wgpuObject('commandEncoder') }}}['beginRenderPass'](desc));
   },
 
   wgpu_command_encoder_begin_compute_pass__deps: ['$wgpuReadTimestampWrites', '$wgpuStore'],
   wgpu_command_encoder_begin_compute_pass: function(commandEncoder, descriptor) {
     {{{ wdebuglog('`wgpu_command_encoder_begin_compute_pass(commandEncoder=${commandEncoder}, descriptor=${descriptor})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
     // descriptor may be a null pointer
 
-    commandEncoder = wgpu[commandEncoder];
+    commandEncoder = {{{ wgpuObject('commandEncoder') }}};
     {{{ replacePtrToIdx('descriptor', 2); }}}
 
     let desc = descriptor ? {
@@ -2108,17 +2918,17 @@ let api = {
   wgpu_command_encoder_copy_buffer_to_buffer: function(commandEncoder, source, sourceOffset, destination, destinationOffset, size) {
     {{{ wdebuglog('`wgpu_command_encoder_copy_buffer_to_buffer(commandEncoder=${commandEncoder}, source=${source}, sourceOffset=${sourceOffset}, destination=${destination}, destinationOffset=${destinationOffset}, size=${size})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
-    {{{ wassert('wgpu[source] instanceof GPUBuffer'); }}}
-    {{{ wassert('wgpu[destination] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
+    {{{ wassert(wgpuIsType('source', 'GPUBuffer')); }}}
+    {{{ wassert(wgpuIsType('destination', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(sourceOffset)'); }}}
     {{{ wassert('sourceOffset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(destinationOffset)'); }}}
     {{{ wassert('destinationOffset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size) || size == Infinity'); }}}
     {{{ wassert('size >= 0'); }}}
-    wgpu[commandEncoder]['copyBufferToBuffer'](wgpu[source], sourceOffset, wgpu[destination], destinationOffset, size < 1/0 ? size : void 0);
+    {{{ wgpuObject('commandEncoder') }}}['copyBufferToBuffer']({{{ wgpuObject('source') }}}, sourceOffset, {{{ wgpuObject('destination') }}}, destinationOffset, size < 1/0 ? size : void 0);
   },
 
   $wgpuReadGpuTexelCopyBufferInfo__deps: ['$wgpuReadI53FromU64HeapIdx'],
@@ -2129,7 +2939,7 @@ let api = {
       'offset': wgpuReadI53FromU64HeapIdx(ptr),
       'bytesPerRow': HEAP32[ptr+2],
       'rowsPerImage': HEAP32[ptr+3],
-      'buffer': wgpu[HEAPU32[ptr+4]]
+      'buffer': {{{ wgpuObject('HEAPU32[ptr+4]') }}}
     };
   },
 
@@ -2138,7 +2948,7 @@ let api = {
     {{{ wassert('ptr'); }}}
     {{{ replacePtrToIdx('ptr', 2); }}}
     return {
-      'texture': wgpu[HEAPU32[ptr]],
+      'texture': {{{ wgpuObject('HEAPU32[ptr]') }}},
       'mipLevel': HEAP32[ptr+1],
       'origin': [HEAP32[ptr+2], HEAP32[ptr+3], HEAP32[ptr+4]],
       'aspect': GPUTextureAspects[HEAPU32[ptr+5]]
@@ -2149,186 +2959,300 @@ let api = {
   wgpu_command_encoder_copy_buffer_to_texture: function(commandEncoder, source, destination, copyWidth, copyHeight, copyDepthOrArrayLayers) {
     {{{ wdebuglog('`wgpu_command_encoder_copy_buffer_to_texture(commandEncoder=${commandEncoder}, source=${source}, destination=${destination}, copyWidth=${copyWidth}, copyHeight=${copyHeight}, copyDepthOrArrayLayers=${copyDepthOrArrayLayers})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
     {{{ wassert('source'); }}}
     {{{ wassert('destination'); }}}
-    wgpu[commandEncoder]['copyBufferToTexture'](wgpuReadGpuTexelCopyBufferInfo(source), wgpuReadGpuTexelCopyTextureInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
+    {{{ wgpuObject('commandEncoder') }}}['copyBufferToTexture'](wgpuReadGpuTexelCopyBufferInfo(source), wgpuReadGpuTexelCopyTextureInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
   },
 
   wgpu_command_encoder_copy_texture_to_buffer__deps: ['$wgpuReadGpuTexelCopyTextureInfo', '$wgpuReadGpuTexelCopyBufferInfo'],
   wgpu_command_encoder_copy_texture_to_buffer: function(commandEncoder, source, destination, copyWidth, copyHeight, copyDepthOrArrayLayers) {
     {{{ wdebuglog('`wgpu_command_encoder_copy_texture_to_buffer(commandEncoder=${commandEncoder}, source=${source}, destination=${destination}, copyWidth=${copyWidth}, copyHeight=${copyHeight}, copyDepthOrArrayLayers=${copyDepthOrArrayLayers})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
     {{{ wassert('source'); }}}
     {{{ wassert('destination'); }}}
-    wgpu[commandEncoder]['copyTextureToBuffer'](wgpuReadGpuTexelCopyTextureInfo(source), wgpuReadGpuTexelCopyBufferInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
+    {{{ wgpuObject('commandEncoder') }}}['copyTextureToBuffer'](wgpuReadGpuTexelCopyTextureInfo(source), wgpuReadGpuTexelCopyBufferInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
   },
 
   wgpu_command_encoder_copy_texture_to_texture__deps: ['$wgpuReadGpuTexelCopyTextureInfo'],
   wgpu_command_encoder_copy_texture_to_texture: function(commandEncoder, source, destination, copyWidth, copyHeight, copyDepthOrArrayLayers) {
     {{{ wdebuglog('`wgpu_command_encoder_copy_texture_to_texture(commandEncoder=${commandEncoder}, source=${source}, destination=${destination}, copyWidth=${copyWidth}, copyHeight=${copyHeight}, copyDepthOrArrayLayers=${copyDepthOrArrayLayers})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
     {{{ wassert('source'); }}}
     {{{ wassert('destination'); }}}
-    wgpu[commandEncoder]['copyTextureToTexture'](wgpuReadGpuTexelCopyTextureInfo(source), wgpuReadGpuTexelCopyTextureInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
+    {{{ wgpuObject('commandEncoder') }}}['copyTextureToTexture'](wgpuReadGpuTexelCopyTextureInfo(source), wgpuReadGpuTexelCopyTextureInfo(destination), [copyWidth, copyHeight, copyDepthOrArrayLayers]);
   },
 
   wgpu_command_encoder_clear_buffer: function(commandEncoder, buffer, offset, size) { 
     {{{ wdebuglog('`wgpu_command_encoder_clear_buffer(commandEncoder=${commandEncoder}, buffer=${buffer}, offset=${offset}, size=${size})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
-    {{{ wassert('wgpu[buffer]'); }}}
-    {{{ wassert('wgpu[buffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
+    {{{ wassert(wgpuObject('buffer')); }}}
+    {{{ wassert(wgpuIsType('buffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(offset)'); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size)'); }}}
     {{{ wassert('size >= -1'); }}} // -1 == MAX_SIZE, or >= 0 for the specified size.
-    wgpu[commandEncoder]['clearBuffer'](wgpu[buffer], offset, size < 0 ? void 0 : size);
+    {{{ wgpuObject('commandEncoder') }}}['clearBuffer']({{{ wgpuObject('buffer') }}}, offset, size < 0 ? void 0 : size);
   },
 
+  wgpu_encoder_push_debug_group__deps: ['$utf8Cached'],
   wgpu_encoder_push_debug_group: function(encoder, groupLabel) {
     {{{ wdebuglog('`wgpu_command_encoder_push_debug_group(encoder=${encoder}, groupLabel=${groupLabel})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUCommandEncoder || wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUCommandEncoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
     {{{ wassert('groupLabel != 0'); }}}
-    wgpu[encoder]['pushDebugGroup'](utf8(groupLabel));
+    {{{ wgpuObject('encoder') }}}['pushDebugGroup'](utf8Cached(groupLabel));
   },
 
   wgpu_encoder_pop_debug_group: function(encoder) {
     {{{ wdebuglog('`wgpu_command_encoder_pop_debug_group(encoder=${encoder})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUCommandEncoder || wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
-    wgpu[encoder]['popDebugGroup']();
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUCommandEncoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['popDebugGroup']();
   },
 
+  wgpu_encoder_insert_debug_marker__deps: ['$utf8Cached'],
   wgpu_encoder_insert_debug_marker: function(encoder, markerLabel) {
     {{{ wdebuglog('`wgpu_command_encoder_insert_debug_marker(encoder=${encoder}, markerLabel=${markerLabel})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUCommandEncoder || wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUCommandEncoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
     {{{ wassert('markerLabel != 0'); }}}
-    wgpu[encoder]['insertDebugMarker'](utf8(markerLabel));
+    {{{ wgpuObject('encoder') }}}['insertDebugMarker'](utf8Cached(markerLabel));
   },
 
   wgpu_command_encoder_resolve_query_set: function(commandEncoder, querySet, firstQuery, queryCount, destination, destinationOffset) {
     {{{ wdebuglog('`wgpu_command_encoder_resolve_query_set(commandEncoder=${commandEncoder}, querySet=${querySet}, firstQuery=${firstQuery}, queryCount=${queryCount}, destination=${destination}, destinationOffset=${destinationOffset})`'); }}}
     {{{ wassert('commandEncoder != 0'); }}}
-    {{{ wassert('wgpu[commandEncoder]'); }}}
-    {{{ wassert('wgpu[commandEncoder] instanceof GPUCommandEncoder'); }}}
-    {{{ wassert('wgpu[querySet] instanceof GPUQuerySet'); }}}
-    {{{ wassert('wgpu[destination] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('commandEncoder')); }}}
+    {{{ wassert(wgpuIsType('commandEncoder', 'GPUCommandEncoder')); }}}
+    {{{ wassert(wgpuIsType('querySet', 'GPUQuerySet')); }}}
+    {{{ wassert(wgpuIsType('destination', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(destinationOffset)'); }}}
     {{{ wassert('destinationOffset >= 0'); }}}
-    wgpu[commandEncoder]['resolveQuerySet'](wgpu[querySet], firstQuery, queryCount, wgpu[destination], destinationOffset);
+    {{{ wgpuObject('commandEncoder') }}}['resolveQuerySet']({{{ wgpuObject('querySet') }}}, firstQuery, queryCount, {{{ wgpuObject('destination') }}}, destinationOffset);
   },
 
   wgpu_encoder_set_pipeline: function(encoder, pipeline) {
     {{{ wdebuglog('`wgpu_encoder_set_pipeline(encoder=${encoder}, pipeline=${pipeline})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
-    {{{ wassert('wgpu[pipeline] instanceof GPURenderPipeline || wgpu[pipeline] instanceof GPUComputePipeline'); }}}
-    {{{ wassert('(wgpu[encoder] instanceof GPUComputePassEncoder) == (wgpu[pipeline] instanceof GPUComputePipeline)'); }}}
-    wgpu[encoder]['setPipeline'](wgpu[pipeline]);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('pipeline', 'GPURenderPipeline', 'GPUComputePipeline')); }}}
+    {{{ wassert(`(${wgpuIsType('encoder', 'GPUComputePassEncoder')}) == (${wgpuIsType('pipeline', 'GPUComputePipeline')})`); }}}
+    {{{ wgpuObject('encoder') }}}['setPipeline']({{{ wgpuObject('pipeline') }}});
   },
 
   wgpu_render_commands_mixin_set_index_buffer__deps: ['$GPUIndexFormats'],
   wgpu_render_commands_mixin_set_index_buffer: function(passEncoder, buffer, indexFormat, offset, size) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_set_index_buffer(passEncoder=${passEncoder}, buffer=${buffer}, indexFormat=${indexFormat}, offset=${offset}, size=${size})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
-    {{{ wassert('wgpu[buffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('buffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(offset)'); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size)'); }}}
     {{{ wassert('size >= -1'); }}}
-    {{{ wassert('buffer == 0 || offset <= wgpu[buffer]["size"]'); }}}
-    {{{ wassert('buffer == 0 || size <= wgpu[buffer]["size"]'); }}}
-    {{{ wassert('buffer == 0 || offset+size <= wgpu[buffer]["size"]'); }}} // Slightly redundant asserts, but check in steps to improve assert failure msg.
+    {{{ wassert(`buffer == 0 || offset <= ${wgpuObject('buffer')}["size"]`); }}}
+    {{{ wassert(`buffer == 0 || size <= ${wgpuObject('buffer')}["size"]`); }}}
+    {{{ wassert(`buffer == 0 || offset+size <= ${wgpuObject('buffer')}["size"]`); }}} // Slightly redundant asserts, but check in steps to improve assert failure msg.
 
-    wgpu[passEncoder]['setIndexBuffer'](wgpu[buffer], GPUIndexFormats[indexFormat], offset, size < 0 ? void 0 : size);
+    {{{ wgpuObject('passEncoder') }}}['setIndexBuffer']({{{ wgpuObject('buffer') }}}, GPUIndexFormats[indexFormat], offset, size < 0 ? void 0 : size);
   },
 
   wgpu_render_commands_mixin_set_vertex_buffer: function(passEncoder, slot, buffer, offset, size) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_set_vertex_buffer(passEncoder=${passEncoder}, slot=${slot}, buffer=${buffer}, offset=${offset}, size=${size})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
     // N.b. buffer may be null here, in which case the existing buffer is intended to be unbound.
-    {{{ wassert('buffer == 0 || wgpu[buffer]'); }}}
-    {{{ wassert('buffer == 0 || wgpu[buffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(`buffer == 0 || ${wgpuObject('buffer')}`); }}}
+    {{{ wassert('buffer == 0 || ' + wgpuIsType('buffer', 'GPUBuffer')); }}}
     {{{ wassert('buffer != 0 || offset == 0'); }}}
     {{{ wassert('buffer != 0 || size <= 0'); }}}
     {{{ wassert('Number.isSafeInteger(offset)'); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('Number.isSafeInteger(size)'); }}}
     {{{ wassert('size >= -1'); }}}
-    {{{ wassert('buffer == 0 || offset <= wgpu[buffer]["size"]'); }}}
-    {{{ wassert('buffer == 0 || size <= wgpu[buffer]["size"]'); }}}
-    {{{ wassert('buffer == 0 || offset+size <= wgpu[buffer]["size"]'); }}} // Slightly redundant asserts, but check in steps to improve assert failure msg.
+    {{{ wassert(`buffer == 0 || offset <= ${wgpuObject('buffer')}["size"]`); }}}
+    {{{ wassert(`buffer == 0 || size <= ${wgpuObject('buffer')}["size"]`); }}}
+    {{{ wassert(`buffer == 0 || offset+size <= ${wgpuObject('buffer')}["size"]`); }}} // Slightly redundant asserts, but check in steps to improve assert failure msg.
 
-    wgpu[passEncoder]['setVertexBuffer'](slot, wgpu[buffer], offset, size < 0 ? void 0 : size);
+    {{{ wgpuObject('passEncoder') }}}['setVertexBuffer'](slot, {{{ wgpuObject('buffer') }}}, offset, size < 0 ? void 0 : size);
   },
 
   wgpu_render_commands_mixin_draw: function(passEncoder, vertexCount, instanceCount, firstVertex, firstInstance) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_draw(passEncoder=${passEncoder}, vertexCount=${vertexCount}, instanceCount=${instanceCount}, firstVertex=${firstVertex}, firstInstance=${firstInstance})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
 
-    wgpu[passEncoder]['draw'](vertexCount, instanceCount, firstVertex, firstInstance);
+    {{{ wgpuObject('passEncoder') }}}['draw'](vertexCount, instanceCount, firstVertex, firstInstance);
   },
 
   wgpu_render_commands_mixin_draw_indexed: function(passEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_draw_indexed(passEncoder=${passEncoder}, indexCount=${indexCount}, instanceCount=${instanceCount}, firstIndex=${firstIndex}, baseVertex=${baseVertex}, firstInstance=${firstInstance})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
 
-    wgpu[passEncoder]['drawIndexed'](indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    {{{ wgpuObject('passEncoder') }}}['drawIndexed'](indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
   },
 
   wgpu_render_commands_mixin_draw_indirect: function(passEncoder, indirectBuffer, indirectOffset) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_draw_indirect(passEncoder=${passEncoder}, indirectBuffer=${indirectBuffer}, indirectOffset=${indirectOffset})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
-    {{{ wassert('wgpu[indirectBuffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('indirectBuffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(indirectOffset)'); }}}
     {{{ wassert('indirectOffset >= 0'); }}}
 
-    wgpu[passEncoder]['drawIndirect'](wgpu[indirectBuffer], indirectOffset);
+    {{{ wgpuObject('passEncoder') }}}['drawIndirect']({{{ wgpuObject('indirectBuffer') }}}, indirectOffset);
   },
 
   wgpu_render_commands_mixin_draw_indexed_indirect: function(passEncoder, indirectBuffer, indirectOffset) {
     {{{ wdebuglog('`wgpu_render_commands_mixin_draw_indexed_indirect(passEncoder=${passEncoder}, indirectBuffer=${indirectBuffer}, indirectOffset=${indirectOffset})`'); }}}
     {{{ wassert('passEncoder != 0'); }}}
-    {{{ wassert('wgpu[passEncoder]'); }}}
-    {{{ wassert('wgpu[passEncoder] instanceof GPURenderPassEncoder || wgpu[passEncoder] instanceof GPURenderBundleEncoder'); }}}
-    {{{ wassert('wgpu[indirectBuffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('indirectBuffer', 'GPUBuffer')); }}}
+    {{{ wassert('Number.isSafeInteger(indirectOffset)'); }}}
+    {{{ wassert('indirectOffset >= 0'); }}}
+
+    {{{ wgpuObject('passEncoder') }}}['drawIndexedIndirect']({{{ wgpuObject('indirectBuffer') }}}, indirectOffset);
+  },
+
+  // Browsers do not support multi-draw indirect, so issue the draws in a loop here, to need only a single Wasm->JS call.
+  wgpu_render_commands_mixin_multi_draw_indirect: function(passEncoder, indirectBuffer, indirectOffset, drawCount, stride) {
+    {{{ wdebuglog('`wgpu_render_commands_mixin_multi_draw_indirect(passEncoder=${passEncoder}, indirectBuffer=${indirectBuffer}, indirectOffset=${indirectOffset}, drawCount=${drawCount}, stride=${stride})`'); }}}
+    {{{ wassert('passEncoder != 0'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('indirectBuffer', 'GPUBuffer')); }}}
+    {{{ wassert('Number.isSafeInteger(indirectOffset)'); }}}
+    {{{ wassert('indirectOffset >= 0'); }}}
+    {{{ wassert('stride == 0 || stride >= 16/*WGPU_DRAW_INDIRECT_ARGS_SIZE*/'); }}}
+
+    let encoder = {{{ wgpuObject('passEncoder') }}}, buffer = {{{ wgpuObject('indirectBuffer') }}};
+    stride ||= 16/*WGPU_DRAW_INDIRECT_ARGS_SIZE*/;
+    for(let end = indirectOffset + drawCount * stride; indirectOffset < end; indirectOffset += stride)
+      encoder['drawIndirect'](buffer, indirectOffset);
+  },
+
+  wgpu_render_commands_mixin_multi_draw_indexed_indirect: function(passEncoder, indirectBuffer, indirectOffset, drawCount, stride) {
+    {{{ wdebuglog('`wgpu_render_commands_mixin_multi_draw_indexed_indirect(passEncoder=${passEncoder}, indirectBuffer=${indirectBuffer}, indirectOffset=${indirectOffset}, drawCount=${drawCount}, stride=${stride})`'); }}}
+    {{{ wassert('passEncoder != 0'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert(wgpuIsType('indirectBuffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(indirectOffset)'); }}}
     {{{ wassert('indirectOffset >= 0'); }}}
+    {{{ wassert('stride == 0 || stride >= 20/*WGPU_DRAW_INDEXED_INDIRECT_ARGS_SIZE*/'); }}}
+
+    let encoder = {{{ wgpuObject('passEncoder') }}}, buffer = {{{ wgpuObject('indirectBuffer') }}};
+    stride ||= 20/*WGPU_DRAW_INDEXED_INDIRECT_ARGS_SIZE*/;
+    for(let end = indirectOffset + drawCount * stride; indirectOffset < end; indirectOffset += stride)
+      encoder['drawIndexedIndirect'](buffer, indirectOffset);
+  },
+
+  // The draw count buffer cannot be read on the CPU, so issue all maxDrawCount draws. (see lib_webgpu.h)
+  wgpu_render_pass_encoder_multi_draw_indirect_count__deps: ['wgpu_render_commands_mixin_multi_draw_indirect'],
+  wgpu_render_pass_encoder_multi_draw_indirect_count: function(passEncoder, indirectBuffer, indirectOffset, maxDrawCount, stride, drawCountBuffer, drawCountBufferOffset) {
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder')); }}}
+    {{{ wassert(wgpuIsType('drawCountBuffer', 'GPUBuffer')); }}}
+    _wgpu_render_commands_mixin_multi_draw_indirect(passEncoder, indirectBuffer, indirectOffset, maxDrawCount, stride);
+  },
 
-    wgpu[passEncoder]['drawIndexedIndirect'](wgpu[indirectBuffer], indirectOffset);
+  wgpu_render_pass_encoder_multi_draw_indexed_indirect_count__deps: ['wgpu_render_commands_mixin_multi_draw_indexed_indirect'],
+  wgpu_render_pass_encoder_multi_draw_indexed_indirect_count: function(passEncoder, indirectBuffer, indirectOffset, maxDrawCount, stride, drawCountBuffer, drawCountBufferOffset) {
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder')); }}}
+    {{{ wassert(wgpuIsType('drawCountBuffer', 'GPUBuffer')); }}}
+    _wgpu_render_commands_mixin_multi_draw_indexed_indirect(passEncoder, indirectBuffer, indirectOffset, maxDrawCount, stride);
+  },
+
+#if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
+  wgpu_render_commands_mixin_draw_batch__deps: ['$wgpu', '$GPUIndexFormats', '$wgpuReadI53FromU64HeapIdx', '_wgpu_browser_is_firefox'],
+#else
+  wgpu_render_commands_mixin_draw_batch__deps: ['$wgpu', '$GPUIndexFormats', '$wgpuReadI53FromU64HeapIdx'],
+#endif
+  wgpu_render_commands_mixin_draw_batch: function(passEncoder, items, numItems) {
+    {{{ wdebuglog('`wgpu_render_commands_mixin_draw_batch(passEncoder=${passEncoder}, items=${items}, numItems=${numItems})`'); }}}
+    {{{ wassert('passEncoder != 0'); }}}
+    {{{ wassert(wgpuObject('passEncoder')); }}}
+    {{{ wassert(wgpuIsType('passEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert('items != 0 || numItems == 0'); }}}
+    {{{ replacePtrToIdx('items', 2); }}}
+    {{{ wassert('items % 2 == 0'); }}} // WGpuDrawBatchItem contains uint64_t fields, so must be 8-byte aligned
+
+    passEncoder = {{{ wgpuObject('passEncoder') }}};
+    let end = items + numItems * {{{ wgpuStructs.WGpuDrawBatchItem.sizeof }}}, i, b, o, size;
+    for(; items < end; items += {{{ wgpuStructs.WGpuDrawBatchItem.sizeof }}}) {
+      if ((o = HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.pipeline }}}])) {
+        {{{ wassert(wgpuIsType('o', 'GPURenderPipeline')); }}}
+        passEncoder['setPipeline']({{{ wgpuObject('o') }}});
+      }
+
+      b = items + {{{ wgpuStructs.WGpuDrawBatchItem.bindGroups }}};
+      for(i = 0; i < 4/*WGPU_DRAW_BATCH_MAX_BIND_GROUPS*/; ++i, b += {{{ wgpuStructs.WGpuDrawBatchBindGroup.sizeof }}}) {
+        if ((o = HEAPU32[b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.bindGroup }}}])) {
+          {{{ wassert(wgpuIsType('o', 'GPUBindGroup')); }}}
+          {{{ wassert('HEAPU32[b+' + wgpuStructs.WGpuDrawBatchBindGroup.numDynamicOffsets + '] <= 4'); }}} // WGPU_DRAW_BATCH_MAX_DYNAMIC_OFFSETS
+#if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
+          // No Wasm4GB/Wasm64 support in Firefox: https://bugzil.la/2022805
+          if (__wgpu_browser_is_firefox()) passEncoder['setBindGroup'](i, {{{ wgpuObject('o') }}}, new Uint32Array(HEAPU32.subarray(b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.dynamicOffsets }}},
+            b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.dynamicOffsets }}}+HEAPU32[b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.numDynamicOffsets }}}])));
+          else
+#endif
+          passEncoder['setBindGroup'](i, {{{ wgpuObject('o') }}}, HEAPU32, b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.dynamicOffsets }}}, HEAPU32[b+{{{ wgpuStructs.WGpuDrawBatchBindGroup.numDynamicOffsets }}}]);
+        }
+      }
+
+      b = items + {{{ wgpuStructs.WGpuDrawBatchItem.indexBuffer }}};
+      if ((o = HEAPU32[b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.buffer }}}])) {
+        {{{ wassert(wgpuIsType('o', 'GPUBuffer')); }}}
+        size = wgpuReadI53FromU64HeapIdx(b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.size }}});
+        passEncoder['setIndexBuffer']({{{ wgpuObject('o') }}}, GPUIndexFormats[HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.indexFormat }}}]],
+          wgpuReadI53FromU64HeapIdx(b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.offset }}}), size || void 0);
+      }
+
+      b = items + {{{ wgpuStructs.WGpuDrawBatchItem.vertexBuffers }}};
+      for(i = 0; i < 4/*WGPU_DRAW_BATCH_MAX_VERTEX_BUFFERS*/; ++i, b += {{{ wgpuStructs.WGpuDrawBatchBufferBinding.sizeof }}}) {
+        if ((o = HEAPU32[b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.buffer }}}])) {
+          {{{ wassert(wgpuIsType('o', 'GPUBuffer')); }}}
+          size = wgpuReadI53FromU64HeapIdx(b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.size }}});
+          passEncoder['setVertexBuffer'](i, {{{ wgpuObject('o') }}}, wgpuReadI53FromU64HeapIdx(b+{{{ wgpuStructs.WGpuDrawBatchBufferBinding.offset }}}), size || void 0);
+        }
+      }
+
+      if (HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.indexCount }}}]) {
+        passEncoder['drawIndexed'](HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.indexCount }}}], HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.instanceCount }}}],
+          HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.firstIndex }}}], HEAP32[items+{{{ wgpuStructs.WGpuDrawBatchItem.baseVertex }}}], HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.firstInstance }}}]);
+      } else if (HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.vertexCount }}}]) {
+        passEncoder['draw'](HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.vertexCount }}}], HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.instanceCount }}}],
+          HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.firstVertex }}}], HEAPU32[items+{{{ wgpuStructs.WGpuDrawBatchItem.firstInstance }}}]);
+      }
+    }
   },
 
   wgpu_encoder_end__deps: ['wgpu_object_destroy'],
   wgpu_encoder_end: function(encoder) {
     {{{ wdebuglog('`wgpu_encoder_end(encoder=${encoder})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder')); }}}
 
-    wgpu[encoder]['end']();
+    {{{ wgpuObject('encoder') }}}['end']();
 
     /* https://gpuweb.github.io/gpuweb/#render-pass-encoder-finalization:
       "The render pass encoder can be ended by calling end() once the user has
@@ -2348,11 +3272,11 @@ let api = {
   wgpu_encoder_finish: function(encoder) {
     {{{ wdebuglog('`wgpu_encoder_finish(encoder=${encoder})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUCommandEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUCommandEncoder', 'GPURenderBundleEncoder')); }}}
 
-    {{{ wdebuglog('`GPU${wgpu[encoder] instanceof GPUCommandEncoder ? "Command" : "RenderBundle"}Encoder.finish()`'); }}}
-    let cmdBuffer = wgpu[encoder]['finish']();
+    {{{ wdebuglog(`\`GPU\${${wgpuObject('encoder')} instanceof GPUCommandEncoder ? "Command" : "RenderBundle"}Encoder.finish()\``); }}}
+    let cmdBuffer = {{{ wgpuObject('encoder') }}}['finish']();
 
     /* https://gpuweb.github.io/gpuweb/#command-encoder-finalization:
       "A GPUCommandBuffer containing the commands recorded by the GPUCommandEncoder can be
@@ -2380,144 +3304,218 @@ let api = {
   wgpu_encoder_set_bind_group: function(encoder, index, /*nullable*/ bindGroup, dynamicOffsets, numDynamicOffsets) {
     {{{ wdebuglog('`wgpu_encoder_set_bind_group(encoder=${encoder}, index=${index}, bindGroup=${bindGroup}, dynamicOffsets=${dynamicOffsets}, numDynamicOffsets=${numDynamicOffsets})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
     // N.b. bindGroup may be null here, in which case the existing bind group is intended to be unbound.
-    {{{ wassert('bindGroup == 0 || wgpu[bindGroup]'); }}}
-    {{{ wassert('bindGroup == 0 || wgpu[bindGroup] instanceof GPUBindGroup'); }}}
+    {{{ wassert(`bindGroup == 0 || ${wgpuObject('bindGroup')}`); }}}
+    {{{ wassert('bindGroup == 0 || ' + wgpuIsType('bindGroup', 'GPUBindGroup')); }}}
     {{{ wassert('dynamicOffsets != 0 || numDynamicOffsets == 0'); }}}
 #if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
     if (__wgpu_browser_is_firefox()) {
       // No Wasm4GB/Wasm64 support in Firefox: https://bugzil.la/2022805
       // Make a deep copy of the buffer that is small enough for Firefox to handle.
       var firefoxWorkaroundBuffer = new Uint32Array(new Uint32Array(HEAPU32.buffer, {{{ shiftPtr('dynamicOffsets', 0) }}}, numDynamicOffsets));
-      wgpu[encoder]['setBindGroup'](index, wgpu[bindGroup], firefoxWorkaroundBuffer);
+      {{{ wgpuObject('encoder') }}}['setBindGroup'](index, {{{ wgpuObject('bindGroup') }}}, firefoxWorkaroundBuffer);
       return;
     }
 #endif
-    wgpu[encoder]['setBindGroup'](index, wgpu[bindGroup], HEAPU32, {{{ shiftPtr('dynamicOffsets', 2) }}}, numDynamicOffsets);
+    {{{ wgpuObject('encoder') }}}['setBindGroup'](index, {{{ wgpuObject('bindGroup') }}}, HEAPU32, {{{ shiftPtr('dynamicOffsets', 2) }}}, numDynamicOffsets);
   },
 
   wgpu_encoder_set_immediates: function(encoder, offset, ptr, size) {
     {{{ wdebuglog('`wgpu_encoder_set_immediates(encoder=${encoder}, offset=${offset}, ptr=${ptr}, size=${size}`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder || wgpu[encoder] instanceof GPURenderPassEncoder || wgpu[encoder] instanceof GPURenderBundleEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
     {{{ wassert('offset >= 0'); }}}
     {{{ wassert('ptr > 0'); }}}
     {{{ wassert('size >= 0'); }}}
-    wgpu[encoder]['setImmediates'](offset, HEAPU8, {{{ shiftPtr('ptr', 0) }}}, size);
+    {{{ wgpuObject('encoder') }}}['setImmediates'](offset, HEAPU8, {{{ shiftPtr('ptr', 0) }}}, size);
   },
 
   wgpu_compute_pass_encoder_dispatch_workgroups: function(encoder, workgroupCountX, workgroupCountY, workgroupCountZ) {
     {{{ wdebuglog('`wgpu_compute_pass_encoder_dispatch_workgroups(encoder=${encoder}, workgroupCountX=${workgroupCountX}, workgroupCountY=${workgroupCountY}, workgroupCountZ=${workgroupCountZ})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder'); }}}
-    wgpu[encoder]['dispatchWorkgroups'](workgroupCountX, workgroupCountY, workgroupCountZ);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['dispatchWorkgroups'](workgroupCountX, workgroupCountY, workgroupCountZ);
   },
 
   wgpu_compute_pass_encoder_dispatch_workgroups_indirect: function(encoder, indirectBuffer, indirectOffset) {
     {{{ wdebuglog('`wgpu_compute_pass_encoder_dispatch_workgroups_indirect(encoder=${encoder}, indirectBuffer=${indirectBuffer}, indirectOffset=${indirectOffset})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPUComputePassEncoder'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder')); }}}
     {{{ wassert('indirectBuffer != 0'); }}}
-    {{{ wassert('wgpu[indirectBuffer]'); }}}
-    {{{ wassert('wgpu[indirectBuffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('indirectBuffer')); }}}
+    {{{ wassert(wgpuIsType('indirectBuffer', 'GPUBuffer')); }}}
     {{{ wassert('Number.isSafeInteger(indirectOffset)'); }}}
     {{{ wassert('indirectOffset >= 0'); }}}
-    wgpu[encoder]['dispatchWorkgroupsIndirect'](wgpu[indirectBuffer], indirectOffset);
+    {{{ wgpuObject('encoder') }}}['dispatchWorkgroupsIndirect']({{{ wgpuObject('indirectBuffer') }}}, indirectOffset);
   },
 
   wgpu_render_pass_encoder_set_viewport: function(encoder, x, y, width, height, minDepth, maxDepth) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_set_viewport(encoder=${encoder}, x=${x}, y=${y}, width=${width}, height=${height}, minDepth=${minDepth}, maxDepth=${maxDepth})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['setViewport'](x, y, width, height, minDepth, maxDepth);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['setViewport'](x, y, width, height, minDepth, maxDepth);
   },
 
   wgpu_render_pass_encoder_set_scissor_rect: function(encoder, x, y, width, height) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_set_scissor_rect(encoder=${encoder}, x=${x}, y=${y}, width=${width}, height=${height})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['setScissorRect'](x, y, width, height);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['setScissorRect'](x, y, width, height);
   },
 
   wgpu_render_pass_encoder_set_blend_constant: function(encoder, r, g, b, a) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_set_blend_constant(encoder=${encoder}, r=${r}, g=${g}, b=${b}, a=${a})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['setBlendConstant']([r, g, b, a]);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['setBlendConstant']([r, g, b, a]);
   },
 
   wgpu_render_pass_encoder_set_stencil_reference: function(encoder, stencilValue) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_set_stencil_reference(encoder=${encoder}, stencilValue=${stencilValue})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['setStencilReference'](stencilValue);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['setStencilReference'](stencilValue);
   },
 
   wgpu_render_pass_encoder_begin_occlusion_query: function(encoder, queryIndex) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_begin_occlusion_query(encoder=${encoder}, queryIndex=${queryIndex})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['beginOcclusionQuery'](queryIndex);
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['beginOcclusionQuery'](queryIndex);
   },
 
   wgpu_render_pass_encoder_end_occlusion_query: function(encoder) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_end_occlusion_query(encoder=${encoder})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['endOcclusionQuery']();
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['endOcclusionQuery']();
   },
 
   wgpu_render_pass_encoder_execute_bundles__deps: ['$wgpuReadArrayOfItems'],
   wgpu_render_pass_encoder_execute_bundles: function(encoder, bundles, numBundles) {
     {{{ wdebuglog('`wgpu_render_pass_encoder_execute_bundles(encoder=${encoder}, bundles=${bundles}, numBundles=${numBundles})`'); }}}
     {{{ wassert('encoder != 0'); }}}
-    {{{ wassert('wgpu[encoder]'); }}}
-    {{{ wassert('wgpu[encoder] instanceof GPURenderPassEncoder'); }}}
-    wgpu[encoder]['executeBundles'](wgpuReadArrayOfItems(wgpu, bundles, numBundles));
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPURenderPassEncoder')); }}}
+    {{{ wgpuObject('encoder') }}}['executeBundles'](wgpuReadArrayOfItems(wgpu, bundles, numBundles));
+  },
+
+  // Decodes a command stream recorded with the wgpu_record_*() functions in lib_webgpu.cpp. See WGPU_RECORDED_COMMAND_* in
+  // lib_webgpu.h for the format.
+#if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
+  wgpu_encoder_replay_commands__deps: ['$wgpu', '$GPUIndexFormats', '_wgpu_browser_is_firefox'],
+#else
+  wgpu_encoder_replay_commands__deps: ['$wgpu', '$GPUIndexFormats'],
+#endif
+  wgpu_encoder_replay_commands: function(encoder, commands, numWords) {
+    {{{ wdebuglog('`wgpu_encoder_replay_commands(encoder=${encoder}, commands=${commands}, numWords=${numWords})`'); }}}
+    {{{ wassert('encoder != 0'); }}}
+    {{{ wassert(wgpuObject('encoder')); }}}
+    {{{ wassert(wgpuIsType('encoder', 'GPUComputePassEncoder', 'GPURenderPassEncoder', 'GPURenderBundleEncoder')); }}}
+    {{{ wassert('commands != 0'); }}}
+    {{{ replacePtrToIdx('commands', 2); }}}
+
+    encoder = {{{ wgpuObject('encoder') }}};
+    let end = commands + numWords, op, imm;
+    while(commands < end) {
+      op = HEAPU32[commands];
+      imm = op >>> 8;
+      switch(op & 0xFF) {
+        case 1: // WGPU_RECORDED_COMMAND_SET_PIPELINE
+          {{{ wassert(wgpuIsType('HEAPU32[commands+1]', 'GPURenderPipeline', 'GPUComputePipeline')); }}}
+          encoder['setPipeline']({{{ wgpuObject('HEAPU32[commands+1]') }}});
+          commands += 2;
+          break;
+        case 2: // WGPU_RECORDED_COMMAND_SET_BIND_GROUP
+          {{{ wassert('HEAPU32[commands+2] == 0 || ' + wgpuIsType('HEAPU32[commands+2]', 'GPUBindGroup')); }}}
+#if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
+          // No Wasm4GB/Wasm64 support in Firefox: https://bugzil.la/2022805
+          if (__wgpu_browser_is_firefox()) encoder['setBindGroup'](HEAPU32[commands+1], {{{ wgpuObject('HEAPU32[commands+2]') }}}, new Uint32Array(HEAPU32.subarray(commands+3, commands+3+imm)));
+          else
+#endif
+          encoder['setBindGroup'](HEAPU32[commands+1], {{{ wgpuObject('HEAPU32[commands+2]') }}}, HEAPU32, commands+3, imm);
+          commands += 3 + imm;
+          break;
+        case 3: // WGPU_RECORDED_COMMAND_SET_INDEX_BUFFER
+          {{{ wassert(wgpuIsType('HEAPU32[commands+1]', 'GPUBuffer')); }}}
+          encoder['setIndexBuffer']({{{ wgpuObject('HEAPU32[commands+1]') }}}, GPUIndexFormats[imm], HEAPU32[commands+2] + HEAPU32[commands+3] * 4294967296,
+            HEAP32[commands+5] < 0 ? void 0 : HEAPU32[commands+4] + HEAPU32[commands+5] * 4294967296);
+          commands += 6;
+          break;
+        case 4: // WGPU_RECORDED_COMMAND_SET_VERTEX_BUFFER
+          {{{ wassert('HEAPU32[commands+1] == 0 || ' + wgpuIsType('HEAPU32[commands+1]', 'GPUBuffer')); }}}
+          encoder['setVertexBuffer'](imm, {{{ wgpuObject('HEAPU32[commands+1]') }}}, HEAPU32[commands+2] + HEAPU32[commands+3] * 4294967296,
+            HEAP32[commands+5] < 0 ? void 0 : HEAPU32[commands+4] + HEAPU32[commands+5] * 4294967296);
+          commands += 6;
+          break;
+        case 5: // WGPU_RECORDED_COMMAND_DRAW
+          encoder['draw'](HEAPU32[commands+1], HEAPU32[commands+2], HEAPU32[commands+3], HEAPU32[commands+4]);
+          commands += 5;
+          break;
+        case 6: // WGPU_RECORDED_COMMAND_DRAW_INDEXED
+          encoder['drawIndexed'](HEAPU32[commands+1], HEAPU32[commands+2], HEAPU32[commands+3], HEAP32[commands+4], HEAPU32[commands+5]);
+          commands += 6;
+          break;
+        case 7: // WGPU_RECORDED_COMMAND_SET_VIEWPORT
+          encoder['setViewport'](HEAPF32[commands+1], HEAPF32[commands+2], HEAPF32[commands+3], HEAPF32[commands+4], HEAPF32[commands+5], HEAPF32[commands+6]);
+          commands += 7;
+          break;
+        case 8: // WGPU_RECORDED_COMMAND_SET_SCISSOR_RECT
+          encoder['setScissorRect'](HEAPU32[commands+1], HEAPU32[commands+2], HEAPU32[commands+3], HEAPU32[commands+4]);
+          commands += 5;
+          break;
+        case 9: // WGPU_RECORDED_COMMAND_SET_STENCIL_REFERENCE
+          encoder['setStencilReference'](HEAPU32[commands+1]);
+          commands += 2;
+          break;
+        default:
+          {{{ wassert('false', 'wgpu_encoder_replay_commands: invalid command opcode!'); }}}
+          return;
+      }
+    }
   },
 
   wgpu_queue_submit_one_and_destroy__deps: ['wgpu_object_destroy'],
   wgpu_queue_submit_one_and_destroy: function(queue, commandBuffer) {
     {{{ wdebuglog('`wgpu_queue_submit_one_and_destroy(queue=${queue}, commandBuffer=${commandBuffer})`'); }}}
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
     {{{ wassert('commandBuffer != 0'); }}}
-    {{{ wassert('wgpu[commandBuffer]'); }}}
-    {{{ wassert('wgpu[commandBuffer] instanceof GPUCommandBuffer'); }}}
-    wgpu[queue]['submit']([wgpu[commandBuffer]]);
+    {{{ wassert(wgpuObject('commandBuffer')); }}}
+    {{{ wassert(wgpuIsType('commandBuffer', 'GPUCommandBuffer')); }}}
+    {{{ wgpuObject('queue') }}}['submit']([{{{ wgpuObject('commandBuffer') }}}]);
     _wgpu_object_destroy(commandBuffer);
   },
 
-  wgpu_queue_submit_multiple_and_destroy__deps: ['wgpu_object_destroy', '$wgpuReadArrayOfItems'],
+  wgpu_queue_submit_multiple_and_destroy__deps: ['wgpu_object_destroy_many', '$wgpuReadArrayOfItems'],
   wgpu_queue_submit_multiple_and_destroy: function(queue, commandBuffers, numCommandBuffers) {
     {{{ wdebuglog('`wgpu_queue_submit_multiple_and_destroy(queue=${queue}, commandBuffers=${commandBuffers}, numCommandBuffers=${numCommandBuffers})`'); }}}
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
-    wgpu[queue]['submit'](wgpuReadArrayOfItems(wgpu, commandBuffers, numCommandBuffers));
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
+    {{{ wgpuObject('queue') }}}['submit'](wgpuReadArrayOfItems(wgpu, commandBuffers, numCommandBuffers));
 
-    {{{ replacePtrToIdx('commandBuffers', 2); }}}
-    while(numCommandBuffers--) _wgpu_object_destroy(HEAPU32[commandBuffers++]);
+    _wgpu_object_destroy_many(commandBuffers, numCommandBuffers);
   },
 
   wgpu_queue_set_on_submitted_work_done_callback: function(queue, callback, userData) {
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
     {{{ wassert('callback'); }}}
-    wgpu[queue]['onSubmittedWorkDone']().then(() => {{{ makeDynCall('vip', 'callback') }}}(queue, userData));
+    {{{ wgpuObject('queue') }}}['onSubmittedWorkDone']().then(() => {{{ makeDynCall('vip', 'callback') }}}(queue, userData));
   },
 
 #if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
@@ -2526,20 +3524,20 @@ let api = {
   wgpu_queue_write_buffer: function(queue, buffer, bufferOffset, data, size) {
     {{{ wdebuglog('`wgpu_queue_write_buffer(queue=${queue}, buffer=${buffer}, bufferOffset=${bufferOffset}, data=${Number(data)>>>0}, size=${size})`'); }}}
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
     {{{ wassert('buffer != 0'); }}}
-    {{{ wassert('wgpu[buffer]'); }}}
-    {{{ wassert('wgpu[buffer] instanceof GPUBuffer'); }}}
+    {{{ wassert(wgpuObject('buffer')); }}}
+    {{{ wassert(wgpuIsType('buffer', 'GPUBuffer')); }}}
 #if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
     if (__wgpu_browser_is_firefox()) {
       // No Wasm4GB/Wasm64 support in Firefox: https://bugzil.la/2022805
       var firefoxWorkaroundBuffer = new Uint8Array(new Uint8Array(HEAPU8.buffer, {{{ shiftPtr('data', 0) }}}, size));
-      wgpu[queue]['writeBuffer'](wgpu[buffer], bufferOffset, firefoxWorkaroundBuffer);
+      {{{ wgpuObject('queue') }}}['writeBuffer']({{{ wgpuObject('buffer') }}}, bufferOffset, firefoxWorkaroundBuffer);
       return;
     }
 #endif
-    wgpu[queue]['writeBuffer'](wgpu[buffer], bufferOffset, HEAPU8, {{{ shiftPtr('data', 0) }}}, size);
+    {{{ wgpuObject('queue') }}}['writeBuffer']({{{ wgpuObject('buffer') }}}, bufferOffset, HEAPU8, {{{ shiftPtr('data', 0) }}}, size);
   },
 
   wgpu_queue_write_texture__deps: ['$wgpuReadGpuTexelCopyTextureInfo',
@@ -2550,14 +3548,14 @@ let api = {
   wgpu_queue_write_texture: function(queue, destination, data, bytesPerBlockRow, blockRowsPerImage, writeWidth, writeHeight, writeDepthOrArrayLayers) {
     {{{ wdebuglog('`wgpu_queue_write_texture(queue=${queue}, destination=${destination}, data=${Number(data)>>>0}, bytesPerBlockRow=${bytesPerBlockRow}, blockRowsPerImage=${blockRowsPerImage}, writeWidth=${writeWidth}, writeHeight=${writeHeight}, writeDepthOrArrayLayers=${writeDepthOrArrayLayers})`'); }}}
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
     {{{ wassert('destination'); }}}
 #if MIN_FIREFOX_VERSION != TARGET_NOT_SUPPORTED && (MEMORY64 || CAN_ADDRESS_2GB)
     if (__wgpu_browser_is_firefox()) {
       // No Wasm4GB/Wasm64 support in Firefox: https://bugzil.la/2022805
       var firefoxWorkaroundBuffer = new Uint8Array(new Uint8Array(HEAPU8.buffer, {{{ shiftPtr('data', 0) }}}, bytesPerBlockRow*blockRowsPerImage*writeDepthOrArrayLayers));
-      wgpu[queue]['writeTexture'](wgpuReadGpuTexelCopyTextureInfo(destination), firefoxWorkaroundBuffer,
+      {{{ wgpuObject('queue') }}}['writeTexture'](wgpuReadGpuTexelCopyTextureInfo(destination), firefoxWorkaroundBuffer,
         { 'offset': 0,
           'bytesPerRow': bytesPerBlockRow,
           'rowsPerImage': blockRowsPerImage
@@ -2565,7 +3563,7 @@ let api = {
       return;
     }
 #endif
-    wgpu[queue]['writeTexture'](wgpuReadGpuTexelCopyTextureInfo(destination), HEAPU8,
+    {{{ wgpuObject('queue') }}}['writeTexture'](wgpuReadGpuTexelCopyTextureInfo(destination), HEAPU8,
       { 'offset': {{{ shiftPtr('data', 0) }}},
         'bytesPerRow': bytesPerBlockRow,
         'rowsPerImage': blockRowsPerImage
@@ -2576,8 +3574,8 @@ let api = {
   wgpu_queue_copy_external_image_to_texture: function(queue, source, destination, copyWidth, copyHeight, copyDepthOrArrayLayers) {
     {{{ wdebuglog('`wgpu_queue_copy_external_image_to_texture(queue=${queue}, source=${source}, destination=${destination}, copyWidth=${copyWidth}, copyHeight=${copyHeight}, copyDepthOrArrayLayers=${copyDepthOrArrayLayers})`'); }}}
     {{{ wassert('queue != 0'); }}}
-    {{{ wassert('wgpu[queue]'); }}}
-    {{{ wassert('wgpu[queue] instanceof GPUQueue'); }}}
+    {{{ wassert(wgpuObject('queue')); }}}
+    {{{ wassert(wgpuIsType('queue', 'GPUQueue')); }}}
     {{{ wassert('source'); }}}
     {{{ wassert('destination'); }}}
 
@@ -2589,17 +3587,17 @@ let api = {
 
 #if ASSERTIONS
     let src = {
-      'source': wgpu[HEAPU32[source]],
+      'source': {{{ wgpuObject('HEAPU32[source]') }}},
       'origin': [HEAP32[source+1], HEAP32[source+2]],
       'flipY': !!HEAPU32[source+3]
       };
     {{{ wdebugdir('src', '`GPUQueue.copyExternalImageToTexture() with src:`'); }}}
     {{{ wdebugdir('dest', '`dst:`'); }}}
     {{{ wdebuglog('`copy dimensions: ${[copyWidth, copyHeight, copyDepthOrArrayLayers]}`'); }}}
-    wgpu[queue]['copyExternalImageToTexture'](src, dest, [copyWidth, copyHeight, copyDepthOrArrayLayers]);
+    {{{ wgpuObject('queue') }}}['copyExternalImageToTexture'](src, dest, [copyWidth, copyHeight, copyDepthOrArrayLayers]);
 #else
-    wgpu[queue]['copyExternalImageToTexture']({
-      'source': wgpu[HEAPU32[source]],
+    {{{ wgpuObject('queue') }}}['copyExternalImageToTexture']({
+      'source': {{{ wgpuObject('HEAPU32[source]') }}},
       'origin': [HEAP32[source+1], HEAP32[source+2]],
       'flipY': !!HEAPU32[source+3]
       }, dest, [copyWidth, copyHeight, copyDepthOrArrayLayers]);
@@ -2612,18 +3610,18 @@ let api = {
   wgpu_query_set_type: function(querySet) {
     {{{ wdebuglog('`wgpu_query_set_type(querySet=${querySet})`'); }}}
     {{{ wassert('querySet != 0'); }}}
-    {{{ wassert('wgpu[querySet]'); }}}
-    {{{ wassert('wgpu[querySet] instanceof GPUQuerySet'); }}}
-    {{{ wassert('GPUQueryTypes.includes(wgpu[querySet]["type"])'); }}}
-    return ' ot'.indexOf(wgpu[querySet]['type'][0]); // 'o'cclusion=1, 't'imestamp=2
+    {{{ wassert(wgpuObject('querySet')); }}}
+    {{{ wassert(wgpuIsType('querySet', 'GPUQuerySet')); }}}
+    {{{ wassert(`GPUQueryTypes.includes(${wgpuObject('querySet')}["type"])`); }}}
+    return ' ot'.indexOf({{{ wgpuObject('querySet') }}}['type'][0]); // 'o'cclusion=1, 't'imestamp=2
   },
 
   wgpu_query_set_count: function(querySet) {
     {{{ wdebuglog('`wgpu_query_set_count(querySet=${querySet})`'); }}}
     {{{ wassert('querySet != 0'); }}}
-    {{{ wassert('wgpu[querySet]'); }}}
-    {{{ wassert('wgpu[querySet] instanceof GPUQuerySet'); }}}
-    return wgpu[querySet]['count'];
+    {{{ wassert(wgpuObject('querySet')); }}}
+    {{{ wassert(wgpuIsType('querySet', 'GPUQuerySet')); }}}
+    return {{{ wgpuObject('querySet') }}}['count'];
   },
 
   wgpu_load_image_bitmap_from_url_async__deps: ['wgpuMuteJsExceptions', '$utf8', '$wgpuStore'],
@@ -2761,6 +3759,17 @@ let api = {
   },
 };
 
+// Object type tests expanded from wgpuIsType() read the wgpuTypes table, and object reads expanded from wgpuObject() call
+// wgpuGet() with WEBGPU_GENERATIONAL_HANDLES, so add those as dependencies of each function that uses them.
+for(const [name, func] of Object.entries(api)) {
+  if (!(func instanceof Function)) continue;
+  for(const [use, dep] of [['wgpuTypes[', '$wgpuTypes'], ['wgpuGet(', '$wgpuGet']]) {
+    if (name != dep && func.toString().includes(use) && !api[`${name}__deps`]?.includes(dep)) {
+      (api[`${name}__deps`] ??= []).push(dep);
+    }
+  }
+}
+
 // If building with -jsDWEBGPU_PROFILE=1, then wrap all WebGPU API calls into
 // performance.now() timers to get a log of any slow running functions.
 #if globalThis.WEBGPU_PROFILE
@@ -0,0 +1,454 @@
+#pragma once
+
+// lib_webgpu_cpp17.h: an optional header-only C++17 layer on top of lib_webgpu.h that allows building vertex layouts,
+// bind group layouts and render pipeline descriptors at compile time. Descriptors that are declared 'static constexpr'
+// with the helpers below are laid out fully initialized in the read-only data section of the program, so creating
+// a pipeline from them does not need to populate any descriptor structs at runtime. Only the object handles (shader
+// modules and pipeline layouts), which are not known until runtime, are patched in at pipeline creation time.
+//
+// Example:
+//
+//   using Vertex = wgpu_cpp17::VertexLayout<WGPU_VERTEX_FORMAT_FLOAT32X3, WGPU_VERTEX_FORMAT_FLOAT32X2, WGPU_VERTEX_FORMAT_UNORM8X4>;
+//   static_assert(Vertex::arrayStride == 24);
+//
+//   static constexpr WGpuVertexBufferLayout buffers[] = { Vertex::layout };
+//   static constexpr WGpuColorTargetState targets[] = { wgpu_cpp17::color_target(WGPU_TEXTURE_FORMAT_BGRA8UNORM) };
+//   static constexpr wgpu_cpp17::RenderPipelineDescriptor pipelineDesc = wgpu_cpp17::RenderPipelineDescriptor()
+//     .with_vertex("vs", buffers)
+//     .with_fragment("fs", targets)
+//     .with_depth_stencil(WGPU_TEXTURE_FORMAT_DEPTH24PLUS, WGPU_TRUE, WGPU_COMPARE_FUNCTION_LESS);
+//
+//   WGpuRenderPipeline pipeline = wgpu_cpp17::create_render_pipeline(device, pipelineDesc, pipelineLayout, shaderModule);
+
+#include "lib_webgpu.h"
+#include "lib_webgpu_vertex_formats.h"
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#if __cplusplus < 201703L
+#error "lib_webgpu_cpp17.h requires C++17 or newer (build with e.g. -std=c++17 or -std=c++20)"
+#endif
+
+// The initializers below omit fields that are intended to default-initialize to zero.
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-field-initializers"
+#pragma clang diagnostic ignored "-Wmissing-designated-field-initializers"
+#endif
+
+namespace wgpu_cpp17
+{
+
+////////////////////////////////////////////////////////////////
+// Vertex formats: constexpr versions of wgpu_vertex_format_channel_count(), wgpu_vertex_format_byte_size() and
+// wgpu_vertex_format_is_unorm(). Both are generated from the table in lib_webgpu_vertex_formats.h.
+
+#define _WGPU_VERTEX_FORMAT_CHANNEL_COUNT(format, channelCount, byteSize, isUnorm) case format: return channelCount;
+#define _WGPU_VERTEX_FORMAT_BYTE_SIZE(format, channelCount, byteSize, isUnorm) case format: return byteSize;
+#define _WGPU_VERTEX_FORMAT_IS_UNORM(format, channelCount, byteSize, isUnorm) case format: return isUnorm;
+
+// Calculates the dimension/number of channels in the given format (1-4), or 0 if the format is not a valid vertex format.
+constexpr int vertex_format_channel_count(WGPU_VERTEX_FORMAT format)
+{
+  switch(format)
+  {
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_CHANNEL_COUNT)
+    default: return 0;
+  }
+}
+
+// Calculates the size of a single element in the given format (1-16), or 0 if the format is not a valid vertex format.
+constexpr int vertex_format_byte_size(WGPU_VERTEX_FORMAT format)
+{
+  switch(format)
+  {
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_BYTE_SIZE)
+    default: return 0;
+  }
+}
+
+// Returns true if the given vertex format is any one of the _UNORM types.
+constexpr bool vertex_format_is_unorm(WGPU_VERTEX_FORMAT format)
+{
+  switch(format)
+  {
+    _WGPU_VERTEX_FORMATS(_WGPU_VERTEX_FORMAT_IS_UNORM)
+    default: return false;
+  }
+}
+
+#undef _WGPU_VERTEX_FORMAT_CHANNEL_COUNT
+#undef _WGPU_VERTEX_FORMAT_BYTE_SIZE
+#undef _WGPU_VERTEX_FORMAT_IS_UNORM
+
+// Returns the byte alignment that WebGPU requires for the offset of a vertex attribute of the given format: min(4, byte size).
+constexpr uint32_t vertex_format_alignment(WGPU_VERTEX_FORMAT format)
+{
+  return vertex_format_byte_size(format) < 4 ? (uint32_t)vertex_format_byte_size(format) : 4u;
+}
+
+////////////////////////////////////////////////////////////////
+// Vertex layouts: VertexBufferLayout<StepMode, FirstShaderLocation, Formats...> packs the given vertex attribute formats
+// tightly one after another, padding each attribute offset up to the alignment that WebGPU requires for its format,
+// and assigns consecutive shader locations to them starting from FirstShaderLocation. The array stride is the size of
+// the vertex, rounded up to a multiple of 4 bytes.
+
+constexpr uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+template<size_t N>
+constexpr std::array<WGpuVertexAttribute, N> vertex_attributes(const WGPU_VERTEX_FORMAT (&formats)[N], uint32_t firstShaderLocation)
+{
+  std::array<WGpuVertexAttribute, N> attributes = {};
+  uint64_t offset = 0;
+  for(size_t i = 0; i < N; ++i)
+  {
+    offset = align_up(offset, vertex_format_alignment(formats[i]));
+    attributes[i] = WGpuVertexAttribute {
+      .offset = offset,
+      .shaderLocation = firstShaderLocation + (uint32_t)i,
+      .format = formats[i]
+    };
+    offset += vertex_format_byte_size(formats[i]);
+  }
+  return attributes;
+}
+
+template<size_t N>
+constexpr uint64_t vertex_array_stride(const WGPU_VERTEX_FORMAT (&formats)[N])
+{
+  std::array<WGpuVertexAttribute, N> attributes = vertex_attributes(formats, 0);
+  return align_up(attributes[N-1].offset + vertex_format_byte_size(formats[N-1]), 4);
+}
+
+template<WGPU_VERTEX_STEP_MODE StepMode, uint32_t FirstShaderLocation, WGPU_VERTEX_FORMAT... Formats>
+struct VertexBufferLayout
+{
+  static_assert(sizeof...(Formats) > 0, "A vertex buffer layout must have at least one attribute!");
+  static_assert(((vertex_format_byte_size(Formats) > 0) && ...), "Invalid WGPU_VERTEX_FORMAT passed to VertexBufferLayout!");
+  static_assert(StepMode == WGPU_VERTEX_STEP_MODE_VERTEX || StepMode == WGPU_VERTEX_STEP_MODE_INSTANCE, "Invalid WGPU_VERTEX_STEP_MODE passed to VertexBufferLayout!");
+
+  static constexpr WGPU_VERTEX_FORMAT formats[] = { Formats... };
+  static constexpr int numAttributes = (int)sizeof...(Formats);
+  static constexpr std::array<WGpuVertexAttribute, sizeof...(Formats)> attributes = vertex_attributes(formats, FirstShaderLocation);
+  static constexpr uint64_t arrayStride = vertex_array_stride(formats);
+
+  // The shader location that the next vertex buffer should start from, if its attributes follow the ones in this buffer.
+  static constexpr uint32_t nextShaderLocation = FirstShaderLocation + (uint32_t)sizeof...(Formats);
+
+  static constexpr WGpuVertexBufferLayout layout = {
+    .attributes = attributes.data(),
+    .numAttributes = numAttributes,
+    .stepMode = StepMode,
+    .arrayStride = arrayStride
+  };
+
+  // Returns the byte offset of the attribute at the given index within a vertex.
+  static constexpr uint64_t offset(int attributeIndex) { return attributes[attributeIndex].offset; }
+};
+
+// A per-vertex buffer layout with shader locations starting from zero.
+template<WGPU_VERTEX_FORMAT... Formats>
+using VertexLayout = VertexBufferLayout<WGPU_VERTEX_STEP_MODE_VERTEX, 0, Formats...>;
+
+// A per-vertex or per-instance buffer layout with shader locations starting from FirstShaderLocation, for use as
+// the second or later buffer in a pipeline, e.g. InstanceLayoutAt<Vertex::nextShaderLocation, WGPU_VERTEX_FORMAT_FLOAT32X4>.
+template<uint32_t FirstShaderLocation, WGPU_VERTEX_FORMAT... Formats>
+using VertexLayoutAt = VertexBufferLayout<WGPU_VERTEX_STEP_MODE_VERTEX, FirstShaderLocation, Formats...>;
+
+template<uint32_t FirstShaderLocation, WGPU_VERTEX_FORMAT... Formats>
+using InstanceLayoutAt = VertexBufferLayout<WGPU_VERTEX_STEP_MODE_INSTANCE, FirstShaderLocation, Formats...>;
+
+////////////////////////////////////////////////////////////////
+// Bind group layout entries. Declare e.g.
+//   static constexpr WGpuBindGroupLayoutEntry entries[] = { uniform_buffer_entry(0, WGPU_SHADER_STAGE_VERTEX), sampler_entry(1, WGPU_SHADER_STAGE_FRAGMENT) };
+// and pass them to wgpu_device_create_bind_group_layout(device, entries, 2).
+
+constexpr WGpuBindGroupLayoutEntry buffer_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, WGPU_BUFFER_BINDING_TYPE type,
+  bool hasDynamicOffset = false, uint64_t minBindingSize = 0)
+{
+  return WGpuBindGroupLayoutEntry {
+    .binding = binding,
+    .visibility = visibility,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_BUFFER,
+    .layout = {
+      .buffer = {
+        .type = type,
+        .hasDynamicOffset = hasDynamicOffset,
+        .minBindingSize = minBindingSize
+      }
+    }
+  };
+}
+
+constexpr WGpuBindGroupLayoutEntry uniform_buffer_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, bool hasDynamicOffset = false, uint64_t minBindingSize = 0)
+{
+  return buffer_entry(binding, visibility, WGPU_BUFFER_BINDING_TYPE_UNIFORM, hasDynamicOffset, minBindingSize);
+}
+
+constexpr WGpuBindGroupLayoutEntry storage_buffer_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, bool readOnly = false, bool hasDynamicOffset = false, uint64_t minBindingSize = 0)
+{
+  return buffer_entry(binding, visibility, readOnly ? WGPU_BUFFER_BINDING_TYPE_READ_ONLY_STORAGE : WGPU_BUFFER_BINDING_TYPE_STORAGE, hasDynamicOffset, minBindingSize);
+}
+
+constexpr WGpuBindGroupLayoutEntry sampler_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, WGPU_SAMPLER_BINDING_TYPE type = WGPU_SAMPLER_BINDING_TYPE_FILTERING)
+{
+  return WGpuBindGroupLayoutEntry {
+    .binding = binding,
+    .visibility = visibility,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_SAMPLER,
+    .layout = {
+      .sampler = {
+        .type = type
+      }
+    }
+  };
+}
+
+constexpr WGpuBindGroupLayoutEntry texture_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, WGPU_TEXTURE_SAMPLE_TYPE sampleType = WGPU_TEXTURE_SAMPLE_TYPE_FLOAT,
+  WGPU_TEXTURE_VIEW_DIMENSION viewDimension = WGPU_TEXTURE_VIEW_DIMENSION_2D, bool multisampled = false)
+{
+  return WGpuBindGroupLayoutEntry {
+    .binding = binding,
+    .visibility = visibility,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_TEXTURE,
+    .layout = {
+      .texture = {
+        .sampleType = sampleType,
+        .viewDimension = viewDimension,
+        .multisampled = multisampled
+      }
+    }
+  };
+}
+
+constexpr WGpuBindGroupLayoutEntry storage_texture_entry(uint32_t binding, WGPU_SHADER_STAGE_FLAGS visibility, WGPU_TEXTURE_FORMAT format,
+  WGPU_STORAGE_TEXTURE_ACCESS access = WGPU_STORAGE_TEXTURE_ACCESS_WRITE_ONLY, WGPU_TEXTURE_VIEW_DIMENSION viewDimension = WGPU_TEXTURE_VIEW_DIMENSION_2D)
+{
+  return WGpuBindGroupLayoutEntry {
+    .binding = binding,
+    .visibility = visibility,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_STORAGE_TEXTURE,
+    .layout = {
+      .storageTexture = {
+        .access = access,
+        .format = format,
+        .viewDimension = viewDimension
+      }
+    }
+  };
+}
+
+////////////////////////////////////////////////////////////////
+// Render pipeline state. These mirror the defaults of WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER and
+// WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER, which are not usable in constant expressions.
+
+constexpr WGpuBlendComponent blend_component(WGPU_BLEND_OPERATION operation, WGPU_BLEND_FACTOR srcFactor, WGPU_BLEND_FACTOR dstFactor)
+{
+  return WGpuBlendComponent {
+    .operation = operation,
+    .srcFactor = srcFactor,
+    .dstFactor = dstFactor
+  };
+}
+
+// Blending is disabled.
+constexpr WGpuBlendState blend_disabled()
+{
+  return WGpuBlendState {
+    .color = blend_component(WGPU_BLEND_OPERATION_DISABLED, WGPU_BLEND_FACTOR_SRC, WGPU_BLEND_FACTOR_ONE_MINUS_SRC),
+    .alpha = blend_component(WGPU_BLEND_OPERATION_ADD, WGPU_BLEND_FACTOR_ONE, WGPU_BLEND_FACTOR_ZERO)
+  };
+}
+
+// Conventional non-premultiplied alpha blending: src * srcAlpha + dst * (1 - srcAlpha).
+constexpr WGpuBlendState blend_alpha()
+{
+  return WGpuBlendState {
+    .color = blend_component(WGPU_BLEND_OPERATION_ADD, WGPU_BLEND_FACTOR_SRC_ALPHA, WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA),
+    .alpha = blend_component(WGPU_BLEND_OPERATION_ADD, WGPU_BLEND_FACTOR_ONE, WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA)
+  };
+}
+
+// Premultiplied alpha blending: src + dst * (1 - srcAlpha).
+constexpr WGpuBlendState blend_premultiplied_alpha()
+{
+  return WGpuBlendState {
+    .color = blend_component(WGPU_BLEND_OPERATION_ADD, WGPU_BLEND_FACTOR_ONE, WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA),
+    .alpha = blend_component(WGPU_BLEND_OPERATION_ADD, WGPU_BLEND_FACTOR_ONE, WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA)
+  };
+}
+
+constexpr WGpuColorTargetState color_target(WGPU_TEXTURE_FORMAT format, WGpuBlendState blend = blend_disabled(), WGPU_COLOR_WRITE_FLAGS writeMask = WGPU_COLOR_WRITE_ALL)
+{
+  return WGpuColorTargetState {
+    .format = format,
+    .blend = blend,
+    .writeMask = writeMask
+  };
+}
+
+constexpr WGpuPrimitiveState primitive_state(WGPU_PRIMITIVE_TOPOLOGY topology = WGPU_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, WGPU_CULL_MODE cullMode = WGPU_CULL_MODE_NONE,
+  WGPU_FRONT_FACE frontFace = WGPU_FRONT_FACE_CCW, WGPU_INDEX_FORMAT stripIndexFormat = WGPU_INDEX_FORMAT_INVALID)
+{
+  return WGpuPrimitiveState {
+    .topology = topology,
+    .stripIndexFormat = stripIndexFormat,
+    .frontFace = frontFace,
+    .cullMode = cullMode
+  };
+}
+
+constexpr WGpuStencilFaceState stencil_face_state(WGPU_COMPARE_FUNCTION compare = WGPU_COMPARE_FUNCTION_ALWAYS, WGPU_STENCIL_OPERATION failOp = WGPU_STENCIL_OPERATION_KEEP,
+  WGPU_STENCIL_OPERATION depthFailOp = WGPU_STENCIL_OPERATION_KEEP, WGPU_STENCIL_OPERATION passOp = WGPU_STENCIL_OPERATION_KEEP)
+{
+  return WGpuStencilFaceState {
+    .compare = compare,
+    .failOp = failOp,
+    .depthFailOp = depthFailOp,
+    .passOp = passOp
+  };
+}
+
+// Pass format == WGPU_TEXTURE_FORMAT_INVALID to disable depth+stenciling altogether.
+constexpr WGpuDepthStencilState depth_stencil_state(WGPU_TEXTURE_FORMAT format = WGPU_TEXTURE_FORMAT_INVALID, WGPU_BOOL depthWriteEnabled = WGPU_FALSE,
+  WGPU_COMPARE_FUNCTION depthCompare = WGPU_COMPARE_FUNCTION_INVALID)
+{
+  return WGpuDepthStencilState {
+    .format = format,
+    .depthWriteEnabled = depthWriteEnabled,
+    .depthCompare = depthCompare,
+    .stencilReadMask = 0xFFFFFFFFu,
+    .stencilWriteMask = 0xFFFFFFFFu,
+    .stencilFront = stencil_face_state(),
+    .stencilBack = stencil_face_state()
+  };
+}
+
+constexpr WGpuMultisampleState multisample_state(uint32_t count = 1, uint32_t mask = 0xFFFFFFFFu, WGPU_BOOL alphaToCoverageEnabled = WGPU_FALSE)
+{
+  return WGpuMultisampleState {
+    .count = count,
+    .mask = mask,
+    .alphaToCoverageEnabled = alphaToCoverageEnabled
+  };
+}
+
+constexpr WGpuRenderPipelineDescriptor render_pipeline_descriptor()
+{
+  return WGpuRenderPipelineDescriptor {
+    .primitive = primitive_state(),
+    .depthStencil = depth_stencil_state(),
+    .multisample = multisample_state()
+  };
+}
+
+// A WGpuRenderPipelineDescriptor that can be built up in a constant expression by chaining the with_*() functions.
+// It can be passed anywhere a const WGpuRenderPipelineDescriptor * is expected. The shader modules and the pipeline
+// layout are left unset, since object handles are only known at runtime: use create_render_pipeline() below to fill
+// them in, or copy the descriptor and set them manually.
+struct RenderPipelineDescriptor : WGpuRenderPipelineDescriptor
+{
+  constexpr RenderPipelineDescriptor() : WGpuRenderPipelineDescriptor(render_pipeline_descriptor()) {}
+
+  template<size_t NumBuffers>
+  constexpr RenderPipelineDescriptor with_vertex(const char *entryPoint, const WGpuVertexBufferLayout (&buffers)[NumBuffers]) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.vertex.entryPoint = entryPoint;
+    d.vertex.buffers = buffers;
+    d.vertex.numBuffers = (int)NumBuffers;
+    return d;
+  }
+
+  // For vertex shaders that do not read any vertex buffers, e.g. ones that generate vertices from @builtin(vertex_index).
+  constexpr RenderPipelineDescriptor with_vertex(const char *entryPoint) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.vertex.entryPoint = entryPoint;
+    d.vertex.buffers = nullptr;
+    d.vertex.numBuffers = 0;
+    return d;
+  }
+
+  template<size_t NumConstants>
+  constexpr RenderPipelineDescriptor with_vertex_constants(const WGpuPipelineConstant (&constants)[NumConstants]) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.vertex.constants = constants;
+    d.vertex.numConstants = (int)NumConstants;
+    return d;
+  }
+
+  template<size_t NumTargets>
+  constexpr RenderPipelineDescriptor with_fragment(const char *entryPoint, const WGpuColorTargetState (&targets)[NumTargets]) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.fragment.entryPoint = entryPoint;
+    d.fragment.targets = targets;
+    d.fragment.numTargets = (int)NumTargets;
+    return d;
+  }
+
+  template<size_t NumConstants>
+  constexpr RenderPipelineDescriptor with_fragment_constants(const WGpuPipelineConstant (&constants)[NumConstants]) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.fragment.constants = constants;
+    d.fragment.numConstants = (int)NumConstants;
+    return d;
+  }
+
+  constexpr RenderPipelineDescriptor with_primitive(const WGpuPrimitiveState &primitiveState) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.primitive = primitiveState;
+    return d;
+  }
+
+  constexpr RenderPipelineDescriptor with_primitive(WGPU_PRIMITIVE_TOPOLOGY topology, WGPU_CULL_MODE cullMode = WGPU_CULL_MODE_NONE, WGPU_FRONT_FACE frontFace = WGPU_FRONT_FACE_CCW) const
+  {
+    return with_primitive(primitive_state(topology, cullMode, frontFace));
+  }
+
+  constexpr RenderPipelineDescriptor with_depth_stencil(const WGpuDepthStencilState &depthStencilState) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.depthStencil = depthStencilState;
+    return d;
+  }
+
+  constexpr RenderPipelineDescriptor with_depth_stencil(WGPU_TEXTURE_FORMAT format, WGPU_BOOL depthWriteEnabled, WGPU_COMPARE_FUNCTION depthCompare) const
+  {
+    return with_depth_stencil(depth_stencil_state(format, depthWriteEnabled, depthCompare));
+  }
+
+  constexpr RenderPipelineDescriptor with_multisample(uint32_t count, WGPU_BOOL alphaToCoverageEnabled = WGPU_FALSE) const
+  {
+    RenderPipelineDescriptor d = *this;
+    d.multisample = multisample_state(count, 0xFFFFFFFFu, alphaToCoverageEnabled);
+    return d;
+  }
+};
+
+// Creates a render pipeline from a (typically static constexpr) descriptor, using the given pipeline layout (or
+// WGPU_AUTO_LAYOUT_MODE_AUTO) and shader module(s). If fragmentModule is null, the vertex module is used for both stages.
+// The descriptor is copied onto the stack to patch in the handles, and the copy is passed to wgpu_device_create_render_pipeline().
+inline WGpuRenderPipeline create_render_pipeline(WGpuDevice device, const WGpuRenderPipelineDescriptor &staticDesc, WGpuPipelineLayout layout,
+  WGpuShaderModule vertexModule, WGpuShaderModule fragmentModule = 0)
+{
+  WGpuRenderPipelineDescriptor desc = staticDesc;
+  desc.vertex.module = vertexModule;
+  desc.fragment.module = fragmentModule ? fragmentModule : vertexModule;
+  desc.layout = layout;
+  return wgpu_device_create_render_pipeline(device, &desc);
+}
+
+} // namespace wgpu_cpp17
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
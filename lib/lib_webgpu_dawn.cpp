@@ -1,11 +1,18 @@
 #ifndef __EMSCRIPTEN__
+// This file implements the functions that WGPU_FILTER_REDUNDANT_STATE redirects to their wgpu_filter_*() variants, and calls
+// them internally, so it must see their unfiltered names.
+#undef WGPU_FILTER_REDUNDANT_STATE
 #include "lib_webgpu.h"
 
 #include "dawn/webgpu.h"
 #include "dawn/dawn_proc.h"
 #include "dawn/native/DawnNative.h"
 
+#include <algorithm>
+#include <list>
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <assert.h>
 #ifdef _WIN32
@@ -36,7 +43,15 @@ enum _WgpuObjectType {
   kWebGPURenderBundleEncoder,
   kWebGPUQueue,
   kWebGPUQuerySet,
-  kWebGPUCanvasContext
+  kWebGPUCanvasContext,
+  kWebGPUOther // Objects that are implemented by this library instead of Dawn, see _WGpuOtherObject.
+};
+static_assert(kWebGPUCanvasContext == WGPU_OBJECT_TYPE_CANVAS_CONTEXT, "_WgpuObjectType must match the order of WGPU_OBJECT_TYPE");
+static_assert(kWebGPUOther == WGPU_OBJECT_TYPE_OTHER, "_WgpuObjectType must match the order of WGPU_OBJECT_TYPE");
+
+// Base class of objects of type kWebGPUOther. These are deleted when the object is destroyed.
+struct _WGpuOtherObject {
+  virtual ~_WGpuOtherObject() {}
 };
 
 enum _WGpuBufferMapState {
@@ -46,15 +61,36 @@ enum _WGpuBufferMapState {
   kWebGPUBufferMapStateMappedForReading,
 };
 
-// lib_webgpu.js tracks derived objects and deletes them when the parent object is deleted.
-// This may potentially cause bad pointers because WGpuObjectBase is a pointer to a _WGpuObject,
-// and if the app still has a pointer to a derived object after it deletes the parent object,
-// it would be a bad pointer. The app should make sure to delete derived objects before a parent
-// object, such as deleting all texture_view's before deleting the texture.
+// Like lib_webgpu.js, this backend tracks derived objects and destroys them when their parent object
+// is destroyed. Object wrappers are never returned to the OS (see _WGpuObjectPool), so a handle that
+// the app still holds to a destroyed object will not point to freed memory, and wgpu_is_valid_object()
+// will return false for it. However, the wrapper may later be reused for a new object, in which case
+// the old handle would alias the new object. Build with WGPU_GENERATIONAL_HANDLES to detect that.
 
-struct _WGpuObject {
+// Object wrappers are allocated from slab pools (see _WGpuObjectPool), and are aligned to
+// cache lines so that accessing a wrapper touches a single cache line.
+struct alignas(64) _WGpuObject {
   _WgpuObjectType type; // C/Dawn doesn't have the RTTI that JS has.
+  uint32_t liveIndex; // Index of this object in _wgpu_live_objects, or WGPU_NOT_LIVE if the object has been destroyed.
   void* dawnObject;
+  bool transient; // If true, this object was created inside a transient scope, and is owned by _wgpu_transient_objects.
+  bool isBuffer; // If true, this is a _WGpuObjectBuffer, allocated from _wgpu_buffer_pool.
+  // For devices, and for the command and render pass encoders created from them: true if the device has the multi-draw
+  // indirect feature enabled. Dawn does not provide a way to get the device of an encoder, so this is passed down on creation.
+  bool multiDrawIndirect;
+#ifdef WGPU_GENERATIONAL_HANDLES
+  WGpuObjectBase id; // The full generational handle that this object is known by.
+#endif
+#ifdef WGPU_OBJECT_INTERNING
+  uint32_t internRefs; // If nonzero, this object is interned, and this is the number of references to it.
+#endif
+  uint32_t serial; // Serial number of this object, or 0 if wgpu_object_get_serial() has not been called for it.
+  // Intrusive links to the object hierarchy: the object that this object was created from,
+  // and a doubly linked list of the objects that were created from this object.
+  _WGpuObject* parent;
+  _WGpuObject* firstChild;
+  _WGpuObject* prevSibling;
+  _WGpuObject* nextSibling;
 };
 
 struct _WGpuObjectBuffer : _WGpuObject {
@@ -96,9 +132,189 @@ private:
   T* _self;
 };
 
-RuntimeStatic<std::map<void*, WGpuObjectBase>> _dawn_to_webgpu;
+// Allocates objects of type T from slabs of SLAB_SIZE contiguous objects, so that creating and
+// destroying WebGPU objects does not go through the general purpose allocator. Slabs are kept
+// around for the lifetime of the program, and freed objects are reused in LIFO order.
+template<typename T, int SLAB_SIZE = 256>
+class _WGpuObjectPool {
+public:
+  ~_WGpuObjectPool() {
+    for (T* slab : _slabs)
+      delete[] slab;
+  }
+
+  T* allocate() {
+    if (_free.empty()) {
+      T* slab = new T[SLAB_SIZE];
+      _slabs.push_back(slab);
+      for (int i = SLAB_SIZE - 1; i >= 0; --i)
+        _free.push_back(slab + i);
+    }
+    T* t = _free.back();
+    _free.pop_back();
+    *t = T{};
+    if (++_numLive > _highWaterMark)
+      _highWaterMark = _numLive;
+    return t;
+  }
+
+  void free(T* t) {
+    _free.push_back(t);
+    --_numLive;
+  }
+
+  void getStats(WGpuObjectPoolStats* stats) const {
+    stats->numLiveObjects = _numLive;
+    stats->highWaterMark = _highWaterMark;
+    stats->capacity = (uint32_t)(_slabs.size() * SLAB_SIZE);
+  }
+private:
+  std::vector<T*> _slabs;
+  std::vector<T*> _free;
+  uint32_t _numLive = 0;
+  uint32_t _highWaterMark = 0;
+};
+
+RuntimeStatic<_WGpuObjectPool<_WGpuObject>> _wgpu_object_pool;
+RuntimeStatic<_WGpuObjectPool<_WGpuObjectBuffer>> _wgpu_buffer_pool;
+
+// All live objects, in no particular order. Each object stores its own index in this table, so that
+// validity checks and removals are O(1) operations that do not need to allocate memory.
+RuntimeStatic<std::vector<_WGpuObject*>> _wgpu_live_objects;
+#define WGPU_NOT_LIVE 0xFFFFFFFFu
 RuntimeStatic<std::map<void*, void*>> _webgpu_to_dawn;
 
+// All objects that have been created inside the active transient scope, in creation order.
+RuntimeStatic<std::vector<_WGpuObject*>> _wgpu_transient_objects;
+bool _wgpu_transient_scope_active = false;
+
+// Scratch stack of objects pending destruction in wgpu_object_destroy(), kept around to avoid reallocating it on each call.
+RuntimeStatic<std::vector<_WGpuObject*>> _wgpu_destroy_stack;
+
+// Bind group cache, see wgpu_device_create_bind_group_cached(). Cached bind groups are kept in a list ordered from the least
+// to the most recently used. Each cached bind group is also registered with the layout and the resources that it references,
+// so that destroying any of them evicts the bind group from the cache.
+struct _WGpuBindGroupCacheEntry {
+  std::string key;
+  _WGpuObject* bindGroup;
+  std::vector<_WGpuObject*> resources;
+};
+typedef std::list<_WGpuBindGroupCacheEntry>::iterator _WGpuBindGroupCacheIterator;
+RuntimeStatic<std::list<_WGpuBindGroupCacheEntry>> _wgpu_bind_group_cache_lru;
+RuntimeStatic<std::unordered_map<std::string, _WGpuBindGroupCacheIterator>> _wgpu_bind_group_cache;
+RuntimeStatic<std::unordered_map<_WGpuObject*, _WGpuBindGroupCacheIterator>> _wgpu_bind_group_cache_entries;
+RuntimeStatic<std::unordered_map<_WGpuObject*, std::vector<_WGpuObject*>>> _wgpu_bind_group_cache_users;
+uint32_t _wgpu_bind_group_cache_capacity = 4096;
+WGpuBindGroupCacheStats _wgpu_bind_group_cache_stats;
+
+// Render bundle cache, see wgpu_render_bundle_cache_begin(). Each cached bundle is registered with the objects that its commands
+// reference, so that destroying any of them evicts the bundle from the cache. While a bundle is being recorded, the objects that
+// its commands reference are collected to the recording of its encoder.
+struct _WGpuRenderBundleCacheEntry {
+  uint32_t key;
+  std::vector<_WGpuObject*> references;
+};
+struct _WGpuRenderBundleRecording {
+  std::vector<_WGpuObject*> references;
+  bool valid = true; // Cleared if a referenced object is destroyed while recording, in which case the bundle is not cached.
+};
+RuntimeStatic<std::unordered_map<uint32_t, _WGpuObject*>> _wgpu_render_bundle_cache;
+RuntimeStatic<std::unordered_map<_WGpuObject*, _WGpuRenderBundleCacheEntry>> _wgpu_render_bundle_cache_entries;
+RuntimeStatic<std::unordered_map<_WGpuObject*, std::vector<_WGpuObject*>>> _wgpu_render_bundle_cache_users;
+RuntimeStatic<std::unordered_map<_WGpuObject*, _WGpuRenderBundleRecording>> _wgpu_render_bundle_cache_recordings;
+WGpuRenderBundleCacheStats _wgpu_render_bundle_cache_stats;
+
+// Cached bind groups and render bundles that should be destroyed because an object that they reference was destroyed.
+RuntimeStatic<std::vector<_WGpuObject*>> _wgpu_cache_evictions;
+
+// Render pipelines that are created with retainDescriptor set retain an owned copy of the Dawn descriptor that they were
+// created with, so that wgpu_device_create_render_pipeline_variant() can create variants of them. The copy holds references
+// to the shader modules and the pipeline layout, so that they stay alive even if the application destroys them.
+struct _WGpuRenderPipelineDescriptorStorage {
+  WGPURenderPipelineDescriptor desc;
+  WGPUDepthStencilState depthStencil;
+  WGPUFragmentState fragment;
+  std::string vertexEntryPoint, fragmentEntryPoint;
+  std::vector<WGPUVertexBufferLayout> vertexBuffers;
+  std::vector<std::vector<WGPUVertexAttribute>> vertexAttributes;
+  std::vector<WGPUColorTargetState> targets;
+  std::vector<WGPUBlendState> blends;
+  std::vector<WGPUConstantEntry> vertexConstants, fragmentConstants;
+  std::vector<std::string> vertexConstantNames, fragmentConstantNames;
+
+  _WGpuRenderPipelineDescriptorStorage() = default;
+  // Copies the descriptor of another pipeline, for creating a variant of it.
+  _WGpuRenderPipelineDescriptorStorage(const _WGpuRenderPipelineDescriptorStorage&) = default;
+  _WGpuRenderPipelineDescriptorStorage& operator=(const _WGpuRenderPipelineDescriptorStorage&) = delete;
+
+  ~_WGpuRenderPipelineDescriptorStorage() {
+    if (desc.layout) wgpuPipelineLayoutRelease(desc.layout);
+    if (desc.vertex.module) wgpuShaderModuleRelease(desc.vertex.module);
+    if (desc.fragment && fragment.module) wgpuShaderModuleRelease(fragment.module);
+  }
+
+  void addRefs() {
+    if (desc.layout) wgpuPipelineLayoutAddRef(desc.layout);
+    if (desc.vertex.module) wgpuShaderModuleAddRef(desc.vertex.module);
+    if (desc.fragment && fragment.module) wgpuShaderModuleAddRef(fragment.module);
+  }
+
+  // Points the descriptor to the arrays and strings in this storage. Must be called after the storage is filled or copied,
+  // and after any of the arrays are resized. A null pointer in the descriptor marks an absent optional field, and stays null.
+  void fixup() {
+    if (desc.depthStencil) desc.depthStencil = &depthStencil;
+    if (desc.fragment) desc.fragment = &fragment;
+    if (desc.vertex.entryPoint.data) desc.vertex.entryPoint = WGPUStringView{ vertexEntryPoint.c_str(), WGPU_STRLEN };
+    if (fragment.entryPoint.data) fragment.entryPoint = WGPUStringView{ fragmentEntryPoint.c_str(), WGPU_STRLEN };
+    for (size_t i = 0; i < vertexBuffers.size(); ++i)
+      vertexBuffers[i].attributes = vertexAttributes[i].data();
+    desc.vertex.buffers = vertexBuffers.data();
+    desc.vertex.bufferCount = vertexBuffers.size();
+    for (size_t i = 0; i < targets.size(); ++i)
+      if (targets[i].blend) targets[i].blend = &blends[i];
+    fragment.targets = targets.data();
+    fragment.targetCount = targets.size();
+    for (size_t i = 0; i < vertexConstants.size(); ++i)
+      vertexConstants[i].key = WGPUStringView{ vertexConstantNames[i].c_str(), WGPU_STRLEN };
+    desc.vertex.constants = vertexConstants.data();
+    desc.vertex.constantCount = vertexConstants.size();
+    for (size_t i = 0; i < fragmentConstants.size(); ++i)
+      fragmentConstants[i].key = WGPUStringView{ fragmentConstantNames[i].c_str(), WGPU_STRLEN };
+    fragment.constants = fragmentConstants.data();
+    fragment.constantCount = fragmentConstants.size();
+  }
+};
+RuntimeStatic<std::unordered_map<_WGpuObject*, _WGpuRenderPipelineDescriptorStorage*>> _wgpu_render_pipeline_descriptors;
+
+#ifdef WGPU_OBJECT_INTERNING
+// If building with WGPU_OBJECT_INTERNING defined, samplers, bind group layouts and pipeline layouts are interned like in
+// lib_webgpu.js with -jsDWEBGPU_OBJECT_INTERNING=1: creating one with a descriptor that is identical to that of an existing
+// object returns the existing object, and wgpu_object_destroy() destroys it only when the last reference is released.
+// Maps a key built from the device and the descriptor contents to the interned object, and back.
+RuntimeStatic<std::unordered_map<std::string, _WGpuObject*>> _wgpu_interned_objects;
+RuntimeStatic<std::unordered_map<_WGpuObject*, std::string>> _wgpu_interned_keys;
+#define _WGPU_INTERN(key, id) _wgpu_intern((key), (id))
+#else
+#define _WGPU_INTERN(key, id) (id)
+#endif
+
+// Total number of objects of each type that have been created and destroyed, indexed by _WgpuObjectType.
+uint32_t _wgpu_num_created_objects[WGPU_OBJECT_TYPE_COUNT];
+uint32_t _wgpu_num_destroyed_objects[WGPU_OBJECT_TYPE_COUNT];
+
+#ifdef WGPU_GENERATIONAL_HANDLES
+// If building with WGPU_GENERATIONAL_HANDLES defined, WGpuObjectBase IDs are generational handles
+// like in lib_webgpu.js: the low 20 bits of an ID are an index to the _wgpu_slots table, and the
+// next 11 bits hold a generation counter that is bumped each time the slot is recycled. This way
+// a stale ID to a destroyed object does not turn into a dangling pointer, but is detected.
+#define WGPU_HANDLE_SLOT_MASK 0xFFFFF
+#define WGPU_HANDLE_GENERATION_INCREMENT 0x100000
+// Slots 0 and 1 are reserved to match the ID space of lib_webgpu.js.
+RuntimeStatic<std::vector<_WGpuObject*>> _wgpu_slots;
+// The last handle that each free slot had.
+RuntimeStatic<std::vector<WGpuObjectBase>> _wgpu_free_handles;
+#endif
+
 // Translate lib_webgpu enums to Dawn enums
 const WGPUFeatureName WGPU_FEATURES_BITFIELD_to_Dawn[] = {
   WGPUFeatureName_CoreFeaturesAndLimits,
@@ -688,8 +904,28 @@ static dawn::native::Instance& GetDawnInstance() {
 
 struct _WGpuCanvasContext {
   WGPUSurface surface;
+  // The most recently acquired surface texture, and a cached view to it. The view is identified by its serial number as
+  // well, since the application may have destroyed it, and its handle may since have been reused by another view.
+  WGPUTexture currentTexture;
+  WGpuTextureView currentTextureView;
+  uint32_t currentTextureViewSerial;
 };
 
+// Returns the cached view to the current surface texture of the given canvas context, or 0 if it has been destroyed.
+static WGpuTextureView _wgpu_canvas_context_cached_view(_WGpuCanvasContext* context) {
+  return context->currentTextureView && wgpu_object_get_serial(context->currentTextureView) == context->currentTextureViewSerial
+    ? context->currentTextureView : 0;
+}
+
+// Releases the cached view to the current surface texture of the given canvas context.
+static void _wgpu_canvas_context_release_current_texture(_WGpuCanvasContext* context) {
+  wgpu_object_destroy(_wgpu_canvas_context_cached_view(context));
+  context->currentTextureView = 0;
+  if (context->currentTexture)
+    wgpuTextureRelease(context->currentTexture);
+  context->currentTexture = nullptr;
+}
+
 // Returns the number of leading zeros.
 // Is there a standard C/C++ function for this?
 static int clz32(int x) {
@@ -719,8 +955,116 @@ static int clz32(int x) {
   return r;
 }
 
+static inline bool _wgpu_is_live(_WGpuObject* obj) {
+  return obj->liveIndex < _wgpu_live_objects->size() && (*_wgpu_live_objects)[obj->liveIndex] == obj;
+}
+
+static inline void _wgpu_add_live(_WGpuObject* obj) {
+  obj->liveIndex = (uint32_t)_wgpu_live_objects->size();
+  _wgpu_live_objects->push_back(obj);
+}
+
+// Removes the given object from the live objects table by moving the last object in the table to its place.
+static inline void _wgpu_remove_live(_WGpuObject* obj) {
+  auto& live = *_wgpu_live_objects;
+  _WGpuObject* last = live.back();
+  live[obj->liveIndex] = last;
+  last->liveIndex = obj->liveIndex;
+  live.pop_back();
+  obj->liveIndex = WGPU_NOT_LIVE;
+}
+
+// Links the given child object as a derived object of the given parent object.
+static void _wgpu_link_parent_and_child(_WGpuObject* parent, _WGpuObject* child) {
+  child->parent = parent;
+  child->prevSibling = nullptr;
+  child->nextSibling = parent->firstChild;
+  if (parent->firstChild)
+    parent->firstChild->prevSibling = child;
+  parent->firstChild = child;
+}
+
+// Unregisters the given cached object from the list of cached objects that reference the given object.
+static void _wgpu_cache_remove_user(std::unordered_map<_WGpuObject*, std::vector<_WGpuObject*>>& cacheUsers, _WGpuObject* referenced, _WGpuObject* user) {
+  auto& users = cacheUsers[referenced];
+  for (size_t j = 0; j < users.size(); ++j)
+    if (users[j] == user) {
+      users[j] = users.back();
+      users.pop_back();
+      break;
+    }
+  if (users.empty())
+    cacheUsers.erase(referenced);
+}
+
+// If the given object is referenced by cached objects, queues those to be destroyed.
+static void _wgpu_cache_evict_users(std::unordered_map<_WGpuObject*, std::vector<_WGpuObject*>>& cacheUsers, _WGpuObject* obj) {
+  auto users = cacheUsers.find(obj);
+  if (users != cacheUsers.end()) {
+    _wgpu_cache_evictions->insert(_wgpu_cache_evictions->end(), users->second.begin(), users->second.end());
+    cacheUsers.erase(users);
+  }
+}
+
+// Called for each object that is destroyed while the bind group cache is not empty. If the object is a cached bind group,
+// removes it from the cache. If the object is referenced by cached bind groups, queues those bind groups to be destroyed.
+static void _wgpu_bind_group_cache_on_destroy(_WGpuObject* obj) {
+  auto entry = _wgpu_bind_group_cache_entries->find(obj);
+  if (entry != _wgpu_bind_group_cache_entries->end()) {
+    _WGpuBindGroupCacheIterator i = entry->second;
+    for (_WGpuObject* resource : i->resources)
+      _wgpu_cache_remove_user(*_wgpu_bind_group_cache_users, resource, obj);
+    _wgpu_bind_group_cache->erase(i->key);
+    _wgpu_bind_group_cache_lru->erase(i);
+    _wgpu_bind_group_cache_entries->erase(entry);
+    return;
+  }
+  _wgpu_cache_evict_users(*_wgpu_bind_group_cache_users, obj);
+}
+
+// Called for each object that is destroyed while the render bundle cache is not empty, or bundles are being recorded for it.
+// Like _wgpu_bind_group_cache_on_destroy(), and additionally invalidates the recordings that reference the object.
+static void _wgpu_render_bundle_cache_on_destroy(_WGpuObject* obj) {
+  auto entry = _wgpu_render_bundle_cache_entries->find(obj);
+  if (entry != _wgpu_render_bundle_cache_entries->end()) {
+    for (_WGpuObject* referenced : entry->second.references)
+      _wgpu_cache_remove_user(*_wgpu_render_bundle_cache_users, referenced, obj);
+    _wgpu_render_bundle_cache->erase(entry->second.key);
+    _wgpu_render_bundle_cache_entries->erase(entry);
+    return;
+  }
+  _wgpu_cache_evict_users(*_wgpu_render_bundle_cache_users, obj);
+
+  // There are rarely more than a few bundles being recorded at a time, so search them linearly.
+  if (_wgpu_render_bundle_cache_recordings->erase(obj))
+    return;
+  for (auto& recording : *_wgpu_render_bundle_cache_recordings)
+    if (std::find(recording.second.references.begin(), recording.second.references.end(), obj) != recording.second.references.end())
+      recording.second.valid = false;
+}
+
+// If the given object has a parent, unlinks the object from it.
+static void _wgpu_unlink_from_parent(_WGpuObject* obj) {
+  if (!obj->parent)
+    return;
+  if (obj->prevSibling)
+    obj->prevSibling->nextSibling = obj->nextSibling;
+  else
+    obj->parent->firstChild = obj->nextSibling;
+  if (obj->nextSibling)
+    obj->nextSibling->prevSibling = obj->prevSibling;
+  obj->parent = obj->prevSibling = obj->nextSibling = nullptr;
+}
+
 static inline _WGpuObject* _wgpu_get(WGpuObjectBase id) {
+#ifdef WGPU_GENERATIONAL_HANDLES
+  // Returns null if the handle is stale, i.e. its generation does not match the object in the slot.
+  uint32_t slot = id & WGPU_HANDLE_SLOT_MASK;
+  _WGpuObject* obj = slot < _wgpu_slots->size() ? (*_wgpu_slots)[slot] : nullptr;
+  return obj && obj->id == id ? obj : nullptr;
+#else
   return (_WGpuObject*)id;
+#endif
 }
 
 template<typename T> inline _WgpuObjectType _wgpu_get_type() { return kWebGPUInvalidObject; }
@@ -749,29 +1093,125 @@ template<typename T>
 static inline T _wgpu_get_dawn(WGpuObjectBase id) {
   if (!id)
     return nullptr;
-  assert(_wgpu_get_type<T>() == ((_WGpuObject*)id)->type);
-  return (T)(((_WGpuObject*)id)->dawnObject);
+  _WGpuObject* obj = _wgpu_get(id);
+  assert(obj && _wgpu_get_type<T>() == obj->type);
+  return (T)obj->dawnObject;
 }
 
 static WGpuObjectBase _wgpu_store(_WgpuObjectType type, void* dawnObject) {
-  _WGpuObject* wgpu;
-  if (type == kWebGPUBuffer)
-    wgpu = new _WGpuObjectBuffer{ type, dawnObject, kWebGPUBufferMapStateUnmapped };
-  else
-    wgpu = new _WGpuObject{ type, dawnObject };
+  bool isBuffer = type == kWebGPUBuffer;
+  _WGpuObject* wgpu = isBuffer ? _wgpu_buffer_pool->allocate() : _wgpu_object_pool->allocate();
+  wgpu->type = type;
+  wgpu->dawnObject = dawnObject;
+  wgpu->transient = _wgpu_transient_scope_active;
+  wgpu->isBuffer = isBuffer;
+  wgpu->multiDrawIndirect = false;
+
+  if (wgpu->transient)
+    _wgpu_transient_objects->push_back(wgpu);
+  ++_wgpu_num_created_objects[type];
+
+#ifdef WGPU_GENERATIONAL_HANDLES
+  WGpuObjectBase id;
+  if (!_wgpu_free_handles->empty()) {
+    // Bump the generation bits of the recycled slot so that old handles to it become stale.
+    id = (_wgpu_free_handles->back() + WGPU_HANDLE_GENERATION_INCREMENT) & 0x7FFFFFFF;
+    _wgpu_free_handles->pop_back();
+  } else {
+    if (_wgpu_slots->size() < 2)
+      _wgpu_slots->resize(2);
+    id = (WGpuObjectBase)_wgpu_slots->size();
+    assert(id <= WGPU_HANDLE_SLOT_MASK && "Too many live WebGPU objects for WGPU_GENERATIONAL_HANDLES!");
+    _wgpu_slots->push_back(nullptr);
+  }
+  wgpu->id = id;
+  (*_wgpu_slots)[id & WGPU_HANDLE_SLOT_MASK] = wgpu;
+  _wgpu_add_live(wgpu);
 
-  (*_dawn_to_webgpu)[dawnObject] = wgpu;
+  return id;
+#else
+  _wgpu_add_live(wgpu);
 
   return wgpu;
+#endif
+}
+
+// Returns the handle that the app knows the given object by.
+static inline WGpuObjectBase _wgpu_handle(_WGpuObject* obj) {
+#ifdef WGPU_GENERATIONAL_HANDLES
+  return obj->id;
+#else
+  return obj;
+#endif
+}
+
+// If the given render bundle encoder is recording a cached bundle, notes down that the bundle references the given object.
+static void _wgpu_render_bundle_cache_track(WGpuRenderBundleEncoder bundleEncoder, WGpuObjectBase object) {
+  if (_wgpu_render_bundle_cache_recordings->empty() || !object)
+    return;
+  auto recording = _wgpu_render_bundle_cache_recordings->find(_wgpu_get(bundleEncoder));
+  if (recording != _wgpu_render_bundle_cache_recordings->end())
+    recording->second.references.push_back(_wgpu_get(object));
+}
+
+#ifdef WGPU_OBJECT_INTERNING
+static std::string _wgpu_intern_key(char type, WGpuDevice device, const void* desc, size_t descSize) {
+  std::string key(1, type);
+  key.append((const char*)&device, sizeof(device));
+  key.append((const char*)desc, descSize);
+  return key;
+}
+
+// Returns the interned object with the given key after adding a reference to it, or 0 if there is none. Objects are not
+// interned inside a transient scope.
+static WGpuObjectBase _wgpu_intern_lookup(const std::string& key) {
+  if (_wgpu_transient_scope_active)
+    return 0;
+  auto i = _wgpu_interned_objects->find(key);
+  if (i == _wgpu_interned_objects->end())
+    return 0;
+  ++i->second->internRefs;
+  return _wgpu_handle(i->second);
+}
+
+// Interns the newly created object with the given handle under the given key. Returns the handle.
+static WGpuObjectBase _wgpu_intern(const std::string& key, WGpuObjectBase id) {
+  _WGpuObject* obj = _wgpu_get(id);
+  if (obj && !_wgpu_transient_scope_active) {
+    obj->internRefs = 1;
+    (*_wgpu_interned_objects)[key] = obj;
+    (*_wgpu_interned_keys)[obj] = key;
+  }
+  return id;
+}
+#endif
+
+static void _wgpu_free_wrapper(_WGpuObject* obj) {
+  if (obj->isBuffer)
+    _wgpu_buffer_pool->free((_WGpuObjectBuffer*)obj);
+  else
+    _wgpu_object_pool->free(obj);
 }
 
 static WGpuObjectBase _wgpu_store_and_set_parent(_WgpuObjectType type, void* dawnObject, WGpuObjectBase parent) {
   WGpuObjectBase id = _wgpu_store(type, dawnObject);
-  // derived objects currently aren't being tracked because deleting them can cause potential for memory errors.
+  // Objects created inside a transient scope are not linked to their parents, since they will all
+  // be released together at the end of the scope anyway.
+  if (parent && !_wgpu_transient_scope_active)
+    _wgpu_link_parent_and_child(_wgpu_get(parent), _wgpu_get(id));
+  return id;
+}
+
+// Passes the multi-draw indirect flag of a device or a command encoder on to the encoder that was created from it.
+static WGpuObjectBase _wgpu_inherit_multi_draw_indirect(WGpuObjectBase id, WGpuObjectBase creator) {
+  if (id)
+    _wgpu_get(id)->multiDrawIndirect = _wgpu_get(creator)->multiDrawIndirect;
   return id;
 }
 
 void _wgpu_object_destroy(_WGpuObject* obj) {
+  ++_wgpu_num_destroyed_objects[obj->type];
+
   // Dawn has separate Destroy functions for the different object types.
   switch (obj->type) {
   case kWebGPUAdapter: {
@@ -816,9 +1256,15 @@ void _wgpu_object_destroy(_WGpuObject* obj) {
   case kWebGPUComputePipeline:
     wgpuComputePipelineRelease((WGPUComputePipeline)obj->dawnObject);
     break;
-  case kWebGPURenderPipeline:
+  case kWebGPURenderPipeline: {
+    auto d = _wgpu_render_pipeline_descriptors->find(obj);
+    if (d != _wgpu_render_pipeline_descriptors->end()) {
+      delete d->second;
+      _wgpu_render_pipeline_descriptors->erase(d);
+    }
     wgpuRenderPipelineRelease((WGPURenderPipeline)obj->dawnObject);
     break;
+  }
   case kWebGPUCommandBuffer:
     wgpuCommandBufferRelease((WGPUCommandBuffer)obj->dawnObject);
     break;
@@ -834,8 +1280,14 @@ void _wgpu_object_destroy(_WGpuObject* obj) {
   case kWebGPUQueue:
     wgpuQueueRelease((WGPUQueue)obj->dawnObject);
     break;
-  case kWebGPUCanvasContext:
+  case kWebGPUCanvasContext: {
+    // The cached view is a child of the context, and gets destroyed with it.
+    _WGpuCanvasContext* context = (_WGpuCanvasContext*)obj->dawnObject;
+    if (context->currentTexture)
+      wgpuTextureRelease(context->currentTexture);
+    context->currentTexture = nullptr;
     break;
+  }
   case kWebGPUQuerySet:
     wgpuQuerySetDestroy((WGPUQuerySet)obj->dawnObject);
     break;
@@ -845,6 +1297,9 @@ void _wgpu_object_destroy(_WGpuObject* obj) {
   case kWebGPURenderBundleEncoder:
     wgpuRenderBundleEncoderDestroy((WGPURenderBundleEncoder)obj->dawnObject);
     break;
+  case kWebGPUOther:
+    delete (_WGpuOtherObject*)obj->dawnObject;
+    break;
   default:
     assert(false);
     break;
@@ -858,31 +1313,148 @@ void _wgpu_object_destroy(_WGpuObject* obj) {
 extern "C" {
 
 uint32_t wgpu_get_num_live_objects() {
-  return _dawn_to_webgpu->size();
+  return (uint32_t)_wgpu_live_objects->size();
 }
 
 void wgpu_object_destroy(WGpuObjectBase wgpuObject) {
   if (wgpuObject == 0)
     return;
 
-  _WGpuObject* obj = (_WGpuObject*)wgpuObject;
-  auto id = _dawn_to_webgpu->find(obj->dawnObject);
-  if (id == _dawn_to_webgpu->end())
+  _WGpuObject* obj = _wgpu_get(wgpuObject);
+#ifdef WGPU_GENERATIONAL_HANDLES
+  // Destroying a stale handle is a no-op, and will not destroy the object that currently occupies the slot.
+  if (!obj)
+    return;
+#endif
+  if (!_wgpu_is_live(obj))
+    return;
+#ifdef WGPU_OBJECT_INTERNING
+  // An interned object is shared by everyone who created it, so destroy it only when the last reference is released.
+  if (obj->internRefs > 1) {
+    --obj->internRefs;
     return;
-  _dawn_to_webgpu->erase(id);
+  }
+#endif
+  _wgpu_unlink_from_parent(obj);
+
+  // Destroy the object and all objects derived from it, e.g. GPUTexture -> GPUTextureViews. The hierarchy
+  // is walked with an explicit stack instead of recursion, so that its size is not limited by the call stack.
+  auto& stack = *_wgpu_destroy_stack;
+  stack.push_back(obj);
+  while (!stack.empty()) {
+    obj = stack.back();
+    stack.pop_back();
+    // The whole subtree is destroyed, so children do not need to be individually unlinked from their parent.
+    for (_WGpuObject* child = obj->firstChild; child; child = child->nextSibling)
+      stack.push_back(child);
+
+    if (!_wgpu_bind_group_cache_entries->empty())
+      _wgpu_bind_group_cache_on_destroy(obj);
+    if (!_wgpu_render_bundle_cache_entries->empty() || !_wgpu_render_bundle_cache_recordings->empty())
+      _wgpu_render_bundle_cache_on_destroy(obj);
+#ifdef WGPU_OBJECT_INTERNING
+    if (obj->internRefs) {
+      auto key = _wgpu_interned_keys->find(obj);
+      _wgpu_interned_objects->erase(key->second);
+      _wgpu_interned_keys->erase(key);
+      obj->internRefs = 0;
+    }
+#endif
+
+    _wgpu_remove_live(obj);
+#ifdef WGPU_GENERATIONAL_HANDLES
+    (*_wgpu_slots)[obj->id & WGPU_HANDLE_SLOT_MASK] = nullptr;
+    _wgpu_free_handles->push_back(obj->id);
+#endif
+    _wgpu_object_destroy(obj);
+    obj->parent = obj->firstChild = obj->prevSibling = obj->nextSibling = nullptr;
 
-  _wgpu_object_destroy(obj);
+    // Transient objects are freed all at once at the end of their scope.
+    if (!obj->transient)
+      _wgpu_free_wrapper(obj);
+  }
+
+  // Evict the cached bind groups and render bundles that referenced any of the destroyed objects. These may have already been
+  // destroyed above as part of the same hierarchy, in which case they are no longer live. (wrappers are not reallocated during the
+  // loop above)
+  auto& evictions = *_wgpu_cache_evictions;
+  while (!evictions.empty()) {
+    obj = evictions.back();
+    evictions.pop_back();
+    if (_wgpu_is_live(obj))
+      wgpu_object_destroy(_wgpu_handle(obj));
+  }
+}
 
-  delete obj;
+void wgpu_object_destroy_many(const WGpuObjectBase* wgpuObjects, int numObjects) {
+  assert(numObjects >= 0);
+  assert(wgpuObjects || numObjects == 0);
+  for (int i = 0; i < numObjects; ++i)
+    wgpu_object_destroy(wgpuObjects[i]);
 }
 
 void wgpu_destroy_all_objects() {
-  for (auto i : *_dawn_to_webgpu) {
-    _WGpuObject* obj = (_WGpuObject*)i.second;
+  if (_wgpu_transient_scope_active)
+    wgpu_transient_scope_end();
+
+  _wgpu_bind_group_cache_lru->clear();
+  _wgpu_bind_group_cache->clear();
+  _wgpu_bind_group_cache_entries->clear();
+  _wgpu_bind_group_cache_users->clear();
+  _wgpu_render_bundle_cache->clear();
+  _wgpu_render_bundle_cache_entries->clear();
+  _wgpu_render_bundle_cache_users->clear();
+  _wgpu_render_bundle_cache_recordings->clear();
+#ifdef WGPU_OBJECT_INTERNING
+  _wgpu_interned_objects->clear();
+  _wgpu_interned_keys->clear();
+#endif
+
+  for (_WGpuObject* obj : *_wgpu_live_objects) {
     _wgpu_object_destroy(obj);
-    delete obj;
+    _wgpu_free_wrapper(obj);
+  }
+  _wgpu_live_objects->clear();
+#ifdef WGPU_GENERATIONAL_HANDLES
+  _wgpu_slots->clear();
+  _wgpu_free_handles->clear();
+#endif
+}
+
+void wgpu_get_live_object_stats(WGpuLiveObjectStats* stats) {
+  assert(stats);
+  for (int type = 0; type < WGPU_OBJECT_TYPE_COUNT; ++type) {
+    stats->numLiveObjects[type] = _wgpu_num_created_objects[type] - _wgpu_num_destroyed_objects[type];
+    stats->numCreatedObjects[type] = _wgpu_num_created_objects[type];
+    stats->numDestroyedObjects[type] = _wgpu_num_destroyed_objects[type];
+  }
+}
+
+void wgpu_get_object_pool_stats(WGpuObjectPoolStats* objectPoolStats, WGpuObjectPoolStats* bufferPoolStats) {
+  assert(objectPoolStats);
+  assert(bufferPoolStats);
+  _wgpu_object_pool->getStats(objectPoolStats);
+  _wgpu_buffer_pool->getStats(bufferPoolStats);
+}
+
+void wgpu_transient_scope_begin() {
+  assert(!_wgpu_transient_scope_active && "Transient scopes cannot be nested!");
+  _wgpu_transient_scope_active = true;
+}
+
+void wgpu_transient_scope_end() {
+  assert(_wgpu_transient_scope_active && "wgpu_transient_scope_end() called without a matching wgpu_transient_scope_begin()!");
+  _wgpu_transient_scope_active = false;
+
+  // Release in reverse creation order, so that derived objects are destroyed before the objects they were created from.
+  auto& objects = *_wgpu_transient_objects;
+  for (auto i = objects.rbegin(); i != objects.rend(); ++i) {
+    _WGpuObject* obj = *i;
+    if (obj->type != kWebGPUInvalidObject)
+      wgpu_object_destroy(_wgpu_handle(obj));
+    _wgpu_free_wrapper(obj);
   }
-  _dawn_to_webgpu->clear();
+  objects.clear();
 }
 
 WGpuCanvasContext wgpu_canvas_get_webgpu_context(void *hwnd) {
@@ -903,7 +1475,16 @@ WGpuCanvasContext wgpu_canvas_get_webgpu_context(void *hwnd) {
 }
 
 WGPU_BOOL wgpu_is_valid_object(WGpuObjectBase obj) {
-  return obj != 0 && _dawn_to_webgpu->find(((_WGpuObject*)obj)->dawnObject) != _dawn_to_webgpu->end();
+#ifdef WGPU_GENERATIONAL_HANDLES
+  return _wgpu_get(obj) != nullptr;
+#else
+  return obj != 0 && _wgpu_is_live(_wgpu_get(obj));
+#endif
+}
+
+void wgpu_intern_string(const char* str) {
+  // Dawn consumes C strings directly, so there is nothing to cache.
+  assert(str);
 }
 
 void wgpu_object_set_label(WGpuObjectBase objBase, const char* label) {
@@ -972,6 +1553,18 @@ int wgpu_object_get_label(WGpuObjectBase obj, char* dstLabel, uint32_t dstLabelS
   return 0;
 }
 
+// Serial numbers are assigned on first query, so that objects that are never queried do not pay for them.
+static uint32_t _wgpu_next_object_serial = 0;
+
+uint32_t wgpu_object_get_serial(WGpuObjectBase obj) {
+  if (!wgpu_is_valid_object(obj))
+    return 0;
+  _WGpuObject* o = _wgpu_get(obj);
+  if (!o->serial)
+    o->serial = ++_wgpu_next_object_serial;
+  return o->serial;
+}
+
 WGPU_BOOL navigator_gpu_request_adapter_async(const WGpuRequestAdapterOptions* options, WGpuRequestAdapterCallback adapterCallback, void* userData) {
   WGpuAdapter adapter = navigator_gpu_request_adapter_sync(options);
   if (adapterCallback)
@@ -1144,6 +1737,12 @@ WGpuDevice wgpu_adapter_request_device_sync(WGpuAdapter adapter, const WGpuDevic
       features.push_back(WGPU_FEATURES_BITFIELD_to_Dawn[i]);
   }
 
+  // Multi-draw indirect is not part of the WebGPU spec, so it cannot be requested in requiredFeatures. Enable it whenever
+  // the adapter supports it, to give wgpu_render_commands_mixin_multi_draw_indirect() its fast path. (see lib_webgpu.h)
+  bool multiDrawIndirect = wgpuAdapterHasFeature(_wgpu_get_dawn<WGPUAdapter>(adapter), WGPUFeatureName_MultiDrawIndirect);
+  if (multiDrawIndirect)
+    features.push_back(WGPUFeatureName_MultiDrawIndirect);
+
   // custom increased limits that we have to specify for the device
   WGPULimits limits = {};
   limits.maxUniformBufferBindingSize = descriptor->requiredLimits.maxUniformBufferBindingSize;
@@ -1192,7 +1791,10 @@ WGpuDevice wgpu_adapter_request_device_sync(WGpuAdapter adapter, const WGpuDevic
     0 /* defaultQueue */
   };
   WGPUDevice device = wgpuAdapterCreateDevice(_wgpu_get_dawn<WGPUAdapter>(adapter), &_desc);
-  return  _wgpu_store_and_set_parent(kWebGPUDevice, device, adapter);
+  WGpuDevice id = _wgpu_store_and_set_parent(kWebGPUDevice, device, adapter);
+  if (id)
+    _wgpu_get(id)->multiDrawIndirect = multiDrawIndirect;
+  return id;
 }
 
 void wgpu_adapter_request_device_async_simple(WGpuAdapter adapter, WGpuRequestDeviceCallback deviceCallback) {
@@ -1272,9 +1874,15 @@ WGpuSampler wgpu_device_create_sampler(WGpuDevice device, const WGpuSamplerDescr
   assert(wgpu_is_device(device));
   // samplerDesc can be a nullptr;
 
+#ifdef WGPU_OBJECT_INTERNING
+  std::string key = _wgpu_intern_key('S', device, samplerDesc, samplerDesc ? sizeof(*samplerDesc) : 0);
+  if (WGpuSampler interned = _wgpu_intern_lookup(key))
+    return interned;
+#endif
+
   if (samplerDesc == nullptr) {
     WGPUSampler sampler = wgpuDeviceCreateSampler(_wgpu_get_dawn<WGPUDevice>(device), nullptr);
-    return _wgpu_store_and_set_parent(kWebGPUSampler, sampler, device);
+    return _WGPU_INTERN(key, _wgpu_store_and_set_parent(kWebGPUSampler, sampler, device));
   }
 
   WGPUSamplerDescriptor _desc = {};
@@ -1290,7 +1898,7 @@ WGpuSampler wgpu_device_create_sampler(WGpuDevice device, const WGpuSamplerDescr
   _desc.maxAnisotropy = (uint16_t)samplerDesc->maxAnisotropy;
 
   WGPUSampler sampler = wgpuDeviceCreateSampler(_wgpu_get_dawn<WGPUDevice>(device), &_desc);
-  return _wgpu_store_and_set_parent(kWebGPUSampler, sampler, device);
+  return _WGPU_INTERN(key, _wgpu_store_and_set_parent(kWebGPUSampler, sampler, device));
 }
 
 WGpuExternalTexture wgpu_device_import_external_texture(WGpuDevice device, const WGpuExternalTextureDescriptor* externalTextureDesc) {
@@ -1303,6 +1911,12 @@ WGpuBindGroupLayout wgpu_device_create_bind_group_layout(WGpuDevice device, cons
   assert(wgpu_is_device(device));
   assert(numEntries == 0 || bindGroupLayoutEntries != nullptr);
 
+#ifdef WGPU_OBJECT_INTERNING
+  std::string key = _wgpu_intern_key('B', device, bindGroupLayoutEntries, numEntries * sizeof(WGpuBindGroupLayoutEntry));
+  if (WGpuBindGroupLayout interned = _wgpu_intern_lookup(key))
+    return interned;
+#endif
+
   std::vector<WGPUBindGroupLayoutEntry> entries(numEntries);
 
   for (int i = 0; i < numEntries; ++i) {
@@ -1347,13 +1961,25 @@ WGpuBindGroupLayout wgpu_device_create_bind_group_layout(WGpuDevice device, cons
   _desc.entries = entries.data();
 
   WGPUBindGroupLayout layout = wgpuDeviceCreateBindGroupLayout(_wgpu_get_dawn<WGPUDevice>(device), &_desc);
-  return _wgpu_store_and_set_parent(kWebGPUBindGroupLayout, layout, device);
+  return _WGPU_INTERN(key, _wgpu_store_and_set_parent(kWebGPUBindGroupLayout, layout, device));
 }
 
 WGpuPipelineLayout wgpu_device_create_pipeline_layout(WGpuDevice device, const WGpuBindGroupLayout* bindGroupLayouts, int numLayouts, int immediateSize) {
   assert(wgpu_is_device(device));
   assert(numLayouts == 0 || bindGroupLayouts != nullptr);
 
+#ifdef WGPU_OBJECT_INTERNING
+  // Bind group layouts are interned as well, so identical pipeline layouts refer to the same bind group layouts. Key on
+  // their serial numbers rather than their handles, since a new bind group layout may reuse the handle of a destroyed one.
+  std::vector<uint32_t> serials(numLayouts);
+  for (int i = 0; i < numLayouts; ++i)
+    serials[i] = wgpu_object_get_serial(bindGroupLayouts[i]);
+  std::string key = _wgpu_intern_key('P', device, serials.data(), numLayouts * sizeof(uint32_t));
+  key.append((const char*)&immediateSize, sizeof(immediateSize));
+  if (WGpuPipelineLayout interned = _wgpu_intern_lookup(key))
+    return interned;
+#endif
+
   std::vector<WGPUBindGroupLayout> layouts(numLayouts);
   for (int i = 0; i < numLayouts; ++i)
     layouts[i] = _wgpu_get_dawn<WGPUBindGroupLayout>(bindGroupLayouts[i]);
@@ -1364,7 +1990,7 @@ WGpuPipelineLayout wgpu_device_create_pipeline_layout(WGpuDevice device, const W
   _desc.immediateSize = immediateSize;
 
   WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(_wgpu_get_dawn<WGPUDevice>(device), &_desc);
-  return _wgpu_store_and_set_parent(kWebGPUPipelineLayout, pipelineLayout, device);
+  return _WGPU_INTERN(key, _wgpu_store_and_set_parent(kWebGPUPipelineLayout, pipelineLayout, device));
 }
 
 WGpuBindGroup wgpu_device_create_bind_group(WGpuDevice device, WGpuBindGroupLayout bindGroupLayout, const WGpuBindGroupEntry* entries, int numEntries) {
@@ -1398,6 +2024,68 @@ WGpuBindGroup wgpu_device_create_bind_group(WGpuDevice device, WGpuBindGroupLayo
   return _wgpu_store_and_set_parent(kWebGPUBindGroup, bindGroup, device);
 }
 
+static void _wgpu_bind_group_cache_evict_least_recently_used() {
+  ++_wgpu_bind_group_cache_stats.numEvictions;
+  wgpu_object_destroy(_wgpu_handle(_wgpu_bind_group_cache_lru->front().bindGroup));
+}
+
+WGpuBindGroup wgpu_device_create_bind_group_cached(WGpuDevice device, WGpuBindGroupLayout bindGroupLayout, const WGpuBindGroupEntry* entries, int numEntries) {
+  assert(numEntries == 0 || entries != nullptr);
+
+  // The device does not need to be part of the key, since a bind group layout belongs to a single device.
+  std::string key((const char*)&bindGroupLayout, sizeof(bindGroupLayout));
+  for (int i = 0; i < numEntries; ++i) {
+    key.append((const char*)&entries[i].binding, sizeof(entries[i].binding));
+    key.append((const char*)&entries[i].resource, sizeof(entries[i].resource));
+    key.append((const char*)&entries[i].bufferBindOffset, sizeof(entries[i].bufferBindOffset));
+    key.append((const char*)&entries[i].bufferBindSize, sizeof(entries[i].bufferBindSize));
+  }
+
+  auto cached = _wgpu_bind_group_cache->find(key);
+  if (cached != _wgpu_bind_group_cache->end()) {
+    // Move the bind group to the most recently used end of the list.
+    _wgpu_bind_group_cache_lru->splice(_wgpu_bind_group_cache_lru->end(), *_wgpu_bind_group_cache_lru, cached->second);
+    ++_wgpu_bind_group_cache_stats.numHits;
+    return _wgpu_handle(cached->second->bindGroup);
+  }
+
+  ++_wgpu_bind_group_cache_stats.numMisses;
+  WGpuBindGroup bindGroup = wgpu_device_create_bind_group(device, bindGroupLayout, entries, numEntries);
+  if (!bindGroup)
+    return 0;
+
+  _WGpuObject* obj = _wgpu_get(bindGroup);
+  _WGpuBindGroupCacheIterator i = _wgpu_bind_group_cache_lru->insert(_wgpu_bind_group_cache_lru->end(), { key, obj, { _wgpu_get(bindGroupLayout) } });
+  for (int j = 0; j < numEntries; ++j)
+    if (_WGpuObject* resource = _wgpu_get(entries[j].resource))
+      i->resources.push_back(resource);
+  for (_WGpuObject* resource : i->resources)
+    (*_wgpu_bind_group_cache_users)[resource].push_back(obj);
+  (*_wgpu_bind_group_cache)[key] = i;
+  (*_wgpu_bind_group_cache_entries)[obj] = i;
+
+  if (_wgpu_bind_group_cache_lru->size() > _wgpu_bind_group_cache_capacity)
+    _wgpu_bind_group_cache_evict_least_recently_used();
+  return bindGroup;
+}
+
+void wgpu_bind_group_cache_set_capacity(uint32_t maxBindGroups) {
+  _wgpu_bind_group_cache_capacity = maxBindGroups;
+  while (_wgpu_bind_group_cache_lru->size() > _wgpu_bind_group_cache_capacity)
+    _wgpu_bind_group_cache_evict_least_recently_used();
+}
+
+void wgpu_bind_group_cache_clear() {
+  while (!_wgpu_bind_group_cache_lru->empty())
+    wgpu_object_destroy(_wgpu_handle(_wgpu_bind_group_cache_lru->front().bindGroup));
+}
+
+void wgpu_get_bind_group_cache_stats(WGpuBindGroupCacheStats* stats) {
+  assert(stats);
+  *stats = _wgpu_bind_group_cache_stats;
+  stats->numBindGroups = (uint32_t)_wgpu_bind_group_cache_lru->size();
+}
+
 WGpuShaderModule wgpu_device_create_shader_module(WGpuDevice device, const WGpuShaderModuleDescriptor* shaderModuleDesc) {
   assert(wgpu_is_device(device));
   assert(shaderModuleDesc != nullptr);
@@ -1493,24 +2181,41 @@ static WGPUBlendComponent fillBlendComponent(const WGpuBlendComponent& blendComp
   };
 }
 
-WGpuRenderPipeline wgpu_device_create_render_pipeline(WGpuDevice device, const WGpuRenderPipelineDescriptor* renderPipelineDesc) {
-  assert(wgpu_is_device(device));
-  assert(renderPipelineDesc != nullptr);
-
-  WGPURenderPipelineDescriptor _desc = {};
-  _desc.layout = _wgpu_get_dawn<WGPUPipelineLayout>(renderPipelineDesc->layout);
+static void fillConstantsStorage(const WGpuPipelineConstant* constants, int numConstants, std::vector<WGPUConstantEntry>& output, std::vector<std::string>& names) {
+  for (int i = 0; i < numConstants; ++i) {
+    output.push_back(WGPUConstantEntry{ nullptr, WGPU_STRING_VIEW_INIT, constants[i].value });
+    names.push_back(constants[i].name);
+  }
+}
 
-  {
-    WGPUPrimitiveState _primitive = {};
-    _primitive.topology = wgpu_primitive_topology_to_dawn(renderPipelineDesc->primitive.topology);
-    _primitive.stripIndexFormat = wgpu_index_format_to_dawn(renderPipelineDesc->primitive.stripIndexFormat);
-    _primitive.frontFace = wgpu_front_face_to_dawn(renderPipelineDesc->primitive.frontFace);
-    _primitive.cullMode = wgpu_cull_mode_to_dawn(renderPipelineDesc->primitive.cullMode);
-    _desc.primitive = _primitive;
+// Adds the given constants to the constants in the storage, replacing the values of the ones with the same name.
+static void mergeConstantsStorage(const WGpuPipelineConstant* constants, int numConstants, std::vector<WGPUConstantEntry>& output, std::vector<std::string>& names) {
+  for (int i = 0; i < numConstants; ++i) {
+    size_t j = 0;
+    while (j < names.size() && names[j] != constants[i].name)
+      ++j;
+    if (j < names.size())
+      output[j].value = constants[i].value;
+    else
+      fillConstantsStorage(&constants[i], 1, output, names);
   }
+}
+
+static _WGpuRenderPipelineDescriptorStorage* fillRenderPipelineDescriptor(const WGpuRenderPipelineDescriptor* renderPipelineDesc) {
+  _WGpuRenderPipelineDescriptorStorage* storage = new _WGpuRenderPipelineDescriptorStorage{};
+  WGPURenderPipelineDescriptor& _desc = storage->desc;
+  _desc.label = WGPU_STRING_VIEW_INIT;
+  _desc.vertex.entryPoint = WGPU_STRING_VIEW_INIT;
+  storage->fragment.entryPoint = WGPU_STRING_VIEW_INIT;
+  _desc.layout = (uintptr_t)renderPipelineDesc->layout > WGPU_AUTO_LAYOUT_MODE_AUTO ? _wgpu_get_dawn<WGPUPipelineLayout>(renderPipelineDesc->layout) : nullptr;
+
+  _desc.primitive.topology = wgpu_primitive_topology_to_dawn(renderPipelineDesc->primitive.topology);
+  _desc.primitive.stripIndexFormat = wgpu_index_format_to_dawn(renderPipelineDesc->primitive.stripIndexFormat);
+  _desc.primitive.frontFace = wgpu_front_face_to_dawn(renderPipelineDesc->primitive.frontFace);
+  _desc.primitive.cullMode = wgpu_cull_mode_to_dawn(renderPipelineDesc->primitive.cullMode);
 
-  WGPUDepthStencilState depthState = {};
   if (renderPipelineDesc->depthStencil.format != WGPU_TEXTURE_FORMAT_INVALID) {
+    WGPUDepthStencilState& depthState = storage->depthStencil;
     depthState.depthBias = renderPipelineDesc->depthStencil.depthBias;
     depthState.depthBiasClamp = renderPipelineDesc->depthStencil.depthBiasClamp;
     depthState.depthBiasSlopeScale = renderPipelineDesc->depthStencil.depthBiasSlopeScale;
@@ -1522,240 +2227,168 @@ WGpuRenderPipeline wgpu_device_create_render_pipeline(WGpuDevice device, const W
     depthState.stencilReadMask = renderPipelineDesc->depthStencil.stencilReadMask;
     depthState.stencilWriteMask = renderPipelineDesc->depthStencil.stencilWriteMask;
     _desc.depthStencil = &depthState;
-  } else
-    _desc.depthStencil = nullptr;
-
-  WGPUMultisampleState multisample = {};
-  multisample.alphaToCoverageEnabled = renderPipelineDesc->multisample.alphaToCoverageEnabled;
-  multisample.count = renderPipelineDesc->multisample.count;
-  multisample.mask = renderPipelineDesc->multisample.mask;
-  _desc.multisample = multisample;
+  }
 
-  WGPUVertexState _vertex = {};
+  _desc.multisample.alphaToCoverageEnabled = renderPipelineDesc->multisample.alphaToCoverageEnabled;
+  _desc.multisample.count = renderPipelineDesc->multisample.count;
+  _desc.multisample.mask = renderPipelineDesc->multisample.mask;
 
   // vertex state
   const auto& vertex = renderPipelineDesc->vertex;
-  _vertex.nextInChain = nullptr;
-  _vertex.module = _wgpu_get_dawn<WGPUShaderModule>(vertex.module);
-  _vertex.entryPoint = WGPUStringView{ vertex.entryPoint, WGPU_STRLEN };
-  _vertex.constantCount = (uint32_t)vertex.numConstants;
-
-  std::vector<WGPUConstantEntry> _vertexConstants(vertex.numConstants);
-  fillConstantsArray(vertex.constants, vertex.numConstants, _vertexConstants);
-  _vertex.constants = _vertexConstants.data();
+  _desc.vertex.module = _wgpu_get_dawn<WGPUShaderModule>(vertex.module);
+  if (vertex.entryPoint) {
+    storage->vertexEntryPoint = vertex.entryPoint;
+    _desc.vertex.entryPoint.data = vertex.entryPoint;
+  }
+  fillConstantsStorage(vertex.constants, vertex.numConstants, storage->vertexConstants, storage->vertexConstantNames);
 
-  _vertex.bufferCount = (uint32_t)vertex.numBuffers;
-  std::vector<WGPUVertexBufferLayout> _vertexBuffers(vertex.numBuffers);
+  storage->vertexBuffers.resize(vertex.numBuffers);
+  storage->vertexAttributes.resize(vertex.numBuffers);
   for (int i = 0; i < vertex.numBuffers; ++i) {
     const auto& vBuffer = vertex.buffers[i];
-    _vertexBuffers[i].arrayStride = vBuffer.arrayStride;
-    _vertexBuffers[i].attributeCount = vBuffer.numAttributes;
-    _vertexBuffers[i].stepMode = wgpu_vertex_step_mode_to_dawn(vBuffer.stepMode);
-
-    WGPUVertexAttribute* attributes = new WGPUVertexAttribute[_vertexBuffers[i].attributeCount];
-    for (int j = 0; j < _vertexBuffers[i].attributeCount; ++j) {
-      WGPU_VERTEX_FORMAT format = vBuffer.attributes[j].format;
-      attributes[j].format = wgpu_vertex_format_to_dawn(format);
+    storage->vertexBuffers[i].arrayStride = vBuffer.arrayStride;
+    storage->vertexBuffers[i].attributeCount = vBuffer.numAttributes;
+    storage->vertexBuffers[i].stepMode = wgpu_vertex_step_mode_to_dawn(vBuffer.stepMode);
+
+    std::vector<WGPUVertexAttribute>& attributes = storage->vertexAttributes[i];
+    attributes.resize(vBuffer.numAttributes);
+    for (int j = 0; j < vBuffer.numAttributes; ++j) {
+      attributes[j].format = wgpu_vertex_format_to_dawn(vBuffer.attributes[j].format);
       attributes[j].offset = vBuffer.attributes[j].offset;
       attributes[j].shaderLocation = vBuffer.attributes[j].shaderLocation;
     }
-    _vertexBuffers[i].attributes = attributes;
   }
-  _vertex.buffers = _vertexBuffers.data();
-  _desc.vertex = _vertex;
 
   const auto& fragment = renderPipelineDesc->fragment;
-  WGPUFragmentState fragmentState = {};
-  std::vector<WGPUColorTargetState> targets(fragment.numTargets);
-  std::vector<WGPUConstantEntry> outputConstants(fragment.numConstants);
-  
-  if (fragment.module == 0) {
-    _desc.fragment = nullptr;
-  } else {
-    fragmentState.constantCount = fragment.numConstants;
-    fragmentState.entryPoint = WGPUStringView{ fragment.entryPoint, WGPU_STRLEN };
-    fragmentState.nextInChain = nullptr;
+  if (fragment.module != 0) {
+    WGPUFragmentState& fragmentState = storage->fragment;
     fragmentState.module = _wgpu_get_dawn<WGPUShaderModule>(fragment.module);
-    fragmentState.targetCount = fragment.numTargets;
-
-    for (int i = 0; i < targets.size(); ++i) {
-      targets[i].nextInChain = nullptr;
+    if (fragment.entryPoint) {
+      storage->fragmentEntryPoint = fragment.entryPoint;
+      fragmentState.entryPoint.data = fragment.entryPoint;
+    }
 
+    storage->targets.resize(fragment.numTargets);
+    storage->blends.resize(fragment.numTargets);
+    for (int i = 0; i < fragment.numTargets; ++i) {
+      WGPUColorTargetState& target = storage->targets[i];
       if (fragment.targets[i].blend.color.operation != WGPU_BLEND_OPERATION_DISABLED) {
-        WGPUBlendState* blend = new WGPUBlendState{};
-        blend->color = fillBlendComponent(fragment.targets[i].blend.color);
-        blend->alpha = fillBlendComponent(fragment.targets[i].blend.alpha);
-        targets[i].blend = blend;
-      } else {
-        targets[i].blend = nullptr;
+        storage->blends[i].color = fillBlendComponent(fragment.targets[i].blend.color);
+        storage->blends[i].alpha = fillBlendComponent(fragment.targets[i].blend.alpha);
+        target.blend = &storage->blends[i];
       }
-
-      targets[i].format = wgpu_texture_format_to_dawn(fragment.targets[i].format);
-      targets[i].writeMask = fragment.targets[i].writeMask;
+      target.format = wgpu_texture_format_to_dawn(fragment.targets[i].format);
+      target.writeMask = fragment.targets[i].writeMask;
     }
 
-    fragmentState.targets = targets.data();
-
-    fillConstantsArray(fragment.constants, fragment.numConstants, outputConstants);
-    fragmentState.constants = outputConstants.data();
+    fillConstantsStorage(fragment.constants, fragment.numConstants, storage->fragmentConstants, storage->fragmentConstantNames);
     _desc.fragment = &fragmentState;
   }
-  
-  WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(_wgpu_get_dawn<WGPUDevice>(device), &_desc);
-
-  if (_desc.fragment != nullptr) {
-    for (int i = 0; i < _desc.fragment->targetCount; ++i)
-      delete _desc.fragment->targets[i].blend;
-  }
-
-  for (int i = 0; i < _desc.vertex.bufferCount; ++i)
-    delete[] _desc.vertex.buffers[i].attributes;
 
-  return _wgpu_store_and_set_parent(kWebGPURenderPipeline, pipeline, device);
+  storage->fixup();
+  storage->addRefs();
+  return storage;
 }
 
-// N.b. wgpu_device_create_render_pipeline_async() can currently only be called from a single thread, but that is fine since
-// WebGPU is currently a single-threaded API.
-static WGPURenderPipelineDescriptor _desc = {};
+static WGpuRenderPipeline _wgpu_store_render_pipeline(WGPURenderPipeline pipeline, WGpuDevice device, _WGpuRenderPipelineDescriptorStorage* storage, WGPU_BOOL retainDescriptor) {
+  WGpuRenderPipeline id = _wgpu_store_and_set_parent(kWebGPURenderPipeline, pipeline, device);
+  if (id && retainDescriptor)
+    (*_wgpu_render_pipeline_descriptors)[_wgpu_get(id)] = storage;
+  else
+    delete storage;
+  return id;
+}
 
-void wgpu_device_create_render_pipeline_async(WGpuDevice device, const WGpuRenderPipelineDescriptor *renderPipelineDesc,
-    WGpuCreatePipelineCallback callback, void *userData) {
+WGpuRenderPipeline wgpu_device_create_render_pipeline(WGpuDevice device, const WGpuRenderPipelineDescriptor* renderPipelineDesc) {
   assert(wgpu_is_device(device));
   assert(renderPipelineDesc != nullptr);
-  assert(callback);
-
-  _desc = {};
-  _desc.layout = renderPipelineDesc->layout > 0 ? _wgpu_get_dawn<WGPUPipelineLayout>(renderPipelineDesc->layout) : 0;
-  _desc.nextInChain = nullptr;
-  _desc.label = WGPU_STRING_VIEW_INIT;
-
-  {
-    WGPUPrimitiveState _primitive = {};
-    _primitive.nextInChain = nullptr;
-    _primitive.topology = wgpu_primitive_topology_to_dawn(renderPipelineDesc->primitive.topology);
-    _primitive.stripIndexFormat = wgpu_index_format_to_dawn(renderPipelineDesc->primitive.stripIndexFormat);
-    _primitive.frontFace = wgpu_front_face_to_dawn(renderPipelineDesc->primitive.frontFace);
-    _primitive.cullMode = wgpu_cull_mode_to_dawn(renderPipelineDesc->primitive.cullMode);
-    _desc.primitive = _primitive;
-  }
 
-  WGPUDepthStencilState depthState = {};
-  if (renderPipelineDesc->depthStencil.format != WGPU_TEXTURE_FORMAT_INVALID) {
-    depthState.depthBias = renderPipelineDesc->depthStencil.depthBias;
-    depthState.depthBiasClamp = renderPipelineDesc->depthStencil.depthBiasClamp;
-    depthState.depthBiasSlopeScale = renderPipelineDesc->depthStencil.depthBiasSlopeScale;
-    depthState.depthCompare = wgpu_compare_function_to_dawn(renderPipelineDesc->depthStencil.depthCompare);
-    depthState.depthWriteEnabled = static_cast<WGPUOptionalBool>(renderPipelineDesc->depthStencil.depthWriteEnabled);
-    depthState.format = wgpu_texture_format_to_dawn(renderPipelineDesc->depthStencil.format);
-    depthState.nextInChain = nullptr;
-    depthState.stencilBack = fillStencilFaceState(renderPipelineDesc->depthStencil.stencilBack);
-    depthState.stencilFront = fillStencilFaceState(renderPipelineDesc->depthStencil.stencilFront);
-    depthState.stencilReadMask = renderPipelineDesc->depthStencil.stencilReadMask;
-    depthState.stencilWriteMask = renderPipelineDesc->depthStencil.stencilWriteMask;
-    _desc.depthStencil = &depthState;
-  } else
-    _desc.depthStencil = nullptr;
-
-  WGPUMultisampleState multisample = {};
-  multisample.alphaToCoverageEnabled = renderPipelineDesc->multisample.alphaToCoverageEnabled;
-  multisample.count = renderPipelineDesc->multisample.count;
-  multisample.mask = renderPipelineDesc->multisample.mask;
-  multisample.nextInChain = nullptr;
-  _desc.multisample = multisample;
-
-  WGPUVertexState _vertex = {};
+  _WGpuRenderPipelineDescriptorStorage* storage = fillRenderPipelineDescriptor(renderPipelineDesc);
+  WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(_wgpu_get_dawn<WGPUDevice>(device), &storage->desc);
+  return _wgpu_store_render_pipeline(pipeline, device, storage, renderPipelineDesc->retainDescriptor);
+}
 
-  // vertex state
-  const auto& vertex = renderPipelineDesc->vertex;
-  _vertex.nextInChain = nullptr;
-  _vertex.module = _wgpu_get_dawn<WGPUShaderModule>(vertex.module);
-  _vertex.entryPoint = WGPUStringView{ vertex.entryPoint, WGPU_STRLEN };
-  _vertex.constantCount = (uint32_t)vertex.numConstants;
+WGpuRenderPipeline wgpu_device_create_render_pipeline_variant(WGpuDevice device, WGpuRenderPipeline base, const WGpuRenderPipelineDelta* delta) {
+  assert(wgpu_is_device(device));
+  assert(wgpu_is_render_pipeline(base));
+  assert(delta != nullptr);
 
-  std::vector<WGPUConstantEntry> _vertexConstants(vertex.numConstants);
-  fillConstantsArray(vertex.constants, vertex.numConstants, _vertexConstants);
-  _vertex.constants = _vertexConstants.data();
+  auto b = _wgpu_render_pipeline_descriptors->find(_wgpu_get(base));
+  assert(b != _wgpu_render_pipeline_descriptors->end() && "Base render pipeline must be created with retainDescriptor set!");
+  _WGpuRenderPipelineDescriptorStorage* storage = new _WGpuRenderPipelineDescriptorStorage(*b->second);
+  WGPURenderPipelineDescriptor& _desc = storage->desc;
 
-  _vertex.bufferCount = (uint32_t)vertex.numBuffers;
-  std::vector<WGPUVertexBufferLayout> _vertexBuffers(vertex.numBuffers);
-  for (int i = 0; i < vertex.numBuffers; ++i) {
-    const auto& vBuffer = vertex.buffers[i];
-    _vertexBuffers[i].arrayStride = vBuffer.arrayStride;
-    _vertexBuffers[i].attributeCount = vBuffer.numAttributes;
-    _vertexBuffers[i].stepMode = wgpu_vertex_step_mode_to_dawn(vBuffer.stepMode);
-
-    WGPUVertexAttribute* attributes = new WGPUVertexAttribute[_vertexBuffers[i].attributeCount];
-    for (int j = 0; j < _vertexBuffers[i].attributeCount; ++j) {
-      WGPU_VERTEX_FORMAT format = vBuffer.attributes[j].format;
-      attributes[j].format = wgpu_vertex_format_to_dawn(format);
-      attributes[j].offset = vBuffer.attributes[j].offset;
-      attributes[j].shaderLocation = vBuffer.attributes[j].shaderLocation;
-    }
-    _vertexBuffers[i].attributes = attributes;
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_TOPOLOGY) {
+    _desc.primitive.topology = wgpu_primitive_topology_to_dawn(delta->topology);
+    _desc.primitive.stripIndexFormat = wgpu_index_format_to_dawn(delta->stripIndexFormat);
+  }
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_FRONT_FACE)
+    _desc.primitive.frontFace = wgpu_front_face_to_dawn(delta->frontFace);
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_CULL_MODE)
+    _desc.primitive.cullMode = wgpu_cull_mode_to_dawn(delta->cullMode);
+
+  if (delta->fields & (WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE | WGPU_RENDER_PIPELINE_DELTA_DEPTH_WRITE | WGPU_RENDER_PIPELINE_DELTA_DEPTH_BIAS))
+    assert(_desc.depthStencil && "Base render pipeline must have a depth-stencil state to apply a depth delta to it!");
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE)
+    storage->depthStencil.depthCompare = wgpu_compare_function_to_dawn(delta->depthCompare);
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_DEPTH_WRITE)
+    storage->depthStencil.depthWriteEnabled = static_cast<WGPUOptionalBool>(delta->depthWriteEnabled);
+  if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_DEPTH_BIAS) {
+    storage->depthStencil.depthBias = delta->depthBias;
+    storage->depthStencil.depthBiasSlopeScale = delta->depthBiasSlopeScale;
+    storage->depthStencil.depthBiasClamp = delta->depthBiasClamp;
   }
-  _vertex.buffers = _vertexBuffers.data();
-  _desc.vertex = _vertex;
-
-  WGPUFragmentState fragmentState = {};
-
-  const auto& fragment = renderPipelineDesc->fragment;
-  std::vector<WGPUColorTargetState> targets(fragment.numTargets);
-  std::vector<WGPUConstantEntry> outputConstants(fragment.numConstants);
-
-  if (fragment.module == 0) {
-    _desc.fragment = nullptr;
-  } else {
-    fragmentState.constantCount = fragment.numConstants;
-    fragmentState.entryPoint = WGPUStringView{ fragment.entryPoint, WGPU_STRLEN };
-    fragmentState.nextInChain = nullptr;
-    fragmentState.module = fragment.module > 0 ? _wgpu_get_dawn<WGPUShaderModule>(fragment.module) : 0;
-    fragmentState.targetCount = fragment.numTargets;
-
-    for (int i = 0; i < targets.size(); ++i) {
-      targets[i].nextInChain = nullptr;
 
-      if (fragment.targets[i].blend.color.operation != WGPU_BLEND_OPERATION_DISABLED) {
-        WGPUBlendState* blend = new WGPUBlendState;
-        blend->color = fillBlendComponent(fragment.targets[i].blend.color);
-        blend->alpha = fillBlendComponent(fragment.targets[i].blend.alpha);
-        targets[i].blend = blend;
+  for (size_t i = 0; i < storage->targets.size(); ++i) {
+    WGPUColorTargetState& target = storage->targets[i];
+    // Sparse color targets stay sparse.
+    if (target.format == WGPUTextureFormat_Undefined)
+      continue;
+    if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_BLEND) {
+      if (delta->blend.color.operation != WGPU_BLEND_OPERATION_DISABLED) {
+        storage->blends[i].color = fillBlendComponent(delta->blend.color);
+        storage->blends[i].alpha = fillBlendComponent(delta->blend.alpha);
+        target.blend = &storage->blends[i];
       } else
-        targets[i].blend = nullptr;
-
-      targets[i].format = wgpu_texture_format_to_dawn(fragment.targets[i].format);
-      targets[i].writeMask = fragment.targets[i].writeMask;
+        target.blend = nullptr;
     }
-      
-    fragmentState.targets = targets.data();
-    
-    fillConstantsArray(fragment.constants, fragment.numConstants, outputConstants);
-    fragmentState.constants = outputConstants.data();
-    _desc.fragment = &fragmentState;
+    if (delta->fields & WGPU_RENDER_PIPELINE_DELTA_WRITE_MASK)
+      target.writeMask = delta->writeMask;
   }
 
-  WGPUDevice _device = _wgpu_get_dawn<WGPUDevice>(device);
+  assert(delta->numVertexConstants == 0 || delta->vertexConstants != nullptr);
+  assert(delta->numFragmentConstants == 0 || delta->fragmentConstants != nullptr);
+  mergeConstantsStorage(delta->vertexConstants, delta->numVertexConstants, storage->vertexConstants, storage->vertexConstantNames);
+  if (_desc.fragment)
+    mergeConstantsStorage(delta->fragmentConstants, delta->numFragmentConstants, storage->fragmentConstants, storage->fragmentConstantNames);
+
+  storage->fixup();
+  storage->addRefs();
+  WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(_wgpu_get_dawn<WGPUDevice>(device), &storage->desc);
+  return _wgpu_store_render_pipeline(pipeline, device, storage, delta->retainDescriptor);
+}
+
+void wgpu_device_create_render_pipeline_async(WGpuDevice device, const WGpuRenderPipelineDescriptor *renderPipelineDesc,
+    WGpuCreatePipelineCallback callback, void *userData) {
+  assert(wgpu_is_device(device));
+  assert(renderPipelineDesc != nullptr);
+  assert(callback);
 
   struct _Data {
     WGpuDevice device;
     WGpuCreatePipelineCallback callback;
     void* userdata;
+    _WGpuRenderPipelineDescriptorStorage* storage;
+    WGPU_BOOL retainDescriptor;
   };
-  _Data* data = new _Data{ device, callback, userData };
+  _Data* data = new _Data{ device, callback, userData, fillRenderPipelineDescriptor(renderPipelineDesc), renderPipelineDesc->retainDescriptor };
 
-  wgpuDeviceCreateRenderPipelineAsync(_device, &_desc,
+  wgpuDeviceCreateRenderPipelineAsync(_wgpu_get_dawn<WGPUDevice>(device), &data->storage->desc,
         [](WGPUCreatePipelineAsyncStatus status, WGPURenderPipeline pipeline, WGPUStringView message, void *userdata) {
     _Data* data = (_Data*)userdata;
-    WGpuRenderPipeline _pipeline = _wgpu_store_and_set_parent(kWebGPURenderPipeline, pipeline, data->device);
+    WGpuRenderPipeline _pipeline = _wgpu_store_render_pipeline(pipeline, data->device, data->storage, data->retainDescriptor);
     data->callback(data->device, nullptr, _pipeline, data->userdata);
     delete data;
-
-    if (_desc.fragment != nullptr) {
-      for (int i = 0; i < _desc.fragment->targetCount; ++i)
-        delete _desc.fragment->targets[i].blend;
-    }
-
-    for (int i = 0; i < _desc.vertex.bufferCount; ++i)
-      delete[] _desc.vertex.buffers[i].attributes;
   }, data);
 }
 
@@ -1765,7 +2398,7 @@ WGpuCommandEncoder wgpu_device_create_command_encoder(WGpuDevice device, const W
   WGPUCommandEncoderDescriptor desc = {};
   WGPUCommandEncoder commandEncoder = wgpuDeviceCreateCommandEncoder(_wgpu_get_dawn<WGPUDevice>(device), nullptr);
 
-  return _wgpu_store_and_set_parent(kWebGPUCommandEncoder, commandEncoder, device);
+  return _wgpu_inherit_multi_draw_indirect(_wgpu_store_and_set_parent(kWebGPUCommandEncoder, commandEncoder, device), device);
 }
 
 WGpuCommandEncoder wgpu_device_create_command_encoder_simple(WGpuDevice device) {
@@ -1774,7 +2407,7 @@ WGpuCommandEncoder wgpu_device_create_command_encoder_simple(WGpuDevice device)
   WGPUCommandEncoderDescriptor desc = {};
   WGPUCommandEncoder commandEncoder = wgpuDeviceCreateCommandEncoder(_wgpu_get_dawn<WGPUDevice>(device), &desc);
 
-  return _wgpu_store_and_set_parent(kWebGPUCommandEncoder, commandEncoder, device);
+  return _wgpu_inherit_multi_draw_indirect(_wgpu_store_and_set_parent(kWebGPUCommandEncoder, commandEncoder, device), device);
 }
 
 WGpuRenderBundleEncoder wgpu_device_create_render_bundle_encoder(WGpuDevice device, const WGpuRenderBundleEncoderDescriptor *renderBundleEncoderDesc) {
@@ -2056,7 +2689,7 @@ WGpuBindGroupLayout wgpu_pipeline_get_bind_group_layout(WGpuObjectBase pipelineB
   } else {
     bindGroupLayout = wgpuRenderPipelineGetBindGroupLayout(_wgpu_get_dawn<WGPURenderPipeline>(pipelineBase), index);
   }
-  return _wgpu_store(kWebGPUBindGroupLayout, bindGroupLayout);
+  return _wgpu_store_and_set_parent(kWebGPUBindGroupLayout, bindGroupLayout, pipelineBase);
 }
 
 WGPU_BOOL wgpu_is_compute_pipeline(WGpuObjectBase object) {
@@ -2131,6 +2764,20 @@ static WGPURenderPassColorAttachment getColorAttachInfo(const WGpuRenderPassColo
   return _attachment;
 }
 
+static WGPURenderPassDepthStencilAttachment getDepthStencilAttachInfo(const WGpuRenderPassDepthStencilAttachment& depthStencilAttachment) {
+  WGPURenderPassDepthStencilAttachment _attachment = {};
+  _attachment.view = _wgpu_get_dawn<WGPUTextureView>(depthStencilAttachment.view);
+  _attachment.depthLoadOp  = wgpu_load_op_to_dawn(depthStencilAttachment.depthLoadOp);
+  _attachment.depthStoreOp = wgpu_store_op_to_dawn(depthStencilAttachment.depthStoreOp);
+  _attachment.depthReadOnly = depthStencilAttachment.depthReadOnly;
+  _attachment.depthClearValue = depthStencilAttachment.depthClearValue;
+  _attachment.stencilLoadOp = wgpu_load_op_to_dawn(depthStencilAttachment.stencilLoadOp);
+  _attachment.stencilStoreOp = wgpu_store_op_to_dawn(depthStencilAttachment.stencilStoreOp);
+  _attachment.stencilClearValue = depthStencilAttachment.stencilClearValue;
+  _attachment.stencilReadOnly = depthStencilAttachment.stencilReadOnly;
+  return _attachment;
+}
+
 WGpuRenderPassEncoder wgpu_command_encoder_begin_render_pass(WGpuCommandEncoder commandEncoder, const WGpuRenderPassDescriptor *renderPassDesc) {
   assert(wgpu_is_command_encoder(commandEncoder));
   assert(renderPassDesc);
@@ -2149,15 +2796,7 @@ WGpuRenderPassEncoder wgpu_command_encoder_begin_render_pass(WGpuCommandEncoder
   if (_depthStencil.view <= 0) {
     _desc.depthStencilAttachment = nullptr;
   } else {
-    depthStencil.view = _wgpu_get_dawn<WGPUTextureView>(_depthStencil.view);
-    depthStencil.depthLoadOp  = wgpu_load_op_to_dawn(_depthStencil.depthLoadOp);
-    depthStencil.depthStoreOp = wgpu_store_op_to_dawn(_depthStencil.depthStoreOp);
-    depthStencil.depthReadOnly = _depthStencil.depthReadOnly;
-    depthStencil.depthClearValue = _depthStencil.depthClearValue;
-    depthStencil.stencilLoadOp = wgpu_load_op_to_dawn(_depthStencil.stencilLoadOp);
-    depthStencil.stencilStoreOp = wgpu_store_op_to_dawn(_depthStencil.stencilStoreOp);
-    depthStencil.stencilClearValue = _depthStencil.stencilClearValue;
-    depthStencil.stencilReadOnly = _depthStencil.stencilReadOnly;
+    depthStencil = getDepthStencilAttachInfo(_depthStencil);
     _desc.depthStencilAttachment = &depthStencil;
   }
 
@@ -2176,7 +2815,81 @@ WGpuRenderPassEncoder wgpu_command_encoder_begin_render_pass(WGpuCommandEncoder
     _desc.nextInChain = nullptr;
 
   WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(_wgpu_get_dawn<WGPUCommandEncoder>(commandEncoder), &_desc);
-  return _wgpu_store(kWebGPURenderPassEncoder, renderPassEncoder);
+  return _wgpu_inherit_multi_draw_indirect(_wgpu_store(kWebGPURenderPassEncoder, renderPassEncoder), commandEncoder);
+}
+
+// A render pass descriptor that is converted to Dawn structures only once, and then patched in place each time a render pass
+// is begun from it. Attachment views and the occlusion query set are stored as handles, and looked up each time a render pass
+// is begun, so that the template does not hold references to them.
+struct _WGpuRenderPassTemplate : _WGpuOtherObject {
+  WGPURenderPassDescriptor desc;
+  WGPURenderPassColorAttachment colorAttachments[WGPU_MAX_COLOR_ATTACHMENTS];
+  WGpuObjectBase views[WGPU_MAX_COLOR_ATTACHMENTS];
+  WGpuObjectBase resolveTargets[WGPU_MAX_COLOR_ATTACHMENTS];
+  WGPURenderPassDepthStencilAttachment depthStencil;
+  WGpuObjectBase depthStencilView;
+  WGpuObjectBase occlusionQuerySet;
+  WGPURenderPassMaxDrawCount maxDrawCount;
+};
+
+WGpuRenderPassTemplate wgpu_render_pass_template_create(const WGpuRenderPassDescriptor *renderPassDesc) {
+  assert(renderPassDesc);
+  assert(renderPassDesc->numColorAttachments <= WGPU_MAX_COLOR_ATTACHMENTS);
+
+  _WGpuRenderPassTemplate* t = new _WGpuRenderPassTemplate{};
+  t->desc.colorAttachmentCount = (uint32_t)renderPassDesc->numColorAttachments;
+  t->desc.colorAttachments = t->colorAttachments;
+  for (int i = 0; i < renderPassDesc->numColorAttachments; ++i) {
+    // Sparse color attachments are left zero-initialized, i.e. without a view.
+    if (renderPassDesc->colorAttachments[i].view)
+      t->colorAttachments[i] = getColorAttachInfo(renderPassDesc->colorAttachments[i]);
+    t->views[i] = renderPassDesc->colorAttachments[i].view;
+    t->resolveTargets[i] = renderPassDesc->colorAttachments[i].resolveTarget;
+  }
+
+  if (renderPassDesc->depthStencilAttachment.view) {
+    t->depthStencil = getDepthStencilAttachInfo(renderPassDesc->depthStencilAttachment);
+    t->depthStencilView = renderPassDesc->depthStencilAttachment.view;
+    t->desc.depthStencilAttachment = &t->depthStencil;
+  }
+
+  t->occlusionQuerySet = renderPassDesc->occlusionQuerySet;
+  t->desc.label = WGPU_STRING_VIEW_INIT;
+
+  if (renderPassDesc->maxDrawCount > 0) {
+    t->maxDrawCount.maxDrawCount = renderPassDesc->maxDrawCount;
+    t->maxDrawCount.chain = { nullptr, WGPUSType_RenderPassMaxDrawCount };
+    t->desc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&t->maxDrawCount);
+  }
+
+  return _wgpu_store(kWebGPUOther, t);
+}
+
+WGpuRenderPassEncoder wgpu_command_encoder_begin_render_pass_from_template(WGpuCommandEncoder commandEncoder, WGpuRenderPassTemplate renderPassTemplate, const WGpuRenderPassPatch *patch) {
+  assert(wgpu_is_command_encoder(commandEncoder));
+  // patch may be null.
+
+  _WGpuObject* obj = _wgpu_get(renderPassTemplate);
+  assert(obj && obj->type == kWebGPUOther);
+  _WGpuRenderPassTemplate* t = (_WGpuRenderPassTemplate*)obj->dawnObject;
+  for (uint32_t i = 0; i < t->desc.colorAttachmentCount; ++i) {
+    // Sparse color attachments stay sparse, even if the patch specifies a view for them.
+    if (!t->views[i])
+      continue;
+    WGPURenderPassColorAttachment& a = t->colorAttachments[i];
+    a.view = _wgpu_get_dawn<WGPUTextureView>(patch && patch->colorAttachmentViews[i] ? patch->colorAttachmentViews[i] : t->views[i]);
+    a.resolveTarget = _wgpu_get_dawn<WGPUTextureView>(patch && patch->resolveTargets[i] ? patch->resolveTargets[i] : t->resolveTargets[i]);
+    if (patch && (patch->clearValueMask & (1u << i))) {
+      const WGpuColor& c = patch->clearValues[i];
+      a.clearValue = WGPUColor{ c.r, c.g, c.b, c.a };
+    }
+  }
+  if (t->desc.depthStencilAttachment)
+    t->depthStencil.view = _wgpu_get_dawn<WGPUTextureView>(patch && patch->depthStencilView ? patch->depthStencilView : t->depthStencilView);
+  t->desc.occlusionQuerySet = _wgpu_get_dawn<WGPUQuerySet>(t->occlusionQuerySet);
+
+  WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(_wgpu_get_dawn<WGPUCommandEncoder>(commandEncoder), &t->desc);
+  return _wgpu_inherit_multi_draw_indirect(_wgpu_store(kWebGPURenderPassEncoder, renderPassEncoder), commandEncoder);
 }
 
 WGpuComputePassEncoder wgpu_command_encoder_begin_compute_pass(WGpuCommandEncoder commandEncoder, const WGpuComputePassDescriptor *computePassDesc) {
@@ -2332,9 +3045,11 @@ void wgpu_encoder_set_bind_group(WGpuBindingCommandsMixin encoder, uint32_t inde
   else if (wgpu_is_compute_pass_encoder(encoder))
     wgpuComputePassEncoderSetBindGroup(_wgpu_get_dawn<WGPUComputePassEncoder>(encoder), index, _wgpu_get_dawn<WGPUBindGroup>(bindGroup),
       numDynamicOffsets, dynamicOffsets);
-  else if (wgpu_is_render_bundle_encoder(encoder))
+  else if (wgpu_is_render_bundle_encoder(encoder)) {
     wgpuRenderBundleEncoderSetBindGroup(_wgpu_get_dawn<WGPURenderBundleEncoder>(encoder), index, _wgpu_get_dawn<WGPUBindGroup>(bindGroup),
       numDynamicOffsets, dynamicOffsets);
+    _wgpu_render_bundle_cache_track(encoder, bindGroup);
+  }
 }
 
 void wgpu_encoder_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase pipeline) {
@@ -2344,8 +3059,10 @@ void wgpu_encoder_set_pipeline(WGpuBindingCommandsMixin encoder, WGpuObjectBase
     wgpuRenderPassEncoderSetPipeline(_wgpu_get_dawn<WGPURenderPassEncoder>(encoder), _wgpu_get_dawn<WGPURenderPipeline>(pipeline));
   else if (wgpu_is_compute_pass_encoder(encoder))
     wgpuComputePassEncoderSetPipeline(_wgpu_get_dawn<WGPUComputePassEncoder>(encoder), _wgpu_get_dawn<WGPUComputePipeline>(pipeline));
-  else if (wgpu_is_render_bundle_encoder(encoder))
+  else if (wgpu_is_render_bundle_encoder(encoder)) {
     wgpuRenderBundleEncoderSetPipeline(_wgpu_get_dawn<WGPURenderBundleEncoder>(encoder), _wgpu_get_dawn<WGPURenderPipeline>(pipeline));
+    _wgpu_render_bundle_cache_track(encoder, pipeline);
+  }
 }
 
 void wgpu_encoder_end(WGpuBindingCommandsMixin encoder) {
@@ -2404,6 +3121,7 @@ void wgpu_render_commands_mixin_set_index_buffer(WGpuRenderCommandsMixin renderC
   } else if (wgpu_is_render_bundle_encoder(renderCommandsMixin)) {
     wgpuRenderBundleEncoderSetIndexBuffer(_wgpu_get_dawn<WGPURenderBundleEncoder>(renderCommandsMixin), _wgpu_get_dawn<WGPUBuffer>(buffer),
         (WGPUIndexFormat) indexFormat, (uint64_t) offset, (uint64_t)size);
+    _wgpu_render_bundle_cache_track(renderCommandsMixin, buffer);
   }
 }
 
@@ -2419,6 +3137,7 @@ void wgpu_render_commands_mixin_set_vertex_buffer(WGpuRenderCommandsMixin render
   } else if (wgpu_is_render_bundle_encoder(renderCommandsMixin)) {
     WGPURenderBundleEncoder _encoder = _wgpu_get_dawn<WGPURenderBundleEncoder>(renderCommandsMixin);
     wgpuRenderBundleEncoderSetVertexBuffer(_encoder, (uint32_t) slot, _wgpu_get_dawn<WGPUBuffer>(buffer), (uint64_t) offset, (uint64_t)size);
+    _wgpu_render_bundle_cache_track(renderCommandsMixin, buffer);
   }
 }
 
@@ -2456,6 +3175,7 @@ void wgpu_render_commands_mixin_draw_indirect(WGpuRenderCommandsMixin renderComm
   } else if (wgpu_is_render_bundle_encoder(renderCommandsMixin)) {
     WGPURenderBundleEncoder _encoder = _wgpu_get_dawn<WGPURenderBundleEncoder>(renderCommandsMixin);
     wgpuRenderBundleEncoderDrawIndirect(_encoder, _wgpu_get_dawn<WGPUBuffer>(indirectBuffer), (uint64_t) indirectOffset);
+    _wgpu_render_bundle_cache_track(renderCommandsMixin, indirectBuffer);
   }
 }
 
@@ -2468,6 +3188,123 @@ void wgpu_render_commands_mixin_draw_indexed_indirect(WGpuRenderCommandsMixin re
   } else if (wgpu_is_render_bundle_encoder(renderCommandsMixin)) {
     WGPURenderBundleEncoder _encoder = _wgpu_get_dawn<WGPURenderBundleEncoder>(renderCommandsMixin);
     wgpuRenderBundleEncoderDrawIndexedIndirect(_encoder, _wgpu_get_dawn<WGPUBuffer>(indirectBuffer), (uint64_t)indirectOffset);
+    _wgpu_render_bundle_cache_track(renderCommandsMixin, indirectBuffer);
+  }
+}
+
+// Issues drawCount indirect draws with a single native multi-draw call if possible, and otherwise one at a time.
+// drawCountBuffer is only used by the native call: the fallback issues all drawCount draws. (see lib_webgpu.h)
+static void _wgpu_multi_draw_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset,
+    uint32_t drawCount, uint32_t stride, WGpuBuffer drawCountBuffer, double_int53_t drawCountBufferOffset, bool indexed) {
+  assert(wgpu_is_render_commands_mixin(renderCommandsMixin));
+  assert(wgpu_is_buffer(indirectBuffer));
+  assert(((uint64_t)indirectOffset & 3) == 0);
+
+  uint32_t argsSize = indexed ? WGPU_DRAW_INDEXED_INDIRECT_ARGS_SIZE : WGPU_DRAW_INDIRECT_ARGS_SIZE;
+  if (!stride) stride = argsSize;
+  assert(stride >= argsSize);
+  WGPUBuffer buffer = _wgpu_get_dawn<WGPUBuffer>(indirectBuffer);
+  uint64_t offset = (uint64_t)indirectOffset, end = offset + (uint64_t)drawCount * stride;
+
+  if (wgpu_is_render_pass_encoder(renderCommandsMixin)) {
+    WGPURenderPassEncoder _encoder = _wgpu_get_dawn<WGPURenderPassEncoder>(renderCommandsMixin);
+    if (_wgpu_get(renderCommandsMixin)->multiDrawIndirect && stride == argsSize) {
+      WGPUBuffer countBuffer = drawCountBuffer ? _wgpu_get_dawn<WGPUBuffer>(drawCountBuffer) : nullptr;
+      if (indexed) wgpuRenderPassEncoderMultiDrawIndexedIndirect(_encoder, buffer, offset, drawCount, countBuffer, (uint64_t)drawCountBufferOffset);
+      else wgpuRenderPassEncoderMultiDrawIndirect(_encoder, buffer, offset, drawCount, countBuffer, (uint64_t)drawCountBufferOffset);
+      return;
+    }
+    auto drawIndirect = indexed ? wgpuRenderPassEncoderDrawIndexedIndirect : wgpuRenderPassEncoderDrawIndirect;
+    for (; offset < end; offset += stride)
+      drawIndirect(_encoder, buffer, offset);
+  } else if (wgpu_is_render_bundle_encoder(renderCommandsMixin)) {
+    WGPURenderBundleEncoder _encoder = _wgpu_get_dawn<WGPURenderBundleEncoder>(renderCommandsMixin);
+    auto drawIndirect = indexed ? wgpuRenderBundleEncoderDrawIndexedIndirect : wgpuRenderBundleEncoderDrawIndirect;
+    for (; offset < end; offset += stride)
+      drawIndirect(_encoder, buffer, offset);
+    _wgpu_render_bundle_cache_track(renderCommandsMixin, indirectBuffer);
+  }
+}
+
+void wgpu_render_commands_mixin_multi_draw_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t drawCount, uint32_t stride) {
+  _wgpu_multi_draw_indirect(renderCommandsMixin, indirectBuffer, indirectOffset, drawCount, stride, 0, 0, false);
+}
+
+void wgpu_render_commands_mixin_multi_draw_indexed_indirect(WGpuRenderCommandsMixin renderCommandsMixin, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t drawCount, uint32_t stride) {
+  _wgpu_multi_draw_indirect(renderCommandsMixin, indirectBuffer, indirectOffset, drawCount, stride, 0, 0, true);
+}
+
+void wgpu_render_pass_encoder_multi_draw_indirect_count(WGpuRenderPassEncoder encoder, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t maxDrawCount, uint32_t stride, WGpuBuffer drawCountBuffer, double_int53_t drawCountBufferOffset) {
+  assert(wgpu_is_render_pass_encoder(encoder));
+  assert(wgpu_is_buffer(drawCountBuffer));
+  _wgpu_multi_draw_indirect(encoder, indirectBuffer, indirectOffset, maxDrawCount, stride, drawCountBuffer, drawCountBufferOffset, false);
+}
+
+void wgpu_render_pass_encoder_multi_draw_indexed_indirect_count(WGpuRenderPassEncoder encoder, WGpuBuffer indirectBuffer, double_int53_t indirectOffset, uint32_t maxDrawCount, uint32_t stride, WGpuBuffer drawCountBuffer, double_int53_t drawCountBufferOffset) {
+  assert(wgpu_is_render_pass_encoder(encoder));
+  assert(wgpu_is_buffer(drawCountBuffer));
+  _wgpu_multi_draw_indirect(encoder, indirectBuffer, indirectOffset, maxDrawCount, stride, drawCountBuffer, drawCountBufferOffset, true);
+}
+
+// Processes a draw batch on a render pass or a render bundle encoder. The Dawn entry points are passed in so that the
+// encoder type only needs to be resolved once per batch, rather than once per command.
+template<typename Encoder>
+static void _wgpu_draw_batch(Encoder encoder, const WGpuDrawBatchItem *items, int numItems,
+    void (*setPipeline)(Encoder, WGPURenderPipeline),
+    void (*setBindGroup)(Encoder, uint32_t, WGPUBindGroup, size_t, const uint32_t *),
+    void (*setIndexBuffer)(Encoder, WGPUBuffer, WGPUIndexFormat, uint64_t, uint64_t),
+    void (*setVertexBuffer)(Encoder, uint32_t, WGPUBuffer, uint64_t, uint64_t),
+    void (*draw)(Encoder, uint32_t, uint32_t, uint32_t, uint32_t),
+    void (*drawIndexed)(Encoder, uint32_t, uint32_t, uint32_t, int32_t, uint32_t)) {
+  for(const WGpuDrawBatchItem *item = items, *end = items + numItems; item < end; ++item) {
+    if (item->pipeline)
+      setPipeline(encoder, _wgpu_get_dawn<WGPURenderPipeline>(item->pipeline));
+
+    for(uint32_t i = 0; i < WGPU_DRAW_BATCH_MAX_BIND_GROUPS; ++i) {
+      const WGpuDrawBatchBindGroup &bg = item->bindGroups[i];
+      if (bg.bindGroup) {
+        assert(bg.numDynamicOffsets <= WGPU_DRAW_BATCH_MAX_DYNAMIC_OFFSETS);
+        setBindGroup(encoder, i, _wgpu_get_dawn<WGPUBindGroup>(bg.bindGroup), bg.numDynamicOffsets, bg.dynamicOffsets);
+      }
+    }
+
+    if (item->indexBuffer.buffer)
+      setIndexBuffer(encoder, _wgpu_get_dawn<WGPUBuffer>(item->indexBuffer.buffer), wgpu_index_format_to_dawn(item->indexFormat),
+        item->indexBuffer.offset, item->indexBuffer.size ? item->indexBuffer.size : WGPU_WHOLE_SIZE);
+
+    for(uint32_t i = 0; i < WGPU_DRAW_BATCH_MAX_VERTEX_BUFFERS; ++i) {
+      const WGpuDrawBatchBufferBinding &vb = item->vertexBuffers[i];
+      if (vb.buffer)
+        setVertexBuffer(encoder, i, _wgpu_get_dawn<WGPUBuffer>(vb.buffer), vb.offset, vb.size ? vb.size : WGPU_WHOLE_SIZE);
+    }
+
+    if (item->indexCount)
+      drawIndexed(encoder, item->indexCount, item->instanceCount, item->firstIndex, item->baseVertex, item->firstInstance);
+    else if (item->vertexCount)
+      draw(encoder, item->vertexCount, item->instanceCount, item->firstVertex, item->firstInstance);
+  }
+}
+
+void wgpu_render_commands_mixin_draw_batch(WGpuRenderCommandsMixin renderCommandsMixin, const WGpuDrawBatchItem *items, int numItems) {
+  assert(wgpu_is_render_commands_mixin(renderCommandsMixin));
+  assert(items || numItems == 0);
+
+  _WGpuObject* obj = _wgpu_get(renderCommandsMixin);
+  if (obj->type == kWebGPURenderPassEncoder)
+    _wgpu_draw_batch((WGPURenderPassEncoder)obj->dawnObject, items, numItems, wgpuRenderPassEncoderSetPipeline, wgpuRenderPassEncoderSetBindGroup,
+      wgpuRenderPassEncoderSetIndexBuffer, wgpuRenderPassEncoderSetVertexBuffer, wgpuRenderPassEncoderDraw, wgpuRenderPassEncoderDrawIndexed);
+  else {
+    _wgpu_draw_batch((WGPURenderBundleEncoder)obj->dawnObject, items, numItems, wgpuRenderBundleEncoderSetPipeline, wgpuRenderBundleEncoderSetBindGroup,
+      wgpuRenderBundleEncoderSetIndexBuffer, wgpuRenderBundleEncoderSetVertexBuffer, wgpuRenderBundleEncoderDraw, wgpuRenderBundleEncoderDrawIndexed);
+    if (!_wgpu_render_bundle_cache_recordings->empty())
+      for (int i = 0; i < numItems; ++i) {
+        _wgpu_render_bundle_cache_track(renderCommandsMixin, items[i].pipeline);
+        for (int j = 0; j < WGPU_DRAW_BATCH_MAX_BIND_GROUPS; ++j)
+          _wgpu_render_bundle_cache_track(renderCommandsMixin, items[i].bindGroups[j].bindGroup);
+        _wgpu_render_bundle_cache_track(renderCommandsMixin, items[i].indexBuffer.buffer);
+        for (int j = 0; j < WGPU_DRAW_BATCH_MAX_VERTEX_BUFFERS; ++j)
+          _wgpu_render_bundle_cache_track(renderCommandsMixin, items[i].vertexBuffers[j].buffer);
+      }
   }
 }
 
@@ -2516,6 +3353,74 @@ void wgpu_render_pass_encoder_execute_bundles(WGpuRenderPassEncoder encoder, con
   wgpuRenderPassEncoderExecuteBundles(_encoder, numBundles, _bundles.data());
 }
 
+WGpuRenderBundleEncoder wgpu_render_bundle_cache_begin(WGpuDevice device, uint32_t key, const WGpuRenderBundleEncoderDescriptor *renderBundleEncoderDesc) {
+  if (_wgpu_render_bundle_cache->count(key)) {
+    ++_wgpu_render_bundle_cache_stats.numHits;
+    return 0;
+  }
+
+  ++_wgpu_render_bundle_cache_stats.numMisses;
+  WGpuRenderBundleEncoder bundleEncoder = wgpu_device_create_render_bundle_encoder(device, renderBundleEncoderDesc);
+  if (bundleEncoder)
+    (*_wgpu_render_bundle_cache_recordings)[_wgpu_get(bundleEncoder)] = _WGpuRenderBundleRecording();
+  return bundleEncoder;
+}
+
+void wgpu_render_bundle_cache_end(WGpuRenderPassEncoder passEncoder, uint32_t key, WGpuRenderBundleEncoder bundleEncoder) {
+  assert(wgpu_is_render_pass_encoder(passEncoder));
+
+  WGpuRenderBundle bundle;
+  if (bundleEncoder) {
+    assert(wgpu_is_render_bundle_encoder(bundleEncoder));
+    auto i = _wgpu_render_bundle_cache_recordings->find(_wgpu_get(bundleEncoder));
+    assert(i != _wgpu_render_bundle_cache_recordings->end());
+    _WGpuRenderBundleRecording recording = std::move(i->second);
+    _wgpu_render_bundle_cache_recordings->erase(i);
+
+    bundle = wgpu_encoder_finish(bundleEncoder);
+    // Replace a bundle that was recorded for the same key in the meantime.
+    wgpu_render_bundle_cache_invalidate(key);
+    // If an object that the bundle references was destroyed while recording, the bundle is not valid. It is executed anyway,
+    // so that the validation error surfaces, but it is not cached.
+    if (!recording.valid) {
+      wgpu_render_pass_encoder_execute_bundles(passEncoder, &bundle, 1);
+      wgpu_object_destroy(bundle);
+      return;
+    }
+
+    std::vector<_WGpuObject*>& references = recording.references;
+    std::sort(references.begin(), references.end());
+    references.erase(std::unique(references.begin(), references.end()), references.end());
+    _WGpuObject* obj = _wgpu_get(bundle);
+    for (_WGpuObject* referenced : references)
+      (*_wgpu_render_bundle_cache_users)[referenced].push_back(obj);
+    (*_wgpu_render_bundle_cache)[key] = obj;
+    (*_wgpu_render_bundle_cache_entries)[obj] = { key, std::move(references) };
+  } else {
+    auto cached = _wgpu_render_bundle_cache->find(key);
+    assert(cached != _wgpu_render_bundle_cache->end());
+    bundle = _wgpu_handle(cached->second);
+  }
+  wgpu_render_pass_encoder_execute_bundles(passEncoder, &bundle, 1);
+}
+
+void wgpu_render_bundle_cache_invalidate(uint32_t key) {
+  auto cached = _wgpu_render_bundle_cache->find(key);
+  if (cached != _wgpu_render_bundle_cache->end())
+    wgpu_object_destroy(_wgpu_handle(cached->second));
+}
+
+void wgpu_render_bundle_cache_clear() {
+  while (!_wgpu_render_bundle_cache->empty())
+    wgpu_object_destroy(_wgpu_handle(_wgpu_render_bundle_cache->begin()->second));
+}
+
+void wgpu_get_render_bundle_cache_stats(WGpuRenderBundleCacheStats* stats) {
+  assert(stats);
+  *stats = _wgpu_render_bundle_cache_stats;
+  stats->numBundles = (uint32_t)_wgpu_render_bundle_cache->size();
+}
+
 WGPU_BOOL wgpu_is_render_bundle(WGpuObjectBase object) {
   _WGpuObject* obj = _wgpu_get(object);
   return obj != nullptr && obj->type == kWebGPURenderBundle;
@@ -2660,6 +3565,7 @@ void wgpu_canvas_context_unconfigure(WGpuCanvasContext canvasContext) {
   _WGpuCanvasContext* context = _wgpu_get_dawn<_WGpuCanvasContext*>(canvasContext);
 
   if (context->surface) {
+    _wgpu_canvas_context_release_current_texture(context);
     wgpuSurfaceUnconfigure(context->surface);
   }
 }
@@ -2679,12 +3585,30 @@ WGpuTextureView wgpu_canvas_context_get_current_texture_view(WGpuCanvasContext c
   WGPUSurfaceTexture surfaceTexture = WGPU_SURFACE_TEXTURE_INIT;
   wgpuSurfaceGetCurrentTexture(context->surface, &surfaceTexture);
 
-  if (surfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Success) {
-    WGPUTextureView textureView = wgpuTextureCreateView(surfaceTexture.texture, nullptr);
-    return _wgpu_store(kWebGPUTextureView, textureView);
-  } else {
+  if (surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_Success) {
+    if (surfaceTexture.texture)
+      wgpuTextureRelease(surfaceTexture.texture);
     return 0;
   }
+
+  // The surface returns the same texture until it is presented, so reuse the cached view to it.
+  if (surfaceTexture.texture == context->currentTexture && _wgpu_canvas_context_cached_view(context)) {
+    wgpuTextureRelease(surfaceTexture.texture);
+    return context->currentTextureView;
+  }
+
+  // The surface texture has rotated, so release the view to the old texture. The reference to the old texture is held
+  // until here, so a new texture cannot alias its address.
+  _wgpu_canvas_context_release_current_texture(context);
+  context->currentTexture = surfaceTexture.texture;
+  WGPUTextureView textureView = wgpuTextureCreateView(surfaceTexture.texture, nullptr);
+  // The cached view is owned by the context, so it must not be released at the end of an active transient scope.
+  bool transientScopeActive = _wgpu_transient_scope_active;
+  _wgpu_transient_scope_active = false;
+  context->currentTextureView = _wgpu_store_and_set_parent(kWebGPUTextureView, textureView, canvasContext);
+  _wgpu_transient_scope_active = transientScopeActive;
+  context->currentTextureViewSerial = wgpu_object_get_serial(context->currentTextureView);
+  return context->currentTextureView;
 }
 
 void wgpu_canvas_context_present(WGpuCanvasContext canvasContext) {
@@ -32,7 +32,8 @@ typedef uint64_t double_int53_t;
 
 // The following should be kept sorted in the order of the WebIDL for easier diffing across changes to the spec: https://www.w3.org/TR/webgpu/#idl-index
 // with the exception that the callback typedefs should appear last in this file to see the necessary definitions.
-#ifdef __EMSCRIPTEN__
+#if defined(__EMSCRIPTEN__) || defined(WGPU_GENERATIONAL_HANDLES)
+// On the web, and in native builds with WGPU_GENERATIONAL_HANDLES defined, objects are referred to by integer IDs.
 typedef int WGpuObjectBase;
 #else
 typedef struct _WGpuObject *WGpuObjectBase;
@@ -166,6 +167,11 @@ typedef struct WGpuExtent3D WGpuExtent3D;
 typedef struct WGpuBindGroupLayoutEntry WGpuBindGroupLayoutEntry;
 typedef WGpuObjectBase WGpuImageBitmap;
 typedef struct WGpuPipelineError WGpuPipelineError;
+typedef int WGPU_OBJECT_TYPE;
+typedef struct WGpuLiveObjectStats WGpuLiveObjectStats;
+#ifndef __EMSCRIPTEN__
+typedef struct WGpuObjectPoolStats WGpuObjectPoolStats;
+#endif
 
 // Callbacks in the order of appearance in the WebIDL:
 
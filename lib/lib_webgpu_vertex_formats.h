@@ -0,0 +1,49 @@
+#pragma once
+
+// lib_webgpu_vertex_formats.h: internal header shared by lib_webgpu.cpp and lib_webgpu_cpp17.h. Do not include this header
+// directly. Lists the properties of each WGPU_VERTEX_FORMAT as an X-macro, so that the runtime wgpu_vertex_format_*()
+// functions (which must build as C++11) and the constexpr helpers in lib_webgpu_cpp17.h are generated from the same table.
+//
+// X(format, channel count, byte size, is unorm)
+#define _WGPU_VERTEX_FORMATS(X) \
+  X(WGPU_VERTEX_FORMAT_UINT8,           1,  1, false) \
+  X(WGPU_VERTEX_FORMAT_UINT8X2,         2,  2, false) \
+  X(WGPU_VERTEX_FORMAT_UINT8X4,         4,  4, false) \
+  X(WGPU_VERTEX_FORMAT_SINT8,           1,  1, false) \
+  X(WGPU_VERTEX_FORMAT_SINT8X2,         2,  2, false) \
+  X(WGPU_VERTEX_FORMAT_SINT8X4,         4,  4, false) \
+  X(WGPU_VERTEX_FORMAT_UNORM8,          1,  1, true)  \
+  X(WGPU_VERTEX_FORMAT_UNORM8X2,        2,  2, true)  \
+  X(WGPU_VERTEX_FORMAT_UNORM8X4,        4,  4, true)  \
+  X(WGPU_VERTEX_FORMAT_SNORM8,          1,  1, false) \
+  X(WGPU_VERTEX_FORMAT_SNORM8X2,        2,  2, false) \
+  X(WGPU_VERTEX_FORMAT_SNORM8X4,        4,  4, false) \
+  X(WGPU_VERTEX_FORMAT_UINT16,          1,  2, false) \
+  X(WGPU_VERTEX_FORMAT_UINT16X2,        2,  4, false) \
+  X(WGPU_VERTEX_FORMAT_UINT16X4,        4,  8, false) \
+  X(WGPU_VERTEX_FORMAT_SINT16,          1,  2, false) \
+  X(WGPU_VERTEX_FORMAT_SINT16X2,        2,  4, false) \
+  X(WGPU_VERTEX_FORMAT_SINT16X4,        4,  8, false) \
+  X(WGPU_VERTEX_FORMAT_UNORM16,         1,  2, true)  \
+  X(WGPU_VERTEX_FORMAT_UNORM16X2,       2,  4, true)  \
+  X(WGPU_VERTEX_FORMAT_UNORM16X4,       4,  8, true)  \
+  X(WGPU_VERTEX_FORMAT_SNORM16,         1,  2, false) \
+  X(WGPU_VERTEX_FORMAT_SNORM16X2,       2,  4, false) \
+  X(WGPU_VERTEX_FORMAT_SNORM16X4,       4,  8, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT16,         1,  2, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT16X2,       2,  4, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT16X4,       4,  8, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT32,         1,  4, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT32X2,       2,  8, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT32X3,       3, 12, false) \
+  X(WGPU_VERTEX_FORMAT_FLOAT32X4,       4, 16, false) \
+  X(WGPU_VERTEX_FORMAT_UINT32,          1,  4, false) \
+  X(WGPU_VERTEX_FORMAT_UINT32X2,        2,  8, false) \
+  X(WGPU_VERTEX_FORMAT_UINT32X3,        3, 12, false) \
+  X(WGPU_VERTEX_FORMAT_UINT32X4,        4, 16, false) \
+  X(WGPU_VERTEX_FORMAT_SINT32,          1,  4, false) \
+  X(WGPU_VERTEX_FORMAT_SINT32X2,        2,  8, false) \
+  X(WGPU_VERTEX_FORMAT_SINT32X3,        3, 12, false) \
+  X(WGPU_VERTEX_FORMAT_SINT32X4,        4, 16, false) \
+  X(WGPU_VERTEX_FORMAT_UNORM10_10_10_2, 4,  4, true)  \
+  X(WGPU_VERTEX_FORMAT_UNORM8X4_BGRA,   4,  4, true)
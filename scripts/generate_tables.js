@@ -0,0 +1,368 @@
+/*
+  This file generates the enum string tables, enum reverse lookup maps, struct layouts and struct reader functions
+  in lib/lib_webgpu.js from the WebGPU IDL in idl/webgpu.idl and the C struct and enum definitions in lib/lib_webgpu.h,
+  so that the JS side marshalling cannot drift from the header.
+
+  Usage: run 'node scripts/generate_tables.js' to rewrite the regions of lib/lib_webgpu.js between the
+         '// GENERATED ... BEGIN' and '// GENERATED ... END' markers in place.
+         Run 'node scripts/generate_tables.js --check' to only verify that lib/lib_webgpu.js is up to date.
+         The script exits with a nonzero status if the IDL and the header disagree, if a computed struct size
+         does not match its VERIFY_STRUCT_SIZE() assertion, or in --check mode, if lib/lib_webgpu.js is stale.
+
+  The generated struct layouts are in units of 32-bit words (HEAPU32 indices), in the Wasm32 layout. Since pointers are
+  padded to 64 bits with _WGPU_PTR_PADDING(), the Wasm64 layouts are identical.
+*/
+
+const fs = require('fs');
+const path = require('path');
+
+const root = path.join(__dirname, '..');
+const idlFile = path.join(root, 'idl', 'webgpu.idl');
+const headerFiles = [path.join(root, 'lib', 'lib_webgpu_fwd.h'), path.join(root, 'lib', 'lib_webgpu.h')];
+const jsFile = path.join(root, 'lib', 'lib_webgpu.js');
+
+// The JS enum tables to generate. Each table is indexed by the integer value of the C enum. 'idl' names the IDL enum(s) that the
+// string values come from, and 'c' names the C enum typedef(s) whose WGPU_FOO_BAR #defines give the indices of the strings.
+// If 'reverse' is set, a Map from string value back to the integer value is also generated, for marshalling JS values to C.
+const enumTables = [
+  // This array combines GPUTextureFormat and GPUVertexFormat values, since they share many of the same strings.
+  { js: 'GPUTextureAndVertexFormats', idl: ['GPUTextureFormat', 'GPUVertexFormat'], c: ['WGPU_TEXTURE_FORMAT', 'WGPU_VERTEX_FORMAT'], reverse: true },
+  { js: 'GPUBlendFactors', idl: 'GPUBlendFactor', c: 'WGPU_BLEND_FACTOR' },
+  { js: 'GPUStencilOperations', idl: 'GPUStencilOperation', c: 'WGPU_STENCIL_OPERATION' },
+  { js: 'GPUCompareFunctions', idl: 'GPUCompareFunction', c: 'WGPU_COMPARE_FUNCTION' },
+  { js: 'GPUBlendOperations', idl: 'GPUBlendOperation', c: 'WGPU_BLEND_OPERATION', skip: ['DISABLED'] },
+  { js: 'GPUIndexFormats', idl: 'GPUIndexFormat', c: 'WGPU_INDEX_FORMAT' },
+  { js: 'GPUTextureDimensions', idl: 'GPUTextureDimension', c: 'WGPU_TEXTURE_DIMENSION' },
+  { js: 'GPUTextureViewDimensions', idl: 'GPUTextureViewDimension', c: 'WGPU_TEXTURE_VIEW_DIMENSION', reverse: true },
+  { js: 'GPUStorageTextureSampleTypes', idl: 'GPUStorageTextureAccess', c: 'WGPU_STORAGE_TEXTURE_ACCESS' },
+  { js: 'GPUAddressModes', idl: 'GPUAddressMode', c: 'WGPU_ADDRESS_MODE' },
+  { js: 'GPUTextureAspects', idl: 'GPUTextureAspect', c: 'WGPU_TEXTURE_ASPECT' },
+  { js: 'GPUPrimitiveTopologys', idl: 'GPUPrimitiveTopology', c: 'WGPU_PRIMITIVE_TOPOLOGY' },
+  { js: 'GPUFrontFaces', idl: 'GPUFrontFace', c: 'WGPU_FRONT_FACE' },
+  { js: 'GPUCullModes', idl: 'GPUCullMode', c: 'WGPU_CULL_MODE' },
+  { js: 'GPUVertexStepModes', idl: 'GPUVertexStepMode', c: 'WGPU_VERTEX_STEP_MODE' },
+  { js: 'GPUBufferBindingTypes', idl: 'GPUBufferBindingType', c: 'WGPU_BUFFER_BINDING_TYPE' },
+  { js: 'GPUSamplerBindingTypes', idl: 'GPUSamplerBindingType', c: 'WGPU_SAMPLER_BINDING_TYPE' },
+  { js: 'GPUTextureSampleTypes', idl: 'GPUTextureSampleType', c: 'WGPU_TEXTURE_SAMPLE_TYPE' },
+  { js: 'GPUQueryTypes', idl: 'GPUQueryType', c: 'WGPU_QUERY_TYPE' },
+  // PredefinedColorSpace is defined in the HTML specification, not in the WebGPU IDL.
+  { js: 'HTMLPredefinedColorSpaces', values: ['srgb', 'srgb-linear', 'display-p3', 'display-p3-linear'], c: 'HTML_PREDEFINED_COLOR_SPACE', reverse: true },
+  // GPUMipmapFilterMode has identical values to GPUFilterMode - the same array is used for both mag/min and mipmap filter lookups.
+  { js: 'GPUFilterModes', idl: 'GPUFilterMode', c: 'WGPU_FILTER_MODE' },
+  { js: 'GPULoadOps', idl: 'GPULoadOp', c: 'WGPU_LOAD_OP', skip: ['UNDEFINED'] },
+  { js: 'GPUStoreOps', idl: 'GPUStoreOp', c: 'WGPU_STORE_OP', skip: ['UNDEFINED'] },
+  { js: 'GPUCanvasToneMappingModes', idl: 'GPUCanvasToneMappingMode', c: 'WGPU_CANVAS_TONE_MAPPING_MODE', reverse: true },
+  { js: 'GPUCanvasAlphaModes', idl: 'GPUCanvasAlphaMode', c: 'WGPU_CANVAS_ALPHA_MODE', reverse: true },
+];
+
+// Structs that flat reader functions are generated for. The JS dictionary member names are the C field names. Fields named
+// unused_padding* are skipped. If 'assertEnums' is set, the reader asserts in debug builds that all enum fields are valid.
+const structReaders = [
+  { struct: 'WGpuStencilFaceState', js: 'wgpuReadGpuStencilFaceState' },
+  { struct: 'WGpuBlendComponent', js: 'wgpuReadGpuBlendComponent', assertEnums: true },
+  { struct: 'WGpuPrimitiveState', js: 'wgpuReadGpuPrimitiveState' },
+  { struct: 'WGpuDepthStencilState', js: 'wgpuReadGpuDepthStencilState' },
+  { struct: 'WGpuMultisampleState', js: 'wgpuReadGpuMultisampleState' },
+];
+
+// Structs whose layouts are emitted in addition to all the structs that have a VERIFY_STRUCT_SIZE() assertion.
+const extraStructLayouts = ['WGpuBlendComponent', 'WGpuBlendState', 'WGpuColorTargetState', 'WGpuVertexAttribute', 'WGpuRenderPipelineDescriptor', 'WGpuCanvasConfiguration'];
+
+let errors = [];
+function error(msg) { errors.push(msg); }
+
+function stripComments(s) {
+  return s.replace(/\/\*[\s\S]*?\*\//g, '').replace(/\/\/.*$/gm, '');
+}
+
+////////////////////////////////////////////////////////////////
+// IDL parsing
+
+function parseIdlEnums(idl) {
+  let enums = {};
+  let re = /enum\s+(\w+)\s*\{([^}]*)\}/g, m;
+  while((m = re.exec(stripComments(idl)))) {
+    enums[m[1]] = [...m[2].matchAll(/"([^"]*)"/g)].map(v => v[1]);
+  }
+  return enums;
+}
+
+////////////////////////////////////////////////////////////////
+// Header parsing
+
+function parseHeader(src) {
+  // Only parse the definitions that are visible to Emscripten builds.
+  src = src.replace(/#ifndef __EMSCRIPTEN__[\s\S]*?#endif/g, '');
+  let defines = {};
+  for(let m of src.matchAll(/^#define\s+(\w+)\s+(\S[^\n]*?)\s*(\/\/.*)?$/gm)) {
+    defines[m[1]] = m[2].trim();
+  }
+  let code = stripComments(src);
+  let typedefs = {}; // name -> underlying type name
+  for(let m of code.matchAll(/typedef\s+(?:struct\s+)?([\w ]+?)\s*(\*?)\s*(\w+)\s*;/g)) {
+    typedefs[m[3]] = m[2] ? '*' : m[1].trim();
+  }
+  for(let m of code.matchAll(/typedef\s+\w+\s*\(\s*\*\s*(\w+)\s*\)/g)) {
+    typedefs[m[1]] = '*'; // Function pointer
+  }
+  let structs = {};
+  for(let m of code.matchAll(/typedef\s+struct\s+(_WGPU_ALIGN_TO_64BITS\s+)?(\w+)\s*\{/g)) {
+    // Find the matching closing brace.
+    let depth = 1, i = m.index + m[0].length;
+    for(; depth > 0; ++i) {
+      if (code[i] == '{') ++depth;
+      else if (code[i] == '}') --depth;
+    }
+    structs[m[2]] = { name: m[2], alignTo64: !!m[1], body: code.substring(m.index + m[0].length, i - 1) };
+  }
+  let verified = {};
+  for(let m of code.matchAll(/^VERIFY_STRUCT_SIZE\(\s*(\w+)\s*,\s*([^;]*?)\)\s*;/gm)) {
+    verified[m[1]] = m[2];
+  }
+  return { defines, typedefs, structs, verified };
+}
+
+function evalDefine(h, expr) {
+  expr = expr.replace(/\b[A-Z_][A-Z0-9_]+\b/g, name => h.defines[name] !== undefined ? `(${evalDefine(h, h.defines[name])})` : name);
+  return Function(`return (${expr});`)();
+}
+
+const scalarTypes = {
+  'char': 1, 'int8_t': 1, 'uint8_t': 1, 'int16_t': 2, 'uint16_t': 2,
+  'int': 4, 'unsigned': 4, 'int32_t': 4, 'uint32_t': 4, 'float': 4,
+  'int64_t': 8, 'uint64_t': 8, 'double': 8
+};
+
+// Returns { size, align, kind } of the given C type in the Wasm32 layout. 'kind' classifies the type for the struct readers.
+function typeInfo(h, type) {
+  type = type.replace(/\bconst\b/g, '').trim();
+  if (type.endsWith('*')) return { size: 4, align: 4, kind: 'ptr' };
+  if (type == 'WGPU_BOOL' || h.defines[type] == 'int' && type == 'WGPU_BOOL') return { size: 4, align: 4, kind: 'bool' };
+  if (type == 'double_int53_t') return { size: 8, align: 8, kind: 'i53' };
+  if (type == 'WGpuObjectBase') return { size: 4, align: 4, kind: 'object' };
+  if (scalarTypes[type]) return { size: scalarTypes[type], align: scalarTypes[type], kind: type };
+  if (h.structs[type]) {
+    let layout = structLayout(h, type);
+    return layout ? { size: layout.size, align: layout.align, kind: 'struct', struct: type } : null;
+  }
+  let underlying = h.typedefs[type];
+  if (underlying == '*') return { size: 4, align: 4, kind: 'ptr' };
+  if (underlying == 'int' && /^(WGPU|HTML)_/.test(type)) return { size: 4, align: 4, kind: 'enum', enumType: type };
+  if (underlying) {
+    let info = typeInfo(h, underlying);
+    if (info && info.kind == 'object') info.objectType = type;
+    return info;
+  }
+  return null;
+}
+
+let layoutCache = {};
+function structLayout(h, name) {
+  if (name in layoutCache) return layoutCache[name];
+  layoutCache[name] = null; // Guard against recursion.
+  let s = h.structs[name];
+  let body = s.body.replace(/_WGPU_PTR_PADDING\((\w+)\)/g, 'uint32_t unused_padding_to_make_32bit_ptrs_64bit_$1');
+  let offset = 0, align = s.alignTo64 ? 8 : 1, fields = [];
+  function place(fieldName, info, count) {
+    align = Math.max(align, info.align);
+    offset = Math.ceil(offset / info.align) * info.align;
+    fields.push({ name: fieldName, offset, info, count });
+    offset += info.size * count;
+  }
+  // Split the body into declarations, treating unions as a single declaration.
+  let decls = [], depth = 0, start = 0;
+  for(let i = 0; i < body.length; ++i) {
+    if (body[i] == '{') ++depth;
+    else if (body[i] == '}') --depth;
+    else if (body[i] == ';' && depth == 0) { decls.push(body.substring(start, i).trim()); start = i + 1; }
+  }
+  for(let decl of decls) {
+    if (!decl) continue;
+    let u = decl.match(/^union\s*\{([\s\S]*)\}\s*(\w+)$/);
+    if (u) {
+      let size = 0, ualign = 1;
+      for(let member of u[1].split(';').map(d => d.trim()).filter(d => d)) {
+        let mm = member.match(/^(.*?)(\w+)$/);
+        let info = mm && typeInfo(h, mm[1]);
+        if (!info) { layoutCache[name] = null; return null; }
+        size = Math.max(size, info.size);
+        ualign = Math.max(ualign, info.align);
+      }
+      place(u[2], { size: Math.ceil(size / ualign) * ualign, align: ualign, kind: 'union' }, 1);
+      continue;
+    }
+    // Declarations of the form 'double r, g, b, a' declare multiple fields of the same type.
+    let [first, ...rest] = decl.split(',').map(d => d.trim());
+    let m = first.match(/^(.*?[\s*])(\w+)\s*(?:\[([^\]]*)\])?$/);
+    if (!m) { layoutCache[name] = null; return null; }
+    let info = typeInfo(h, m[1].trim());
+    if (!info) { layoutCache[name] = null; return null; }
+    for(let d of [first.substring(m[1].length)].concat(rest)) {
+      let f = d.match(/^(\w+)\s*(?:\[([^\]]*)\])?$/);
+      // A flexible array member 'foo[]' does not contribute to the size of the struct.
+      place(f[1], info, f[2] === undefined ? 1 : f[2] ? evalDefine(h, f[2]) : 0);
+    }
+  }
+  let size = Math.ceil(offset / align) * align;
+  return layoutCache[name] = { name, size, align, fields };
+}
+
+////////////////////////////////////////////////////////////////
+// Code generation
+
+function cEnumValues(h, prefix) {
+  let values = {};
+  for(let name in h.defines) {
+    if (name.startsWith(prefix + '_') && /^-?\d+$/.test(h.defines[name])) {
+      values[name.substring(prefix.length + 1)] = parseInt(h.defines[name]);
+    }
+  }
+  return values;
+}
+
+function generateEnumTable(h, idlEnums, table) {
+  let strings = table.values || [].concat(table.idl).flatMap(e => {
+    if (!idlEnums[e]) { error(`IDL enum ${e} not found for ${table.js}!`); return []; }
+    return idlEnums[e];
+  });
+  let prefixes = [].concat(table.c);
+  let array = [];
+  let used = new Set();
+  for(let s of strings) {
+    let cName = s.toUpperCase().replace(/-/g, '_');
+    let prefix = prefixes.find(p => cEnumValues(h, p)[cName] !== undefined);
+    if (!prefix) {
+      error(`${table.js}: IDL value '${s}' does not have a corresponding ${prefixes.map(p => p + '_' + cName).join(' or ')} in lib_webgpu.h!`);
+      continue;
+    }
+    let value = cEnumValues(h, prefix)[cName];
+    if (array[value] !== undefined) error(`${table.js}: '${s}' and '${array[value]}' both map to value ${value}!`);
+    array[value] = s;
+    used.add(prefix + '_' + cName);
+  }
+  // Check that every C enum value has a string, except the _INVALID ones and the ones that are marshalled specially.
+  for(let prefix of prefixes) {
+    let values = cEnumValues(h, prefix);
+    for(let v in values) {
+      if (v == 'INVALID' || v == 'FIRST_VALUE' || v == 'LAST_VALUE' || (table.skip || []).includes(v)) continue;
+      if (!used.has(prefix + '_' + v)) error(`${table.js}: ${prefix}_${v} in lib_webgpu.h does not have a corresponding value in the IDL!`);
+    }
+  }
+  let items = [];
+  for(let i = 0; i < array.length; ++i) items.push(array[i] === undefined ? '' : ` '${array[i]}'`);
+  let out = `  $${table.js}: [${items.join(',')} ],\n`;
+  if (table.reverse) {
+    if (new Set(strings).size != strings.length) error(`${table.js}: a reverse lookup Map cannot be generated, since the table has duplicate strings!`);
+    let ids = table.js.replace(/s$/, '') + 'Ids';
+    out += `  $${ids}__deps: ['$${table.js}', '$wgpuEnumIds'],\n`;
+    out += `  $${ids}: '=wgpuEnumIds(${table.js})',\n`;
+  }
+  return out;
+}
+
+function enumTableForType(enumType) {
+  return enumTables.find(t => [].concat(t.c).includes(enumType));
+}
+
+function generateStructReader(h, reader) {
+  let layout = structLayout(h, reader.struct);
+  if (!layout) { error(`Unable to compute the layout of ${reader.struct}!`); return ''; }
+  let deps = [], asserts = [], members = [];
+  for(let f of layout.fields) {
+    if (f.name.startsWith('unused_padding')) continue;
+    let idx = f.offset % 4 == 0 ? `idx${f.offset ? '+' + f.offset / 4 : ''}` : null;
+    if (!idx || f.count != 1) { error(`${reader.struct}.${f.name}: unsupported field for a generated reader!`); continue; }
+    let expr;
+    switch(f.info.kind) {
+      case 'enum': {
+        let table = enumTableForType(f.info.enumType);
+        if (!table) { error(`${reader.struct}.${f.name}: no JS enum table for ${f.info.enumType}!`); continue; }
+        if (!deps.includes('$' + table.js)) deps.push('$' + table.js);
+        expr = `${table.js}[HEAPU32[${idx}]]`;
+        if (reader.assertEnums) asserts.push(`    {{{ wassert('${expr}'); }}}\n`);
+        break;
+      }
+      case 'bool': expr = `!!HEAPU32[${idx}]`; break;
+      case 'int': case 'int32_t': expr = `HEAP32[${idx}]`; break;
+      case 'unsigned': case 'uint32_t': expr = `HEAPU32[${idx}]`; break;
+      case 'float': expr = `HEAPF32[${idx}]`; break;
+      case 'struct': {
+        let nested = structReaders.find(r => r.struct == f.info.struct);
+        if (!nested) { error(`${reader.struct}.${f.name}: no generated reader for ${f.info.struct}!`); continue; }
+        if (!deps.includes('$' + nested.js)) deps.push('$' + nested.js);
+        expr = `${nested.js}(${idx})`;
+        break;
+      }
+      default: error(`${reader.struct}.${f.name}: unsupported field type for a generated reader!`); continue;
+    }
+    members.push(`      '${f.name}': ${expr}`);
+  }
+  let out = '';
+  if (deps.length) out += `  $${reader.js}__deps: [${deps.map(d => `'${d}'`).join(', ')}],\n`;
+  out += `  $${reader.js}: function(idx) {\n`;
+  out += `    {{{ wassert('idx != 0'); }}}\n`;
+  out += asserts.join('');
+  out += `    return {\n${members.join(',\n')}\n    };\n  },\n`;
+  return out;
+}
+
+function generateStructLayouts(h) {
+  let names = Object.keys(h.verified).concat(extraStructLayouts.filter(n => !(n in h.verified)));
+  let lines = [];
+  for(let name of names) {
+    if (!h.structs[name]) { error(`Struct ${name} not found in lib_webgpu.h!`); continue; }
+    let layout = structLayout(h, name);
+    if (!layout) { error(`Unable to compute the layout of ${name}!`); continue; }
+    if (name in h.verified) {
+      let expected = evalDefine(h, h.verified[name].replace(/sizeof\(\s*(\w+)\s*\)/g, (_, t) => {
+        let info = typeInfo(h, t);
+        if (!info) throw new Error(`Unknown type ${t} in VERIFY_STRUCT_SIZE(${name})`);
+        return info.size;
+      }));
+      if (expected != layout.size) error(`sizeof(${name}) was computed to be ${layout.size} bytes, but VERIFY_STRUCT_SIZE() expects ${expected} bytes!`);
+    }
+    if (layout.size % 4) { error(`sizeof(${name}) is not a multiple of 4 bytes!`); continue; }
+    let fields = layout.fields.filter(f => !f.name.startsWith('unused_padding') && f.offset % 4 == 0).map(f => `${f.name}: ${f.offset / 4}`);
+    lines.push(`    ${name}: { sizeof: ${layout.size / 4}, ${fields.join(', ')} },`);
+  }
+  return `{{{\n  // Sizes and field offsets of WebGPU structs, in 32-bit words.\n  globalThis.wgpuStructs = {\n${lines.join('\n')}\n  };\n  null;\n}}}\n`;
+}
+
+function replaceRegion(js, marker, content) {
+  let begin = `// GENERATED ${marker} BEGIN: do not edit by hand, run 'node scripts/generate_tables.js' instead.\n`;
+  let end = `// GENERATED ${marker} END`;
+  let b = js.indexOf(begin), e = js.indexOf(end);
+  if (b < 0 || e < b) throw new Error(`Unable to find the GENERATED ${marker} region in lib_webgpu.js!`);
+  return js.substring(0, b + begin.length) + content + js.substring(e);
+}
+
+////////////////////////////////////////////////////////////////
+
+let idlEnums = parseIdlEnums(fs.readFileSync(idlFile, 'utf8'));
+let h = parseHeader(headerFiles.map(f => fs.readFileSync(f, 'utf8')).join('\n'));
+
+let enumCode = enumTables.map(t => generateEnumTable(h, idlEnums, t)).join('');
+let readerCode = structReaders.map(r => '\n' + generateStructReader(h, r)).join('');
+let layoutCode = generateStructLayouts(h);
+
+if (errors.length) {
+  for(let e of errors) console.error(e);
+  process.exit(1);
+}
+
+let js = fs.readFileSync(jsFile, 'utf8');
+let newJs = replaceRegion(js, 'STRUCT LAYOUTS', layoutCode);
+newJs = replaceRegion(newJs, 'ENUM TABLES', enumCode + readerCode);
+
+if (process.argv.includes('--check')) {
+  if (newJs != js) {
+    console.error('lib/lib_webgpu.js is out of date with respect to lib/lib_webgpu.h and idl/webgpu.idl. Run \'node scripts/generate_tables.js\' to update it.');
+    process.exit(1);
+  }
+  console.log('lib/lib_webgpu.js is up to date.');
+} else if (newJs != js) {
+  fs.writeFileSync(jsFile, newJs);
+  console.log('Updated lib/lib_webgpu.js.');
+} else {
+  console.log('lib/lib_webgpu.js is already up to date.');
+}
@@ -39,6 +39,9 @@ tests = list(glob.glob('test/*.cpp'))
 if len(options.tests_to_run) > 0:
   tests = list(filter(lambda t: contains_substring(t, options.tests_to_run), tests))
 
+# Verify that the generated enum tables and struct layouts in lib_webgpu.js are in sync with lib_webgpu.h and the IDL.
+subprocess.check_call(['node', 'scripts/generate_tables.js', '--check'])
+
 output_file = os.path.join(test_dir, 'test.html')
 
 cmd = ['em++', 'lib/lib_webgpu.cpp', '-o', output_file, '-Ilib/', '--js-library', 'lib/lib_webgpu.js', '--emrun', '-profiling-funcs', '-Wno-experimental']
@@ -0,0 +1,101 @@
+// Tests the compile-time helpers in lib_webgpu_cpp17.h: checks vertex layout offsets, strides and shader locations
+// with static_asserts, verifies that the constexpr vertex format helpers agree with the runtime functions, and creates
+// a bind group layout and a render pipeline from static constexpr descriptors.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include "lib_webgpu_cpp17.h"
+#include <assert.h>
+#include <stdio.h>
+
+using namespace wgpu_cpp17;
+
+// position: float32x3 at 0, uv: float16x2 at 12, normal: snorm8x4 at 16, padding byte attribute: uint8 at 20 => stride 24.
+using Vertex = VertexLayout<WGPU_VERTEX_FORMAT_FLOAT32X3, WGPU_VERTEX_FORMAT_FLOAT16X2, WGPU_VERTEX_FORMAT_SNORM8X4, WGPU_VERTEX_FORMAT_UINT8>;
+static_assert(Vertex::numAttributes == 4);
+static_assert(Vertex::offset(0) == 0 && Vertex::offset(1) == 12 && Vertex::offset(2) == 16 && Vertex::offset(3) == 20);
+static_assert(Vertex::arrayStride == 24);
+static_assert(Vertex::attributes[3].shaderLocation == 3);
+static_assert(Vertex::layout.stepMode == WGPU_VERTEX_STEP_MODE_VERTEX);
+
+// A 2-byte attribute followed by a 4-byte one gets padded to 4-byte alignment.
+using Instance = InstanceLayoutAt<Vertex::nextShaderLocation, WGPU_VERTEX_FORMAT_UINT16, WGPU_VERTEX_FORMAT_FLOAT32X4>;
+static_assert(Instance::offset(1) == 4);
+static_assert(Instance::arrayStride == 20);
+static_assert(Instance::attributes[0].shaderLocation == 4 && Instance::attributes[1].shaderLocation == 5);
+static_assert(Instance::layout.stepMode == WGPU_VERTEX_STEP_MODE_INSTANCE);
+
+static constexpr WGpuVertexBufferLayout buffers[] = { Vertex::layout, Instance::layout };
+
+static constexpr WGpuBindGroupLayoutEntry bindGroupLayoutEntries[] = {
+  uniform_buffer_entry(0, WGPU_SHADER_STAGE_VERTEX),
+  sampler_entry(1, WGPU_SHADER_STAGE_FRAGMENT),
+  texture_entry(2, WGPU_SHADER_STAGE_FRAGMENT),
+};
+static_assert(bindGroupLayoutEntries[1].type == WGPU_BIND_GROUP_LAYOUT_TYPE_SAMPLER);
+static_assert(bindGroupLayoutEntries[2].layout.texture.viewDimension == WGPU_TEXTURE_VIEW_DIMENSION_2D);
+
+static constexpr WGpuColorTargetState targets[] = { color_target(WGPU_TEXTURE_FORMAT_RGBA8UNORM, blend_alpha()) };
+
+static constexpr RenderPipelineDescriptor pipelineDesc = RenderPipelineDescriptor()
+  .with_vertex("vs", buffers)
+  .with_fragment("fs", targets)
+  .with_primitive(WGPU_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, WGPU_CULL_MODE_BACK)
+  .with_depth_stencil(WGPU_TEXTURE_FORMAT_DEPTH24PLUS, WGPU_TRUE, WGPU_COMPARE_FUNCTION_LESS);
+static_assert(pipelineDesc.vertex.numBuffers == 2);
+static_assert(pipelineDesc.fragment.numTargets == 1);
+static_assert(pipelineDesc.depthStencil.stencilFront.compare == WGPU_COMPARE_FUNCTION_ALWAYS);
+static_assert(pipelineDesc.multisample.count == 1);
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  for(WGPU_VERTEX_FORMAT f = WGPU_VERTEX_FORMAT_FIRST_VALUE; f <= WGPU_VERTEX_FORMAT_UNORM8X4_BGRA; ++f)
+  {
+    assert(vertex_format_byte_size(f) == wgpu_vertex_format_byte_size(f));
+    assert(vertex_format_channel_count(f) == wgpu_vertex_format_channel_count(f));
+    assert(vertex_format_is_unorm(f) == !!wgpu_vertex_format_is_unorm(f));
+  }
+
+  WGpuShaderModuleDescriptor smdesc = {
+    .code = "struct Uniforms { scale: f32 };\n"
+            "@group(0) @binding(0) var<uniform> u: Uniforms;\n"
+            "@group(0) @binding(1) var s: sampler;\n"
+            "@group(0) @binding(2) var t: texture_2d<f32>;\n"
+            "struct VSOut { @builtin(position) pos: vec4f, @location(0) uv: vec2f };\n"
+            "@vertex fn vs(@location(0) p: vec3f, @location(1) uv: vec2f, @location(2) n: vec4f, @location(3) id: u32,\n"
+            "              @location(4) instanceId: u32, @location(5) offset: vec4f) -> VSOut {\n"
+            "  return VSOut(vec4f(p * u.scale, 1) + offset, uv);\n"
+            "}\n"
+            "@fragment fn fs(in: VSOut) -> @location(0) vec4f {\n"
+            "  return textureSample(t, s, in.uv);\n"
+            "}",
+  };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &smdesc);
+
+  wgpu_device_push_error_scope(device, WGPU_ERROR_FILTER_VALIDATION);
+  WGpuBindGroupLayout bgl = wgpu_device_create_bind_group_layout(device, bindGroupLayoutEntries, 3);
+  WGpuPipelineLayout layout = wgpu_device_create_pipeline_layout(device, &bgl, 1);
+  WGpuRenderPipeline pipeline = create_render_pipeline(device, pipelineDesc, layout, shader);
+  assert(wgpu_is_render_pipeline(pipeline));
+
+  // The same static descriptor can also be used with an automatic layout.
+  WGpuRenderPipeline autoLayoutPipeline = create_render_pipeline(device, pipelineDesc, (WGpuPipelineLayout)WGPU_AUTO_LAYOUT_MODE_AUTO, shader);
+  assert(wgpu_is_render_pipeline(autoLayoutPipeline));
+
+  wgpu_device_pop_error_scope_async(device, [](WGpuDevice d, WGPU_ERROR_TYPE type, const char *m, void *) {
+    if (type != WGPU_ERROR_TYPE_NO_ERROR)
+      printf("lib_webgpu_cpp17.h: error: %s\n", m ? m : "");
+    assert(type == WGPU_ERROR_TYPE_NO_ERROR);
+    EM_ASM(window.close());
+  }, 0);
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
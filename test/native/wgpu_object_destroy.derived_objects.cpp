@@ -0,0 +1,47 @@
+// Tests that destroying a parent object on the Dawn backend destroys all of the objects derived from it,
+// so that creating and tearing down devices repeatedly does not accumulate objects.
+// This test is not run by test.py, since it targets the Dawn backend. See
+// wgpu_object_destroy.handle_table_benchmark.cpp for how to build it.
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdio.h>
+
+int main()
+{
+  WGpuAdapter adapter = navigator_gpu_request_adapter_sync_simple();
+  assert(adapter);
+  uint32_t numLiveObjectsBefore = wgpu_get_num_live_objects();
+
+  for(int i = 0; i < 100; ++i)
+  {
+    WGpuDevice device = wgpu_adapter_request_device_sync_simple(adapter);
+    assert(device);
+
+    WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+    desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+    desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+    desc.width = 256;
+    desc.height = 256;
+    WGpuTexture texture = wgpu_device_create_texture(device, &desc);
+    WGpuTextureView view = wgpu_texture_create_view_simple(texture);
+    WGpuSampler sampler = wgpu_device_create_sampler(device, 0);
+    assert(wgpu_is_texture_view(view));
+    assert(wgpu_is_sampler(sampler));
+
+    // Destroying a texture destroys its views.
+    wgpu_object_destroy(texture);
+    assert(!wgpu_is_valid_object(view));
+    assert(wgpu_is_valid_object(sampler));
+
+    // Destroying the device destroys its queue and all remaining objects created from it.
+    wgpu_object_destroy(device);
+    assert(!wgpu_is_valid_object(sampler));
+    assert(wgpu_get_num_live_objects() == numLiveObjectsBefore);
+  }
+
+  WGpuObjectPoolStats objectPoolStats, bufferPoolStats;
+  wgpu_get_object_pool_stats(&objectPoolStats, &bufferPoolStats);
+  assert(objectPoolStats.numLiveObjects == numLiveObjectsBefore);
+  printf("Test passed.\n");
+}
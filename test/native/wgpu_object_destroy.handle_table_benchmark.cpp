@@ -0,0 +1,68 @@
+// Native microbenchmark of the object handle table of the Dawn backend (lib_webgpu_dawn.cpp).
+// Creates and destroys 1M objects, and measures the cost of object creation, validity checks,
+// individual destruction, and bulk teardown with wgpu_destroy_all_objects().
+// This test is not run by test.py, since it targets the Dawn backend. Build it against Dawn with e.g.
+//   c++ -O3 -std=c++17 -Ilib -I<dawn>/include -I<dawn-build>/gen/include test/native/wgpu_object_destroy.handle_table_benchmark.cpp
+//       lib/lib_webgpu.cpp lib/lib_webgpu_dawn.cpp -L<dawn-build> -lwebgpu_dawn -o handle_table_benchmark
+// Optionally add -DWGPU_GENERATIONAL_HANDLES to benchmark generational handles.
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+
+#define NUM_OBJECTS 1000000
+
+static double NowMsecs()
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main()
+{
+  WGpuAdapter adapter = navigator_gpu_request_adapter_sync_simple();
+  assert(adapter);
+  WGpuDevice device = wgpu_adapter_request_device_sync_simple(adapter);
+  assert(device);
+  uint32_t numLiveObjectsBefore = wgpu_get_num_live_objects();
+
+  // Command encoders are used, since unlike e.g. samplers, Dawn does not deduplicate them.
+  std::vector<WGpuCommandEncoder> objects(NUM_OBJECTS);
+
+  double t0 = NowMsecs();
+  for(int i = 0; i < NUM_OBJECTS; ++i)
+    objects[i] = wgpu_device_create_command_encoder_simple(device);
+  double t1 = NowMsecs();
+  assert(wgpu_get_num_live_objects() == numLiveObjectsBefore + NUM_OBJECTS);
+
+  int numValid = 0;
+  for(int i = 0; i < NUM_OBJECTS; ++i)
+    numValid += wgpu_is_valid_object(objects[i]);
+  double t2 = NowMsecs();
+  assert(numValid == NUM_OBJECTS);
+
+  // Destroy objects in a scattered order to avoid measuring just the best case.
+  for(int i = 0; i < NUM_OBJECTS; i += 2)
+    wgpu_object_destroy(objects[i]);
+  for(int i = 1; i < NUM_OBJECTS; i += 2)
+    wgpu_object_destroy(objects[i]);
+  double t3 = NowMsecs();
+  assert(wgpu_get_num_live_objects() == numLiveObjectsBefore);
+
+  for(int i = 0; i < NUM_OBJECTS; ++i)
+    objects[i] = wgpu_device_create_command_encoder_simple(device);
+  double t4 = NowMsecs();
+  wgpu_destroy_all_objects();
+  double t5 = NowMsecs();
+  assert(wgpu_get_num_live_objects() == 0);
+
+  printf("%d objects: create %.1f nsecs/object, wgpu_is_valid_object() %.1f nsecs/object, wgpu_object_destroy() %.1f nsecs/object, wgpu_destroy_all_objects() %.1f nsecs/object.\n",
+    NUM_OBJECTS, (t1-t0)*1e6/NUM_OBJECTS, (t2-t1)*1e6/NUM_OBJECTS, (t3-t2)*1e6/NUM_OBJECTS, (t5-t4)*1e6/NUM_OBJECTS);
+
+  WGpuObjectPoolStats objectPoolStats, bufferPoolStats;
+  wgpu_get_object_pool_stats(&objectPoolStats, &bufferPoolStats);
+  assert(objectPoolStats.numLiveObjects == 0);
+  assert(objectPoolStats.highWaterMark >= NUM_OBJECTS);
+  printf("Object wrapper pool high water mark: %u objects, capacity: %u objects.\n", objectPoolStats.highWaterMark, objectPoolStats.capacity);
+}
@@ -0,0 +1,46 @@
+// Verifies that wgpu_canvas_context_get_current_texture_view() returns the same cached view while the
+// canvas texture stays the same, and that rendering several frames does not accumulate objects.
+// flags: -sEXIT_RUNTIME=0 -sJSPI
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+int main()
+{
+  WGpuAdapter adapter = navigator_gpu_request_adapter_sync_simple();
+  WGpuDevice device = wgpu_adapter_request_device_sync_simple(adapter);
+
+  WGpuCanvasContext ctx = wgpu_canvas_get_webgpu_context("canvas");
+  WGpuCanvasConfiguration config = WGPU_CANVAS_CONFIGURATION_DEFAULT_INITIALIZER;
+  config.device = device;
+  config.format = navigator_gpu_get_preferred_canvas_format();
+  wgpu_canvas_context_configure(ctx, &config);
+
+  uint32_t numLiveObjects = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    WGpuTextureView view = wgpu_canvas_context_get_current_texture_view(ctx);
+    assert(wgpu_is_texture_view(view));
+    assert(wgpu_canvas_context_get_current_texture_view(ctx) == view);
+
+    // The view to the previous frame's canvas texture was replaced when the texture rotated.
+    if (i == 0) numLiveObjects = wgpu_get_num_live_objects();
+    assert(wgpu_get_num_live_objects() == numLiveObjects);
+
+    WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+    colorAttachment.view = view;
+    colorAttachment.loadOp = WGPU_LOAD_OP_CLEAR;
+
+    WGpuRenderPassDescriptor passDesc = {};
+    passDesc.numColorAttachments = 1;
+    passDesc.colorAttachments = &colorAttachment;
+
+    WGpuCommandEncoder encoder = wgpu_device_create_command_encoder_simple(device);
+    wgpu_render_pass_encoder_end(wgpu_command_encoder_begin_render_pass(encoder, &passDesc));
+    wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+
+    wgpu_present_all_rendering_and_wait_for_next_animation_frame();
+  }
+
+  EM_ASM(window.close());
+}
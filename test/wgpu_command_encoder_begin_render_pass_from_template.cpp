@@ -0,0 +1,77 @@
+// Tests wgpu_render_pass_template_create() and wgpu_command_encoder_begin_render_pass_from_template():
+// begins render passes from a template without and with a patch that swaps the color attachment view,
+// the depth-stencil view and the clear color, as a renderer that alternates between two targets would.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuTextureDescriptor tdesc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  tdesc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  tdesc.usage = WGPU_TEXTURE_USAGE_RENDER_ATTACHMENT;
+  tdesc.width = 64;
+  tdesc.height = 64;
+  WGpuTextureView views[2];
+  for(int i = 0; i < 2; ++i)
+    views[i] = wgpu_texture_create_view_simple(wgpu_device_create_texture(device, &tdesc));
+
+  tdesc.format = WGPU_TEXTURE_FORMAT_DEPTH24PLUS;
+  WGpuTextureView depthViews[2];
+  for(int i = 0; i < 2; ++i)
+    depthViews[i] = wgpu_texture_create_view_simple(wgpu_device_create_texture(device, &tdesc));
+
+  WGpuRenderPassColorAttachment ca = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  ca.view = views[0];
+  ca.loadOp = WGPU_LOAD_OP_CLEAR;
+  ca.clearValue = (WGpuColor){ .r = 1, .g = 0, .b = 0, .a = 1 };
+  WGpuRenderPassDescriptor passDesc = WGPU_RENDER_PASS_DESCRIPTOR_DEFAULT_INITIALIZER;
+  passDesc.colorAttachments = &ca;
+  passDesc.numColorAttachments = 1;
+  passDesc.depthStencilAttachment.view = depthViews[0];
+  passDesc.depthStencilAttachment.depthLoadOp = WGPU_LOAD_OP_CLEAR;
+  passDesc.depthStencilAttachment.depthClearValue = 1.f;
+  passDesc.depthStencilAttachment.depthStoreOp = WGPU_STORE_OP_STORE;
+
+  WGpuRenderPassTemplate renderPassTemplate = wgpu_render_pass_template_create(&passDesc);
+  assert(wgpu_is_valid_object(renderPassTemplate));
+
+  WGpuRenderPassPatch patch = {};
+  for(int frame = 0; frame < 4; ++frame)
+  {
+    WGpuCommandEncoder enc = wgpu_device_create_command_encoder(device, 0);
+
+    // The first frame uses the template as is.
+    WGpuRenderPassEncoder pass;
+    if (frame == 0)
+      pass = wgpu_command_encoder_begin_render_pass_from_template(enc, renderPassTemplate, 0);
+    else
+    {
+      patch.colorAttachmentViews[0] = views[frame % 2];
+      patch.depthStencilView = depthViews[frame % 2];
+      patch.clearValueMask = 1;
+      patch.clearValues[0] = (WGpuColor){ .r = 0, .g = frame / 4.0, .b = 0, .a = 1 };
+      pass = wgpu_command_encoder_begin_render_pass_from_template(enc, renderPassTemplate, &patch);
+    }
+    assert(wgpu_is_render_pass_encoder(pass));
+    wgpu_render_pass_encoder_end(pass);
+
+    wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(enc));
+  }
+
+  wgpu_object_destroy(renderPassTemplate);
+  assert(!wgpu_is_valid_object(renderPassTemplate));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,127 @@
+// Tests wgpu_descriptor_blob_serialize() and creating objects from descriptor blobs: serializes a render pipeline,
+// a bind group layout and a render pass descriptor, moves the blobs to another memory location as an asset loader
+// would, and creates the objects from them. Also checks that blobs of the wrong type or with a truncated size are rejected.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Serializes the given descriptor to a newly allocated blob, and returns a copy of it at a different address, along with its size.
+static void *SerializeAndMove(WGPU_DESCRIPTOR_BLOB_TYPE type, const void *descriptor, int numEntries, const WGpuObjectBase *objects, int numObjects, uint32_t *outSize)
+{
+  uint32_t size = *outSize = wgpu_descriptor_blob_serialize(type, descriptor, numEntries, objects, numObjects, 0, 0);
+  assert(size > sizeof(WGpuDescriptorBlobHeader));
+  void *blob = malloc(size);
+  assert(wgpu_descriptor_blob_serialize(type, descriptor, numEntries, objects, numObjects, blob, size) == size);
+  void *moved = malloc(size);
+  memcpy(moved, blob, size);
+  free(blob);
+  return moved;
+}
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuShaderModuleDescriptor smdesc = {
+    .code = "override kScale: f32 = 1.0;\n"
+            "@vertex fn vs(@location(0) pos: vec2f) -> @builtin(position) vec4f {\n"
+            "  return vec4f(pos * kScale, 0, 1);\n"
+            "}\n"
+            "@fragment fn fs() -> @location(0) vec4f {\n"
+            "  return vec4f(1, 0, 0, 1);\n"
+            "}",
+  };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &smdesc);
+
+  WGpuVertexAttribute attribute = { .offset = 0, .shaderLocation = 0, .format = WGPU_VERTEX_FORMAT_FLOAT32X2 };
+  WGpuVertexBufferLayout vertexBuffer = { .attributes = &attribute, .numAttributes = 1, .arrayStride = 8 };
+  WGpuPipelineConstant constant = { .name = "kScale", .value = 0.5 };
+  WGpuColorTargetState ct = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  ct.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+
+  WGpuRenderPipelineDescriptor desc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.vertex.module = shader;
+  desc.vertex.entryPoint = "vs";
+  desc.vertex.buffers = &vertexBuffer;
+  desc.vertex.numBuffers = 1;
+  desc.vertex.constants = &constant;
+  desc.vertex.numConstants = 1;
+  desc.fragment.module = shader;
+  desc.fragment.entryPoint = "fs";
+  desc.fragment.targets = &ct;
+  desc.fragment.numTargets = 1;
+
+  // The blob references the shader module by its index in the object table.
+  WGpuObjectBase pipelineObjects[] = { shader };
+  uint32_t pipelineBlobSize;
+  void *pipelineBlob = SerializeAndMove(WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PIPELINE, &desc, 1, pipelineObjects, 1, &pipelineBlobSize);
+  WGpuRenderPipeline pipeline = wgpu_device_create_render_pipeline_from_blob(device, pipelineBlob, pipelineBlobSize, pipelineObjects, 1);
+  assert(wgpu_is_render_pipeline(pipeline));
+
+  // A blob of the wrong type, one that is truncated by the buffer it is loaded into, or one with a size that does not match
+  // its contents, is rejected.
+  assert(!wgpu_device_create_bind_group_layout_from_blob(device, pipelineBlob, pipelineBlobSize, pipelineObjects, 1));
+  assert(!wgpu_device_create_render_pipeline_from_blob(device, pipelineBlob, pipelineBlobSize - 4, pipelineObjects, 1));
+  assert(!wgpu_device_create_render_pipeline_from_blob(device, pipelineBlob, sizeof(WGpuDescriptorBlobHeader) - 4, pipelineObjects, 1));
+  ((WGpuDescriptorBlobHeader *)pipelineBlob)->size -= 4;
+  assert(!wgpu_device_create_render_pipeline_from_blob(device, pipelineBlob, pipelineBlobSize, pipelineObjects, 1));
+  free(pipelineBlob);
+
+  WGpuBindGroupLayoutEntry layoutEntries[2] = {
+    {
+      .binding = 0,
+      .visibility = WGPU_SHADER_STAGE_VERTEX,
+      .type = WGPU_BIND_GROUP_LAYOUT_TYPE_BUFFER,
+      .layout.buffer = { .type = WGPU_BUFFER_BINDING_TYPE_UNIFORM, .minBindingSize = 64 },
+    },
+    {
+      .binding = 1,
+      .visibility = WGPU_SHADER_STAGE_FRAGMENT,
+      .type = WGPU_BIND_GROUP_LAYOUT_TYPE_SAMPLER,
+      .layout.sampler = { .type = WGPU_SAMPLER_BINDING_TYPE_FILTERING },
+    },
+  };
+  uint32_t layoutBlobSize;
+  void *layoutBlob = SerializeAndMove(WGPU_DESCRIPTOR_BLOB_TYPE_BIND_GROUP_LAYOUT, layoutEntries, 2, 0, 0, &layoutBlobSize);
+  WGpuBindGroupLayout bgl = wgpu_device_create_bind_group_layout_from_blob(device, layoutBlob, layoutBlobSize, 0, 0);
+  assert(wgpu_is_bind_group_layout(bgl));
+  free(layoutBlob);
+
+  WGpuTextureDescriptor tdesc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  tdesc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  tdesc.usage = WGPU_TEXTURE_USAGE_RENDER_ATTACHMENT;
+  tdesc.width = 64;
+  tdesc.height = 64;
+  WGpuTextureView view = wgpu_texture_create_view_simple(wgpu_device_create_texture(device, &tdesc));
+
+  WGpuRenderPassColorAttachment ca = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  ca.view = view;
+  ca.loadOp = WGPU_LOAD_OP_CLEAR;
+  WGpuRenderPassDescriptor passDesc = WGPU_RENDER_PASS_DESCRIPTOR_DEFAULT_INITIALIZER;
+  passDesc.colorAttachments = &ca;
+  passDesc.numColorAttachments = 1;
+  uint32_t passBlobSize;
+  void *passBlob = SerializeAndMove(WGPU_DESCRIPTOR_BLOB_TYPE_RENDER_PASS, &passDesc, 1, &view, 1, &passBlobSize);
+  WGpuRenderPassTemplate renderPassTemplate = wgpu_render_pass_template_create_from_blob(passBlob, passBlobSize, &view, 1);
+  assert(wgpu_is_valid_object(renderPassTemplate));
+  free(passBlob);
+
+  WGpuCommandEncoder enc = wgpu_device_create_command_encoder(device, 0);
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass_from_template(enc, renderPassTemplate, 0);
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+  wgpu_render_pass_encoder_end(pass);
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(enc));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,94 @@
+// Verifies that wgpu_device_create_bind_group_cached() returns the same bind group for identical entries, evicts
+// cached bind groups when a resource that they reference is destroyed, and bounds the cache size with LRU eviction.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuBufferDescriptor bdesc = {
+    .size = 512,
+    .usage = WGPU_BUFFER_USAGE_UNIFORM,
+  };
+  WGpuBuffer buffer = wgpu_device_create_buffer(device, &bdesc);
+
+  WGpuBindGroupLayoutEntry layoutEntry = {
+    .binding = 0,
+    .visibility = WGPU_SHADER_STAGE_VERTEX,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_BUFFER,
+    .layout.buffer = {
+      .type = WGPU_BUFFER_BINDING_TYPE_UNIFORM,
+    },
+  };
+  WGpuBindGroupLayout bgl = wgpu_device_create_bind_group_layout(device, &layoutEntry, 1);
+
+  WGpuBindGroupEntry entry = {
+    .binding = 0,
+    .resource = buffer,
+    .bufferBindSize = 256,
+  };
+  WGpuBindGroup bg = wgpu_device_create_bind_group_cached(device, bgl, &entry, 1);
+  assert(wgpu_is_bind_group(bg));
+  assert(wgpu_device_create_bind_group_cached(device, bgl, &entry, 1) == bg);
+
+  // A different buffer offset is a different bind group.
+  entry.bufferBindOffset = 256;
+  WGpuBindGroup bg2 = wgpu_device_create_bind_group_cached(device, bgl, &entry, 1);
+  assert(wgpu_is_bind_group(bg2));
+  assert(bg2 != bg);
+
+  WGpuBindGroupCacheStats stats;
+  wgpu_get_bind_group_cache_stats(&stats);
+  assert(stats.numBindGroups == 2);
+  assert(stats.numHits == 1);
+  assert(stats.numMisses == 2);
+
+  // Destroying the buffer evicts and destroys both bind groups that reference it.
+  wgpu_object_destroy(buffer);
+  assert(!wgpu_is_valid_object(bg));
+  assert(!wgpu_is_valid_object(bg2));
+  wgpu_get_bind_group_cache_stats(&stats);
+  assert(stats.numBindGroups == 0);
+
+  // When the cache is full, the least recently used bind group is evicted.
+  wgpu_bind_group_cache_set_capacity(2);
+  WGpuBuffer buffers[3];
+  WGpuBindGroup bindGroups[3];
+  entry.bufferBindOffset = 0;
+  for(int i = 0; i < 3; ++i)
+  {
+    buffers[i] = wgpu_device_create_buffer(device, &bdesc);
+    entry.resource = buffers[i];
+    bindGroups[i] = wgpu_device_create_bind_group_cached(device, bgl, &entry, 1);
+    if (i == 1)
+    {
+      // Use the first bind group again, so that the second one becomes the least recently used.
+      entry.resource = buffers[0];
+      assert(wgpu_device_create_bind_group_cached(device, bgl, &entry, 1) == bindGroups[0]);
+    }
+  }
+  assert(wgpu_is_bind_group(bindGroups[0]));
+  assert(!wgpu_is_valid_object(bindGroups[1]));
+  assert(wgpu_is_bind_group(bindGroups[2]));
+  wgpu_get_bind_group_cache_stats(&stats);
+  assert(stats.numBindGroups == 2);
+  assert(stats.numEvictions == 1);
+
+  wgpu_bind_group_cache_clear();
+  assert(!wgpu_is_valid_object(bindGroups[0]));
+  assert(!wgpu_is_valid_object(bindGroups[2]));
+  assert(wgpu_is_buffer(buffers[0]));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,108 @@
+// Verifies that wgpu_device_create_render_pipeline_cached() returns the same pipeline for descriptors that have identical
+// contents, even if they are stored at different addresses, and creates a new pipeline when any field differs or when an
+// object that the descriptor references has been replaced by a new object with the same ID.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <string.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuShaderModuleDescriptor vsDesc = {
+    .code = "@vertex fn main(@location(0) pos : vec2<f32>) -> @builtin(position) vec4<f32> { return vec4<f32>(pos, 0.0, 1.0); }"
+  };
+  WGpuShaderModule vs = wgpu_device_create_shader_module(device, &vsDesc);
+
+  WGpuShaderModuleDescriptor fsDesc = {
+    .code = "@fragment fn main() -> @location(0) vec4<f32> { return vec4<f32>(1.0); }"
+  };
+  WGpuShaderModule fs = wgpu_device_create_shader_module(device, &fsDesc);
+
+  WGpuVertexAttribute vertexAttr = {};
+  vertexAttr.format = WGPU_VERTEX_FORMAT_FLOAT32X2;
+
+  WGpuVertexBufferLayout vbLayout = {};
+  vbLayout.numAttributes = 1;
+  vbLayout.attributes = &vertexAttr;
+  vbLayout.arrayStride = 8;
+
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = navigator_gpu_get_preferred_canvas_format();
+
+  WGpuRenderPipelineDescriptor desc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.vertex.module = vs;
+  desc.vertex.entryPoint = "main";
+  desc.vertex.numBuffers = 1;
+  desc.vertex.buffers = &vbLayout;
+  desc.fragment.module = fs;
+  desc.fragment.entryPoint = "main";
+  desc.fragment.numTargets = 1;
+  desc.fragment.targets = &colorTarget;
+
+  WGpuRenderPipeline pipeline = wgpu_device_create_render_pipeline_cached(device, &desc);
+  assert(wgpu_is_render_pipeline(pipeline));
+
+  // A deep copy of the descriptor hits the cache.
+  char entryPoint[5];
+  strcpy(entryPoint, "main");
+  WGpuVertexAttribute vertexAttr2 = vertexAttr;
+  WGpuVertexBufferLayout vbLayout2 = vbLayout;
+  vbLayout2.attributes = &vertexAttr2;
+  WGpuColorTargetState colorTarget2 = colorTarget;
+  WGpuRenderPipelineDescriptor desc2 = desc;
+  desc2.vertex.entryPoint = entryPoint;
+  desc2.vertex.buffers = &vbLayout2;
+  desc2.fragment.targets = &colorTarget2;
+  assert(wgpu_device_create_render_pipeline_cached(device, &desc2) == pipeline);
+
+  // Changing a field behind a pointer misses the cache.
+  colorTarget2.writeMask = WGPU_COLOR_WRITE_RED;
+  WGpuRenderPipeline pipeline2 = wgpu_device_create_render_pipeline_cached(device, &desc2);
+  assert(wgpu_is_render_pipeline(pipeline2));
+  assert(pipeline2 != pipeline);
+
+  WGpuPipelineCacheStats stats;
+  wgpu_get_pipeline_cache_stats(&stats);
+  assert(stats.numPipelines == 2);
+  assert(stats.numHits == 1);
+  assert(stats.numMisses == 2);
+
+  // A new shader module that reuses the ID of a destroyed one is a different object, so it misses the cache.
+  wgpu_object_destroy(fs);
+  WGpuShaderModule fs2 = wgpu_device_create_shader_module(device, &fsDesc);
+  desc.fragment.module = fs2;
+  WGpuRenderPipeline pipeline3 = wgpu_device_create_render_pipeline_cached(device, &desc);
+  assert(wgpu_is_render_pipeline(pipeline3));
+  assert(pipeline3 != pipeline);
+  wgpu_get_pipeline_cache_stats(&stats);
+  assert(stats.numMisses == 3);
+
+  wgpu_pipeline_cache_clear();
+  assert(!wgpu_is_render_pipeline(pipeline));
+  assert(!wgpu_is_render_pipeline(pipeline2));
+  assert(!wgpu_is_render_pipeline(pipeline3));
+  wgpu_get_pipeline_cache_stats(&stats);
+  assert(stats.numPipelines == 0);
+
+  // A cached pipeline that was destroyed is not returned, even if an unrelated pipeline reuses its ID, and clearing
+  // the cache does not destroy that unrelated pipeline.
+  pipeline = wgpu_device_create_render_pipeline_cached(device, &desc);
+  wgpu_object_destroy(pipeline);
+  WGpuRenderPipeline appPipeline = wgpu_device_create_render_pipeline(device, &desc2);
+  assert(wgpu_device_create_render_pipeline_cached(device, &desc) != appPipeline);
+  wgpu_pipeline_cache_clear();
+  assert(wgpu_is_render_pipeline(appPipeline));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
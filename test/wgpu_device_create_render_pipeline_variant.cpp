@@ -0,0 +1,113 @@
+// Tests wgpu_device_create_render_pipeline_variant(): creates variants of a base render pipeline with different
+// culling, depth and blend state, overrides a pipeline constant, and derives a variant from another variant.
+// Variants must remain creatable after the base pipeline's shader module has been destroyed. Only pipelines that
+// retain their descriptors can be used as bases.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdio.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuShaderModuleDescriptor smdesc = {
+    .code = "override kScale: f32 = 1.0;\n"
+            "override kBrightness: f32 = 0.5;\n"
+            "@vertex fn vs(@builtin(vertex_index) vi: u32) -> @builtin(position) vec4f {\n"
+            "  return vec4f(0, 0, 0, kScale);\n"
+            "}\n"
+            "@fragment fn fs() -> @location(0) vec4f {\n"
+            "  return vec4f(kBrightness, kBrightness, kBrightness, 1);\n"
+            "}",
+  };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &smdesc);
+
+  WGpuPipelineConstant vsConstants[] = {
+    { .name = "kScale", .value = 2.0 },
+  };
+
+  WGpuColorTargetState ct = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  ct.format = navigator_gpu_get_preferred_canvas_format();
+
+  WGpuRenderPipelineDescriptor desc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.vertex.module = shader;
+  desc.vertex.entryPoint = "vs";
+  desc.vertex.constants = vsConstants;
+  desc.vertex.numConstants = 1;
+  desc.fragment.module = shader;
+  desc.fragment.entryPoint = "fs";
+  desc.fragment.targets = &ct;
+  desc.fragment.numTargets = 1;
+  desc.depthStencil.format = WGPU_TEXTURE_FORMAT_DEPTH24PLUS;
+  desc.depthStencil.depthWriteEnabled = WGPU_TRUE;
+  desc.depthStencil.depthCompare = WGPU_COMPARE_FUNCTION_LESS;
+  desc.retainDescriptor = WGPU_TRUE;
+
+  wgpu_device_push_error_scope(device, WGPU_ERROR_FILTER_VALIDATION);
+  WGpuRenderPipeline base = wgpu_device_create_render_pipeline(device, &desc);
+  assert(wgpu_is_render_pipeline(base));
+
+  // A back-face culled, alpha blended variant that does not write depth, e.g. for transparent geometry.
+  WGpuRenderPipelineDelta delta = {
+    .fields = WGPU_RENDER_PIPELINE_DELTA_CULL_MODE | WGPU_RENDER_PIPELINE_DELTA_DEPTH_WRITE | WGPU_RENDER_PIPELINE_DELTA_BLEND,
+    .cullMode = WGPU_CULL_MODE_BACK,
+    .depthWriteEnabled = WGPU_FALSE,
+    .blend = {
+      .color = { .operation = WGPU_BLEND_OPERATION_ADD, .srcFactor = WGPU_BLEND_FACTOR_SRC_ALPHA, .dstFactor = WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA },
+      .alpha = { .operation = WGPU_BLEND_OPERATION_ADD, .srcFactor = WGPU_BLEND_FACTOR_ONE, .dstFactor = WGPU_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA },
+    },
+    .retainDescriptor = WGPU_TRUE,
+  };
+  WGpuRenderPipeline transparent = wgpu_device_create_render_pipeline_variant(device, base, &delta);
+  assert(wgpu_is_render_pipeline(transparent));
+  assert(transparent != base);
+
+  // The shader module is retained by the pipelines that were created from it.
+  wgpu_object_destroy(shader);
+
+  // A variant of a variant that overrides a fragment constant that the base did not set, and a vertex constant that it did.
+  WGpuPipelineConstant fsConstants[] = {
+    { .name = "kBrightness", .value = 1.0 },
+  };
+  WGpuPipelineConstant vsConstants2[] = {
+    { .name = "kScale", .value = 4.0 },
+  };
+  WGpuRenderPipelineDelta constantsDelta = {
+    .fields = WGPU_RENDER_PIPELINE_DELTA_DEPTH_COMPARE,
+    .depthCompare = WGPU_COMPARE_FUNCTION_LESS_EQUAL,
+    .numVertexConstants = 1,
+    .numFragmentConstants = 1,
+    .retainDescriptor = WGPU_TRUE,
+    .vertexConstants = vsConstants2,
+    .fragmentConstants = fsConstants,
+  };
+  WGpuRenderPipeline bright = wgpu_device_create_render_pipeline_variant(device, transparent, &constantsDelta);
+  assert(wgpu_is_render_pipeline(bright));
+
+  // Destroying the base pipeline does not affect its variants.
+  wgpu_object_destroy(base);
+  WGpuRenderPipelineDelta linesDelta = {
+    .fields = WGPU_RENDER_PIPELINE_DELTA_TOPOLOGY | WGPU_RENDER_PIPELINE_DELTA_WRITE_MASK,
+    .topology = WGPU_PRIMITIVE_TOPOLOGY_LINE_LIST,
+    .writeMask = WGPU_COLOR_WRITE_RED,
+  };
+  WGpuRenderPipeline lines = wgpu_device_create_render_pipeline_variant(device, bright, &linesDelta);
+  assert(wgpu_is_render_pipeline(lines));
+
+  wgpu_device_pop_error_scope_async(device, [](WGpuDevice d, WGPU_ERROR_TYPE type, const char *m, void *) {
+    if (type != WGPU_ERROR_TYPE_NO_ERROR)
+      printf("Render pipeline variants: error: %s\n", m ? m : "");
+    assert(type == WGPU_ERROR_TYPE_NO_ERROR);
+    EM_ASM(window.close());
+  }, 0);
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,75 @@
+// Tests that with object interning, samplers, bind group layouts and pipeline layouts that are created with identical
+// descriptors share the same handle, and are only destroyed when the last reference to them is released.
+// flags: -sEXIT_RUNTIME=0 -jsDWEBGPU_OBJECT_INTERNING=1
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  uint32_t numLiveObjects = wgpu_get_num_live_objects();
+
+  WGpuSamplerDescriptor samplerDesc = WGPU_SAMPLER_DESCRIPTOR_DEFAULT_INITIALIZER;
+  WGpuSampler sampler = wgpu_device_create_sampler(device, &samplerDesc);
+  WGpuSamplerDescriptor samplerDesc2 = samplerDesc;
+  assert(wgpu_device_create_sampler(device, &samplerDesc2) == sampler);
+  samplerDesc2.magFilter = WGPU_FILTER_MODE_LINEAR;
+  WGpuSampler linearSampler = wgpu_device_create_sampler(device, &samplerDesc2);
+  assert(linearSampler != sampler);
+  assert(wgpu_get_num_live_objects() == numLiveObjects + 2);
+
+  // The first destroy releases one of the two references to the sampler.
+  wgpu_object_destroy(sampler);
+  assert(wgpu_is_sampler(sampler));
+  wgpu_object_destroy(sampler);
+  assert(!wgpu_is_valid_object(sampler));
+
+  WGpuBindGroupLayoutEntry layoutEntry = {
+    .binding = 0,
+    .visibility = WGPU_SHADER_STAGE_FRAGMENT,
+    .type = WGPU_BIND_GROUP_LAYOUT_TYPE_SAMPLER,
+    .layout.sampler = {
+      .type = WGPU_SAMPLER_BINDING_TYPE_FILTERING,
+    },
+  };
+  WGpuBindGroupLayout bgl = wgpu_device_create_bind_group_layout(device, &layoutEntry, 1);
+  assert(wgpu_device_create_bind_group_layout(device, &layoutEntry, 1) == bgl);
+
+  WGpuPipelineLayout pipelineLayout = wgpu_device_create_pipeline_layout(device, &bgl, 1);
+  assert(wgpu_device_create_pipeline_layout(device, &bgl, 1) == pipelineLayout);
+
+  // A bind group layout that reuses the ID of a destroyed one must not map to the old interned pipeline layout.
+  wgpu_object_destroy(bgl);
+  wgpu_object_destroy(bgl);
+  assert(!wgpu_is_valid_object(bgl));
+  layoutEntry.visibility = WGPU_SHADER_STAGE_VERTEX;
+  WGpuBindGroupLayout vertexBgl = wgpu_device_create_bind_group_layout(device, &layoutEntry, 1);
+  WGpuPipelineLayout vertexPipelineLayout = wgpu_device_create_pipeline_layout(device, &vertexBgl, 1);
+  assert(vertexPipelineLayout != pipelineLayout);
+
+  // Objects created inside a transient scope are not interned.
+  wgpu_transient_scope_begin();
+  WGpuSampler transientSampler = wgpu_device_create_sampler(device, &samplerDesc2);
+  assert(transientSampler != linearSampler);
+  wgpu_transient_scope_end();
+  assert(wgpu_is_sampler(linearSampler));
+
+  // Destroying the device destroys interned objects regardless of their reference count.
+  wgpu_object_destroy(device);
+  assert(!wgpu_is_valid_object(linearSampler));
+  assert(!wgpu_is_valid_object(vertexBgl));
+  assert(!wgpu_is_valid_object(pipelineLayout));
+  assert(!wgpu_is_valid_object(vertexPipelineLayout));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
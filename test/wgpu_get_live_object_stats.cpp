@@ -0,0 +1,48 @@
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuLiveObjectStats stats;
+  wgpu_get_live_object_stats(&stats);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_ADAPTER] == 1);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_DEVICE] == 1);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_QUEUE] == 1);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_SAMPLER] == 0);
+
+  WGpuSampler samplers[3];
+  for(int i = 0; i < 3; ++i)
+    samplers[i] = wgpu_device_create_sampler(device, 0);
+  wgpu_object_destroy(samplers[0]);
+
+  wgpu_get_live_object_stats(&stats);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_SAMPLER] == 2);
+  assert(stats.numCreatedObjects[WGPU_OBJECT_TYPE_SAMPLER] == 3);
+  assert(stats.numDestroyedObjects[WGPU_OBJECT_TYPE_SAMPLER] == 1);
+
+  uint32_t numLive = 0;
+  for(int i = 0; i < WGPU_OBJECT_TYPE_COUNT; ++i)
+    numLive += stats.numLiveObjects[i];
+  assert(numLive == wgpu_get_num_live_objects());
+
+  // Destroying the device destroys the Queue as well.
+  wgpu_object_destroy(device);
+  wgpu_get_live_object_stats(&stats);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_DEVICE] == 0);
+  assert(stats.numLiveObjects[WGPU_OBJECT_TYPE_QUEUE] == 0);
+  assert(stats.numDestroyedObjects[WGPU_OBJECT_TYPE_DEVICE] == 1);
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
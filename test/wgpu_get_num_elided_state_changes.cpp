@@ -0,0 +1,113 @@
+// Verifies that when building with WGPU_FILTER_REDUNDANT_STATE, state changes that set already bound state are elided and counted by
+// wgpu_get_num_elided_state_changes(), and that state changes that do change the state, or that are set on a new encoder that
+// reuses the handle of a finished one, are not.
+// flags: -sEXIT_RUNTIME=0 -DWGPU_FILTER_REDUNDANT_STATE
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+static const char *shaderCode =
+  "@vertex fn vs(@builtin(vertex_index) i: u32) -> @builtin(position) vec4f { return vec4f(0,0,0,1); }\n"
+  "@fragment fn fs() -> @location(0) vec4f { return vec4f(1,0,0,1); }";
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGPU_TEXTURE_FORMAT format = navigator_gpu_get_preferred_canvas_format();
+
+  WGpuCanvasConfiguration config = WGPU_CANVAS_CONFIGURATION_DEFAULT_INITIALIZER;
+  config.device = device;
+  config.format = format;
+  wgpu_canvas_context_configure(wgpu_canvas_get_webgpu_context("canvas"), &config);
+
+  WGpuShaderModuleDescriptor shaderDesc = { .code = shaderCode };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &shaderDesc);
+
+  WGpuRenderPipelineDescriptor pipeDesc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  pipeDesc.vertex.module = shader;
+  pipeDesc.vertex.entryPoint = "vs";
+  pipeDesc.fragment.module = shader;
+  pipeDesc.fragment.entryPoint = "fs";
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = format;
+  pipeDesc.fragment.numTargets = 1;
+  pipeDesc.fragment.targets = &colorTarget;
+  WGpuRenderPipeline pipeline = wgpu_device_create_render_pipeline(device, &pipeDesc);
+
+  // Create index buffer with 4 indices
+  uint16_t indices[] = { 0, 1, 2, 0 };
+  WGpuBufferDescriptor ibDesc = {
+    .size = sizeof(indices),
+    .usage = WGPU_BUFFER_USAGE_INDEX,
+    .mappedAtCreation = WGPU_TRUE,
+  };
+  WGpuBuffer indexBuf = wgpu_device_create_buffer(device, &ibDesc);
+  wgpu_buffer_get_mapped_range(indexBuf, 0);
+  wgpu_buffer_write_mapped_range(indexBuf, 0, 0, indices, sizeof(indices));
+  wgpu_buffer_unmap(indexBuf);
+
+  WGpuCommandEncoder encoder = wgpu_device_create_command_encoder(device, 0);
+  WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  colorAttachment.view = wgpu_canvas_context_get_current_texture(wgpu_canvas_get_webgpu_context("canvas"));
+  WGpuRenderPassDescriptor passDesc = {
+    .colorAttachments = &colorAttachment,
+    .numColorAttachments = 1,
+  };
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+
+  uint32_t numElided = wgpu_get_num_elided_state_changes();
+
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+  wgpu_render_pass_encoder_set_index_buffer(pass, indexBuf, WGPU_INDEX_FORMAT_UINT16, 0, sizeof(indices));
+  wgpu_render_pass_encoder_set_viewport(pass, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f);
+  wgpu_render_pass_encoder_set_scissor_rect(pass, 0, 0, 1, 1);
+  wgpu_render_pass_encoder_set_blend_constant(pass, 0.0, 0.0, 0.0, 1.0);
+  assert(wgpu_get_num_elided_state_changes() == numElided); // First calls set unknown state, so none are elided.
+  wgpu_render_pass_encoder_draw_indexed(pass, 3, 1, 0, 0, 0);
+
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+  wgpu_render_pass_encoder_set_index_buffer(pass, indexBuf, WGPU_INDEX_FORMAT_UINT16, 0, sizeof(indices));
+  wgpu_render_pass_encoder_set_viewport(pass, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f);
+  wgpu_render_pass_encoder_set_scissor_rect(pass, 0, 0, 1, 1);
+  wgpu_render_pass_encoder_set_blend_constant(pass, 0.0, 0.0, 0.0, 1.0);
+  assert(wgpu_get_num_elided_state_changes() == numElided + 5); // All of these are redundant.
+  wgpu_render_pass_encoder_draw_indexed(pass, 3, 1, 0, 0, 0);
+
+  wgpu_render_pass_encoder_set_index_buffer(pass, indexBuf, WGPU_INDEX_FORMAT_UINT16, 2, sizeof(indices) - 2);
+  wgpu_render_pass_encoder_set_scissor_rect(pass, 0, 0, 2, 2);
+  assert(wgpu_get_num_elided_state_changes() == numElided + 5); // These change the state, so they are not elided.
+  wgpu_render_pass_encoder_draw_indexed(pass, 3, 1, 0, 0, 0);
+
+  wgpu_render_pass_encoder_end(pass);
+
+  // A finished render bundle encoder releases its handle, which the next pass may reuse. The state that was set on the bundle
+  // encoder must not make the first state changes of that pass look redundant.
+  WGpuRenderBundleEncoderDescriptor bundleDesc = {
+    .colorFormats = &format,
+    .numColorFormats = 1,
+    .sampleCount = 1,
+  };
+  WGpuRenderBundleEncoder bundleEncoder = wgpu_device_create_render_bundle_encoder(device, &bundleDesc);
+  wgpu_render_bundle_encoder_set_pipeline(bundleEncoder, pipeline);
+  wgpu_render_bundle_encoder_set_index_buffer(bundleEncoder, indexBuf, WGPU_INDEX_FORMAT_UINT16, 0, sizeof(indices));
+  wgpu_object_destroy(wgpu_render_bundle_encoder_finish(bundleEncoder));
+  pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+  wgpu_render_pass_encoder_set_index_buffer(pass, indexBuf, WGPU_INDEX_FORMAT_UINT16, 0, sizeof(indices));
+  assert(wgpu_get_num_elided_state_changes() == numElided + 5);
+  wgpu_render_pass_encoder_draw_indexed(pass, 3, 1, 0, 0, 0);
+  wgpu_render_pass_encoder_end(pass);
+
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
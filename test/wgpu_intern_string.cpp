@@ -0,0 +1,54 @@
+// Tests that labels, entry points and pipeline constant names are read correctly both from strings registered with
+// wgpu_intern_string(), and from unregistered strings whose memory is reused for a different string between calls.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <string.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  static const char *entryPoint = "main";
+  wgpu_intern_string(entryPoint);
+
+  WGpuShaderModuleDescriptor smdesc = {
+    .code = "override kValue: u32 = 1;\n"
+            "@compute @workgroup_size(kValue) fn main() {}\n",
+  };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &smdesc);
+
+  WGpuPipelineConstant constant = { .name = "kValue", .value = 2.0 };
+  for(int i = 0; i < 2; ++i)
+  {
+    WGpuComputePipeline pipeline = wgpu_device_create_compute_pipeline(device, shader, entryPoint, WGPU_AUTO_LAYOUT_MODE_AUTO, &constant, 1);
+    assert(wgpu_is_compute_pipeline(pipeline));
+  }
+
+  // Reusing the same memory for a different label must not return the previously cached string.
+  char label[16];
+  char readLabel[16];
+  strcpy(label, "first");
+  wgpu_object_set_label(shader, label);
+  wgpu_object_get_label(shader, readLabel, sizeof(readLabel));
+  assert(!strcmp(readLabel, "first"));
+  strcpy(label, "second");
+  wgpu_object_set_label(shader, label);
+  wgpu_object_get_label(shader, readLabel, sizeof(readLabel));
+  assert(!strcmp(readLabel, "second"));
+  strcpy(label, "first");
+  wgpu_object_set_label(shader, label);
+  wgpu_object_get_label(shader, readLabel, sizeof(readLabel));
+  assert(!strcmp(readLabel, "first"));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
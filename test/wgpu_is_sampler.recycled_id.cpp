@@ -0,0 +1,39 @@
+// Verifies that the type of an object is forgotten when it is destroyed, so that wgpu_is_*() functions return
+// false for destroyed objects, and report the type of the new object when its ID gets recycled.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuSampler sampler = wgpu_device_create_sampler(device, 0);
+  assert(wgpu_is_sampler(sampler));
+  wgpu_object_destroy(sampler);
+  assert(!wgpu_is_sampler(sampler));
+
+  // Without generational handles, the texture reuses the ID of the destroyed sampler.
+  WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  desc.width = 16;
+  desc.height = 16;
+  WGpuTexture texture = wgpu_device_create_texture(device, &desc);
+  assert(texture == sampler);
+  assert(wgpu_is_texture(texture));
+  assert(!wgpu_is_sampler(texture));
+  assert(!wgpu_is_texture_view(texture));
+  assert(!wgpu_is_render_commands_mixin(texture));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
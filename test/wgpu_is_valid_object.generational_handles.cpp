@@ -0,0 +1,52 @@
+// Tests that with generational handles, a stale ID to a destroyed object does not alias
+// a new object that reuses the same slot in the object table.
+// flags: -sEXIT_RUNTIME=0 -jsDWEBGPU_GENERATIONAL_HANDLES=1
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuSampler first = wgpu_device_create_sampler(device, 0);
+  assert(wgpu_is_valid_object(first));
+  assert(wgpu_is_sampler(first));
+  wgpu_object_destroy(first);
+  assert(!wgpu_is_valid_object(first));
+
+  // The slot of 'first' is recycled, but under a different generation.
+  WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  desc.width = 16;
+  desc.height = 16;
+  WGpuTexture second = wgpu_device_create_texture(device, &desc);
+  assert(second != first);
+  assert((second & 0xFFFFF) == (first & 0xFFFFF));
+  assert(wgpu_is_valid_object(second));
+  assert(!wgpu_is_valid_object(first));
+  assert(!wgpu_is_sampler(first));
+  assert(!wgpu_is_texture(first));
+  assert(wgpu_texture_width(second) == 16);
+
+  // Destroying a stale handle is a no-op.
+  wgpu_object_destroy(first);
+  assert(wgpu_is_valid_object(second));
+
+  WGpuTextureView view = wgpu_texture_create_view_simple(second);
+  assert(wgpu_is_texture_view(view));
+  wgpu_object_destroy(second); // Destroys the view as well
+  assert(!wgpu_is_valid_object(view));
+  assert(wgpu_get_num_live_objects() == 3); // Adapter, Device and Queue
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,90 @@
+// Benchmarks the cost of the WebGPU object table under heavy object churn, which
+// is typical of a renderer that creates and destroys a number of textures, texture
+// views and command encoders each frame. The creation+destruction cost per object
+// is measured both with an empty object table, and with a large number of other
+// objects being kept alive, to verify that the cost of wgpuStore() and
+// wgpu_object_destroy() does not depend on the occupancy of the object table.
+// Run in -O3 and --closure builds to get representative numbers.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <emscripten/emscripten.h>
+#include <assert.h>
+#include <stdio.h>
+
+#define NUM_FRAMES 100
+#define NUM_OBJECTS_PER_FRAME 100
+#define NUM_LIVE_OBJECTS 20000
+
+static WGpuSampler liveObjects[NUM_LIVE_OBJECTS];
+
+// Simulates NUM_FRAMES frames, each creating and destroying NUM_OBJECTS_PER_FRAME
+// textures, texture views and command encoders. Returns the average time in
+// nanoseconds that one create+destroy pair took.
+static double ChurnObjects(WGpuDevice device)
+{
+  WGpuTextureDescriptor tdesc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  tdesc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  tdesc.usage  = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  tdesc.width  = 4;
+  tdesc.height = 4;
+
+  WGpuTexture textures[NUM_OBJECTS_PER_FRAME];
+  WGpuTextureView views[NUM_OBJECTS_PER_FRAME];
+  WGpuCommandEncoder encoders[NUM_OBJECTS_PER_FRAME];
+
+  uint32_t numLiveObjectsBefore = wgpu_get_num_live_objects();
+  double t0 = emscripten_get_now();
+  for(int frame = 0; frame < NUM_FRAMES; ++frame)
+  {
+    for(int i = 0; i < NUM_OBJECTS_PER_FRAME; ++i)
+    {
+      textures[i] = wgpu_device_create_texture(device, &tdesc);
+      views[i] = wgpu_texture_create_view_simple(textures[i]);
+      encoders[i] = wgpu_device_create_command_encoder_simple(device);
+    }
+    for(int i = 0; i < NUM_OBJECTS_PER_FRAME; ++i)
+    {
+      wgpu_object_destroy(encoders[i]);
+      wgpu_object_destroy(views[i]);
+      wgpu_object_destroy(textures[i]);
+    }
+  }
+  double t1 = emscripten_get_now();
+  assert(wgpu_get_num_live_objects() == numLiveObjectsBefore); // Churn should not leak objects
+
+  return (t1 - t0) * 1e6 / (NUM_FRAMES * NUM_OBJECTS_PER_FRAME * 3);
+}
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  uint32_t numLiveObjectsEmpty = wgpu_get_num_live_objects();
+  double emptyTable = ChurnObjects(device);
+
+  for(int i = 0; i < NUM_LIVE_OBJECTS; ++i)
+    liveObjects[i] = wgpu_device_create_sampler(device, 0);
+  // Free every other object to scatter free IDs all around the object table.
+  for(int i = 0; i < NUM_LIVE_OBJECTS; i += 2)
+    wgpu_object_destroy(liveObjects[i]);
+
+  double fullTable = ChurnObjects(device);
+
+  printf("Object churn: %.1f nsecs/object with %u live objects, %.1f nsecs/object with %u live objects.\n",
+    emptyTable, numLiveObjectsEmpty, fullTable, wgpu_get_num_live_objects());
+
+  for(int i = 1; i < NUM_LIVE_OBJECTS; i += 2)
+    wgpu_object_destroy(liveObjects[i]);
+  assert(wgpu_get_num_live_objects() == 3); // Adapter, Device and Queue
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,42 @@
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  desc.width = 16;
+  desc.height = 16;
+  WGpuTexture texture = wgpu_device_create_texture(device, &desc);
+  WGpuTextureView view = wgpu_texture_create_view_simple(texture);
+  WGpuSampler sampler = wgpu_device_create_sampler(device, 0);
+  WGpuSampler sampler2 = wgpu_device_create_sampler(device, 0);
+  assert(wgpu_get_num_live_objects() == 7);
+
+  // Null and already destroyed objects are skipped, and derived objects are destroyed with their parents.
+  wgpu_object_destroy(sampler2);
+  WGpuObjectBase objects[4] = { texture, 0, sampler2, sampler };
+  wgpu_object_destroy_many(objects, 4);
+  assert(!wgpu_is_valid_object(texture));
+  assert(!wgpu_is_valid_object(view));
+  assert(!wgpu_is_valid_object(sampler));
+  assert(wgpu_get_num_live_objects() == 3); // Adapter, Device and Queue
+
+  wgpu_object_destroy_many(0, 0);
+  assert(wgpu_get_num_live_objects() == 3);
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,76 @@
+// Benchmarks tearing down a hierarchy of 100k objects: 1000 textures with 99 views each.
+// Compares destroying every object individually, destroying the textures individually so
+// that their views are destroyed in cascade, and destroying the textures with a single
+// wgpu_object_destroy_many() call.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdio.h>
+#include <emscripten/emscripten.h>
+
+#define NUM_TEXTURES 1000
+#define NUM_VIEWS_PER_TEXTURE 99
+
+WGpuTexture textures[NUM_TEXTURES];
+WGpuTextureView views[NUM_TEXTURES][NUM_VIEWS_PER_TEXTURE];
+
+void CreateHierarchy(WGpuDevice device)
+{
+  WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  desc.width = 4;
+  desc.height = 4;
+  for(int i = 0; i < NUM_TEXTURES; ++i)
+  {
+    textures[i] = wgpu_device_create_texture(device, &desc);
+    for(int j = 0; j < NUM_VIEWS_PER_TEXTURE; ++j)
+      views[i][j] = wgpu_texture_create_view_simple(textures[i]);
+  }
+  assert(wgpu_get_num_live_objects() == 3 + NUM_TEXTURES * (1 + NUM_VIEWS_PER_TEXTURE));
+}
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  const int numObjects = NUM_TEXTURES * (1 + NUM_VIEWS_PER_TEXTURE);
+
+  CreateHierarchy(device);
+  double t0 = emscripten_performance_now();
+  for(int i = 0; i < NUM_TEXTURES; ++i)
+  {
+    for(int j = 0; j < NUM_VIEWS_PER_TEXTURE; ++j)
+      wgpu_object_destroy(views[i][j]);
+    wgpu_object_destroy(textures[i]);
+  }
+  double t1 = emscripten_performance_now();
+  assert(wgpu_get_num_live_objects() == 3);
+
+  CreateHierarchy(device);
+  double t2 = emscripten_performance_now();
+  for(int i = 0; i < NUM_TEXTURES; ++i)
+    wgpu_object_destroy(textures[i]);
+  double t3 = emscripten_performance_now();
+  assert(wgpu_get_num_live_objects() == 3);
+
+  CreateHierarchy(device);
+  double t4 = emscripten_performance_now();
+  wgpu_object_destroy_many(textures, NUM_TEXTURES);
+  double t5 = emscripten_performance_now();
+  assert(wgpu_get_num_live_objects() == 3);
+
+  printf("Tearing down %d objects: individually %.3f msecs, cascaded from parents %.3f msecs, wgpu_object_destroy_many() %.3f msecs.\n",
+    numObjects, t1-t0, t3-t2, t5-t4);
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
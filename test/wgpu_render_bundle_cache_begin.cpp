@@ -0,0 +1,130 @@
+// Verifies that wgpu_render_bundle_cache_begin() records a bundle only on the first use of a key, and records it again after an
+// object that the bundle references is destroyed.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+static const char *shaderCode =
+  "@vertex fn vs(@location(0) p: vec2f) -> @builtin(position) vec4f { return vec4f(p,0,1); }\n"
+  "@fragment fn fs() -> @location(0) vec4f { return vec4f(1,0,0,1); }";
+
+static WGpuDevice device;
+static WGpuRenderPipeline pipeline;
+static WGPU_TEXTURE_FORMAT format;
+
+static WGpuBuffer CreateVertexBuffer()
+{
+  float vertices[] = { 0.f, 0.f, 1.f, 0.f, 0.f, 1.f };
+  WGpuBufferDescriptor vbDesc = {
+    .size = sizeof(vertices),
+    .usage = WGPU_BUFFER_USAGE_VERTEX,
+    .mappedAtCreation = WGPU_TRUE,
+  };
+  WGpuBuffer vb = wgpu_device_create_buffer(device, &vbDesc);
+  wgpu_buffer_get_mapped_range(vb, 0);
+  wgpu_buffer_write_mapped_range(vb, 0, 0, vertices, sizeof(vertices));
+  wgpu_buffer_unmap(vb);
+  return vb;
+}
+
+// Renders a frame with a cached block of draws, and returns whether the block had to be recorded.
+static bool RenderFrame(WGpuBuffer vertexBuffer)
+{
+  WGpuCommandEncoder encoder = wgpu_device_create_command_encoder(device, 0);
+  WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  colorAttachment.view = wgpu_canvas_context_get_current_texture(wgpu_canvas_get_webgpu_context("canvas"));
+  WGpuRenderPassDescriptor passDesc = {
+    .colorAttachments = &colorAttachment,
+    .numColorAttachments = 1,
+  };
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+
+  WGpuRenderBundleEncoderDescriptor bundleDesc = {
+    .colorFormats = &format,
+    .numColorFormats = 1,
+    .sampleCount = 1,
+  };
+  WGpuRenderBundleEncoder bundleEncoder = wgpu_render_bundle_cache_begin(device, 42, &bundleDesc);
+  if (bundleEncoder)
+  {
+    wgpu_render_bundle_encoder_set_pipeline(bundleEncoder, pipeline);
+    wgpu_render_bundle_encoder_set_vertex_buffer(bundleEncoder, 0, vertexBuffer);
+    for(int i = 0; i < 100; ++i)
+      wgpu_render_bundle_encoder_draw(bundleEncoder, 3);
+  }
+  wgpu_render_bundle_cache_end(pass, 42, bundleEncoder);
+
+  wgpu_render_pass_encoder_end(pass);
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+  return bundleEncoder != 0;
+}
+
+void ObtainedWebGpuDevice(WGpuDevice dev, void *userData)
+{
+  device = dev;
+  format = navigator_gpu_get_preferred_canvas_format();
+
+  WGpuCanvasConfiguration config = WGPU_CANVAS_CONFIGURATION_DEFAULT_INITIALIZER;
+  config.device = device;
+  config.format = format;
+  wgpu_canvas_context_configure(wgpu_canvas_get_webgpu_context("canvas"), &config);
+
+  WGpuShaderModuleDescriptor shaderDesc = { .code = shaderCode };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &shaderDesc);
+
+  WGpuVertexAttribute attr = { .offset = 0, .shaderLocation = 0, .format = WGPU_VERTEX_FORMAT_FLOAT32X2 };
+  WGpuVertexBufferLayout vbLayout = { .attributes = &attr, .numAttributes = 1, .arrayStride = 8 };
+  WGpuRenderPipelineDescriptor pipeDesc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  pipeDesc.vertex.module = shader;
+  pipeDesc.vertex.entryPoint = "vs";
+  pipeDesc.vertex.numBuffers = 1;
+  pipeDesc.vertex.buffers = &vbLayout;
+  pipeDesc.fragment.module = shader;
+  pipeDesc.fragment.entryPoint = "fs";
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = format;
+  pipeDesc.fragment.numTargets = 1;
+  pipeDesc.fragment.targets = &colorTarget;
+  pipeline = wgpu_device_create_render_pipeline(device, &pipeDesc);
+
+  WGpuBuffer vb = CreateVertexBuffer();
+  assert(RenderFrame(vb));  // Recorded
+  assert(!RenderFrame(vb)); // Replayed from the cache
+
+  WGpuRenderBundleCacheStats stats;
+  wgpu_get_render_bundle_cache_stats(&stats);
+  assert(stats.numBundles == 1);
+  assert(stats.numHits == 1);
+  assert(stats.numMisses == 1);
+
+  // Destroying the vertex buffer that the bundle references evicts the bundle, so it is recorded again.
+  wgpu_object_destroy(vb);
+  wgpu_get_render_bundle_cache_stats(&stats);
+  assert(stats.numBundles == 0);
+  vb = CreateVertexBuffer();
+  assert(RenderFrame(vb));
+  assert(!RenderFrame(vb));
+
+  // Invalidating the key explicitly also records it again.
+  wgpu_render_bundle_cache_invalidate(42);
+  assert(RenderFrame(vb));
+
+  wgpu_render_bundle_cache_clear();
+  wgpu_get_render_bundle_cache_stats(&stats);
+  assert(stats.numBundles == 0);
+  assert(stats.numHits == 2);
+  assert(stats.numMisses == 3);
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
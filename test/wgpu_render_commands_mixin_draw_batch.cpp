@@ -0,0 +1,89 @@
+// Verifies that wgpu_render_commands_mixin_draw_batch() performs the state changes and draws of each item in a render pass,
+// and leaves state that an item does not set unchanged for the following items.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+static const char *shaderCode =
+  "@vertex fn vs(@builtin(vertex_index) i: u32) -> @builtin(position) vec4f { return vec4f(0,0,0,1); }\n"
+  "@fragment fn fs() -> @location(0) vec4f { return vec4f(1,0,0,1); }";
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGPU_TEXTURE_FORMAT format = navigator_gpu_get_preferred_canvas_format();
+
+  WGpuCanvasConfiguration config = WGPU_CANVAS_CONFIGURATION_DEFAULT_INITIALIZER;
+  config.device = device;
+  config.format = format;
+  wgpu_canvas_context_configure(wgpu_canvas_get_webgpu_context("canvas"), &config);
+
+  WGpuShaderModuleDescriptor shaderDesc = { .code = shaderCode };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &shaderDesc);
+
+  WGpuRenderPipelineDescriptor pipeDesc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  pipeDesc.vertex.module = shader;
+  pipeDesc.vertex.entryPoint = "vs";
+  pipeDesc.fragment.module = shader;
+  pipeDesc.fragment.entryPoint = "fs";
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = format;
+  pipeDesc.fragment.numTargets = 1;
+  pipeDesc.fragment.targets = &colorTarget;
+  WGpuRenderPipeline pipeline = wgpu_device_create_render_pipeline(device, &pipeDesc);
+
+  // Create index buffer with 4 indices
+  uint16_t indices[] = { 0, 1, 2, 0 };
+  WGpuBufferDescriptor ibDesc = {
+    .size = sizeof(indices),
+    .usage = WGPU_BUFFER_USAGE_INDEX,
+    .mappedAtCreation = WGPU_TRUE,
+  };
+  WGpuBuffer indexBuf = wgpu_device_create_buffer(device, &ibDesc);
+  wgpu_buffer_get_mapped_range(indexBuf, 0);
+  wgpu_buffer_write_mapped_range(indexBuf, 0, 0, indices, sizeof(indices));
+  wgpu_buffer_unmap(indexBuf);
+
+  WGpuCommandEncoder encoder = wgpu_device_create_command_encoder(device, 0);
+  WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  colorAttachment.view = wgpu_canvas_context_get_current_texture(wgpu_canvas_get_webgpu_context("canvas"));
+  WGpuRenderPassDescriptor passDesc = {
+    .colorAttachments = &colorAttachment,
+    .numColorAttachments = 1,
+  };
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+
+  WGpuDrawBatchItem items[3];
+  for(int i = 0; i < 3; ++i)
+    items[i] = WGPU_DRAW_BATCH_ITEM_DEFAULT_INITIALIZER;
+
+  // First item binds the pipeline and the index buffer, and draws indexed.
+  items[0].pipeline = pipeline;
+  items[0].indexFormat = WGPU_INDEX_FORMAT_UINT16;
+  items[0].indexBuffer.buffer = indexBuf;
+  items[0].indexCount = 3;
+  // Second item reuses the state of the first item, and draws non-indexed.
+  items[1].vertexCount = 3;
+  // Third item reuses the index buffer with a different first index, and draws two instances.
+  items[2].indexCount = 3;
+  items[2].firstIndex = 1;
+  items[2].instanceCount = 2;
+
+  wgpu_render_commands_mixin_draw_batch(pass, items, 3);
+  wgpu_render_commands_mixin_draw_batch(pass, items, 0); // An empty batch is a no-op.
+
+  wgpu_render_pass_encoder_end(pass);
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
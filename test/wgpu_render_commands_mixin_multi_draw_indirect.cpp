@@ -0,0 +1,102 @@
+// Verifies that wgpu_render_commands_mixin_multi_draw_indirect() and its indexed and draw count buffer variants
+// issue tightly packed and strided indirect draws on render passes and render bundles.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+static const char *shaderCode =
+  "@vertex fn vs(@builtin(vertex_index) i: u32) -> @builtin(position) vec4f { return vec4f(f32(i&1u), f32(i>>1u), 0, 1); }\n"
+  "@fragment fn fs() -> @location(0) vec4f { return vec4f(1,0,0,1); }";
+
+static WGpuBuffer CreateBuffer(WGpuDevice device, int usage, const void *data, uint32_t size)
+{
+  WGpuBufferDescriptor desc = {
+    .size = size,
+    .usage = usage,
+    .mappedAtCreation = WGPU_TRUE,
+  };
+  WGpuBuffer buffer = wgpu_device_create_buffer(device, &desc);
+  wgpu_buffer_get_mapped_range(buffer, 0);
+  wgpu_buffer_write_mapped_range(buffer, 0, 0, data, size);
+  wgpu_buffer_unmap(buffer);
+  return buffer;
+}
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGPU_TEXTURE_FORMAT format = navigator_gpu_get_preferred_canvas_format();
+  WGpuCanvasContext canvasContext = wgpu_canvas_get_webgpu_context("canvas");
+  WGpuCanvasConfiguration config = WGPU_CANVAS_CONFIGURATION_DEFAULT_INITIALIZER;
+  config.device = device;
+  config.format = format;
+  wgpu_canvas_context_configure(canvasContext, &config);
+
+  WGpuShaderModuleDescriptor shaderDesc = { .code = shaderCode };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &shaderDesc);
+  WGpuRenderPipelineDescriptor pipeDesc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  pipeDesc.vertex.module = shader;
+  pipeDesc.vertex.entryPoint = "vs";
+  pipeDesc.fragment.module = shader;
+  pipeDesc.fragment.entryPoint = "fs";
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = format;
+  pipeDesc.fragment.numTargets = 1;
+  pipeDesc.fragment.targets = &colorTarget;
+  WGpuRenderPipeline pipeline = wgpu_device_create_render_pipeline(device, &pipeDesc);
+
+  // Three tightly packed draws, and three draws with a 32 byte stride. The last draw has instanceCount 0, so that it is a
+  // no-op past the draw count of 2 in the draw count buffer.
+  uint32_t drawArgs[] = { 3,1,0,0, 3,1,1,0, 3,0,0,0 };
+  uint32_t stridedDrawArgs[] = { 3,1,0,0, 0,0,0,0, 3,1,1,0, 0,0,0,0, 3,0,0,0, 0,0,0,0 };
+  uint32_t indexedDrawArgs[] = { 3,1,0,0,0, 3,1,1,0,0, 3,0,0,0,0 };
+  uint32_t drawCount = 2;
+  uint16_t indices[] = { 0, 1, 2, 3 };
+  WGpuBuffer indirectBuffer = CreateBuffer(device, WGPU_BUFFER_USAGE_INDIRECT, drawArgs, sizeof(drawArgs));
+  WGpuBuffer stridedIndirectBuffer = CreateBuffer(device, WGPU_BUFFER_USAGE_INDIRECT, stridedDrawArgs, sizeof(stridedDrawArgs));
+  WGpuBuffer indexedIndirectBuffer = CreateBuffer(device, WGPU_BUFFER_USAGE_INDIRECT, indexedDrawArgs, sizeof(indexedDrawArgs));
+  WGpuBuffer drawCountBuffer = CreateBuffer(device, WGPU_BUFFER_USAGE_INDIRECT, &drawCount, sizeof(drawCount));
+  WGpuBuffer indexBuffer = CreateBuffer(device, WGPU_BUFFER_USAGE_INDEX, indices, sizeof(indices));
+
+  WGpuRenderBundleEncoderDescriptor bundleDesc = {
+    .colorFormats = &format,
+    .numColorFormats = 1,
+    .sampleCount = 1,
+  };
+  WGpuRenderBundleEncoder bundleEncoder = wgpu_device_create_render_bundle_encoder(device, &bundleDesc);
+  wgpu_render_bundle_encoder_set_pipeline(bundleEncoder, pipeline);
+  wgpu_render_bundle_encoder_multi_draw_indirect(bundleEncoder, stridedIndirectBuffer, 0, 3, 32);
+  WGpuRenderBundle bundle = wgpu_render_bundle_encoder_finish(bundleEncoder);
+  assert(wgpu_is_render_bundle(bundle));
+
+  WGpuCommandEncoder encoder = wgpu_device_create_command_encoder(device, 0);
+  WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  colorAttachment.view = wgpu_canvas_context_get_current_texture(canvasContext);
+  WGpuRenderPassDescriptor passDesc = {
+    .colorAttachments = &colorAttachment,
+    .numColorAttachments = 1,
+  };
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+  wgpu_render_pass_encoder_multi_draw_indirect(pass, indirectBuffer, 0, 3);
+  wgpu_render_pass_encoder_multi_draw_indirect(pass, stridedIndirectBuffer, 32, 2, 32);
+  wgpu_render_pass_encoder_multi_draw_indirect_count(pass, indirectBuffer, 0, 3, 0, drawCountBuffer, 0);
+  wgpu_render_pass_encoder_set_index_buffer(pass, indexBuffer, WGPU_INDEX_FORMAT_UINT16);
+  wgpu_render_pass_encoder_multi_draw_indexed_indirect(pass, indexedIndirectBuffer, 0, 3);
+  wgpu_render_pass_encoder_multi_draw_indexed_indirect_count(pass, indexedIndirectBuffer, 0, 3, WGPU_DRAW_INDEXED_INDIRECT_ARGS_SIZE, drawCountBuffer, 0);
+  wgpu_render_pass_encoder_execute_bundles(pass, &bundle, 1);
+  wgpu_render_pass_encoder_end(pass);
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
@@ -0,0 +1,116 @@
+// Benchmarks the CPU cost of issuing draw calls directly with one Wasm->JS call per command,
+// versus recording them with wgpu_record_draw() and replaying the recorded command stream
+// with wgpu_render_pass_flush_commands(). Each draw call is preceded by a
+// wgpu_render_pass_encoder_set_scissor_rect() call, to resemble a renderer that changes
+// some state between draws.
+// Run in -O3 and --closure builds to get representative numbers.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <emscripten/emscripten.h>
+#include <assert.h>
+#include <stdio.h>
+
+#define RENDER_TARGET_SIZE 64
+
+static const char *shaderCode =
+  "@vertex fn vs(@builtin(vertex_index) i: u32) -> @builtin(position) vec4f { return vec4f(0,0,0,1); }\n"
+  "@fragment fn fs() -> @location(0) vec4f { return vec4f(1,0,0,1); }";
+
+static WGpuDevice device;
+static WGpuRenderPipeline pipeline;
+static WGpuTextureView renderTarget;
+
+// Renders numDraws draw calls in one render pass, either directly or via the command
+// recorder. Returns the average time in nanoseconds that issuing one draw took, excluding
+// the time taken to submit the work to the GPU.
+static double RenderDraws(int numDraws, bool record)
+{
+  WGpuCommandEncoder encoder = wgpu_device_create_command_encoder_simple(device);
+  WGpuRenderPassColorAttachment colorAttachment = WGPU_RENDER_PASS_COLOR_ATTACHMENT_DEFAULT_INITIALIZER;
+  colorAttachment.view = renderTarget;
+  WGpuRenderPassDescriptor passDesc = {
+    .colorAttachments = &colorAttachment,
+    .numColorAttachments = 1,
+  };
+  WGpuRenderPassEncoder pass = wgpu_command_encoder_begin_render_pass(encoder, &passDesc);
+  wgpu_render_pass_encoder_set_pipeline(pass, pipeline);
+
+  double t0 = emscripten_get_now();
+  if (record)
+  {
+    for(int i = 0; i < numDraws; ++i)
+    {
+      wgpu_record_set_scissor_rect(pass, i % RENDER_TARGET_SIZE, 0, 1, RENDER_TARGET_SIZE);
+      wgpu_record_draw(pass, 3, 1, 0, 0);
+    }
+    wgpu_render_pass_flush_commands(pass);
+  }
+  else
+  {
+    for(int i = 0; i < numDraws; ++i)
+    {
+      wgpu_render_pass_encoder_set_scissor_rect(pass, i % RENDER_TARGET_SIZE, 0, 1, RENDER_TARGET_SIZE);
+      wgpu_render_pass_encoder_draw(pass, 3, 1, 0, 0);
+    }
+  }
+  double t1 = emscripten_get_now();
+
+  wgpu_render_pass_encoder_end(pass);
+  wgpu_queue_submit_one_and_destroy(wgpu_device_get_queue(device), wgpu_command_encoder_finish(encoder));
+  wgpu_object_destroy(pass);
+  wgpu_object_destroy(encoder);
+
+  return (t1 - t0) * 1e6 / numDraws;
+}
+
+void ObtainedWebGpuDevice(WGpuDevice result, void *userData)
+{
+  device = result;
+
+  WGpuShaderModuleDescriptor shaderDesc = { .code = shaderCode };
+  WGpuShaderModule shader = wgpu_device_create_shader_module(device, &shaderDesc);
+
+  WGpuRenderPipelineDescriptor pipeDesc = WGPU_RENDER_PIPELINE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  pipeDesc.vertex.module = shader;
+  pipeDesc.vertex.entryPoint = "vs";
+  pipeDesc.fragment.module = shader;
+  pipeDesc.fragment.entryPoint = "fs";
+  WGpuColorTargetState colorTarget = WGPU_COLOR_TARGET_STATE_DEFAULT_INITIALIZER;
+  colorTarget.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  pipeDesc.fragment.numTargets = 1;
+  pipeDesc.fragment.targets = &colorTarget;
+  pipeline = wgpu_device_create_render_pipeline(device, &pipeDesc);
+
+  WGpuTextureDescriptor tdesc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  tdesc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  tdesc.usage  = WGPU_TEXTURE_USAGE_RENDER_ATTACHMENT;
+  tdesc.width  = RENDER_TARGET_SIZE;
+  tdesc.height = RENDER_TARGET_SIZE;
+  renderTarget = wgpu_texture_create_view_simple(wgpu_device_create_texture(device, &tdesc));
+
+  // Warm up both code paths before measuring.
+  RenderDraws(1000, false);
+  RenderDraws(1000, true);
+
+  const int numDraws[] = { 1000, 10000, 100000 };
+  for(int i = 0; i < 3; ++i)
+  {
+    double direct = RenderDraws(numDraws[i], false);
+    double recorded = RenderDraws(numDraws[i], true);
+    printf("%d draws: %.1f nsecs/draw direct, %.1f nsecs/draw recorded (%.2fx).\n",
+      numDraws[i], direct, recorded, direct / recorded);
+  }
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
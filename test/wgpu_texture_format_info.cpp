@@ -0,0 +1,109 @@
+// Tests wgpu_texture_format_info() and the texture upload size helpers: checks block sizes, aspects and sRGB pairs of a few formats,
+// then uploads the full mip chain of a texture with a non-256-multiple width both with wgpu_queue_write_texture() using tightly packed
+// rows, and with wgpu_command_encoder_copy_buffer_to_texture() from a staging buffer sized and pitched with the helpers.
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  const WGpuTextureFormatInfo *rgba8 = wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_RGBA8UNORM);
+  assert(rgba8->blockWidth == 1 && rgba8->blockHeight == 1 && rgba8->bytesPerBlock == 4 && rgba8->numComponents == 4);
+  assert(rgba8->srgbPair == WGPU_TEXTURE_FORMAT_RGBA8UNORM_SRGB);
+  assert(wgpu_texture_format_info(rgba8->srgbPair)->flags & WGPU_TEXTURE_FORMAT_FLAG_SRGB);
+  assert(rgba8->flags & WGPU_TEXTURE_FORMAT_FLAG_FILTERABLE);
+  assert(!(wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_R32FLOAT)->flags & WGPU_TEXTURE_FORMAT_FLAG_FILTERABLE));
+
+  const WGpuTextureFormatInfo *ds = wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_DEPTH32FLOAT_STENCIL8);
+  assert(ds->flags & WGPU_TEXTURE_FORMAT_FLAG_DEPTH);
+  assert(ds->flags & WGPU_TEXTURE_FORMAT_FLAG_STENCIL);
+  assert(ds->sampleType == WGPU_TEXTURE_SAMPLE_TYPE_DEPTH);
+
+  const WGpuTextureFormatInfo *astc = wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_ASTC_10X6_UNORM_SRGB);
+  assert(astc->blockWidth == 10 && astc->blockHeight == 6 && astc->bytesPerBlock == 16);
+  assert(astc->compression == WGPU_TEXTURE_COMPRESSION_ASTC);
+  assert(astc->srgbPair == WGPU_TEXTURE_FORMAT_ASTC_10X6_UNORM);
+
+  // A 13x13 BC1 image is 4x4 blocks of 8 bytes.
+  assert(wgpu_texture_format_bytes_per_row(WGPU_TEXTURE_FORMAT_BC1_RGBA_UNORM, 13) == 32);
+  assert(wgpu_texture_format_rows_per_image(WGPU_TEXTURE_FORMAT_BC1_RGBA_UNORM, 13) == 4);
+  assert(wgpu_texture_format_image_size(WGPU_TEXTURE_FORMAT_BC1_RGBA_UNORM, 13, 13, 1, 0) == 128);
+
+  // Invalid formats return the WGPU_TEXTURE_FORMAT_INVALID entry.
+  assert(wgpu_texture_format_info(-1) == wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_INVALID));
+  assert(wgpu_texture_format_info(WGPU_VERTEX_FORMAT_FLOAT32X4) == wgpu_texture_format_info(WGPU_TEXTURE_FORMAT_INVALID));
+  assert(wgpu_texture_format_bytes_per_row(WGPU_TEXTURE_FORMAT_INVALID, 100) == 0);
+
+  const uint32_t width = 100, height = 30, mipLevelCount = 3;
+  assert(wgpu_texture_format_bytes_per_row(WGPU_TEXTURE_FORMAT_RGBA8UNORM, width) == 400);
+  assert(wgpu_texture_format_aligned_bytes_per_row(WGPU_TEXTURE_FORMAT_RGBA8UNORM, width) == 512);
+  assert(wgpu_texture_format_mip_chain_size(WGPU_TEXTURE_FORMAT_RGBA8UNORM, WGPU_TEXTURE_DIMENSION_2D, width, height, 1, mipLevelCount, WGPU_FALSE)
+    == (100*30 + 50*15 + 25*7) * 4);
+  assert(wgpu_texture_format_mip_chain_size(WGPU_TEXTURE_FORMAT_RGBA8UNORM, WGPU_TEXTURE_DIMENSION_2D, width, height, 1, mipLevelCount, WGPU_TRUE)
+    == 512*30 + 256*15 + 256*7);
+  // The depth of a 3D texture is halved at each level.
+  assert(wgpu_texture_format_mip_chain_size(WGPU_TEXTURE_FORMAT_R8UNORM, WGPU_TEXTURE_DIMENSION_3D, 4, 4, 4, 3, WGPU_FALSE) == 64 + 8 + 1);
+
+  WGpuTextureDescriptor tdesc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  tdesc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  tdesc.usage = WGPU_TEXTURE_USAGE_COPY_DST | WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  tdesc.width = width;
+  tdesc.height = height;
+  tdesc.mipLevelCount = mipLevelCount;
+  WGpuTexture texture = wgpu_device_create_texture(device, &tdesc);
+
+  uint64_t stagingSize = wgpu_texture_format_mip_chain_size(tdesc.format, WGPU_TEXTURE_DIMENSION_2D, width, height, 1, mipLevelCount, WGPU_TRUE);
+  WGpuBufferDescriptor bdesc = {
+    .size = stagingSize,
+    .usage = WGPU_BUFFER_USAGE_COPY_SRC,
+    .mappedAtCreation = WGPU_TRUE,
+  };
+  WGpuBuffer staging = wgpu_device_create_buffer(device, &bdesc);
+  wgpu_buffer_unmap(staging);
+
+  wgpu_device_push_error_scope(device, WGPU_ERROR_FILTER_VALIDATION);
+  WGpuQueue queue = wgpu_device_get_queue(device);
+  WGpuCommandEncoder enc = wgpu_device_create_command_encoder(device, 0);
+  WGpuTexelCopyBufferInfo src = WGPU_TEXEL_COPY_BUFFER_INFO_DEFAULT_INITIALIZER;
+  src.buffer = staging;
+  WGpuTexelCopyTextureInfo dst = WGPU_TEXEL_COPY_TEXTURE_INFO_DEFAULT_INITIALIZER;
+  dst.texture = texture;
+  void *pixels = calloc(wgpu_texture_format_image_size(tdesc.format, width, height, 1, 0), 1);
+  for(uint32_t level = 0; level < mipLevelCount; ++level)
+  {
+    uint32_t w = width >> level, h = height >> level;
+    dst.mipLevel = level;
+
+    // wgpu_queue_write_texture() accepts tightly packed rows.
+    wgpu_queue_write_texture(queue, &dst, pixels, wgpu_texture_format_bytes_per_row(tdesc.format, w), wgpu_texture_format_rows_per_image(tdesc.format, h), w, h);
+
+    // Buffer to texture copies require rows to be 256-byte aligned.
+    src.bytesPerRow = wgpu_texture_format_aligned_bytes_per_row(tdesc.format, w);
+    src.rowsPerImage = wgpu_texture_format_rows_per_image(tdesc.format, h);
+    wgpu_command_encoder_copy_buffer_to_texture(enc, &src, &dst, w, h);
+    src.offset += wgpu_texture_format_image_size(tdesc.format, w, h, 1, src.bytesPerRow);
+  }
+  free(pixels);
+  assert(src.offset == stagingSize);
+  wgpu_queue_submit_one_and_destroy(queue, wgpu_command_encoder_finish(enc));
+
+  wgpu_device_pop_error_scope_async(device, [](WGpuDevice d, WGPU_ERROR_TYPE type, const char *m, void *) {
+    if (type != WGPU_ERROR_TYPE_NO_ERROR)
+      printf("Texture uploads: error: %s\n", m ? m : "");
+    assert(type == WGPU_ERROR_TYPE_NO_ERROR);
+    EM_ASM(window.close());
+  }, 0);
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}
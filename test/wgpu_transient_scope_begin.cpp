@@ -0,0 +1,49 @@
+// flags: -sEXIT_RUNTIME=0
+
+#include "lib_webgpu.h"
+#include <assert.h>
+
+void ObtainedWebGpuDevice(WGpuDevice device, void *userData)
+{
+  WGpuTextureDescriptor desc = WGPU_TEXTURE_DESCRIPTOR_DEFAULT_INITIALIZER;
+  desc.format = WGPU_TEXTURE_FORMAT_RGBA8UNORM;
+  desc.usage = WGPU_TEXTURE_USAGE_TEXTURE_BINDING;
+  desc.width = 16;
+  desc.height = 16;
+  WGpuTexture texture = wgpu_device_create_texture(device, &desc);
+  assert(wgpu_get_num_live_objects() == 4); // Adapter, Device, Queue and Texture
+
+  for(int frame = 0; frame < 3; ++frame)
+  {
+    wgpu_transient_scope_begin();
+    WGpuTextureView view = wgpu_texture_create_view_simple(texture);
+    WGpuCommandEncoder encoder = wgpu_device_create_command_encoder_simple(device);
+    WGpuCommandBuffer commandBuffer = wgpu_encoder_finish(encoder); // Destroys the encoder
+    assert(wgpu_is_texture_view(view));
+    assert(!wgpu_is_valid_object(encoder));
+    assert(wgpu_is_command_buffer(commandBuffer));
+    assert(wgpu_get_num_live_objects() == 6);
+    wgpu_transient_scope_end();
+
+    assert(!wgpu_is_valid_object(view));
+    assert(!wgpu_is_valid_object(commandBuffer));
+    assert(wgpu_is_texture(texture));
+    assert(wgpu_get_num_live_objects() == 4);
+  }
+
+  // Objects created outside a transient scope are not affected by it.
+  wgpu_object_destroy(texture);
+  assert(wgpu_get_num_live_objects() == 3);
+
+  EM_ASM(window.close());
+}
+
+void ObtainedWebGpuAdapter(WGpuAdapter adapter, void *userData)
+{
+  wgpu_adapter_request_device_async_simple(adapter, ObtainedWebGpuDevice);
+}
+
+int main()
+{
+  navigator_gpu_request_adapter_async_simple(ObtainedWebGpuAdapter);
+}